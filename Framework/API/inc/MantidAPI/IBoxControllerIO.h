@@ -9,6 +9,8 @@
 #include "MantidKernel/DiskBuffer.h"
 #include "MantidKernel/System.h"
 
+#include <vector>
+
 namespace Mantid {
 namespace API {
 
@@ -45,6 +47,24 @@ public:
   /**Save a double data block in the specified file position */
   virtual void saveBlock(const std::vector<double> & /* DataBlock */,
                          const uint64_t /*blockPosition*/) const = 0;
+  /** Save a float data block holding the events of a box with the given
+   * extents. Back ends making no use of the extents save it with saveBlock()
+   */
+  virtual void saveBlockInBox(const std::vector<float> &DataBlock,
+                              const uint64_t blockPosition,
+                              const std::vector<double> & /*boxMin*/,
+                              const std::vector<double> & /*boxMax*/) const {
+    this->saveBlock(DataBlock, blockPosition);
+  }
+  /** Save a double data block holding the events of a box with the given
+   * extents. Back ends making no use of the extents save it with saveBlock()
+   */
+  virtual void saveBlockInBox(const std::vector<double> &DataBlock,
+                              const uint64_t blockPosition,
+                              const std::vector<double> & /*boxMin*/,
+                              const std::vector<double> & /*boxMax*/) const {
+    this->saveBlock(DataBlock, blockPosition);
+  }
   /** load known size float data block from spefied file position */
   virtual void loadBlock(std::vector<float> & /* Block */,
                          const uint64_t /*blockPosition*/,
@@ -39,6 +39,24 @@ CoordTransform::CoordTransform(const size_t inD, const size_t outD)
         "CoordTransform: invalid number of input dimensions!");
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the transformation to many input vectors, e.g. the centers of the
+ * events in a box. Subclasses override this to avoid a virtual call per
+ * vector.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: number of coordinates from the start of one input
+ * vector to the start of the next, >= inD
+ * @param outVectors :: array of nVectors * outD output coordinates
+ * @param nVectors :: number of vectors to transform
+ */
+void CoordTransform::applyBatch(const coord_t *inputVectors,
+                                const size_t inputStride, coord_t *outVectors,
+                                const size_t nVectors) const {
+  for (size_t i = 0; i < nVectors; ++i)
+    this->apply(inputVectors + i * inputStride, outVectors + i * outD);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Apply the transformation to an input vector (as a VMD type).
  * This wraps the apply(in,out) method (and will be slower!)
@@ -81,6 +81,12 @@ private:
 
   /// create event workspace
   boost::shared_ptr<DataObjects::EventWorkspace> createEventWorkspaceNoLog();
+  /// create the (empty) output workspace of one splitting target
+  API::MatrixWorkspace_sptr createTargetWorkspace();
+  /// declare an output property for the workspace of a splitting target
+  void declareTargetWorkspaceProperty(const std::string &propertyName,
+                                      const std::string &wsName,
+                                      const API::MatrixWorkspace_sptr &ws);
   /// create output workspaces if the splitters are given in SplittersWorkspace
   void createOutputWorkspaces();
   /// create output workspaces in the case of using TableWorlspace for splitters
@@ -112,6 +118,16 @@ private:
   /// Filter events by splitters in format of vector
   void filterEventsByVectorSplitters(double progressamount);
 
+  /// Get the event lists to split the events of a spectrum into
+  std::map<int, DataObjects::EventList *>
+  getOutputEventLists(const size_t iws,
+                      std::map<int, DataObjects::EventList> &splitLists);
+
+  /// Histogram the split events of a spectrum into the output workspaces
+  void
+  histogramSplitEvents(const size_t iws,
+                       const std::map<int, DataObjects::EventList> &splitLists);
+
   /// Examine workspace
   void examineAndSortEventWS();
 
@@ -164,7 +180,7 @@ private:
   std::set<int> m_targetWorkspaceIndexSet;
   int m_maxTargetIndex;
   Kernel::TimeSplitterType m_splitters;
-  std::map<int, DataObjects::EventWorkspace_sptr> m_outputWorkspacesMap;
+  std::map<int, API::MatrixWorkspace_sptr> m_outputWorkspacesMap;
   std::vector<std::string> m_wsNames;
 
   std::vector<double> m_detTofOffsets;
@@ -172,6 +188,11 @@ private:
 
   bool m_filterByPulseTime;
 
+  /// Flag to histogram the split events rather than output them
+  bool m_histogramOutput;
+  /// Bin edges of the output histograms
+  std::vector<double> m_outputBinEdges;
+
   DataObjects::TableWorkspace_sptr m_informationWS;
   bool m_hasInfoWS;
 
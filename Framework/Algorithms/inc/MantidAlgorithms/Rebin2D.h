@@ -11,8 +11,10 @@
 // Includes
 //------------------------------------------------------------------------------
 #include "MantidAPI/Algorithm.h"
+#include "MantidDataObjects/FractionalRebinning.h"
 #include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidKernel/System.h"
+#include "MantidTypes/SpectrumDefinition.h"
 
 namespace Mantid {
 namespace Algorithms {
@@ -40,6 +42,23 @@ public:
   const std::string category() const override { return "Transforms\\Rebin"; }
 
 protected:
+  /// Overlap weights kept for later runs with the same binning and geometry
+  struct OverlapCacheEntry {
+    /// name of the algorithm that calculated the weights
+    std::string algorithm;
+    /// the values that define the binning and geometry
+    std::vector<std::vector<double>> key;
+    /// the overlaps of the input bins with the output bins
+    DataObjects::FractionalRebinning::OverlapWeights weights;
+    /// the spectrum definitions of the output, if the algorithm sets them
+    std::vector<SpectrumDefinition> spectrumDefinitions;
+  };
+
+  void declareReuseOverlapWeightsProperty();
+  boost::shared_ptr<const OverlapCacheEntry>
+  cachedOverlaps(const std::vector<std::vector<double>> &key) const;
+  static void cacheOverlaps(boost::shared_ptr<const OverlapCacheEntry> entry);
+
   /// Progress reporter
   boost::shared_ptr<API::Progress> m_progress;
 
@@ -54,6 +73,7 @@ private:
                         HistogramData::BinEdges &newXBins,
                         HistogramData::BinEdges &newYBins,
                         const bool useFractionalArea) const;
+  static boost::shared_ptr<const OverlapCacheEntry> &overlapCache();
 };
 
 } // namespace Algorithms
@@ -10,6 +10,7 @@
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidAlgorithms/SampleCorrections/MCInteractionVolume.h"
 #include <tuple>
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -40,6 +41,11 @@ public:
                                        const Kernel::V3D &finalPos,
                                        double lambdaBefore,
                                        double lambdaAfter) const;
+  std::tuple<std::vector<double>, double>
+  calculate(Kernel::PseudoRandomNumberGenerator &rng,
+            const Kernel::V3D &finalPos,
+            const std::vector<double> &lambdasBefore,
+            const std::vector<double> &lambdasAfter) const;
 
 private:
   const IBeamProfile &m_beamProfile;
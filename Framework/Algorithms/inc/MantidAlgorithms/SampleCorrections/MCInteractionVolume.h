@@ -9,6 +9,7 @@
 
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -17,6 +18,7 @@ class Sample;
 namespace Geometry {
 class IObject;
 class SampleEnvironment;
+class Track;
 } // namespace Geometry
 
 namespace Kernel {
@@ -46,8 +48,19 @@ public:
                              const Kernel::V3D &startPos,
                              const Kernel::V3D &endPos, double lambdaBefore,
                              double lambdaAfter) const;
+  bool calculateAbsorption(Kernel::PseudoRandomNumberGenerator &rng,
+                           const Kernel::V3D &startPos,
+                           const Kernel::V3D &endPos,
+                           const std::vector<double> &lambdasBefore,
+                           const std::vector<double> &lambdasAfter,
+                           std::vector<double> &attenuations) const;
 
 private:
+  bool generateTracks(Kernel::PseudoRandomNumberGenerator &rng,
+                      const Kernel::V3D &startPos, const Kernel::V3D &endPos,
+                      Geometry::Track &beforeScatter,
+                      Geometry::Track &afterScatter) const;
+
   const boost::shared_ptr<Geometry::IObject> m_sample;
   const Geometry::SampleEnvironment *m_env;
   const Geometry::BoundingBox m_activeRegion;
@@ -90,10 +90,30 @@ private:
   void init() override;
   void exec() override;
 
+  /// The neighbours of each output spectrum and their weights, as the rows of
+  /// a sparse matrix
+  struct NeighbourWeights {
+    /// the property values the neighbours were found with
+    std::string settings;
+    /// the spectra, detectors and detector positions of the input
+    std::vector<double> geometry;
+    /// the position of the first neighbour of each row, and the end of the
+    /// last row
+    std::vector<size_t> offsets;
+    /// the input workspace index of each neighbour
+    std::vector<size_t> indices;
+    /// the weight of each neighbour
+    std::vector<double> weights;
+  };
+
   void execWorkspace2D();
   void execEvent(Mantid::DataObjects::EventWorkspace_sptr ws);
+  void findNeighbours();
   void findNeighboursRectangular();
   void findNeighboursUbiqutious();
+  std::string neighbourSettings() const;
+  std::vector<double> neighbourGeometry() const;
+  static boost::shared_ptr<const NeighbourWeights> &neighbourCache();
   Mantid::Geometry::Instrument_const_sptr fetchInstrument() const;
 
   /// Sets the weighting stragegy.
@@ -142,6 +162,9 @@ private:
   /// Vector of list of neighbours (with weight) for each workspace index.
   std::vector<std::vector<weightedNeighbour>> m_neighbours;
 
+  /// The neighbour lists of the output spectra, as a sparse matrix
+  boost::shared_ptr<const NeighbourWeights> m_weights;
+
   /// Progress reporter
   std::unique_ptr<Mantid::API::Progress> m_progress = nullptr;
 };
@@ -66,6 +66,10 @@ private:
   void initAngularCachesNonPSD(const API::MatrixWorkspace &workspace);
   /// Get angles and calculate angular widths.
   void initAngularCachesPSD(const API::MatrixWorkspace &workspace);
+  /// The values that define the overlaps of the input and output bins
+  std::vector<std::vector<double>>
+  overlapKey(const API::MatrixWorkspace &inputWS,
+             const API::MatrixWorkspace &outputWS) const;
 
   SofQCommon m_EmodeProperties;
   /// Output Q axis
@@ -21,8 +21,10 @@
 #include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <iterator>
+#include <memory>
 #include <numeric>
 
 using namespace Mantid::Kernel;
@@ -38,6 +40,22 @@ namespace Algorithms {
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(DiffractionFocussing2)
 
+namespace {
+/// The number of chunks of events to split the focussing into for each thread
+const size_t CHUNKS_PER_THREAD = 4;
+
+/// A range of the spectra of a group, focussed into one partial event list
+struct FocusChunk {
+  /// the index of the group in the output workspace
+  size_t group;
+  /// the first and one past the last position in the indices of the group
+  size_t first;
+  size_t last;
+  /// the list to accumulate the events of the range into
+  EventList *partial;
+};
+} // namespace
+
 /** Initialisation method. Declares properties to be used in algorithm.
  *
  */
@@ -354,14 +372,20 @@ void DiffractionFocussing2::execEvent() {
 
   // determine precount size
   vector<size_t> size_required(this->m_validGroups.size(), 0);
+  vector<vector<size_t>> eventsAtIndex(this->m_validGroups.size());
+  size_t totalEvents = 0;
   int totalHistProcess = 0;
   for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++) {
     const vector<size_t> &indices = this->m_wsIndices[iGroup];
 
     totalHistProcess += static_cast<int>(indices.size());
+    eventsAtIndex[iGroup].reserve(indices.size());
     for (auto index : indices) {
-      size_required[iGroup] += m_eventW->getSpectrum(index).getNumberEvents();
+      eventsAtIndex[iGroup].push_back(
+          m_eventW->getSpectrum(index).getNumberEvents());
+      size_required[iGroup] += eventsAtIndex[iGroup].back();
     }
+    totalEvents += size_required[iGroup];
     prog->report(1, "Pre-counting");
   }
 
@@ -381,74 +405,91 @@ void DiffractionFocussing2::execEvent() {
   }
 
   // ----------- Focus ---------------
+  // The spectra of each group are split into chunks of similar numbers of
+  // events, so that a few large groups still keep every thread busy. Each
+  // chunk is accumulated into its own partial list, the first of a group
+  // being the output list, and the partials of each group are then joined
+  // pairwise, in order, until only the output list is left.
+  const size_t eventsPerChunk = std::max<size_t>(
+      totalEvents / (CHUNKS_PER_THREAD *
+                     static_cast<size_t>(PARALLEL_GET_MAX_THREADS)),
+      1);
+  std::vector<FocusChunk> chunks;
+  std::vector<std::vector<EventList *>> partials(this->m_validGroups.size());
+  std::vector<std::unique_ptr<EventList>> partialStorage;
+  for (size_t iGroup = 0; iGroup < this->m_validGroups.size(); iGroup++) {
+    const auto &events = eventsAtIndex[iGroup];
+    size_t first = 0;
+    while (first < events.size() || partials[iGroup].empty()) {
+      size_t last = first;
+      size_t nEvents = 0;
+      while (last < events.size() &&
+             (last == first || nEvents < eventsPerChunk))
+        nEvents += events[last++];
+      if (partials[iGroup].empty()) {
+        partials[iGroup].push_back(&out->getSpectrum(iGroup));
+      } else {
+        partialStorage.push_back(make_unique<EventList>());
+        partialStorage.back()->switchTo(eventWtype);
+        partialStorage.back()->reserve(nEvents);
+        partials[iGroup].push_back(partialStorage.back().get());
+      }
+      chunks.push_back({iGroup, first, last, partials[iGroup].back()});
+      first = last;
+    }
+  }
+  g_log.debug() << "Focussing " << totalEvents << " events in "
+                << chunks.size() << " chunks.\n";
+
   prog.reset();
   prog = make_unique<Progress>(this, 0.3, 0.9, totalHistProcess);
 
-  if (this->m_validGroups.size() == 1) {
-    g_log.information() << "Performing focussing on a single group\n";
-    // Special case of a single group - parallelize differently
-    EventList &groupEL = out->getSpectrum(0);
-    const std::vector<size_t> &indices = this->m_wsIndices[0];
-
-    int chunkSize = 200;
-
-    int end = (totalHistProcess / chunkSize) + 1;
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int wiChunk = 0; wiChunk < end; wiChunk++) {
-      PARALLEL_START_INTERUPT_REGION
-
-      // Perform in chunks for more efficiency
-      int max = (wiChunk + 1) * chunkSize;
-      if (max > totalHistProcess)
-        max = totalHistProcess;
-
-      // Make a blank EventList that will accumulate the chunk.
-      EventList chunkEL;
-      chunkEL.switchTo(eventWtype);
-      // chunkEL.reserve(numEventsInChunk);
-
-      // process the chunk
-      for (int i = wiChunk * chunkSize; i < max; i++) {
-        // Accumulate the chunk
-        size_t wi = indices[i];
-        chunkEL += m_eventW->getSpectrum(wi);
-      }
-
-      // Rejoin the chunk with the rest.
-      PARALLEL_CRITICAL(DiffractionFocussing2_JoinChunks) {
-        groupEL += chunkEL;
+  const int nChunks = static_cast<int>(chunks.size());
+  PARALLEL_FOR_IF(Kernel::threadSafe(*m_eventW))
+  for (int iChunk = 0; iChunk < nChunks; iChunk++) {
+    PARALLEL_START_INTERUPT_REGION
+    const FocusChunk &chunk = chunks[iChunk];
+    const std::vector<size_t> &indices = this->m_wsIndices[chunk.group];
+    for (size_t i = chunk.first; i < chunk.last; i++) {
+      const size_t wi = indices[i];
+      // Put what was in the OLD workspace index wi into the partial list
+      *chunk.partial += m_eventW->getSpectrum(wi);
+
+      prog->reportIncrement(1, "Appending Lists");
+
+      // When focussing in place, you can clear out old memory from the input
+      // one!
+      if (inPlace) {
+        boost::const_pointer_cast<EventWorkspace>(m_eventW)
+            ->getSpectrum(wi)
+            .clear();
       }
-
-      PARALLEL_END_INTERUPT_REGION
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-  } else {
-    // ------ PARALLELIZE BY GROUPS -------------------------
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
 
-    int nValidGroups = static_cast<int>(this->m_validGroups.size());
+  // Join neighbouring partials of every group at once, doubling the distance
+  // between them each time, so that the events keep the order of the spectra.
+  for (size_t stride = 1;; stride *= 2) {
+    std::vector<std::pair<EventList *, EventList *>> joins;
+    for (auto &groupPartials : partials) {
+      for (size_t i = 0; i + stride < groupPartials.size(); i += 2 * stride)
+        joins.emplace_back(groupPartials[i], groupPartials[i + stride]);
+    }
+    if (joins.empty())
+      break;
+    const int nJoins = static_cast<int>(joins.size());
     PARALLEL_FOR_IF(Kernel::threadSafe(*m_eventW))
-    for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
+    for (int iJoin = 0; iJoin < nJoins; iJoin++) {
       PARALLEL_START_INTERUPT_REGION
-      const std::vector<size_t> &indices = this->m_wsIndices[iGroup];
-      for (auto wi : indices) {
-        // In workspace index iGroup, put what was in the OLD workspace index wi
-        out->getSpectrum(iGroup) += m_eventW->getSpectrum(wi);
-
-        prog->reportIncrement(1, "Appending Lists");
-
-        // When focussing in place, you can clear out old memory from the input
-        // one!
-        if (inPlace) {
-          boost::const_pointer_cast<EventWorkspace>(m_eventW)
-              ->getSpectrum(wi)
-              .clear();
-        }
-      }
+      *joins[iJoin].first += *joins[iJoin].second;
+      joins[iJoin].second->clear();
       PARALLEL_END_INTERUPT_REGION
     }
     PARALLEL_CHECK_INTERUPT_REGION
-  } // (done with parallel by groups)
+  }
+  partialStorage.clear();
 
   // Now that the data is cleaned up, go through it and set the X vectors to the
   // input workspace we first talked about.
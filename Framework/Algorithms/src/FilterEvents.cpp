@@ -12,6 +12,7 @@
 #include "MantidAPI/TableRow.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceProperty.h"
+#include "MantidAlgorithms/Rebin.h"
 #include "MantidAlgorithms/TimeAtSampleStrategyDirect.h"
 #include "MantidAlgorithms/TimeAtSampleStrategyElastic.h"
 #include "MantidAlgorithms/TimeAtSampleStrategyIndirect.h"
@@ -26,9 +27,11 @@
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/LogFilter.h"
 #include "MantidKernel/PhysicalConstants.h"
+#include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 
 #include <memory>
@@ -64,7 +67,8 @@ FilterEvents::FilterEvents()
       m_useSplittersWorkspace(false), m_useArbTableSplitters(false),
       m_targetWorkspaceIndexSet(), m_splitters(), m_outputWorkspacesMap(),
       m_wsNames(), m_detTofOffsets(), m_detTofFactors(),
-      m_filterByPulseTime(false), m_informationWS(), m_hasInfoWS(),
+      m_filterByPulseTime(false), m_histogramOutput(false),
+      m_outputBinEdges(), m_informationWS(), m_hasInfoWS(),
       m_progress(0.), m_outputWSNameBase(), m_toGroupWS(false),
       m_vecSplitterTime(), m_vecSplitterGroup(), m_splitSampleLogs(false),
       m_useDBSpectrum(false), m_dbWSIndex(-1), m_tofCorrType(NoneCorrect),
@@ -103,6 +107,15 @@ void FilterEvents::init() {
                   "environment log.  This option can make execution of "
                   "algorithm faster.  But it lowers precision.");
 
+  declareProperty(
+      make_unique<ArrayProperty<double>>(
+          "OutputBinning", boost::make_shared<RebinParamsValidator>(true)),
+      "If given, the output workspaces are histograms with this binning, as "
+      "in the Params of Rebin. The events are histogrammed as they are "
+      "split, so the split events are never held in memory. This is much "
+      "cheaper than splitting into event workspaces and then rebinning them "
+      "when there are many splitting targets.");
+
   declareProperty("GroupWorkspaces", false,
                   "Option to group all the output "
                   "workspaces.  Group name will be "
@@ -313,12 +326,12 @@ void FilterEvents::exec() {
 
   // Form the names of output workspaces
   std::vector<std::string> outputwsnames;
-  std::map<int, DataObjects::EventWorkspace_sptr>::iterator miter;
+  std::map<int, API::MatrixWorkspace_sptr>::iterator miter;
   Goniometer inputGonio = m_eventWS->run().getGoniometer();
   for (miter = m_outputWorkspacesMap.begin();
        miter != m_outputWorkspacesMap.end(); ++miter) {
     try {
-      DataObjects::EventWorkspace_sptr ws_i = miter->second;
+      API::MatrixWorkspace_sptr ws_i = miter->second;
       ws_i->mutableRun().setGoniometer(inputGonio, true);
     } catch (std::runtime_error &) {
       g_log.warning("Cannot set goniometer.");
@@ -440,6 +453,15 @@ void FilterEvents::processAlgorithmProperties() {
   m_outputWSNameBase = this->getPropertyValue("OutputWorkspaceBaseName");
   m_filterByPulseTime = this->getProperty("FilterByPulseTime");
 
+  const std::vector<double> binning = getProperty("OutputBinning");
+  m_histogramOutput = !binning.empty();
+  if (m_histogramOutput) {
+    m_outputBinEdges.clear();
+    static_cast<void>(VectorHelper::createAxisFromRebinParams(
+        Rebin::rebinParamsFromInput(binning, *m_eventWS, g_log),
+        m_outputBinEdges));
+  }
+
   m_toGroupWS = this->getProperty("GroupWorkspaces");
 
   if (m_toGroupWS && (m_outputWSNameBase == m_eventWS->getName())) {
@@ -637,7 +659,7 @@ void FilterEvents::copyNoneSplitLogs(
     } else {
       // non time series properties
       // single value property: copy to the new workspace
-      std::map<int, DataObjects::EventWorkspace_sptr>::iterator ws_iter;
+      std::map<int, API::MatrixWorkspace_sptr>::iterator ws_iter;
       for (ws_iter = m_outputWorkspacesMap.begin();
            ws_iter != m_outputWorkspacesMap.end(); ++ws_iter) {
 
@@ -716,13 +738,13 @@ void FilterEvents::splitTimeSeriesLogs(
   // integrate proton charge
   for (int tindex = 0; tindex <= max_target_index; ++tindex) {
     // find output workspace
-    std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
+    std::map<int, API::MatrixWorkspace_sptr>::iterator wsiter;
     wsiter = m_outputWorkspacesMap.find(tindex);
     if (wsiter == m_outputWorkspacesMap.end()) {
       g_log.information() << "Workspace target (indexed as " << tindex
                           << ") does not have workspace associated.\n";
     } else {
-      DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
+      API::MatrixWorkspace_sptr ws_i = wsiter->second;
       ws_i->mutableRun().integrateProtonCharge();
     }
   }
@@ -769,7 +791,7 @@ void FilterEvents::splitTimeSeriesProperty(
   // assign to output workspaces
   for (int tindex = 0; tindex <= max_target_index; ++tindex) {
     // find output workspace
-    std::map<int, DataObjects::EventWorkspace_sptr>::iterator wsiter;
+    std::map<int, API::MatrixWorkspace_sptr>::iterator wsiter;
     wsiter = m_outputWorkspacesMap.find(tindex);
     if (wsiter == m_outputWorkspacesMap.end()) {
       // unable to find workspace associated with target index
@@ -778,7 +800,7 @@ void FilterEvents::splitTimeSeriesProperty(
                           << "\n";
     } else {
       // add property to the associated workspace
-      DataObjects::EventWorkspace_sptr ws_i = wsiter->second;
+      API::MatrixWorkspace_sptr ws_i = wsiter->second;
       ws_i->mutableRun().addProperty(output_vector[tindex], true);
     }
   }
@@ -1130,10 +1152,7 @@ void FilterEvents::createOutputWorkspaces() {
         add2output = false;
     }
 
-    boost::shared_ptr<EventWorkspace> optws =
-        create<EventWorkspace>(*m_eventWS);
-    // Clear Run without copying first.
-    optws->setSharedRun(Kernel::make_cow<Run>());
+    API::MatrixWorkspace_sptr optws = createTargetWorkspace();
     m_outputWorkspacesMap.emplace(wsgroup, optws);
 
     // Add information, including title and comment, to output workspace
@@ -1173,22 +1192,14 @@ void FilterEvents::createOutputWorkspaces() {
 
       // create these output properties
       if (!this->m_toGroupWS) {
-        if (!this->existsProperty(propertynamess.str())) {
-          declareProperty(
-              Kernel::make_unique<
-                  API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-                  propertynamess.str(), wsname.str(), Direction::Output),
-              "Output");
-        }
-        setProperty(propertynamess.str(), optws);
+        declareTargetWorkspaceProperty(propertynamess.str(), wsname.str(),
+                                       optws);
       }
 
       ++numoutputws;
       g_log.debug() << "Created output Workspace of group = " << wsgroup
                     << "  Property Name = " << propertynamess.str()
-                    << " Workspace name = " << wsname.str()
-                    << " with Number of events = " << optws->getNumberEvents()
-                    << "\n";
+                    << " Workspace name = " << wsname.str() << "\n";
 
       // Update progress report
       m_progress = 0.1 + 0.1 * wsgindex / numnewws;
@@ -1241,12 +1252,8 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
       wsname << m_outputWSNameBase << "_unfiltered";
     }
 
-    // create new workspace from input EventWorkspace and all the sample logs
-    // are copied to the new one
-    boost::shared_ptr<EventWorkspace> optws =
-        create<EventWorkspace>(*m_eventWS);
-    // Clear Run without copying first.
-    optws->setSharedRun(Kernel::make_cow<Run>());
+    // create new workspace from input EventWorkspace
+    API::MatrixWorkspace_sptr optws = createTargetWorkspace();
     m_outputWorkspacesMap.emplace(wsgroup, optws);
 
     // add to output workspace property
@@ -1262,20 +1269,12 @@ void FilterEvents::createOutputWorkspacesMatrixCase() {
     AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
 
     g_log.debug() << "Created output Workspace of group = " << wsgroup
-                  << " Workspace name = " << wsname.str()
-                  << " with Number of events = " << optws->getNumberEvents()
-                  << "\n";
+                  << " Workspace name = " << wsname.str() << "\n";
 
     // Set (property) to output workspace and set to ADS
     if (m_toGroupWS) {
-      if (!this->existsProperty(propertynamess.str())) {
-        declareProperty(
-            Kernel::make_unique<
-                API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-                propertynamess.str(), wsname.str(), Direction::Output),
-            "Output");
-      }
-      setProperty(propertynamess.str(), optws);
+      declareTargetWorkspaceProperty(propertynamess.str(), wsname.str(),
+                                     optws);
 
       g_log.debug() << "  Property Name = " << propertynamess.str() << "\n";
     } else {
@@ -1333,10 +1332,7 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
     }
 
     // create new workspace
-    boost::shared_ptr<EventWorkspace> optws =
-        create<EventWorkspace>(*m_eventWS);
-    // Clear Run without copying first.
-    optws->setSharedRun(Kernel::make_cow<Run>());
+    API::MatrixWorkspace_sptr optws = createTargetWorkspace();
     m_outputWorkspacesMap.emplace(wsgroup, optws);
 
     // TODO/NOW/ISSUE -- How about comment and info?
@@ -1350,9 +1346,7 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
     AnalysisDataService::Instance().addOrReplace(wsname.str(), optws);
 
     g_log.debug() << "Created output Workspace of group = " << wsgroup
-                  << " Workspace name = " << wsname.str()
-                  << " with Number of events = " << optws->getNumberEvents()
-                  << "\n";
+                  << " Workspace name = " << wsname.str() << "\n";
 
     if (this->m_toGroupWS) {
       std::stringstream propertynamess;
@@ -1361,14 +1355,8 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
       } else {
         propertynamess << "OutputWorkspace_" << wsgroup;
       }
-      if (!this->existsProperty(propertynamess.str())) {
-        declareProperty(
-            Kernel::make_unique<
-                API::WorkspaceProperty<DataObjects::EventWorkspace>>(
-                propertynamess.str(), wsname.str(), Direction::Output),
-            "Output");
-      }
-      setProperty(propertynamess.str(), optws);
+      declareTargetWorkspaceProperty(propertynamess.str(), wsname.str(),
+                                     optws);
 
       g_log.debug() << "  Property Name = " << propertynamess.str() << "\n";
     } else {
@@ -1389,6 +1377,48 @@ void FilterEvents::createOutputWorkspacesTableSplitterCase() {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Create the output workspace of one splitting target. It is an
+ * EventWorkspace, or a Workspace2D if the split events are histogrammed.
+ * The sample logs are not copied.
+ * @return the new workspace
+ */
+API::MatrixWorkspace_sptr FilterEvents::createTargetWorkspace() {
+  API::MatrixWorkspace_sptr optws;
+  if (m_histogramOutput)
+    optws = create<Workspace2D>(*m_eventWS, BinEdges(m_outputBinEdges));
+  else
+    optws = create<EventWorkspace>(*m_eventWS);
+  // Clear Run without copying first.
+  optws->setSharedRun(Kernel::make_cow<Run>());
+  return optws;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Declare (if needed) and set the output property of a splitting target
+ * @param propertyName :: name of the output property
+ * @param wsName :: name of the output workspace
+ * @param ws :: the output workspace
+ */
+void FilterEvents::declareTargetWorkspaceProperty(
+    const std::string &propertyName, const std::string &wsName,
+    const API::MatrixWorkspace_sptr &ws) {
+  if (!this->existsProperty(propertyName)) {
+    if (m_histogramOutput)
+      declareProperty(
+          Kernel::make_unique<API::WorkspaceProperty<API::MatrixWorkspace>>(
+              propertyName, wsName, Direction::Output),
+          "Output");
+    else
+      declareProperty(
+          Kernel::make_unique<
+              API::WorkspaceProperty<DataObjects::EventWorkspace>>(
+              propertyName, wsName, Direction::Output),
+          "Output");
+  }
+  setProperty(propertyName, ws);
+}
+
 /** Set up neutron event's TOF correction.
  * It can be (1) parsed from TOF-correction table workspace to vectors,
  * (2) created according to detector's position in instrument;
@@ -1631,14 +1661,9 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
       // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      std::map<int, DataObjects::EventList> splitLists;
+      std::map<int, DataObjects::EventList *> outputs =
+          getOutputEventLists(iws, splitLists);
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
 
@@ -1652,6 +1677,7 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
       } else {
         input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
       }
+      histogramSplitEvents(iws, splitLists);
     }
 
     PARALLEL_END_INTERUPT_REGION
@@ -1703,14 +1729,9 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
       // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
+      std::map<int, DataObjects::EventList> splitLists;
+      map<int, DataObjects::EventList *> outputs =
+          getOutputEventLists(iws, splitLists);
 
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -1730,6 +1751,7 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
         logmessage = input_el.splitByFullTimeMatrixSplitter(
             m_vecSplitterTime, m_vecSplitterGroup, outputs, false, 1.0, 0.0);
       }
+      histogramSplitEvents(iws, splitLists);
 
       if (printdetail)
         g_log.notice(logmessage);
@@ -1760,6 +1782,55 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Get the event lists that the events of one spectrum are split into, by
+ * splitting target. They are the spectra of the output EventWorkspaces, or
+ * temporary lists if the outputs are histograms.
+ * @param iws :: workspace index of the spectrum
+ * @param splitLists :: holds the temporary lists
+ * @return the event list of each splitting target
+ */
+std::map<int, DataObjects::EventList *> FilterEvents::getOutputEventLists(
+    const size_t iws, std::map<int, DataObjects::EventList> &splitLists) {
+  std::map<int, DataObjects::EventList *> outputs;
+  if (m_histogramOutput) {
+    for (const auto &ws : m_outputWorkspacesMap)
+      outputs.emplace(ws.first, &splitLists[ws.first]);
+    return outputs;
+  }
+
+  PARALLEL_CRITICAL(build_elist) {
+    for (auto &ws : m_outputWorkspacesMap) {
+      int index = ws.first;
+      auto &output_el =
+          static_cast<EventWorkspace &>(*ws.second).getSpectrum(iws);
+      outputs.emplace(index, &output_el);
+    }
+  }
+  return outputs;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Histogram the events of one spectrum, split into temporary lists by
+ * getOutputEventLists(), into the output workspaces. Does nothing if the
+ * outputs are EventWorkspaces.
+ * @param iws :: workspace index of the spectrum
+ * @param splitLists :: the split events, by splitting target
+ */
+void FilterEvents::histogramSplitEvents(
+    const size_t iws, const std::map<int, DataObjects::EventList> &splitLists) {
+  if (!m_histogramOutput)
+    return;
+
+  for (const auto &split : splitLists) {
+    MantidVec y_data, e_data;
+    split.second.generateHistogram(m_outputBinEdges, y_data, e_data);
+    auto &outws = *m_outputWorkspacesMap.at(split.first);
+    outws.mutableY(iws) = std::move(y_data);
+    outws.mutableE(iws) = std::move(e_data);
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Generate a vector of integer time series property for each splitter
  * corresponding to each target (in integer)
@@ -1887,13 +1958,13 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
   if (m_useSplittersWorkspace) {
     g_log.debug() << "There are " << split_tsp_vec.size()
                   << " TimeSeriesPropeties.\n";
-    std::map<int, DataObjects::EventWorkspace_sptr>::iterator miter;
+    std::map<int, API::MatrixWorkspace_sptr>::iterator miter;
     for (miter = m_outputWorkspacesMap.begin();
          miter != m_outputWorkspacesMap.end(); ++miter) {
       g_log.debug() << "Output workspace index: " << miter->first << "\n";
       if (0 <= miter->first &&
           miter->first < static_cast<int>(split_tsp_vec.size())) {
-        DataObjects::EventWorkspace_sptr outws = miter->second;
+        API::MatrixWorkspace_sptr outws = miter->second;
         outws->mutableRun().addProperty(split_tsp_vec[miter->first], true);
       }
     }
@@ -1902,7 +1973,7 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
     for (int itarget = 0; itarget < static_cast<int>(split_tsp_vec.size());
          ++itarget) {
       // use itarget to find the workspace that is mapped
-      std::map<int, DataObjects::EventWorkspace_sptr>::iterator ws_iter;
+      std::map<int, API::MatrixWorkspace_sptr>::iterator ws_iter;
       ws_iter = m_outputWorkspacesMap.find(itarget);
 
       // skip if an itarget does not have matched workspace
@@ -1913,7 +1984,7 @@ void FilterEvents::mapSplitterTSPtoWorkspaces(
       }
 
       // get the workspace and add property
-      DataObjects::EventWorkspace_sptr outws = ws_iter->second;
+      API::MatrixWorkspace_sptr outws = ws_iter->second;
       outws->mutableRun().addProperty(split_tsp_vec[itarget], true);
     }
 
@@ -111,6 +111,12 @@ void MonteCarloAbsorption::init() {
       "The number of \"neutron\" events to generate per simulated point");
   declareProperty("SeedValue", DEFAULT_SEED, positiveInt,
                   "Seed the random number generator with this value");
+  declareProperty("ResimulateTracksForDifferentWavelengths", true,
+                  "If true, new scatter points and tracks are generated for "
+                  "each simulated wavelength point. If false, the tracks of "
+                  "each spectrum are generated once and used for all of its "
+                  "wavelength points, which is much faster and gives "
+                  "correlated, smoother factors across the wavelengths.");
 
   InterpolationOption interpolateOpt;
   declareProperty(interpolateOpt.property(), interpolateOpt.propertyDoc());
@@ -163,9 +169,12 @@ void MonteCarloAbsorption::exec() {
   interpolateOpt.set(getPropertyValue("Interpolation"));
   const bool useSparseInstrument = getProperty("SparseInstrument");
   const int maxScatterPtAttempts = getProperty("MaxScatterPtAttempts");
+  const bool resimulateTracks =
+      getProperty("ResimulateTracksForDifferentWavelengths");
   auto outputWS = doSimulation(*inputWS, static_cast<size_t>(nevents), nlambda,
                                seed, interpolateOpt, useSparseInstrument,
-                               static_cast<size_t>(maxScatterPtAttempts));
+                               static_cast<size_t>(maxScatterPtAttempts),
+                               resimulateTracks);
 
   setProperty("OutputWorkspace", std::move(outputWS));
 }
@@ -198,12 +207,15 @@ std::map<std::string, std::string> MonteCarloAbsorption::validateInputs() {
  * @param useSparseInstrument If true, use sparse instrument in simulation
  * @param maxScatterPtAttempts The maximum number of tries to generate a
  * scatter point within the object
+ * @param resimulateTracks If true, generate new tracks for each wavelength
+ * point, otherwise use the tracks of a spectrum for all of its points
  * @return A new workspace containing the correction factors & errors
  */
 MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     const MatrixWorkspace &inputWS, const size_t nevents, int nlambda,
     const int seed, const InterpolationOption &interpolateOpt,
-    const bool useSparseInstrument, const size_t maxScatterPtAttempts) {
+    const bool useSparseInstrument, const size_t maxScatterPtAttempts,
+    const bool resimulateTracks) {
   auto outputWS = createOutputWorkspace(inputWS);
   const auto inputNbins = static_cast<int>(inputWS.blocksize());
   if (isEmpty(nlambda) || nlambda > inputNbins) {
@@ -266,9 +278,11 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
 
     auto &outY = simulationWS.mutableY(i);
     const auto lambdas = simulationWS.points(i);
-    // Simulation for each requested wavelength point
+    // The requested wavelength points, and the wavelengths before and after
+    // scattering at each
+    std::vector<int> simulatedBins;
+    std::vector<double> lambdasIn, lambdasOut;
     for (int j = 0; j < nbins; j += lambdaStepSize) {
-      prog.report(reportMsg);
       const double lambdaStep = lambdas[j];
       double lambdaIn(lambdaStep), lambdaOut(lambdaStep);
       if (efixed.emode() == DeltaEMode::Direct) {
@@ -278,8 +292,9 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       } else {
         // elastic case already initialized
       }
-      std::tie(outY[j], std::ignore) =
-          strategy.calculate(rng, detPos, lambdaIn, lambdaOut);
+      simulatedBins.push_back(j);
+      lambdasIn.push_back(lambdaIn);
+      lambdasOut.push_back(lambdaOut);
 
       // Ensure we have the last point for the interpolation
       if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
@@ -287,6 +302,24 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
       }
     }
 
+    if (resimulateTracks) {
+      // Simulation for each requested wavelength point
+      for (size_t k = 0; k < simulatedBins.size(); ++k) {
+        prog.report(reportMsg);
+        std::tie(outY[simulatedBins[k]], std::ignore) =
+            strategy.calculate(rng, detPos, lambdasIn[k], lambdasOut[k]);
+      }
+    } else {
+      // One simulation for all of the requested wavelength points
+      std::vector<double> factors;
+      std::tie(factors, std::ignore) =
+          strategy.calculate(rng, detPos, lambdasIn, lambdasOut);
+      for (size_t k = 0; k < simulatedBins.size(); ++k) {
+        outY[simulatedBins[k]] = factors[k];
+      }
+      prog.reportIncrement(simulatedBins.size(), reportMsg);
+    }
+
     // Interpolate through points not simulated
     if (!useSparseInstrument && lambdaStepSize > 1) {
       auto histnew = simulationWS.histogram(i);
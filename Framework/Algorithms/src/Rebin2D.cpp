@@ -18,6 +18,8 @@
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <mutex>
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -29,6 +31,11 @@ using namespace DataObjects;
 using namespace Geometry;
 using namespace Mantid::HistogramData;
 
+namespace {
+/// Guards the overlap weights kept for reuse
+std::mutex g_overlapCacheMutex;
+} // namespace
+
 //--------------------------------------------------------------------------
 // Private methods
 //--------------------------------------------------------------------------
@@ -69,6 +76,7 @@ void Rebin2D::init() {
   declareProperty(
       Kernel::make_unique<PropertyWithValue<bool>>("Transpose", false),
       "Run the Transpose algorithm on the resulting matrix.");
+  declareReuseOverlapWeightsProperty();
 }
 
 /**
@@ -130,33 +138,77 @@ void Rebin2D::exec() {
   m_progress = boost::shared_ptr<API::Progress>(
       new API::Progress(this, 0.0, 1.0, nreports));
 
-  PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
-  for (int64_t i = 0; i < static_cast<int64_t>(numYBins);
-       ++i) // signed for openmp
-  {
-    PARALLEL_START_INTERUPT_REGION
-
-    m_progress->report("Computing polygon intersections");
-    const double vlo = oldYEdges[i];
-    const double vhi = oldYEdges[i + 1];
-    for (size_t j = 0; j < numXBins; ++j) {
-      // For each input polygon test where it intersects with
-      // the output grid and assign the appropriate weights of Y/E
-      const double x_j = oldXEdges[j];
-      const double x_jp1 = oldXEdges[j + 1];
-      Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
-      if (!useFractionalArea) {
-        FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, *outputWS,
-                                           newYBins.rawData());
-      } else {
-        FractionalRebinning::rebinToFractionalOutput(
-            inputQ, inputWS, i, j, *outputRB, newYBins.rawData(), inputHasFA);
+  const bool reuseWeights = getProperty("ReuseOverlapWeights");
+  boost::shared_ptr<const OverlapCacheEntry> overlaps;
+  boost::shared_ptr<OverlapCacheEntry> newOverlaps;
+  std::vector<std::vector<FractionalRebinning::IndexedOverlap>> inputOverlaps;
+  if (reuseWeights) {
+    const std::vector<std::vector<double>> key{
+        oldXEdges.rawData(), oldYEdges, newXBins.rawData(),
+        newYBins.rawData(), {useFractionalArea ? 1. : 0.}};
+    overlaps = cachedOverlaps(key);
+    if (overlaps) {
+      g_log.information("Reusing the overlap weights of an earlier run.");
+    } else {
+      newOverlaps = boost::make_shared<OverlapCacheEntry>();
+      newOverlaps->algorithm = name();
+      newOverlaps->key = key;
+      inputOverlaps.resize(numYBins);
+    }
+  }
+
+  if (!overlaps) {
+    PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
+    for (int64_t i = 0; i < static_cast<int64_t>(numYBins);
+         ++i) // signed for openmp
+    {
+      PARALLEL_START_INTERUPT_REGION
+
+      m_progress->report("Computing polygon intersections");
+      const double vlo = oldYEdges[i];
+      const double vhi = oldYEdges[i + 1];
+      for (size_t j = 0; j < numXBins; ++j) {
+        // For each input polygon test where it intersects with
+        // the output grid and assign the appropriate weights of Y/E
+        const double x_j = oldXEdges[j];
+        const double x_jp1 = oldXEdges[j + 1];
+        Quadrilateral inputQ = Quadrilateral(x_j, x_jp1, vlo, vhi);
+        if (newOverlaps) {
+          FractionalRebinning::calculateOverlaps(
+              inputQ, i, j, newXBins.rawData(), newYBins.rawData(),
+              !useFractionalArea, inputOverlaps[i]);
+        } else if (!useFractionalArea) {
+          FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, *outputWS,
+                                             newYBins.rawData());
+        } else {
+          FractionalRebinning::rebinToFractionalOutput(
+              inputQ, inputWS, i, j, *outputRB, newYBins.rawData(),
+              inputHasFA);
+        }
       }
+
+      PARALLEL_END_INTERUPT_REGION
     }
+    PARALLEL_CHECK_INTERUPT_REGION
+  }
 
-    PARALLEL_END_INTERUPT_REGION
+  if (newOverlaps) {
+    newOverlaps->weights = FractionalRebinning::groupOverlaps(
+        inputOverlaps, outputWS->getNumberHistograms());
+    std::vector<std::vector<FractionalRebinning::IndexedOverlap>>().swap(
+        inputOverlaps);
+    overlaps = newOverlaps;
+    cacheOverlaps(overlaps);
+  }
+  if (overlaps) {
+    if (!useFractionalArea) {
+      FractionalRebinning::rebinToOutput(overlaps->weights, *inputWS,
+                                         *outputWS);
+    } else {
+      FractionalRebinning::rebinToFractionalOutput(
+          overlaps->weights, *inputWS, *outputRB, inputHasFA);
+    }
   }
-  PARALLEL_CHECK_INTERUPT_REGION
   if (useFractionalArea) {
     outputRB->finalize(true, true);
   }
@@ -175,6 +227,48 @@ void Rebin2D::exec() {
   setProperty("OutputWorkspace", outputWS);
 }
 
+/**
+ * Declare the property that keeps the overlap weights for later runs
+ */
+void Rebin2D::declareReuseOverlapWeightsProperty() {
+  declareProperty(
+      "ReuseOverlapWeights", false,
+      "If true, keep the overlaps of the input bins with the output bins in "
+      "memory and reuse them in later runs with the same binning and "
+      "geometry. Only the overlaps of the latest setup are kept.");
+}
+
+/**
+ * Get the overlap weights this algorithm kept for the given setup
+ * @param key :: The values that define the binning and geometry
+ * @return The weights, or null if they were not kept
+ */
+boost::shared_ptr<const Rebin2D::OverlapCacheEntry>
+Rebin2D::cachedOverlaps(const std::vector<std::vector<double>> &key) const {
+  std::lock_guard<std::mutex> lock(g_overlapCacheMutex);
+  const auto &cache = overlapCache();
+  if (cache && cache->algorithm == name() && cache->key == key)
+    return cache;
+  return nullptr;
+}
+
+/**
+ * Keep overlap weights for later runs, replacing those kept before
+ * @param entry :: The weights and the setup they were calculated for
+ */
+void Rebin2D::cacheOverlaps(boost::shared_ptr<const OverlapCacheEntry> entry) {
+  std::lock_guard<std::mutex> lock(g_overlapCacheMutex);
+  overlapCache() = std::move(entry);
+}
+
+/**
+ * @return The overlap weights of the last run that asked to reuse them
+ */
+boost::shared_ptr<const Rebin2D::OverlapCacheEntry> &Rebin2D::overlapCache() {
+  static boost::shared_ptr<const OverlapCacheEntry> cache;
+  return cache;
+}
+
 /**
  * Setup the output workspace
  * @param parent :: A pointer to the input workspace
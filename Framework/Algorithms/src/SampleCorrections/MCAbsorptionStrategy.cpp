@@ -12,6 +12,9 @@
 #include "MantidAlgorithms/SampleCorrections/RectangularBeamProfile.h"
 #include "MantidGeometry/Objects/CSGObject.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace Mantid {
 using Kernel::PseudoRandomNumberGenerator;
 
@@ -78,5 +81,57 @@ MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
   return make_tuple(factor / static_cast<double>(m_nevents), m_error);
 }
 
+/**
+ * Compute the corrections for a final position of the neutron and a list of
+ * wavelengths before and after scattering. Each generated track is used for
+ * all of the wavelengths, so the scatter points are generated and traced
+ * through the objects once rather than once per wavelength.
+ * @param rng A reference to a PseudoRandomNumberGenerator
+ * @param finalPos Defines the final position of the neutron, assumed to be
+ * where it is detected
+ * @param lambdasBefore Wavelengths, in \f$\\A^-1\f$, before scattering
+ * @param lambdasAfter Wavelengths, in \f$\\A^-1\f$, after scattering, one
+ * for each wavelength before scattering
+ * @return A tuple of the <correction factor for each wavelength, associated
+ * error>.
+ */
+std::tuple<std::vector<double>, double>
+MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
+                                const Kernel::V3D &finalPos,
+                                const std::vector<double> &lambdasBefore,
+                                const std::vector<double> &lambdasAfter) const {
+  const auto scatterBounds = m_scatterVol.getBoundingBox();
+  std::vector<double> factors(lambdasBefore.size(), 0.0);
+  std::vector<double> attenuations;
+  for (size_t i = 0; i < m_nevents; ++i) {
+    size_t attempts(0);
+    do {
+      const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
+
+      if (m_scatterVol.calculateAbsorption(rng, neutron.startPos, finalPos,
+                                           lambdasBefore, lambdasAfter,
+                                           attenuations)) {
+        std::transform(factors.begin(), factors.end(), attenuations.cbegin(),
+                       factors.begin(), std::plus<double>());
+        break;
+      }
+      ++attempts;
+      if (attempts == m_maxScatterAttempts) {
+        throw std::runtime_error("Unable to generate valid track through "
+                                 "sample interaction volume after " +
+                                 std::to_string(m_maxScatterAttempts) +
+                                 " attempts. Try increasing the maximum "
+                                 "threshold or if this does not help then "
+                                 "please check the defined shape.");
+      }
+    } while (true);
+  }
+  for (auto &factor : factors) {
+    factor /= static_cast<double>(m_nevents);
+  }
+  using std::make_tuple;
+  return make_tuple(std::move(factors), m_error);
+}
+
 } // namespace Algorithms
 } // namespace Mantid
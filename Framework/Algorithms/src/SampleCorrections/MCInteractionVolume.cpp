@@ -31,6 +31,48 @@ double attenuation(double rho, double sigma, double length) {
   using std::exp;
   return exp(-100 * rho * sigma * length);
 }
+
+/**
+ * Compute the attenuation factor of a track
+ * @param path A track whose segments have been computed
+ * @param lambda Wavelength, in \f$\\A^-1\f$
+ * @return The dimensionless attenuated fraction
+ */
+double calculateAttenuation(const Track &path, double lambda) {
+  double factor(1.0);
+  for (const auto &segment : path) {
+    const double length = segment.distInsideObject;
+    const auto &segObj = *(segment.object);
+    const auto &segMat = segObj.material();
+    factor *= attenuation(segMat.numberDensity(),
+                          segMat.totalScatterXSection(lambda) +
+                              segMat.absorbXSection(lambda),
+                          length);
+  }
+  return factor;
+}
+
+/**
+ * Add the exponents of the attenuation factors of a track for a list of
+ * wavelengths, so that the factors of several tracks are the exponentials of
+ * the sums
+ * @param path A track whose segments have been computed
+ * @param lambdas Wavelengths, in \f$\\A^-1\f$
+ * @param exponents The exponent for each wavelength, added to
+ */
+void addAttenuationExponents(const Track &path,
+                             const std::vector<double> &lambdas,
+                             std::vector<double> &exponents) {
+  for (const auto &segment : path) {
+    const double length = segment.distInsideObject;
+    const auto &segMat = segment.object->material();
+    const double rhoLength = 100 * segMat.numberDensity() * length;
+    for (size_t i = 0; i < lambdas.size(); ++i) {
+      exponents[i] -= rhoLength * (segMat.totalScatterXSection(lambdas[i]) +
+                                   segMat.absorbXSection(lambdas[i]));
+    }
+  }
+}
 } // namespace
 
 /**
@@ -72,21 +114,23 @@ const Geometry::BoundingBox &MCInteractionVolume::getBoundingBox() const {
 }
 
 /**
- * Calculate the attenuation correction factor the volume given a start and
- * end point.
+ * Generate a scatter point in the volume and the tracks from it back to the
+ * start position and on to the end position.
  * @param rng A reference to a PseudoRandomNumberGenerator producing
  * random number between [0,1]
  * @param startPos Origin of the initial track
  * @param endPos Final position of neutron after scattering (assumed to be
  * outside of the "volume")
- * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
- * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
- * @return The fraction of the beam that has been attenuated. A negative number
- * indicates the track was not valid.
+ * @param beforeScatter Set to the track from the scatter point back to the
+ * start position
+ * @param afterScatter Set to the track from the scatter point to the end
+ * position
+ * @return False if the tracks are not valid
  */
-double MCInteractionVolume::calculateAbsorption(
+bool MCInteractionVolume::generateTracks(
     Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
-    const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+    const Kernel::V3D &endPos, Track &beforeScatter,
+    Track &afterScatter) const {
   // Generate scatter point. If there is an environment present then
   // first select whether the scattering occurs on the sample or the
   // environment. The attenuation for the path leading to the scatter point
@@ -103,7 +147,7 @@ double MCInteractionVolume::calculateAbsorption(
   }
   auto toStart = startPos - scatterPos;
   toStart.normalize();
-  Track beforeScatter(scatterPos, toStart);
+  beforeScatter = Track(scatterPos, toStart);
   int nlinks = m_sample->interceptSurface(beforeScatter);
   if (m_env) {
     nlinks += m_env->interceptSurfaces(beforeScatter);
@@ -111,35 +155,83 @@ double MCInteractionVolume::calculateAbsorption(
   // This should not happen but numerical precision means that it can
   // occasionally occur with tracks that are very close to the surface
   if (nlinks == 0) {
-    return -1.0;
+    return false;
   }
 
-  // Function to calculate total attenuation for a track
-  auto calculateAttenuation = [](const Track &path, double lambda) {
-    double factor(1.0);
-    for (const auto &segment : path) {
-      const double length = segment.distInsideObject;
-      const auto &segObj = *(segment.object);
-      const auto &segMat = segObj.material();
-      factor *= attenuation(segMat.numberDensity(),
-                            segMat.totalScatterXSection(lambda) +
-                                segMat.absorbXSection(lambda),
-                            length);
-    }
-    return factor;
-  };
-
   // Now track to final destination
   V3D scatteredDirec = endPos - scatterPos;
   scatteredDirec.normalize();
-  Track afterScatter(scatterPos, scatteredDirec);
+  afterScatter = Track(scatterPos, scatteredDirec);
   m_sample->interceptSurface(afterScatter);
   if (m_env) {
     m_env->interceptSurfaces(afterScatter);
   }
+  return true;
+}
+
+/**
+ * Calculate the attenuation correction factor the volume given a start and
+ * end point.
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
+ * @return The fraction of the beam that has been attenuated. A negative number
+ * indicates the track was not valid.
+ */
+double MCInteractionVolume::calculateAbsorption(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+  Track beforeScatter, afterScatter;
+  if (!generateTracks(rng, startPos, endPos, beforeScatter, afterScatter)) {
+    return -1.0;
+  }
   return calculateAttenuation(beforeScatter, lambdaBefore) *
          calculateAttenuation(afterScatter, lambdaAfter);
 }
 
+/**
+ * Calculate the attenuation correction factors of one scatter point for a
+ * list of wavelengths. The tracks do not depend on the wavelengths, so they
+ * are generated once for all of them.
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param lambdasBefore Wavelengths, in \f$\\A^-1\f$, before scattering
+ * @param lambdasAfter Wavelengths, in \f$\\A^-1\f$, after scattering, one
+ * for each wavelength before scattering
+ * @param attenuations Set to the fraction of the beam that has been
+ * attenuated for each pair of wavelengths
+ * @return False if the tracks were not valid, in which case attenuations is
+ * not set
+ */
+bool MCInteractionVolume::calculateAbsorption(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    const Kernel::V3D &endPos, const std::vector<double> &lambdasBefore,
+    const std::vector<double> &lambdasAfter,
+    std::vector<double> &attenuations) const {
+  if (lambdasBefore.size() != lambdasAfter.size()) {
+    throw std::invalid_argument("MCInteractionVolume::calculateAbsorption() - "
+                                "Expected as many wavelengths after "
+                                "scattering as before.");
+  }
+  Track beforeScatter, afterScatter;
+  if (!generateTracks(rng, startPos, endPos, beforeScatter, afterScatter)) {
+    return false;
+  }
+  attenuations.assign(lambdasBefore.size(), 0.0);
+  addAttenuationExponents(beforeScatter, lambdasBefore, attenuations);
+  addAttenuationExponents(afterScatter, lambdasAfter, attenuations);
+  for (auto &factor : attenuations) {
+    factor = std::exp(factor);
+  }
+  return true;
+}
+
 } // namespace Algorithms
 } // namespace Mantid
@@ -24,6 +24,10 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -35,6 +39,14 @@ using ConstVecProperties = const VecProperties;
 namespace Mantid {
 namespace Algorithms {
 
+namespace {
+/// The number of bins summed together over all the neighbours of a spectrum
+/// before moving on to the next bins, so the partial sums stay in the cache
+const size_t BLOCK_SIZE = 1024;
+/// Guards the neighbours kept for later runs
+std::mutex g_neighbourCacheMutex;
+} // namespace
+
 // Register the class into the algorithm factory
 DECLARE_ALGORITHM(SmoothNeighbours)
 
@@ -168,6 +180,13 @@ void SmoothNeighbours::init() {
                   "InputWorkspace using SumPixelsX and SumPixelsY.  Individual "
                   "pixels will have averages.");
 
+  declareProperty(
+      "ReuseNeighbourWeights", false,
+      "If true, keep the neighbours and weights of every spectrum in memory "
+      "and reuse them in later runs with the same instrument, detectors, "
+      "masking and smoothing properties. Only the neighbours of the latest "
+      "setup are kept.");
+
   setPropertyGroup("RadiusUnits", NON_UNIFORM_GROUP);
   setPropertyGroup("Radius", NON_UNIFORM_GROUP);
   setPropertyGroup("NumberOfNeighbours", NON_UNIFORM_GROUP);
@@ -581,12 +600,7 @@ void SmoothNeighbours::exec() {
   m_progress =
       make_unique<Progress>(this, 0.0, 0.2, inWS->getNumberHistograms());
 
-  // Run the appropriate method depending on the type of the instrument
-  if (inWS->getInstrument()->containsRectDetectors() ==
-      Instrument::ContainsState::Full)
-    findNeighboursRectangular();
-  else
-    findNeighboursUbiqutious();
+  findNeighbours();
 
   EventWorkspace_sptr wsEvent =
       boost::dynamic_pointer_cast<EventWorkspace>(inWS);
@@ -602,6 +616,113 @@ void SmoothNeighbours::exec() {
                              "EventWorkspace as its input.");
 }
 
+//--------------------------------------------------------------------------------------------
+/** Fill the sparse matrix of neighbours and weights, reusing the one from an
+ * earlier run with the same setup if requested
+ */
+void SmoothNeighbours::findNeighbours() {
+  const bool reuse = getProperty("ReuseNeighbourWeights");
+  std::string settings;
+  std::vector<double> geometry;
+  if (reuse) {
+    settings = neighbourSettings();
+    geometry = neighbourGeometry();
+    std::lock_guard<std::mutex> lock(g_neighbourCacheMutex);
+    const auto &cache = neighbourCache();
+    if (cache && cache->settings == settings && cache->geometry == geometry) {
+      g_log.information("Reusing the neighbours of an earlier run.");
+      m_weights = cache;
+      outWI = m_weights->offsets.size() - 1;
+      return;
+    }
+  }
+
+  // Run the appropriate method depending on the type of the instrument
+  if (inWS->getInstrument()->containsRectDetectors() ==
+      Instrument::ContainsState::Full)
+    findNeighboursRectangular();
+  else
+    findNeighboursUbiqutious();
+
+  // Gather the neighbours of the output spectra into the rows of the matrix
+  auto weights = boost::make_shared<NeighbourWeights>();
+  weights->offsets.reserve(outWI + 1);
+  weights->offsets.push_back(0);
+  for (size_t i = 0; i < outWI; ++i) {
+    for (const auto &neighbour : m_neighbours[i]) {
+      weights->indices.push_back(neighbour.first);
+      weights->weights.push_back(neighbour.second);
+    }
+    weights->offsets.push_back(weights->indices.size());
+  }
+  m_neighbours.clear();
+
+  if (reuse) {
+    weights->settings = std::move(settings);
+    weights->geometry = std::move(geometry);
+  }
+  m_weights = weights;
+  if (reuse) {
+    std::lock_guard<std::mutex> lock(g_neighbourCacheMutex);
+    neighbourCache() = m_weights;
+  }
+}
+
+/**
+ * Get the values of the properties that choose the neighbours and weights
+ * @return The name of the instrument and the property values, as one string
+ */
+std::string SmoothNeighbours::neighbourSettings() const {
+  std::ostringstream settings;
+  settings << inWS->getInstrument()->getName();
+  for (const auto property : getProperties()) {
+    const auto &name = property->name();
+    if (name != INPUT_WORKSPACE && name != "OutputWorkspace" &&
+        name != "PreserveEvents" && name != "ReuseNeighbourWeights")
+      settings << ';' << name << '=' << property->value();
+  }
+  return settings.str();
+}
+
+/**
+ * Get the spectra, detector IDs, masking and detector positions of the input,
+ * which the neighbours and weights depend on
+ * @return The values, in a flat vector
+ */
+std::vector<double> SmoothNeighbours::neighbourGeometry() const {
+  const MatrixWorkspace &ws = *inWS;
+  const auto &detectorInfo = ws.detectorInfo();
+  const size_t numberOfSpectra = ws.getNumberHistograms();
+  std::vector<double> geometry;
+  geometry.reserve(3 * numberOfSpectra + 4 * detectorInfo.size());
+  for (size_t i = 0; i < numberOfSpectra; ++i) {
+    const auto &spectrum = ws.getSpectrum(i);
+    const auto &detIDs = spectrum.getDetectorIDs();
+    geometry.push_back(static_cast<double>(spectrum.getSpectrumNo()));
+    geometry.push_back(static_cast<double>(detIDs.size()));
+    geometry.insert(geometry.end(), detIDs.begin(), detIDs.end());
+  }
+  for (size_t i = 0; i < detectorInfo.size(); ++i) {
+    const auto position = detectorInfo.position(i);
+    geometry.push_back(detectorInfo.isMasked(i) ? 1.0 : 0.0);
+    geometry.push_back(position.X());
+    geometry.push_back(position.Y());
+    geometry.push_back(position.Z());
+  }
+  return geometry;
+}
+
+/**
+ * The neighbours and weights kept for later runs, guarded by
+ * g_neighbourCacheMutex
+ * @return A reference to the kept neighbours, which may be null
+ */
+boost::shared_ptr<const SmoothNeighbours::NeighbourWeights> &
+SmoothNeighbours::neighbourCache() {
+  static boost::shared_ptr<const NeighbourWeights> cache;
+  return cache;
+}
+
 //--------------------------------------------------------------------------------------------
 /** Execute the algorithm for a Workspace2D/don't preserve events input */
 void SmoothNeighbours::execWorkspace2D() {
@@ -629,6 +750,12 @@ void SmoothNeighbours::execWorkspace2D() {
   // Copy geometry over.
   // API::WorkspaceFactory::Instance().initializeFromParent(inWS, outWS, false);
 
+  // The histograms of event lists are made on every access, so sum all their
+  // bins at once
+  const size_t blockSize =
+      boost::dynamic_pointer_cast<const EventWorkspace>(inWS) ? YLength
+                                                             : BLOCK_SIZE;
+
   // Go through all the output workspace
   PARALLEL_FOR_IF(Kernel::threadSafe(*inWS, *outWS))
   for (int outWIi = 0; outWIi < int(numberOfSpectra); outWIi++) {
@@ -644,34 +771,42 @@ void SmoothNeighbours::execWorkspace2D() {
     auto &outX = outSpec.mutableX();
 
     // Which are the neighbours?
-    std::vector<weightedNeighbour> &neighbours = m_neighbours[outWIi];
-    std::vector<weightedNeighbour>::iterator it;
-    for (it = neighbours.begin(); it != neighbours.end(); ++it) {
-      size_t inWI = it->first;
-      double weight = it->second;
-      double weightSquared = weight * weight;
-
-      const auto &inSpec = inWS->getSpectrum(inWI);
-      const auto &inY = inSpec.y();
-      const auto &inE = inSpec.e();
-      const auto &inX = inSpec.x();
-
-      for (size_t i = 0; i < YLength; i++) {
-        // Add the weighted signal
-        outY[i] += inY[i] * weight;
-        // Square the error, scale by weight (which you have to square too),
-        // then add in quadrature
-        double errorSquared = inE[i];
-        errorSquared *= errorSquared;
-        errorSquared *= weightSquared;
-        outE[i] += errorSquared;
-        // Copy the X values as well
-        outX[i] = inX[i];
-      }
+    const size_t first = m_weights->offsets[outWIi];
+    const size_t last = m_weights->offsets[outWIi + 1];
+
+    // Sum a block of bins over all the neighbours at a time
+    for (size_t blockStart = 0; blockStart < YLength;
+         blockStart += blockSize) {
+      const size_t blockEnd = std::min(blockStart + blockSize, YLength);
+      for (size_t n = first; n < last; ++n) {
+        const double weight = m_weights->weights[n];
+        const double weightSquared = weight * weight;
+
+        const auto &inSpec = inWS->getSpectrum(m_weights->indices[n]);
+        const auto &inY = inSpec.y();
+        const auto &inE = inSpec.e();
+
+        for (size_t i = blockStart; i < blockEnd; i++) {
+          // Add the weighted signal
+          outY[i] += inY[i] * weight;
+          // Square the error, scale by weight (which you have to square too),
+          // then add in quadrature
+          double errorSquared = inE[i];
+          errorSquared *= errorSquared;
+          errorSquared *= weightSquared;
+          outE[i] += errorSquared;
+        }
+      } //(each neighbour)
+    }
+
+    // Copy the X values of the last neighbour
+    if (last > first) {
+      const auto &inX = inWS->x(m_weights->indices[last - 1]);
+      std::copy(inX.begin(), inX.begin() + YLength, outX.begin());
       if (inWS->isHistogramData()) {
         outX[YLength] = inX[YLength];
       }
-    } //(each neighbour)
+    }
 
     // Now un-square the error, since we summed it in quadrature
     for (size_t i = 0; i < YLength; i++)
@@ -706,8 +841,9 @@ void SmoothNeighbours::setupNewInstrument(MatrixWorkspace_sptr outws) {
     outSpec.clearDetectorIDs();
 
     // Which are the neighbours?
-    for (const auto &neighbor : m_neighbours[outWIi]) {
-      const auto &inSpec = inWS->getSpectrum(neighbor.first);
+    for (size_t n = m_weights->offsets[outWIi];
+         n < m_weights->offsets[outWIi + 1]; ++n) {
+      const auto &inSpec = inWS->getSpectrum(m_weights->indices[n]);
       outSpec.addDetectorIDs(inSpec.getDetectorIDs());
     }
   }
@@ -751,8 +887,9 @@ void SmoothNeighbours::spreadPixels(MatrixWorkspace_sptr outws) {
   for (int outWIi = 0; outWIi < int(numberOfSpectra2); outWIi++) {
 
     // Which are the neighbours?
-    for (const auto &neighbor : m_neighbours[outWIi]) {
-      outws2->setHistogram(neighbor.first, outws->histogram(outWIi));
+    for (size_t n = m_weights->offsets[outWIi];
+         n < m_weights->offsets[outWIi + 1]; ++n) {
+      outws2->setHistogram(m_weights->indices[n], outws->histogram(outWIi));
     }
   }
   this->setProperty("OutputWorkspace", outws2);
@@ -790,14 +927,12 @@ void SmoothNeighbours::execEvent(Mantid::DataObjects::EventWorkspace_sptr ws) {
     EventList &outEL = outWS->getSpectrum(outWIi);
 
     // Which are the neighbours?
-    std::vector<weightedNeighbour> &neighbours = m_neighbours[outWIi];
-    std::vector<weightedNeighbour>::iterator it;
-    for (it = neighbours.begin(); it != neighbours.end(); ++it) {
-      size_t inWI = it->first;
+    for (size_t n = m_weights->offsets[outWIi];
+         n < m_weights->offsets[outWIi + 1]; ++n) {
       // if(sum)outEL.copyInfoFrom(*ws->getSpectrum(inWI));
-      double weight = it->second;
+      const double weight = m_weights->weights[n];
       // Copy the event list
-      EventList tmpEL = ws->getSpectrum(inWI);
+      EventList tmpEL = ws->getSpectrum(m_weights->indices[n]);
       // Scale it
       tmpEL *= weight;
       // Add it
@@ -94,6 +94,7 @@ const std::string SofQWNormalisedPolygon::category() const {
  */
 void SofQWNormalisedPolygon::init() {
   SofQW::createCommonInputProperties(*this);
+  declareReuseOverlapWeightsProperty();
 }
 
 /**
@@ -140,12 +141,35 @@ void SofQWNormalisedPolygon::exec() {
   const auto &inputIndices = inputWS->indexInfo();
   const auto &spectrumInfo = inputWS->spectrumInfo();
 
+  const bool reuseWeights = getProperty("ReuseOverlapWeights");
+  boost::shared_ptr<const OverlapCacheEntry> overlaps;
+  boost::shared_ptr<OverlapCacheEntry> newOverlaps;
+  std::vector<std::vector<FractionalRebinning::IndexedOverlap>> inputOverlaps;
+  if (reuseWeights) {
+    const auto key = overlapKey(*inputWS, *outputWS);
+    overlaps = cachedOverlaps(key);
+    if (overlaps) {
+      g_log.information("Reusing the overlap weights of an earlier run.");
+      m_progress->reportIncrement(nreports, "Reusing polygon intersections");
+    } else {
+      newOverlaps = boost::make_shared<OverlapCacheEntry>();
+      newOverlaps->algorithm = name();
+      newOverlaps->key = key;
+      inputOverlaps.resize(nHistos);
+    }
+  }
+
   PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
   for (int64_t i = 0; i < static_cast<int64_t>(nHistos);
        ++i) // signed for openmp
   {
     PARALLEL_START_INTERUPT_REGION
 
+    // The overlaps and the spectrum-detector mapping are already known
+    if (overlaps) {
+      continue;
+    }
+
     if (spectrumInfo.isMasked(i) || spectrumInfo.isMonitor(i)) {
       continue;
     }
@@ -184,8 +208,14 @@ void SofQWNormalisedPolygon::exec() {
 
       Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
 
-      FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j,
-                                                   *outputWS, m_Qout);
+      if (newOverlaps) {
+        FractionalRebinning::calculateOverlaps(inputQ, i, j,
+                                               outputWS->x(0).rawData(), m_Qout,
+                                               false, inputOverlaps[i]);
+      } else {
+        FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j,
+                                                     *outputWS, m_Qout);
+      }
 
       // Find which q bin this point lies in
       const MantidVec::difference_type qIndex =
@@ -209,6 +239,22 @@ void SofQWNormalisedPolygon::exec() {
   }
   PARALLEL_CHECK_INTERUPT_REGION
 
+  if (newOverlaps) {
+    newOverlaps->weights = FractionalRebinning::groupOverlaps(
+        inputOverlaps, outputWS->getNumberHistograms());
+    std::vector<std::vector<FractionalRebinning::IndexedOverlap>>().swap(
+        inputOverlaps);
+    newOverlaps->spectrumDefinitions = detIDMapping;
+    overlaps = newOverlaps;
+    cacheOverlaps(overlaps);
+  } else if (overlaps) {
+    detIDMapping = overlaps->spectrumDefinitions;
+  }
+  if (overlaps) {
+    FractionalRebinning::rebinToFractionalOutput(overlaps->weights, *inputWS,
+                                                 *outputWS);
+  }
+
   outputWS->finalize();
   FractionalRebinning::normaliseOutput(outputWS, inputWS, m_progress);
 
@@ -231,6 +277,40 @@ void SofQWNormalisedPolygon::exec() {
   }
 }
 
+/**
+ * Collect the values that define the overlaps of the input bins with the
+ * output bins: the energy mode and fixed energies, the angles of the
+ * spectra, which of them are used, and the input and output binning.
+ * The angular caches must have been initialised.
+ * @param inputWS :: The input workspace
+ * @param outputWS :: The output workspace
+ * @return The values, to compare with those of the overlaps kept before
+ */
+std::vector<std::vector<double>>
+SofQWNormalisedPolygon::overlapKey(const MatrixWorkspace &inputWS,
+                                   const MatrixWorkspace &outputWS) const {
+  const auto &spectrumInfo = inputWS.spectrumInfo();
+  const size_t nHistos = inputWS.getNumberHistograms();
+  std::vector<double> used(nHistos, 0.);
+  std::vector<double> eFixed(nHistos, 0.);
+  for (size_t i = 0; i < nHistos; ++i) {
+    if (spectrumInfo.isMasked(i) || spectrumInfo.isMonitor(i))
+      continue;
+    used[i] = 1.;
+    eFixed[i] = m_EmodeProperties.m_emode == 1
+                    ? m_EmodeProperties.m_efixed
+                    : m_EmodeProperties.getEFixed(spectrumInfo.detector(i));
+  }
+  return {{static_cast<double>(m_EmodeProperties.m_emode)},
+          std::move(eFixed),
+          std::move(used),
+          m_theta,
+          m_thetaWidths,
+          inputWS.x(0).rawData(),
+          outputWS.x(0).rawData(),
+          m_Qout};
+}
+
 /**
  * A map detector ID and Q ranges
  * This method looks unnecessary as it could be calculated on the fly but
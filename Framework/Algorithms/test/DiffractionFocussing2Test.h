@@ -22,6 +22,8 @@
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include <cxxtest/TestSuite.h>
 
+#include <algorithm>
+
 using namespace Mantid;
 using namespace Mantid::DataHandling;
 using namespace Mantid::API;
@@ -102,6 +104,63 @@ public:
     dotestEventWorkspace(false, 1, false);
   }
 
+  void test_EventWorkspace_Keeps_Events_In_Order_Of_Spectra() {
+    // Enough pixels for the large group to be split between the threads
+    const std::string wsName("DiffractionFocussing2Test_order");
+    EventWorkspace_sptr inputW =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(3, 40);
+    inputW->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+    for (size_t pix = 0; pix < inputW->getNumberHistograms(); pix++) {
+      inputW->setHistogram(pix, BinEdges{1.0, 2.0, 1e6});
+      // More events in the first bank than in the others
+      const size_t nEvents = pix < 1600 ? 3 : 1;
+      for (size_t i = 0; i < nEvents; i++)
+        inputW->getSpectrum(pix).addEventQuickly(
+            TofEvent(static_cast<double>(10 * pix + i)));
+    }
+    AnalysisDataService::Instance().addOrReplace(wsName, inputW);
+    FrameworkManager::Instance().exec(
+        "CreateGroupingWorkspace", 6, "InputWorkspace", wsName.c_str(),
+        "GroupNames", "bank1,bank2,bank3", "OutputWorkspace",
+        "DiffractionFocussing2Test_order_group");
+
+    DiffractionFocussing2 alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", wsName);
+    alg.setPropertyValue("OutputWorkspace", wsName + "_focussed");
+    alg.setPropertyValue("GroupingWorkspace",
+                         "DiffractionFocussing2Test_order_group");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    EventWorkspace_const_sptr output;
+    TS_ASSERT_THROWS_NOTHING(
+        output = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            wsName + "_focussed"));
+    if (!output)
+      return;
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), 3);
+    TS_ASSERT_EQUALS(output->getNumberEvents(), 3 * 1600 + 2 * 1600);
+    for (size_t wi = 0; wi < output->getNumberHistograms(); wi++) {
+      const auto &events = output->getSpectrum(wi).getEvents();
+      TS_ASSERT_EQUALS(events.size(), wi == 0 ? 3 * 1600 : 1600);
+      TS_ASSERT_EQUALS(output->getSpectrum(wi).getDetectorIDs().size(), 1600);
+      // The events of the spectra follow each other in order
+      const bool inOrder = std::is_sorted(
+          events.begin(), events.end(),
+          [](const TofEvent &a, const TofEvent &b) {
+            return a.tof() < b.tof();
+          });
+      TS_ASSERT(inOrder);
+      TS_ASSERT_EQUALS(events.front().tof(), 10.0 * 1600 * wi);
+    }
+
+    AnalysisDataService::Instance().remove(wsName);
+    AnalysisDataService::Instance().remove(wsName + "_focussed");
+    AnalysisDataService::Instance().remove(
+        "DiffractionFocussing2Test_order_group");
+  }
+
   void dotestEventWorkspace(bool inplace, size_t numgroups,
                             bool preserveEvents = true,
                             int bankWidthInPixels = 16) {
@@ -17,6 +17,7 @@
 #include "MantidDataObjects/Events.h"
 #include "MantidDataObjects/SplittersWorkspace.h"
 #include "MantidDataObjects/TableWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/TimeSeriesProperty.h"
@@ -266,6 +267,72 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Filter events straight into histograms, which must match histogramming
+   * the filtered events
+   */
+  void test_FilterToHistograms() {
+    int64_t runstart_i64 = 20000000000;
+    int64_t pulsedt = 100 * 1000 * 1000;
+    int64_t tofdt = 10 * 1000 * 1000;
+    size_t numpulses = 5;
+
+    EventWorkspace_sptr inpWS =
+        createEventWorkspace(runstart_i64, pulsedt, tofdt, numpulses);
+    AnalysisDataService::Instance().addOrReplace("TestHisto", inpWS);
+    SplittersWorkspace_sptr splws =
+        createSplittersWorkspace(runstart_i64, pulsedt, tofdt);
+    AnalysisDataService::Instance().addOrReplace("SplitterHisto", splws);
+
+    const std::vector<double> binning{0., 1000., 100000.};
+    for (const bool toHistograms : {false, true}) {
+      FilterEvents filter;
+      filter.initialize();
+      filter.setProperty("InputWorkspace", "TestHisto");
+      filter.setProperty("OutputWorkspaceBaseName",
+                         toHistograms ? "FilteredHisto" : "FilteredEvents");
+      filter.setProperty("SplitterWorkspace", "SplitterHisto");
+      filter.setProperty("OutputTOFCorrectionWorkspace", "CorrectionWS");
+      if (toHistograms)
+        filter.setProperty("OutputBinning", binning);
+      TS_ASSERT_THROWS_NOTHING(filter.execute());
+      TS_ASSERT(filter.isExecuted());
+      int numsplittedws = filter.getProperty("NumberOutputWS");
+      TS_ASSERT_EQUALS(numsplittedws, 4);
+    }
+
+    for (const std::string suffix : {"_0", "_1", "_2", "_unfiltered"}) {
+      auto events = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+          "FilteredEvents" + suffix);
+      auto histograms =
+          AnalysisDataService::Instance().retrieveWS<Workspace2D>(
+              "FilteredHisto" + suffix);
+      TS_ASSERT(events);
+      TS_ASSERT(histograms);
+      if (!events || !histograms)
+        break;
+      TS_ASSERT_EQUALS(histograms->getNumberHistograms(),
+                       events->getNumberHistograms());
+      TS_ASSERT_EQUALS(histograms->run().getProtonCharge(),
+                       events->run().getProtonCharge());
+      TS_ASSERT(histograms->run().hasProperty("splitter") ==
+                events->run().hasProperty("splitter"));
+      for (size_t iws = 0; iws < events->getNumberHistograms(); ++iws) {
+        TS_ASSERT_EQUALS(histograms->x(iws).size(), 101);
+        MantidVec Y, E;
+        events->getSpectrum(iws).generateHistogram(histograms->x(iws).rawData(),
+                                                   Y, E);
+        TS_ASSERT_EQUALS(histograms->y(iws).rawData(), Y);
+        TS_ASSERT_EQUALS(histograms->e(iws).rawData(), E);
+      }
+      AnalysisDataService::Instance().remove("FilteredEvents" + suffix);
+      AnalysisDataService::Instance().remove("FilteredHisto" + suffix);
+    }
+
+    AnalysisDataService::Instance().remove("TestHisto");
+    AnalysisDataService::Instance().remove("SplitterHisto");
+  }
+
   //----------------------------------------------------------------------------------------------
   /**  Filter events without any correction and test for user-specified
    *workspace starting value
@@ -63,6 +63,44 @@ public:
     TS_ASSERT_DELTA(1.0 / std::sqrt(nevents), error, 1e-08);
   }
 
+  void test_Simulation_For_Several_Wavelengths_Uses_Each_Track_For_All() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    MockBeamProfile testBeamProfile;
+    EXPECT_CALL(testBeamProfile, defineActiveRegion(_))
+        .WillOnce(Return(testSampleSphere.getShape().getBoundingBox()));
+    const size_t nevents(10), maxTries(100);
+    MCAbsorptionStrategy mcabsorb(testBeamProfile, testSampleSphere, nevents,
+                                  maxTries);
+    // 3 random numbers per event expected, whatever the number of wavelengths
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(30))
+        .WillRepeatedly(Return(0.5));
+    const Mantid::Algorithms::IBeamProfile::Ray testRay = {V3D(-2, 0, 0),
+                                                           V3D(1, 0, 0)};
+    EXPECT_CALL(testBeamProfile, generatePoint(_, _))
+        .Times(Exactly(static_cast<int>(nevents)))
+        .WillRepeatedly(Return(testRay));
+    const V3D endPos(0.7, 0.7, 1.4);
+    const std::vector<double> lambdasBefore = {2.5, 2.5, 1.0};
+    const std::vector<double> lambdasAfter = {3.5, 3.5, 1.5};
+
+    std::vector<double> factors;
+    double error(0.0);
+    std::tie(factors, error) =
+        mcabsorb.calculate(rng, endPos, lambdasBefore, lambdasAfter);
+    TS_ASSERT_EQUALS(3, factors.size());
+    TS_ASSERT_DELTA(0.0043828472, factors[0], 1e-08);
+    TS_ASSERT_DELTA(0.0043828472, factors[1], 1e-08);
+    TS_ASSERT_LESS_THAN(factors[0], factors[2]);
+    TS_ASSERT_DELTA(1.0 / std::sqrt(nevents), error, 1e-08);
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
@@ -60,6 +60,32 @@ public:
     TS_ASSERT_DELTA(0.0028357258, factor, 1e-8);
   }
 
+  void test_Absorption_For_Several_Wavelengths_Uses_One_Set_Of_Tracks() {
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+    using namespace ::testing;
+
+    const V3D startPos(-2.0, 0.0, 0.0), endPos(0.7, 0.7, 1.4);
+    const std::vector<double> lambdasBefore = {2.5, 1.0};
+    const std::vector<double> lambdasAfter = {3.5, 1.5};
+    // The random numbers for a single scatter point
+    MockRNG rng;
+    EXPECT_CALL(rng, nextValue())
+        .Times(Exactly(3))
+        .WillRepeatedly(Return(0.25));
+
+    auto sample = createTestSample(TestSampleType::SolidSphere);
+    MCInteractionVolume interactor(sample, sample.getShape().getBoundingBox());
+    std::vector<double> factors;
+    TS_ASSERT(interactor.calculateAbsorption(rng, startPos, endPos,
+                                             lambdasBefore, lambdasAfter,
+                                             factors));
+    TS_ASSERT_EQUALS(2, factors.size());
+    TS_ASSERT_DELTA(0.0028357258, factors[0], 1e-8);
+    // Shorter wavelengths are attenuated less
+    TS_ASSERT_LESS_THAN(factors[0], factors[1]);
+  }
+
   void test_Absorption_In_Sample_With_Hole_Container_Scatter_In_All_Segments() {
     using Mantid::Kernel::V3D;
     using namespace MonteCarloTesting;
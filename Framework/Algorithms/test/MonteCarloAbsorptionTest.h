@@ -222,6 +222,30 @@ public:
     TS_ASSERT_DELTA(0.000438, outputWS->y(0).back(), delta);
   }
 
+  void test_Tracks_Shared_By_All_Wavelengths() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {
+        2, 10, Environment::SamplePlusContainer, DeltaEMode::Elastic, -1, -1};
+    auto inputWS = setUpWS(wsProps);
+    auto mcabs = createAlgorithm();
+    TS_ASSERT_THROWS_NOTHING(mcabs->setProperty("InputWorkspace", inputWS));
+    TS_ASSERT_THROWS_NOTHING(
+        mcabs->setProperty("ResimulateTracksForDifferentWavelengths", false));
+    mcabs->execute();
+    auto outputWS = getOutputWorkspace(mcabs);
+
+    verifyDimensions(wsProps, outputWS);
+    // Each track is attenuated more at longer wavelengths, so without the
+    // noise of new tracks the factors fall steadily
+    for (size_t i = 0; i < outputWS->getNumberHistograms(); ++i) {
+      const auto &y = outputWS->y(i);
+      TS_ASSERT_LESS_THAN(0.0, y.back());
+      for (size_t j = 1; j < y.size(); ++j) {
+        TS_ASSERT_LESS_THAN(y[j], y[j - 1]);
+      }
+    }
+  }
+
   //---------------------------------------------------------------------------
   // Failure cases
   //---------------------------------------------------------------------------
@@ -67,7 +67,8 @@ MatrixWorkspace_sptr makeInputWS(const bool distribution,
 MatrixWorkspace_sptr runAlgorithm(MatrixWorkspace_sptr inputWS,
                                   const std::string &axis1Params,
                                   const std::string &axis2Params,
-                                  const bool UseFractionalArea = false) {
+                                  const bool UseFractionalArea = false,
+                                  const bool reuseOverlapWeights = false) {
   // Name of the output workspace.
   std::string outWSName("Rebin2DTest_OutputWS");
 
@@ -80,6 +81,8 @@ MatrixWorkspace_sptr runAlgorithm(MatrixWorkspace_sptr inputWS,
   TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Axis2Binning", axis2Params));
   TS_ASSERT_THROWS_NOTHING(
       alg.setProperty("UseFractionalArea", UseFractionalArea));
+  TS_ASSERT_THROWS_NOTHING(
+      alg.setProperty("ReuseOverlapWeights", reuseOverlapWeights));
   TS_ASSERT_THROWS_NOTHING(alg.execute(););
   TS_ASSERT(alg.isExecuted());
 
@@ -234,7 +237,55 @@ public:
     }
   }
 
+  void test_Reused_Overlap_Weights_Give_The_Same_Result() {
+    for (const bool distribution : {false, true}) {
+      for (const bool useFractionalArea : {false, true}) {
+        MatrixWorkspace_sptr inputWS = makeInputWS(distribution);
+        MatrixWorkspace_sptr expected = runAlgorithm(
+            inputWS, "5.,1.8,25", "-0.5,2.5,9.5", useFractionalArea);
+        // The first run calculates the weights, the second reuses them
+        for (size_t run = 0; run < 2; ++run) {
+          MatrixWorkspace_sptr outputWS =
+              runAlgorithm(inputWS, "5.,1.8,25", "-0.5,2.5,9.5",
+                           useFractionalArea, true);
+          checkSameData(*outputWS, *expected);
+        }
+        // Different data with the same binning
+        inputWS->mutableY(3)[4] = 7.;
+        inputWS->mutableE(5)[1] = 0.5;
+        expected = runAlgorithm(inputWS, "5.,1.8,25", "-0.5,2.5,9.5",
+                                useFractionalArea);
+        MatrixWorkspace_sptr outputWS = runAlgorithm(
+            inputWS, "5.,1.8,25", "-0.5,2.5,9.5", useFractionalArea, true);
+        checkSameData(*outputWS, *expected);
+        // Different binning
+        expected = runAlgorithm(inputWS, "5.,2.4,25", "-0.5,2.5,9.5",
+                                useFractionalArea);
+        outputWS = runAlgorithm(inputWS, "5.,2.4,25", "-0.5,2.5,9.5",
+                                useFractionalArea, true);
+        checkSameData(*outputWS, *expected);
+      }
+    }
+  }
+
 private:
+  void checkSameData(const MatrixWorkspace &outputWS,
+                     const MatrixWorkspace &expected) {
+    TS_ASSERT_EQUALS(outputWS.id(), expected.id());
+    TS_ASSERT_EQUALS(outputWS.getNumberHistograms(),
+                     expected.getNumberHistograms());
+    TS_ASSERT_EQUALS(outputWS.blocksize(), expected.blocksize());
+    if (outputWS.getNumberHistograms() != expected.getNumberHistograms() ||
+        outputWS.blocksize() != expected.blocksize())
+      return;
+    for (size_t i = 0; i < outputWS.getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < outputWS.blocksize(); ++j) {
+        TS_ASSERT_DELTA(outputWS.y(i)[j], expected.y(i)[j], 1e-10);
+        TS_ASSERT_DELTA(outputWS.e(i)[j], expected.e(i)[j], 1e-10);
+      }
+    }
+  }
+
   void checkData(MatrixWorkspace_const_sptr outputWS, const size_t nxvalues,
                  const size_t nhist, const bool dist, const bool onAxis1,
                  const bool small_bins = false) {
@@ -325,6 +376,14 @@ public:
                  useFractionalArea);
   }
 
+  void test_Reuse_Overlap_Weights() {
+    constexpr bool useFractionalArea = true;
+    constexpr bool reuseOverlapWeights = true;
+    for (size_t run = 0; run < 5; ++run)
+      runAlgorithm(m_inputWS, "100,10,41000", "-0.5,0.5,499.5",
+                   useFractionalArea, reuseOverlapWeights);
+  }
+
 private:
   MatrixWorkspace_sptr m_inputWS;
 };
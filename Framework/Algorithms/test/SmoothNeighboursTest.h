@@ -427,6 +427,58 @@ public:
     TS_ASSERT_EQUALS("Rectangular Detectors", propSumPixelsY->getGroup());
     TS_ASSERT_EQUALS("Rectangular Detectors", propZeroEdgePixels->getGroup());
   }
+
+  void test_reused_neighbour_weights_give_the_same_result() {
+    MatrixWorkspace_sptr inWS =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(100, 10);
+
+    auto expected = runWithNeighbourWeights(inWS, false, "Linear");
+    // The first run keeps the neighbours, the second reuses them
+    auto first = runWithNeighbourWeights(inWS, true, "Linear");
+    auto second = runWithNeighbourWeights(inWS, true, "Linear");
+    // A different weighting must not reuse the neighbours
+    auto flat = runWithNeighbourWeights(inWS, true, "Flat");
+    auto expectedFlat = runWithNeighbourWeights(inWS, false, "Flat");
+
+    for (const auto &ws : {first, second}) {
+      TS_ASSERT_EQUALS(ws->getNumberHistograms(),
+                       expected->getNumberHistograms());
+      for (size_t wi = 0; wi < expected->getNumberHistograms(); wi++) {
+        TS_ASSERT_EQUALS(ws->x(wi).rawData(), expected->x(wi).rawData());
+        TS_ASSERT_EQUALS(ws->y(wi).rawData(), expected->y(wi).rawData());
+        TS_ASSERT_EQUALS(ws->e(wi).rawData(), expected->e(wi).rawData());
+        TS_ASSERT_EQUALS(ws->getSpectrum(wi).getDetectorIDs(),
+                         expected->getSpectrum(wi).getDetectorIDs());
+      }
+    }
+    size_t nDifferent(0);
+    for (size_t wi = 0; wi < expectedFlat->getNumberHistograms(); wi++) {
+      TS_ASSERT_EQUALS(flat->e(wi).rawData(), expectedFlat->e(wi).rawData());
+      if (flat->e(wi).rawData() != expected->e(wi).rawData())
+        ++nDifferent;
+    }
+    TS_ASSERT_LESS_THAN(0, nDifferent);
+  }
+
+private:
+  MatrixWorkspace_sptr runWithNeighbourWeights(MatrixWorkspace_sptr inWS,
+                                               bool reuse,
+                                               std::string weightedSum) {
+    SmoothNeighbours alg;
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.initialize();
+    alg.setProperty("InputWorkspace", inWS);
+    alg.setProperty("OutputWorkspace", "unused");
+    alg.setProperty("PreserveEvents", false);
+    alg.setProperty("WeightedSum", weightedSum);
+    alg.setProperty("NumberOfNeighbours", 8);
+    alg.setProperty("Radius", 1.2);
+    alg.setProperty("RadiusUnits", "NumberOfPixels");
+    alg.setProperty("ReuseNeighbourWeights", reuse);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    return alg.getProperty("OutputWorkspace");
+  }
 };
 
 class SmoothNeighboursTestPerformance : public CxxTest::TestSuite {
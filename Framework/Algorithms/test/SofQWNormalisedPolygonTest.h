@@ -92,6 +92,35 @@ public:
     }
   }
 
+  void test_reused_overlap_weights_give_the_same_result() {
+    auto inWS = SofQWTest::loadTestFile();
+    const auto expected = runWithOverlapWeights(inWS, false);
+    // The first run calculates the weights, the second reuses them
+    for (size_t run = 0; run < 2; ++run) {
+      const auto result = runWithOverlapWeights(inWS, true);
+      TS_ASSERT_EQUALS(result->getNumberHistograms(),
+                       expected->getNumberHistograms());
+      TS_ASSERT_EQUALS(result->blocksize(), expected->blocksize());
+      for (size_t i = 0; i < expected->getNumberHistograms(); ++i) {
+        TS_ASSERT_EQUALS(result->getSpectrum(i).getDetectorIDs(),
+                         expected->getSpectrum(i).getDetectorIDs());
+        for (size_t j = 0; j < expected->blocksize(); ++j) {
+          TS_ASSERT_DELTA(result->y(i)[j], expected->y(i)[j], 1e-10);
+          TS_ASSERT_DELTA(result->e(i)[j], expected->e(i)[j], 1e-10);
+        }
+      }
+    }
+    // Different data in the same geometry and binning
+    inWS->mutableY(3)[100] *= 2.;
+    const auto changed = runWithOverlapWeights(inWS, true);
+    const auto changedExpected = runWithOverlapWeights(inWS, false);
+    for (size_t i = 0; i < changed->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < changed->blocksize(); ++j) {
+        TS_ASSERT_DELTA(changed->y(i)[j], changedExpected->y(i)[j], 1e-10);
+      }
+    }
+  }
+
   void testEAndQBinningParams() {
     // SofQWNormalisedPolygon uses it's own setUpOutputWorkspace while
     // the other SofQW* algorithms use the one in SofQW.
@@ -202,6 +231,25 @@ public:
       TS_ASSERT_DELTA(delta, dQ, 1e-12);
     }
   }
+
+private:
+  static MatrixWorkspace_sptr
+  runWithOverlapWeights(const MatrixWorkspace_sptr &inWS,
+                        const bool reuseOverlapWeights) {
+    SofQWNormalisedPolygon alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", inWS);
+    alg.setPropertyValue("OutputWorkspace", "__unused");
+    alg.setPropertyValue("QAxisBinning", "0.5,0.25,2");
+    alg.setPropertyValue("EMode", "Indirect");
+    alg.setPropertyValue("EFixed", "1.84");
+    alg.setProperty("ReplaceNaNs", true);
+    alg.setProperty("ReuseOverlapWeights", reuseOverlapWeights);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    return alg.getProperty("OutputWorkspace");
+  }
 };
 
 class SofQWNormalisedPolygonTestPerformance : public CxxTest::TestSuite {
@@ -0,0 +1,106 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAHANDLING_BANKEVENTCHUNKS_H_
+#define MANTID_DATAHANDLING_BANKEVENTCHUNKS_H_
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class BankPulseTimes;
+
+namespace Mantid {
+namespace Kernel {
+class Task;
+class ThreadScheduler;
+} // namespace Kernel
+namespace DataHandling {
+
+/** Splits the events of a bank into consecutive ranges, so that reading one
+  range from disk overlaps with processing the previous one.
+
+  The range size is a whole number of HDF5 chunks of the bank's event
+  fields, so that no HDF5 chunk is decompressed twice. Ranges of the same
+  bank fill the same event lists, so the processing tasks of each part of the
+  bank (see splitId()) are released to the scheduler one range at a time, in
+  range order, and the events of every list keep the order of the file.
+
+  The event_index and pulse times of the bank are read by the first range to
+  be loaded and shared with the others.
+*/
+class MANTID_DATAHANDLING_DLL BankEventChunks {
+public:
+  /// Number of ranges read ahead of the one being processed
+  static const std::size_t PREFETCH_DEPTH;
+
+  static std::size_t chunkSize(const std::size_t hdf5ChunkSize);
+
+  BankEventChunks(const std::size_t numEvents, const std::size_t chunkSize);
+  ~BankEventChunks();
+
+  /// Number of ranges in the bank
+  std::size_t numChunks() const { return m_numChunks; }
+  std::pair<int64_t, int64_t> range(const std::size_t index) const;
+  detid_t splitId(const detid_t minId, const detid_t maxId,
+                  const bool splitProcessing);
+
+  void setPulseData(boost::shared_ptr<std::vector<uint64_t>> eventIndex,
+                    boost::shared_ptr<BankPulseTimes> pulseTimes);
+  bool pulseData(boost::shared_ptr<std::vector<uint64_t>> &eventIndex,
+                 boost::shared_ptr<BankPulseTimes> &pulseTimes) const;
+
+  void process(const std::size_t part, const std::size_t index,
+               std::unique_ptr<Kernel::Task> task,
+               Kernel::ThreadScheduler &scheduler);
+  void processed(const std::size_t part, Kernel::ThreadScheduler &scheduler);
+
+private:
+  /// The processing order of one part of the bank
+  struct PartQueue {
+    /// Index of the next range to process
+    std::size_t next = 0;
+    /// Whether the task of range next is running
+    bool running = false;
+    /// Tasks of later ranges, null if a range has nothing to process
+    std::map<std::size_t, std::unique_ptr<Kernel::Task>> waiting;
+  };
+
+  void release(PartQueue &queue, Kernel::ThreadScheduler &scheduler);
+
+  /// Number of events in the bank
+  const std::size_t m_numEvents;
+  /// Number of events in each range
+  const std::size_t m_chunkSize;
+  /// Number of ranges
+  const std::size_t m_numChunks;
+  /// Protects all the members below
+  mutable std::mutex m_mutex;
+  /// Largest ID processed as the lower part of the bank, once set
+  detid_t m_splitId;
+  /// Whether m_splitId has been set
+  bool m_haveSplitId;
+  /// The event_index of the bank, once read
+  boost::shared_ptr<std::vector<uint64_t>> m_eventIndex;
+  /// The pulse times of the bank, once read
+  boost::shared_ptr<BankPulseTimes> m_pulseTimes;
+  /// Processing order of the lower and upper part of the bank
+  std::array<PartQueue, 2> m_parts;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_BANKEVENTCHUNKS_H_ */
@@ -14,11 +14,16 @@
 
 #include <nexus/NeXusFile.hpp>
 
+#include <array>
+#include <memory>
+
 class BankPulseTimes;
 
 namespace Mantid {
 namespace DataHandling {
+class BankEventChunks;
 class DefaultEventLoader;
+class ProcessBankData;
 
 /** This task does the disk IO from loading the NXS file, and so will be on a
   disk IO mutex
@@ -33,11 +38,18 @@ public:
                        const bool oldNeXusFileNames, API::Progress *prog,
                        boost::shared_ptr<std::mutex> ioMutex,
                        Kernel::ThreadScheduler &scheduler,
-                       const std::vector<int> &framePeriodNumbers);
+                       const std::vector<int> &framePeriodNumbers,
+                       boost::shared_ptr<BankEventChunks> chunks =
+                           boost::shared_ptr<BankEventChunks>(),
+                       const std::size_t chunkIndex = 0);
 
   void run() override;
 
 private:
+  void loadAndProcess();
+  std::unique_ptr<LoadBankFromDiskTask>
+  makeChunkTask(const std::size_t chunkIndex);
+  void submit(const std::size_t part, std::unique_ptr<ProcessBankData> task);
   void loadPulseTimes(::NeXus::File &file);
   std::vector<uint64_t> loadEventIndex(::NeXus::File &file);
   void prepareEventId(::NeXus::File &file, int64_t &start_event,
@@ -76,6 +88,14 @@ private:
   bool m_have_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
+  /// Ranges of the bank read one after the other, or null to read it whole
+  boost::shared_ptr<BankEventChunks> m_chunks;
+  /// Index of the range loaded by this task
+  std::size_t m_chunkIndex;
+  /// Task loading a later range, run once this range has been processed
+  std::unique_ptr<LoadBankFromDiskTask> m_nextChunkTask;
+  /// Whether a task processing each part of the range has been handed over
+  std::array<bool, 2> m_submitted;
 }; // END-DEF-CLASS LoadBankFromDiskTask
 
 } // namespace DataHandling
@@ -174,8 +174,7 @@ private:
   /// Execution code
   void exec() override;
 
-  bool canUseParallelLoader(const bool haveWeights,
-                            const bool oldNeXusFileNames,
+  bool canUseParallelLoader(const bool oldNeXusFileNames,
                             const std::string &classType) const;
 
   DataObjects::EventWorkspace_sptr createEmptyEventWorkspace();
@@ -96,6 +96,8 @@ private:
 
   bool createOutputWorkspace(std::vector<bool> &loadMonitorFlags);
 
+  bool loadEventMonitorsInParallel(const std::vector<bool> &loadMonitorFlags);
+
   void readEventMonitorEntry(NeXus::File &file, size_t ws_index);
 
   void readHistoMonitorEntry(NeXus::File &file, size_t ws_index,
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "MantidDataHandling/DllConfig.h"
+#include "MantidParallel/IO/EventFilter.h"
 
 namespace Mantid {
 namespace DataObjects {
@@ -19,19 +20,31 @@ class EventWorkspace;
 namespace DataHandling {
 
 /** Loader for event data from Nexus files with parallelism based on multiple
-  processes (MPI) for performance. This class provides integration of the low
-  level loader component Parallel::IO::EventLoader with higher level concepts
-  such as DataObjects::EventWorkspace and the instrument.
+  processes (MPI) or threads for performance. This class provides integration
+  of the low level loader component Parallel::IO::EventLoader with higher level
+  concepts such as DataObjects::EventWorkspace and the instrument.
+
+  Weighted (simulated) events are loaded as TofEvent first, and the event
+  lists are switched to WeightedEvent with the weights read alongside once all
+  events are loaded.
 
   @author Simon Heybrock
   @date 2017
 */
 class MANTID_DATAHANDLING_DLL ParallelEventLoader {
 public:
-  static void load(DataObjects::EventWorkspace &ws, const std::string &filename,
-                   const std::string &groupName,
-                   const std::vector<std::string> &bankNames,
-                   const bool eventIDIsSpectrumNumber);
+  static Parallel::IO::EventStatistics
+  load(DataObjects::EventWorkspace &ws, const std::string &filename,
+       const std::string &groupName, const std::vector<std::string> &bankNames,
+       const bool eventIDIsSpectrumNumber, const bool haveWeights,
+       const Parallel::IO::EventFilter &filter = Parallel::IO::EventFilter{},
+       const int numThreads = 1);
+  static Parallel::IO::EventStatistics
+  loadMonitors(DataObjects::EventWorkspace &ws, const std::string &filename,
+               const std::string &groupName,
+               const std::vector<std::string> &monitorNames,
+               const std::vector<size_t> &workspaceIndices,
+               const int numThreads = 1);
 };
 
 } // namespace DataHandling
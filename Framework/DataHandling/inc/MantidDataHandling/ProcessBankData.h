@@ -10,6 +10,7 @@
 #include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidGeometry/IDTypes.h"
 #include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/Timer.h"
 
 #include <boost/shared_array.hpp>
@@ -19,6 +20,7 @@ namespace API {
 class Progress;
 }
 namespace DataHandling {
+class BankEventChunks;
 class DefaultEventLoader;
 
 /** This task does the disk IO from loading the NXS file,
@@ -54,8 +56,24 @@ public:
 
   void run() override;
 
+  void scheduleOnCompletion(Kernel::ThreadScheduler &scheduler,
+                            std::unique_ptr<Kernel::Task> task);
+  void setBankChunks(BankEventChunks &chunks, const std::size_t part,
+                     Kernel::ThreadScheduler &scheduler);
+
 private:
+  void processEvents();
   size_t getWorkspaceIndexFromPixelID(const detid_t pixID);
+  std::vector<size_t> countEventsPerPixel() const;
+  template <class T>
+  void allocateSlices(const std::vector<std::vector<T> *> &eventVectors,
+                      const std::vector<size_t> &counts,
+                      std::vector<size_t> &sliceStart,
+                      std::vector<size_t> &sliceEnd) const;
+  template <class T>
+  void trimSlices(const std::vector<std::vector<T> *> &eventVectors,
+                  const std::vector<size_t> &sliceNext,
+                  const std::vector<size_t> &sliceEnd) const;
 
   /// Algorithm being run
   DefaultEventLoader &m_loader;
@@ -90,6 +108,15 @@ private:
   detid_t m_max_id;
   /// timer for performance
   Mantid::Kernel::Timer m_timer;
+  /// Scheduler to push m_followUpTask and the next range to
+  Kernel::ThreadScheduler *m_scheduler = nullptr;
+  /// Ranges of the bank, if this task processes one of them. They own this
+  /// task until it is scheduled, so they are not shared.
+  BankEventChunks *m_chunks = nullptr;
+  /// Part of the bank processed by this task, see BankEventChunks::splitId()
+  std::size_t m_part = 0;
+  /// Task to schedule once the events have been processed
+  std::unique_ptr<Kernel::Task> m_followUpTask;
 }; // ENDDEF-CLASS ProcessBankData
 } // namespace DataHandling
 } // namespace Mantid
@@ -0,0 +1,178 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/BankEventChunks.h"
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/// Aim for this many events per range: 32 MB of event_id and TOF
+constexpr std::size_t TARGET_CHUNK_EVENTS = 4 * 1024 * 1024;
+} // namespace
+
+const std::size_t BankEventChunks::PREFETCH_DEPTH = 2;
+
+/** Work out the number of events to read at once.
+ *
+ * @param hdf5ChunkSize :: length of the HDF5 chunks of the event fields, or
+ * 0 if they are not chunked
+ * @return the target size rounded to a whole number of HDF5 chunks
+ */
+std::size_t BankEventChunks::chunkSize(const std::size_t hdf5ChunkSize) {
+  if (hdf5ChunkSize == 0)
+    return TARGET_CHUNK_EVENTS;
+  const std::size_t numHDF5Chunks = std::max(
+      std::size_t{1},
+      (TARGET_CHUNK_EVENTS + hdf5ChunkSize / 2) / hdf5ChunkSize);
+  return numHDF5Chunks * hdf5ChunkSize;
+}
+
+/** Constructor
+ *
+ * @param numEvents :: number of events in the bank
+ * @param chunkSize :: number of events in each range, see chunkSize()
+ */
+BankEventChunks::BankEventChunks(const std::size_t numEvents,
+                                 const std::size_t chunkSize)
+    : m_numEvents(numEvents), m_chunkSize(chunkSize),
+      m_numChunks(chunkSize == 0 ? 0
+                                 : (numEvents + chunkSize - 1) / chunkSize),
+      m_splitId(std::numeric_limits<detid_t>::max()), m_haveSplitId(false) {
+  if (chunkSize == 0)
+    throw std::invalid_argument("BankEventChunks: chunk size must be > 0");
+}
+
+/// Destructor. Deletes the tasks that never got to run, e.g. on cancellation
+BankEventChunks::~BankEventChunks() = default;
+
+/** Get the events of a range.
+ *
+ * @param index :: index of the range
+ * @return the index of the first event and one past the last event
+ */
+std::pair<int64_t, int64_t>
+BankEventChunks::range(const std::size_t index) const {
+  const std::size_t start = std::min(index * m_chunkSize, m_numEvents);
+  const std::size_t stop = std::min(start + m_chunkSize, m_numEvents);
+  return {static_cast<int64_t>(start), static_cast<int64_t>(stop)};
+}
+
+/** Get the detector ID splitting the bank into two parts that are processed
+ * in parallel. The split is fixed by the first range to ask for it, so that
+ * the parts of all the ranges cover the same IDs.
+ *
+ * @param minId :: smallest ID in the calling range
+ * @param maxId :: largest ID in the calling range
+ * @param splitProcessing :: whether to split the bank at all
+ * @return the largest ID of the lower part
+ */
+detid_t BankEventChunks::splitId(const detid_t minId, const detid_t maxId,
+                                 const bool splitProcessing) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_haveSplitId) {
+    if (splitProcessing)
+      m_splitId = minId + (maxId - minId) / 2;
+    m_haveSplitId = true;
+  }
+  return m_splitId;
+}
+
+/** Keep the event_index and pulse times of the bank for the other ranges.
+ *
+ * @param eventIndex :: the event_index field of the bank
+ * @param pulseTimes :: the pulse times of the bank
+ */
+void BankEventChunks::setPulseData(
+    boost::shared_ptr<std::vector<uint64_t>> eventIndex,
+    boost::shared_ptr<BankPulseTimes> pulseTimes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_eventIndex = std::move(eventIndex);
+  m_pulseTimes = std::move(pulseTimes);
+}
+
+/** Get the event_index and pulse times of the bank, if a range has read them.
+ *
+ * @param eventIndex :: set to the event_index field of the bank
+ * @param pulseTimes :: set to the pulse times of the bank
+ * @return true if they have been read
+ */
+bool BankEventChunks::pulseData(
+    boost::shared_ptr<std::vector<uint64_t>> &eventIndex,
+    boost::shared_ptr<BankPulseTimes> &pulseTimes) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_eventIndex)
+    return false;
+  eventIndex = m_eventIndex;
+  pulseTimes = m_pulseTimes;
+  return true;
+}
+
+/** Hand over the processing task of one part of a range. The task is pushed
+ * to the scheduler once the tasks of all earlier ranges of the same part have
+ * run, and the task must call processed() when it is done. Every range must
+ * hand over a task, or null if it has nothing to process, for both parts.
+ *
+ * @param part :: 0 for the lower part, 1 for the upper part
+ * @param index :: index of the range
+ * @param task :: the task processing the events, or null
+ * @param scheduler :: the scheduler to push the task to
+ */
+void BankEventChunks::process(const std::size_t part, const std::size_t index,
+                              std::unique_ptr<Kernel::Task> task,
+                              Kernel::ThreadScheduler &scheduler) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto &queue = m_parts.at(part);
+  queue.waiting[index] = std::move(task);
+  release(queue, scheduler);
+}
+
+/** Mark the running task of a part as done and release the task of the next
+ * range.
+ *
+ * @param part :: 0 for the lower part, 1 for the upper part
+ * @param scheduler :: the scheduler to push the next task to
+ */
+void BankEventChunks::processed(const std::size_t part,
+                                Kernel::ThreadScheduler &scheduler) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto &queue = m_parts.at(part);
+  queue.running = false;
+  ++queue.next;
+  release(queue, scheduler);
+}
+
+/** Push the task of the next range of a part, skipping the ranges that have
+ * nothing to process. m_mutex must be held.
+ *
+ * @param queue :: the part
+ * @param scheduler :: the scheduler to push the task to
+ */
+void BankEventChunks::release(PartQueue &queue,
+                              Kernel::ThreadScheduler &scheduler) {
+  while (!queue.running) {
+    auto it = queue.waiting.find(queue.next);
+    if (it == queue.waiting.end())
+      return;
+    auto task = std::move(it->second);
+    queue.waiting.erase(it);
+    if (task) {
+      queue.running = true;
+      scheduler.push(task.release());
+    } else {
+      ++queue.next;
+    }
+  }
+}
+
+} // namespace DataHandling
+} // namespace Mantid
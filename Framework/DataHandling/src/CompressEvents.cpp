@@ -62,6 +62,23 @@ void CompressEvents::init() {
       "starting filtering. Ignored if WallClockTolerance is not specified. "
       "Default is start of run",
       Direction::Input);
+
+  declareProperty(
+      "CompactStorage", false,
+      "Also keep the output events in a compact encoding in memory: the TOF "
+      "is rounded to a multiple of Tolerance and weights and pulse times are "
+      "packed. Histogramming and TOF conversions use the compact events "
+      "directly; other operations unpack them first. Requires a positive "
+      "Tolerance.");
+}
+
+std::map<std::string, std::string> CompressEvents::validateInputs() {
+  std::map<std::string, std::string> issues;
+  const bool compactStorage = getProperty("CompactStorage");
+  const double toleranceTof = getProperty("Tolerance");
+  if (compactStorage && toleranceTof <= 0.0)
+    issues["Tolerance"] = "Must be positive to use CompactStorage";
+  return issues;
 }
 
 void CompressEvents::exec() {
@@ -137,6 +154,10 @@ void CompressEvents::exec() {
         });
   }
 
+  const bool compactStorage = getProperty("CompactStorage");
+  if (compactStorage)
+    outputWS->setCompressedStorage(toleranceTof);
+
   // Cast to the matrixOutputWS and save it
   this->setProperty("OutputWorkspace", outputWS);
 }
@@ -6,17 +6,59 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidAPI/Progress.h"
+#include "MantidDataHandling/BankEventChunks.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadSchedulerMutexes.h"
 #include "MantidKernel/make_unique.h"
 
+#include <H5Cpp.h>
+
 using namespace Mantid::Kernel;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/**
+ * Get the length of the HDF5 chunks of the event_id field of each bank.
+ * @param alg :: The loading algorithm, for the file name and top entry
+ * @param bankNames :: The banks to look at
+ * @param oldNeXusFileNames :: Whether the field is called event_pixel_id
+ * @return The chunk length of each bank, 0 if not chunked or not found
+ */
+std::vector<size_t>
+getHDF5ChunkSizes(const LoadEventNexus &alg,
+                  const std::vector<std::string> &bankNames,
+                  const bool oldNeXusFileNames) {
+  std::vector<size_t> chunkSizes(bankNames.size(), 0);
+  const std::string field =
+      oldNeXusFileNames ? "/event_pixel_id" : "/event_id";
+  try {
+    H5::Exception::dontPrint();
+    H5::H5File file(alg.m_filename, H5F_ACC_RDONLY);
+    for (size_t i = 0; i < bankNames.size(); ++i) {
+      try {
+        const auto dataset = file.openDataSet("/" + alg.m_top_entry_name +
+                                              "/" + bankNames[i] + field);
+        const auto properties = dataset.getCreatePlist();
+        if (properties.getLayout() == H5D_CHUNKED) {
+          hsize_t chunkDims[1];
+          if (properties.getChunk(1, chunkDims) == 1)
+            chunkSizes[i] = static_cast<size_t>(chunkDims[0]);
+        }
+      } catch (H5::Exception &) {
+        // Leave as unknown; the bank reader reports any real problem
+      }
+    }
+  } catch (H5::Exception &) {
+    // Not an HDF5 file that can be opened here: use the default size
+  }
+  return chunkSizes;
+}
+} // namespace
+
 void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                               bool haveWeights, bool event_id_is_spec,
                               std::vector<std::string> bankNames,
@@ -35,17 +77,50 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   ThreadPool pool(scheduler);
   auto diskIOMutex = boost::make_shared<std::mutex>();
 
+  // Large banks are read in ranges, so that reading a range overlaps with
+  // processing the previous one. Not when loading a chunk of the file, or
+  // when compressing: each range would compress the whole event lists again.
+  const bool readInRanges =
+      chunk == EMPTY_INT() && loader.alg->compressTolerance < 0;
+  std::vector<boost::shared_ptr<BankEventChunks>> bankChunks(bankNames.size());
+  if (readInRanges) {
+    const auto hdf5ChunkSizes =
+        getHDF5ChunkSizes(*loader.alg, bankNames, oldNeXusFileNames);
+    for (size_t i = bankRange.first; i < bankRange.second; i++) {
+      const auto chunkSize = BankEventChunks::chunkSize(hdf5ChunkSizes[i]);
+      if (bankNumEvents[i] > chunkSize)
+        bankChunks[i] =
+            boost::make_shared<BankEventChunks>(bankNumEvents[i], chunkSize);
+    }
+  }
+
   // set up progress bar for the rest of the (multi-threaded) process
-  size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
+  size_t numTasks = 0;
+  for (size_t i = bankRange.first; i < bankRange.second; i++)
+    numTasks += bankChunks[i] ? bankChunks[i]->numChunks() : 1;
+  size_t numProg = numTasks * (1 + 3); // 1 = disktask, 3 = proc task
   if (loader.splitProcessing)
-    numProg += bankNames.size() * 3; // 3 = second proc task
+    numProg += numTasks * 3; // 3 = second proc task
   auto prog = Kernel::make_unique<API::Progress>(loader.alg, 0.3, 1.0, numProg);
 
   for (size_t i = bankRange.first; i < bankRange.second; i++) {
-    if (bankNumEvents[i] > 0)
+    if (bankNumEvents[i] == 0)
+      continue;
+    if (bankChunks[i]) {
+      // Read the first ranges; each one schedules a later one once it has
+      // been processed
+      const auto numFirst = std::min(BankEventChunks::PREFETCH_DEPTH,
+                                     bankChunks[i]->numChunks());
+      for (size_t chunkIndex = 0; chunkIndex < numFirst; ++chunkIndex)
+        pool.schedule(new LoadBankFromDiskTask(
+            loader, bankNames[i], classType, bankNumEvents[i],
+            oldNeXusFileNames, prog.get(), diskIOMutex, *scheduler, periodLog,
+            bankChunks[i], chunkIndex));
+    } else {
       pool.schedule(new LoadBankFromDiskTask(
           loader, bankNames[i], classType, bankNumEvents[i], oldNeXusFileNames,
           prog.get(), diskIOMutex, *scheduler, periodLog));
+    }
   }
   // Start and end all threads
   pool.joinAll();
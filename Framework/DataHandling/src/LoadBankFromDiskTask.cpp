@@ -5,6 +5,7 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
+#include "MantidDataHandling/BankEventChunks.h"
 #include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
@@ -25,19 +26,29 @@ namespace DataHandling {
  * @param ioMutex :: a mutex shared for all Disk I-O tasks
  * @param scheduler :: the ThreadScheduler that runs this task.
  * @param framePeriodNumbers :: Period numbers corresponding to each frame
+ * @param chunks :: If set, the ranges the bank is split into, and this task
+ * only loads the range chunkIndex.
+ * @param chunkIndex :: The range to load if chunks is set
  */
 LoadBankFromDiskTask::LoadBankFromDiskTask(
     DefaultEventLoader &loader, const std::string &entry_name,
     const std::string &entry_type, const std::size_t numEvents,
     const bool oldNeXusFileNames, API::Progress *prog,
     boost::shared_ptr<std::mutex> ioMutex, Kernel::ThreadScheduler &scheduler,
-    const std::vector<int> &framePeriodNumbers)
+    const std::vector<int> &framePeriodNumbers,
+    boost::shared_ptr<BankEventChunks> chunks, const std::size_t chunkIndex)
     : m_loader(loader), entry_name(entry_name), entry_type(entry_type),
       prog(prog), scheduler(scheduler), m_loadError(false),
       m_oldNexusFileNames(oldNeXusFileNames), m_have_weight(false),
-      m_framePeriodNumbers(framePeriodNumbers) {
+      m_framePeriodNumbers(framePeriodNumbers), m_chunks(std::move(chunks)),
+      m_chunkIndex(chunkIndex) {
   setMutex(ioMutex);
-  m_cost = static_cast<double>(numEvents);
+  if (m_chunks) {
+    const auto range = m_chunks->range(m_chunkIndex);
+    m_cost = static_cast<double>(range.second - range.first);
+  } else {
+    m_cost = static_cast<double>(numEvents);
+  }
   m_min_id = std::numeric_limits<uint32_t>::max();
   m_max_id = 0;
 }
@@ -179,6 +190,13 @@ void LoadBankFromDiskTask::prepareEventId(
   if (stop_event > dim0)
     stop_event = dim0;
 
+  // Only load this task's part of the bank
+  if (m_chunks) {
+    const auto range = m_chunks->range(m_chunkIndex);
+    start_event = std::max(start_event, range.first);
+    stop_event = std::max(start_event, std::min(stop_event, range.second));
+  }
+
   m_loader.alg->getLogger().debug()
       << entry_name << ": start_event " << start_event << " stop_event "
       << stop_event << "\n";
@@ -329,7 +347,59 @@ LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   return event_weight;
 }
 
+/** Load the bank, or its range if it is split into ranges, and schedule the
+ * processing of the events. When the bank is split, the range PREFETCH_DEPTH
+ * ahead is scheduled to be read once this one has been processed, so only a
+ * few ranges of a bank are held in memory at a time.
+ */
 void LoadBankFromDiskTask::run() {
+  const std::size_t nextChunk = m_chunkIndex + BankEventChunks::PREFETCH_DEPTH;
+  if (m_chunks && nextChunk < m_chunks->numChunks())
+    m_nextChunkTask = makeChunkTask(nextChunk);
+
+  m_submitted.fill(false);
+  this->loadAndProcess();
+
+  if (m_chunks) {
+    // Let the later ranges of the parts with nothing to process go ahead
+    for (std::size_t part = 0; part < m_submitted.size(); ++part) {
+      if (!m_submitted[part])
+        m_chunks->process(part, m_chunkIndex, nullptr, scheduler);
+    }
+  }
+
+  // Nothing was scheduled to take over the next range (e.g. no events of this
+  // range passed the filters), so read it straight away.
+  if (m_nextChunkTask && !m_loader.alg->getCancel())
+    scheduler.push(m_nextChunkTask.release());
+}
+
+/** Hand over the processing task of one part of this range. The bank pushes
+ * it to the scheduler once the earlier ranges of the part are processed.
+ * @param part :: The part of the bank, see BankEventChunks::splitId()
+ * @param task :: The task processing the events of the part
+ */
+void LoadBankFromDiskTask::submit(const std::size_t part,
+                                  std::unique_ptr<ProcessBankData> task) {
+  task->setBankChunks(*m_chunks, part, scheduler);
+  m_chunks->process(part, m_chunkIndex, std::move(task), scheduler);
+  m_submitted[part] = true;
+}
+
+/** Create a task loading another range of the same bank
+ * @param chunkIndex :: The range to load
+ * @returns The new task
+ */
+std::unique_ptr<LoadBankFromDiskTask>
+LoadBankFromDiskTask::makeChunkTask(const std::size_t chunkIndex) {
+  return Kernel::make_unique<LoadBankFromDiskTask>(
+      m_loader, entry_name, entry_type, 0, m_oldNexusFileNames, prog,
+      getMutex(), scheduler, m_framePeriodNumbers, m_chunks, chunkIndex);
+}
+
+/** Load the events from the file and schedule the ProcessBankData tasks
+ */
+void LoadBankFromDiskTask::loadAndProcess() {
   // These give the limits in each file as to which events we actually load
   // (when filtering by time).
   m_loadStart.resize(1, 0);
@@ -344,7 +414,7 @@ void LoadBankFromDiskTask::run() {
   std::unique_ptr<uint32_t[]> event_id;
   std::unique_ptr<float[]> event_time_of_flight;
   std::unique_ptr<float[]> event_weight;
-  std::vector<uint64_t> event_index;
+  auto event_index = boost::make_shared<std::vector<uint64_t>>();
 
   // Open the file
   ::NeXus::File file(m_loader.alg->m_filename);
@@ -354,25 +424,32 @@ void LoadBankFromDiskTask::run() {
     // Open the bankN_event group
     file.openGroup(entry_name, entry_type);
 
-    // Load the event_index field.
-    event_index = this->loadEventIndex(file);
+    // Load the event_index field and the pulse times, once per bank
+    if (!m_chunks || !m_chunks->pulseData(event_index, thisBankPulseTimes)) {
+      *event_index = this->loadEventIndex(file);
+
+      if (!m_loadError) {
+        // Load and validate the pulse times
+        this->loadPulseTimes(file);
+
+        // The event_index should be the same length as the pulse times from
+        // DAS logs.
+        if (event_index->size() != thisBankPulseTimes->numPulses)
+          m_loader.alg->getLogger().warning()
+              << "Bank " << entry_name
+              << " has a mismatch between the number of event_index entries "
+                 "and the number of pulse times in event_time_zero.\n";
+        if (m_chunks)
+          m_chunks->setPulseData(event_index, thisBankPulseTimes);
+      }
+    }
 
     if (!m_loadError) {
-      // Load and validate the pulse times
-      this->loadPulseTimes(file);
-
-      // The event_index should be the same length as the pulse times from DAS
-      // logs.
-      if (event_index.size() != thisBankPulseTimes->numPulses)
-        m_loader.alg->getLogger().warning()
-            << "Bank " << entry_name
-            << " has a mismatch between the number of event_index entries "
-               "and the number of pulse times in event_time_zero.\n";
 
       // Open and validate event_id field.
       int64_t start_event = 0;
       int64_t stop_event = 0;
-      this->prepareEventId(file, start_event, stop_event, event_index);
+      this->prepareEventId(file, start_event, stop_event, *event_index);
 
       // These are the arguments to getSlab()
       m_loadStart[0] = start_event;
@@ -395,7 +472,10 @@ void LoadBankFromDiskTask::run() {
           }
         }
       } // Size is at least 1
-      else {
+      else if (m_chunks && m_loadSize[0] == 0) {
+        // All the events of this range were filtered out
+        m_loadError = true;
+      } else {
         // Found a size that was 0 or less; stop processing
         m_loader.alg->getLogger().error()
             << "Loading bank " << entry_name
@@ -458,13 +538,6 @@ void LoadBankFromDiskTask::run() {
     return;
   }
 
-  // schedule the job to generate the event lists
-  auto mid_id = m_max_id;
-  if (m_loader.splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
-    // only split if told to and the section to load is at least 1/4 the size
-    // of the whole bank
-    mid_id = (m_max_id + m_min_id) / 2;
-
   // No error? Launch a new task to process that data.
   size_t numEvents = static_cast<size_t>(m_loadSize[0]);
   size_t startAt = static_cast<size_t>(m_loadStart[0]);
@@ -474,21 +547,40 @@ void LoadBankFromDiskTask::run() {
   boost::shared_array<float> event_time_of_flight_shrd(
       event_time_of_flight.release());
   boost::shared_array<float> event_weight_shrd(event_weight.release());
-  auto event_index_shrd =
-      boost::make_shared<std::vector<uint64_t>>(std::move(event_index));
-
-  ProcessBankData *newTask1 = new ProcessBankData(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-      numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-      event_weight_shrd, m_min_id, mid_id);
-  scheduler.push(newTask1);
-  if (m_loader.splitProcessing && (mid_id < m_max_id)) {
-    ProcessBankData *newTask2 = new ProcessBankData(
+  auto makeTask = [&](const uint32_t minId, const uint32_t maxId) {
+    return Kernel::make_unique<ProcessBankData>(
         m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-        numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, (mid_id + 1), m_max_id);
-    scheduler.push(newTask2);
+        numEvents, startAt, event_index, thisBankPulseTimes, m_have_weight,
+        event_weight_shrd, minId, maxId);
+  };
+
+  if (m_chunks) {
+    // All the ranges of the bank must split at the same ID, so that every
+    // pixel is always processed by the tasks of the same part
+    const auto splitId = static_cast<uint32_t>(m_chunks->splitId(
+        static_cast<detid_t>(m_min_id), static_cast<detid_t>(m_max_id),
+        m_loader.splitProcessing));
+    if (m_min_id <= splitId) {
+      auto lowerTask = makeTask(m_min_id, std::min(m_max_id, splitId));
+      if (m_nextChunkTask)
+        lowerTask->scheduleOnCompletion(scheduler, std::move(m_nextChunkTask));
+      submit(0, std::move(lowerTask));
+    }
+    if (m_max_id > splitId)
+      submit(1, makeTask(std::max(m_min_id, splitId + 1), m_max_id));
+    return;
   }
+
+  // schedule the job to generate the event lists
+  auto mid_id = m_max_id;
+  if (m_loader.splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
+    // only split if told to and the section to load is at least 1/4 the size
+    // of the whole bank
+    mid_id = (m_max_id + m_min_id) / 2;
+
+  scheduler.push(makeTask(m_min_id, mid_id).release());
+  if (m_loader.splitProcessing && (mid_id < m_max_id))
+    scheduler.push(makeTask(mid_id + 1, m_max_id).release());
 }
 
 /**
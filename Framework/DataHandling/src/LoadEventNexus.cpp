@@ -267,11 +267,11 @@ void LoadEventNexus::init() {
       make_unique<PropertyWithValue<bool>>("LoadLogs", true, Direction::Input),
       "Load the Sample/DAS logs from the file (default True).");
 
-#ifdef MPI_EXPERIMENTAL
   declareProperty(make_unique<PropertyWithValue<bool>>("UseParallelLoader",
                                                        true, Direction::Input),
-                  "Use experimental parallel loader for loading event data.");
-#endif
+                  "Use the parallel loader for loading event data. It is "
+                  "skipped for files and options it does not support, such as "
+                  "several periods.");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -898,19 +898,48 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
   longest_tof = 0.;
 
   bool loaded{false};
-  if (canUseParallelLoader(haveWeights, oldNeXusFileNames, classType)) {
+  if (canUseParallelLoader(oldNeXusFileNames, classType)) {
     auto ws = m_ws->getSingleHeldWorkspace();
     m_file->close();
+    Parallel::IO::EventFilter filter;
+    filter.tofMin = filter_tof_min;
+    filter.tofMax = filter_tof_max;
+    filter.pulseTimeStart = filter_time_start;
+    filter.pulseTimeStop = filter_time_stop;
+    std::string failure;
     try {
-      ParallelEventLoader::load(*ws, m_filename, m_top_entry_name, bankNames,
-                                event_id_is_spec);
+      const auto statistics = ParallelEventLoader::load(
+          *ws, m_filename, m_top_entry_name, bankNames, event_id_is_spec,
+          haveWeights, filter, PARALLEL_GET_MAX_THREADS);
       g_log.information() << "Used ParallelEventLoader.\n";
       loaded = true;
-      shortest_tof = 0.0;
-      longest_tof = 1e10;
-    } catch (const std::runtime_error &) {
-      g_log.warning()
-          << "ParallelEventLoader failed, falling back to default loader.\n";
+      shortest_tof = std::min(shortest_tof, statistics.shortestTof);
+      longest_tof = std::max(longest_tof, statistics.longestTof);
+      bad_tofs += statistics.badTofs;
+      discarded_events += statistics.discardedEvents;
+    } catch (const std::runtime_error &e) {
+      failure = e.what();
+    } catch (const H5::Exception &e) {
+      // The file has a layout the parallel loader does not understand
+      failure = e.getDetailMsg();
+    }
+    if (!loaded) {
+      g_log.warning() << "ParallelEventLoader failed, falling back to default "
+                         "loader: "
+                      << failure << '\n';
+      // Drop anything loaded before the failure
+      for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+        ws->getSpectrum(i).clear(false);
+    }
+    if (loaded && compressTolerance >= 0) {
+      const auto numHistograms =
+          static_cast<int64_t>(ws->getNumberHistograms());
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t i = 0; i < numHistograms; ++i) {
+        auto &eventList = ws->getSpectrum(i);
+        if (eventList.getNumberEvents() > 0)
+          eventList.compressEvents(compressTolerance, &eventList);
+      }
     }
     safeOpenFile(m_filename);
   }
@@ -924,6 +953,15 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
                              totalChunks);
   }
 
+  // Move the events of each spectrum next to the thread that will process it
+  if (ConfigService::Instance()
+          .getValue<bool>("MultiThreaded.NumaPlacement")
+          .get_value_or(false)) {
+    m_ws->applyFilter([](MatrixWorkspace_sptr ws) {
+      boost::static_pointer_cast<EventWorkspace>(ws)->applyNumaPlacement();
+    });
+  }
+
   // Info reporting
   const std::size_t eventsLoaded = m_ws->getNumberEvents();
   g_log.information() << "Read " << eventsLoaded << " events"
@@ -1430,33 +1468,24 @@ void LoadEventNexus::safeOpenFile(const std::string fname) {
 
 /// The parallel loader currently has no support for a series of special
 /// cases, as indicated by the return value of this method.
-bool LoadEventNexus::canUseParallelLoader(const bool haveWeights,
-                                          const bool oldNeXusFileNames,
+bool LoadEventNexus::canUseParallelLoader(const bool oldNeXusFileNames,
                                           const std::string &classType) const {
-#ifndef MPI_EXPERIMENTAL
-  // Actually the parallel loader would work also in non-MPI builds but it is
-  // likely to be slower than the default loader and may also exhibit unusual
-  // behavior for non-standard Nexus files.
-  return false;
-#else
   bool useParallelLoader = getProperty("UseParallelLoader");
   if (!useParallelLoader)
     return false;
+#ifndef MPI_EXPERIMENTAL
+  // Without MPI several "ranks" can only come from the threading backend used
+  // in tests, where HDF5 access has to be serialized by the caller. The
+  // parallel loader opens the file from all ranks at once.
+  if (communicator().size() != 1)
+    return false;
 #endif
   if (m_ws->nPeriods() != 1)
     return false;
-  if (haveWeights)
-    return false;
   if (oldNeXusFileNames)
     return false;
-  if (filter_tof_min != -1e20 || filter_tof_max != 1e20)
-    return false;
-  if (filter_time_start != Types::Core::DateAndTime::minimum() ||
-      filter_time_stop != Types::Core::DateAndTime::maximum())
-    return false;
-  if (!isDefault("CompressTolerance") || !isDefault("SpectrumMin") ||
-      !isDefault("SpectrumMax") || !isDefault("SpectrumList") ||
-      !isDefault("ChunkNumber"))
+  if (!isDefault("SpectrumMin") || !isDefault("SpectrumMax") ||
+      !isDefault("SpectrumList") || !isDefault("ChunkNumber"))
     return false;
   if (classType != "NXevent_data")
     return false;
@@ -13,11 +13,14 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataHandling/ISISRunLogs.h"
 #include "MantidDataHandling/LoadEventNexus.h"
+#include "MantidDataHandling/ParallelEventLoader.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/UnitFactory.h"
 
+#include <H5Cpp.h>
 #include <Poco/File.h>
 #include <Poco/Path.h>
 #include <boost/lexical_cast.hpp>
@@ -164,58 +167,67 @@ void LoadNexusMonitors2::exec() {
 
   m_top_entry_name = this->getPropertyValue("NXentryName");
 
-  // top level file information
-  ::NeXus::File file(m_filename);
-
-  // open the correct entry
-  using string_map_t = std::map<std::string, std::string>;
-  string_map_t::const_iterator it;
-  string_map_t entries = file.getEntries();
-
-  if (m_top_entry_name.empty()) {
-    for (it = entries.begin(); it != entries.end(); ++it) {
-      if (((it->first == "entry") || (it->first == "raw_data_1")) &&
-          (it->second == "NXentry")) {
-        file.openGroup(it->first, it->second);
-        m_top_entry_name = it->first;
-        break;
+  size_t numPeriods = 0;
+  std::vector<bool> loadMonitorFlags;
+  bool useEventMon;
+  {
+    // top level file information
+    ::NeXus::File file(m_filename);
+
+    // open the correct entry
+    using string_map_t = std::map<std::string, std::string>;
+    string_map_t::const_iterator it;
+    string_map_t entries = file.getEntries();
+
+    if (m_top_entry_name.empty()) {
+      for (it = entries.begin(); it != entries.end(); ++it) {
+        if (((it->first == "entry") || (it->first == "raw_data_1")) &&
+            (it->second == "NXentry")) {
+          file.openGroup(it->first, it->second);
+          m_top_entry_name = it->first;
+          break;
+        }
+      }
+    } else {
+      if (!keyExists(m_top_entry_name, entries)) {
+        throw std::invalid_argument(m_filename +
+                                    " does not contain an entry named " +
+                                    m_top_entry_name);
       }
     }
-  } else {
-    if (!keyExists(m_top_entry_name, entries)) {
-      throw std::invalid_argument(
-          m_filename + " does not contain an entry named " + m_top_entry_name);
+    prog1.report();
+
+    m_monitor_count = getMonitorInfo(file, numPeriods);
+    // Fix the detector numbers if the defaults above are not correct
+    // fixUDets(detector_numbers, file, spectra_numbers, m_monitor_count);
+    // a temporary place to put the spectra/detector numbers
+    // this gets the ids from the "isis_vms_compat" group
+    fixUDets(file);
+
+    if (numPeriods > 1) {
+      m_multiPeriodCounts.resize(m_monitor_count);
+      m_multiPeriodBinEdges.resize(m_monitor_count);
     }
-  }
-  prog1.report();
 
-  size_t numPeriods = 0;
-  m_monitor_count = getMonitorInfo(file, numPeriods);
-  // Fix the detector numbers if the defaults above are not correct
-  // fixUDets(detector_numbers, file, spectra_numbers, m_monitor_count);
-  // a temporary place to put the spectra/detector numbers
-  // this gets the ids from the "isis_vms_compat" group
-  fixUDets(file);
+    // Nothing to do
+    if (0 == m_monitor_count) {
+      // previous version just used to return, but that
+      // threw an error when the OutputWorkspace property was not set.
+      // and the error message was confusing.
+      // This has changed to throw a specific error.
+      throw std::invalid_argument(m_filename +
+                                  " does not contain any monitors");
+    }
 
-  if (numPeriods > 1) {
-    m_multiPeriodCounts.resize(m_monitor_count);
-    m_multiPeriodBinEdges.resize(m_monitor_count);
-  }
+    // Create the output workspace
+    useEventMon = createOutputWorkspace(loadMonitorFlags);
+  } // The file is closed before the event monitors are read through HDF5
 
-  // Nothing to do
-  if (0 == m_monitor_count) {
-    // previous version just used to return, but that
-    // threw an error when the OutputWorkspace property was not set.
-    // and the error message was confusing.
-    // This has changed to throw a specific error.
-    throw std::invalid_argument(m_filename + " does not contain any monitors");
-  }
+  const bool eventMonitorsLoaded =
+      useEventMon && loadEventMonitorsInParallel(loadMonitorFlags);
 
-  // only used if using event monitors
-  // EventWorkspace_sptr eventWS;
-  // Create the output workspace
-  std::vector<bool> loadMonitorFlags;
-  bool useEventMon = createOutputWorkspace(loadMonitorFlags);
+  ::NeXus::File file(m_filename);
+  file.openGroup(m_top_entry_name, "NXentry");
 
   API::Progress prog3(this, 0.6, 1.0, m_monitor_count);
 
@@ -236,7 +248,9 @@ void LoadNexusMonitors2::exec() {
     if (loadMonitorFlags[ws_index]) {
       g_log.information() << "\n";
       file.openGroup(m_monitorInfo[ws_index].name, "NXmonitor");
-      if (useEventMon) {
+      if (eventMonitorsLoaded) {
+        // already loaded by the ParallelEventLoader
+      } else if (useEventMon) {
         // load as an event monitor
         readEventMonitorEntry(file, ws_index);
       } else {
@@ -672,6 +686,59 @@ bool LoadNexusMonitors2::createOutputWorkspace(
   return useEventMon;
 }
 
+/**
+ * Load the flagged event monitors through the ParallelEventLoader. The NeXus
+ * file must not be open while this runs.
+ *
+ * @param loadMonitorFlags :: Whether the monitor of each index is loaded
+ * @return True if the monitors were loaded, false if the file has a layout
+ * the ParallelEventLoader does not support, in which case the event lists are
+ * left empty for readEventMonitorEntry.
+ */
+bool LoadNexusMonitors2::loadEventMonitorsInParallel(
+    const std::vector<bool> &loadMonitorFlags) {
+  auto &eventWS = dynamic_cast<EventWorkspace &>(*m_workspace);
+  std::vector<std::string> monitorNames;
+  std::vector<size_t> workspaceIndices;
+  for (size_t i = 0; i < m_monitor_count; ++i) {
+    if (loadMonitorFlags[i]) {
+      monitorNames.push_back(m_monitorInfo[i].name);
+      workspaceIndices.push_back(i);
+    }
+  }
+
+  std::string failure;
+  try {
+    ParallelEventLoader::loadMonitors(eventWS, m_filename, m_top_entry_name,
+                                      monitorNames, workspaceIndices,
+                                      PARALLEL_GET_MAX_THREADS);
+  } catch (const std::runtime_error &e) {
+    failure = e.what();
+  } catch (const H5::Exception &e) {
+    failure = e.getDetailMsg();
+  }
+  if (!failure.empty()) {
+    g_log.warning() << "ParallelEventLoader failed, falling back to reading "
+                       "the event monitors through NeXus: "
+                    << failure << '\n';
+    for (const auto index : workspaceIndices)
+      eventWS.getSpectrum(index).clear(false);
+    return false;
+  }
+
+  for (const auto index : workspaceIndices) {
+    auto &eventList = eventWS.getSpectrum(index);
+    const auto &events = eventList.getEvents();
+    if (std::is_sorted(events.cbegin(), events.cend(),
+                       [](const Types::Event::TofEvent &lhs,
+                          const Types::Event::TofEvent &rhs) {
+                         return lhs.pulseTime() < rhs.pulseTime();
+                       }))
+      eventList.setSortOrder(DataObjects::PULSETIME_SORT);
+  }
+  return true;
+}
+
 void LoadNexusMonitors2::readEventMonitorEntry(NeXus::File &file,
                                                size_t ws_index) {
   // setup local variables
@@ -8,6 +8,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
 #include "MantidIndexing/IndexInfo.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidParallel/IO/EventLoader.h"
 #include "MantidTypes/Event/TofEvent.h"
 #include "MantidTypes/SpectrumDefinition.h"
@@ -80,24 +81,84 @@ std::vector<int32_t> bankOffsetsSpectrumNumbers(
   return bankOffsets;
 }
 
-/// Load events from given banks into given EventWorkspace.
-void ParallelEventLoader::load(DataObjects::EventWorkspace &ws,
-                               const std::string &filename,
-                               const std::string &groupName,
-                               const std::vector<std::string> &bankNames,
-                               const bool eventIDIsSpectrumNumber) {
+/** Load events from given banks into given EventWorkspace.
+ *
+ * @param ws Workspace to add the events to.
+ * @param filename Path of the Nexus file.
+ * @param groupName Name of the NXentry holding the banks.
+ * @param bankNames Names of the NXevent_data groups to load.
+ * @param eventIDIsSpectrumNumber True if the event IDs are spectrum numbers
+ * rather than detector IDs.
+ * @param haveWeights True if the events are weighted. Banks without weights
+ * then get a weight of 1.
+ * @param filter Events outside the filter are not loaded.
+ * @param numThreads Number of threads parsing events, used if the workspace
+ * is not distributed over several processes.
+ * @return Statistics of the events that were loaded.
+ */
+Parallel::IO::EventStatistics ParallelEventLoader::load(
+    DataObjects::EventWorkspace &ws, const std::string &filename,
+    const std::string &groupName, const std::vector<std::string> &bankNames,
+    const bool eventIDIsSpectrumNumber, const bool haveWeights,
+    const Parallel::IO::EventFilter &filter, const int numThreads) {
   const size_t size = ws.getNumberHistograms();
   std::vector<std::vector<Types::Event::TofEvent> *> eventLists(size, nullptr);
   for (size_t i = 0; i < size; ++i)
     DataObjects::getEventsFrom(ws.getSpectrum(i), eventLists[i]);
+  std::vector<std::vector<float>> weights(haveWeights ? size : 0);
+  std::vector<std::vector<float> *> weightLists;
+  for (auto &weight : weights)
+    weightLists.push_back(&weight);
   const auto offsets =
       eventIDIsSpectrumNumber
           ? bankOffsetsSpectrumNumbers(ws, filename, groupName, bankNames)
           : bankOffsets(ws, filename, groupName, bankNames);
 
-  Parallel::IO::EventLoader::load(ws.indexInfo().communicator(), filename,
-                                  groupName, bankNames, offsets,
-                                  std::move(eventLists));
+  const auto statistics = Parallel::IO::EventLoader::load(
+      ws.indexInfo().communicator(), filename, groupName, bankNames, offsets,
+      std::move(eventLists), std::move(weightLists), filter, numThreads);
+
+  if (haveWeights) {
+    const auto numSpectra = static_cast<int64_t>(size);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numSpectra; ++i) {
+      auto &spectrum = ws.getSpectrum(i);
+      spectrum.switchTo(API::WEIGHTED);
+      auto &events = spectrum.getWeightedEvents();
+      const auto &weight = weights[i];
+      for (size_t j = 0; j < events.size(); ++j) {
+        events[j].m_weight = weight[j];
+        events[j].m_errorSquared = weight[j] * weight[j];
+      }
+      std::vector<float>().swap(weights[i]);
+    }
+  }
+  return statistics;
+}
+
+/** Load the events of event monitors into given EventWorkspace. Any event IDs
+ * of the monitors are ignored.
+ *
+ * @param ws Workspace to add the events to.
+ * @param filename Path of the Nexus file.
+ * @param groupName Name of the NXentry holding the monitors.
+ * @param monitorNames Names of the NXmonitor groups to load.
+ * @param workspaceIndices Workspace index of each monitor.
+ * @param numThreads Number of threads parsing events.
+ * @return Statistics of the events that were loaded.
+ */
+Parallel::IO::EventStatistics ParallelEventLoader::loadMonitors(
+    DataObjects::EventWorkspace &ws, const std::string &filename,
+    const std::string &groupName, const std::vector<std::string> &monitorNames,
+    const std::vector<size_t> &workspaceIndices, const int numThreads) {
+  std::vector<std::vector<Types::Event::TofEvent> *> eventLists(
+      monitorNames.size(), nullptr);
+  for (size_t i = 0; i < monitorNames.size(); ++i)
+    DataObjects::getEventsFrom(ws.getSpectrum(workspaceIndices[i]),
+                               eventLists[i]);
+  return Parallel::IO::EventLoader::loadSingleSpectrumBanks(
+      filename, groupName, monitorNames, std::move(eventLists),
+      Parallel::IO::EventFilter{}, numThreads);
 }
 
 } // namespace DataHandling
@@ -5,14 +5,37 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidDataHandling/BankEventChunks.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 
+#include <functional>
+
 using namespace Mantid::DataObjects;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Calls a function when it goes out of scope, unless it was called earlier
+class CallOnExit {
+public:
+  explicit CallOnExit(std::function<void()> func) : m_func(std::move(func)) {}
+  CallOnExit(const CallOnExit &) = delete;
+  CallOnExit &operator=(const CallOnExit &) = delete;
+  ~CallOnExit() { callNow(); }
+  /// Call the function now instead of on exit
+  void callNow() {
+    if (m_func)
+      m_func();
+    m_func = nullptr;
+  }
+
+private:
+  std::function<void()> m_func;
+};
+} // namespace
+
 ProcessBankData::ProcessBankData(
     DefaultEventLoader &m_loader, std::string entry_name, API::Progress *prog,
     boost::shared_array<uint32_t> event_id,
@@ -33,10 +56,21 @@ ProcessBankData::ProcessBankData(
   m_cost = static_cast<double>(numEvents);
 }
 
-/** Run the data processing
- * FIXME/TODO - split run() into readable methods
+/** Run the data processing, then let the next range of the bank go ahead and
+ * schedule the follow-up task, if any
  */
 void ProcessBankData::run() { // override {
+  processEvents();
+  if (m_chunks)
+    m_chunks->processed(m_part, *m_scheduler);
+  if (m_followUpTask && !m_loader.alg->getCancel())
+    m_scheduler->push(m_followUpTask.release());
+}
+
+/** Add the events to the event lists
+ * FIXME/TODO - split processEvents() into readable methods
+ */
+void ProcessBankData::processEvents() {
   // Local tof limits
   double my_shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -49,14 +83,34 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
-
-    std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
-    for (size_t i = 0; i < numEvents; i++) {
-      detid_t thisId = detid_t(event_id[i]);
-      if (thisId >= m_min_id && thisId <= m_max_id)
-        counts[thisId - m_min_id]++;
-    }
+  // With a single period every event of a pixel goes to the same list, so
+  // each pixel gets a slice of exactly the right size in its event vector and
+  // the events are written straight into it. Otherwise the lists are
+  // reserved and the events appended.
+  const bool writeToSlices = m_loader.precount && outputWS.nPeriods() == 1;
+  // Per pixel: next position to write to, and end of the slice
+  std::vector<size_t> sliceNext;
+  std::vector<size_t> sliceEnd;
+  // The slices are allocated before the events are written, so drop the
+  // unwritten part of them however processing stops, e.g. on cancellation,
+  // or the lists would keep default constructed events
+  CallOnExit trimUnwrittenSlices([&] {
+    if (!writeToSlices)
+      return;
+    if (have_weight)
+      trimSlices(m_loader.weightedEventVectors[0], sliceNext, sliceEnd);
+    else
+      trimSlices(m_loader.eventVectors[0], sliceNext, sliceEnd);
+  });
+  if (writeToSlices) {
+    const auto counts = countEventsPerPixel();
+    if (have_weight)
+      allocateSlices(m_loader.weightedEventVectors[0], counts, sliceNext,
+                     sliceEnd);
+    else
+      allocateSlices(m_loader.eventVectors[0], counts, sliceNext, sliceEnd);
+  } else if (m_loader.precount) {
+    const auto counts = countEventsPerPixel();
 
     // Now we pre-allocate (reserve) the vectors of events in each pixel
     // counted
@@ -165,7 +219,11 @@ void ProcessBankData::run() { // override {
           auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
           // NULL eventVector indicates a bad spectrum lookup
           if (eventVector) {
-            eventVector->emplace_back(tof, pulsetime, weight, errorSq);
+            if (writeToSlices)
+              (*eventVector)[sliceNext[detId - m_min_id]++] =
+                  WeightedEvent(tof, pulsetime, weight, errorSq);
+            else
+              eventVector->emplace_back(tof, pulsetime, weight, errorSq);
           } else {
             ++my_discarded_events;
           }
@@ -174,7 +232,11 @@ void ProcessBankData::run() { // override {
           auto *eventVector = m_loader.eventVectors[periodIndex][detId];
           // NULL eventVector indicates a bad spectrum lookup
           if (eventVector) {
-            eventVector->emplace_back(tof, pulsetime);
+            if (writeToSlices)
+              (*eventVector)[sliceNext[detId - m_min_id]++] =
+                  Types::Event::TofEvent(tof, pulsetime);
+            else
+              eventVector->emplace_back(tof, pulsetime);
           } else {
             ++my_discarded_events;
           }
@@ -202,6 +264,10 @@ void ProcessBankData::run() { // override {
     } // valid detector IDs
   }   //(for each event)
 
+  // Drop the unused part of the slices if the loop was cut short, before
+  // compressing the lists
+  trimUnwrittenSlices.callNow();
+
   //------------ Compress Events (or set sort order) ------------------
   // Do it on all the detector IDs we touched
   if (compress) {
@@ -246,7 +312,107 @@ void ProcessBankData::run() { // override {
   alg->getLogger().debug() << "Time to process " << entry_name << " " << m_timer
                            << "\n";
 #endif
-} // END-OF-RUN()
+} // END-OF-PROCESSEVENTS()
+
+/**
+ * Schedule a task once this one has finished processing its events, e.g. to
+ * read the next part of a bank without holding more than a few parts in
+ * memory.
+ *
+ * @param scheduler :: The scheduler to push the task to
+ * @param task :: The task to schedule
+ */
+void ProcessBankData::scheduleOnCompletion(Kernel::ThreadScheduler &scheduler,
+                                           std::unique_ptr<Kernel::Task> task) {
+  m_scheduler = &scheduler;
+  m_followUpTask = std::move(task);
+}
+
+/**
+ * Mark this task as the processing of one part of a range of a bank, so that
+ * it tells the bank when it is done and the next range can be processed.
+ *
+ * @param chunks :: The ranges of the bank, which must outlive the task
+ * @param part :: The part of the bank processed by this task
+ * @param scheduler :: The scheduler to push the next range to
+ */
+void ProcessBankData::setBankChunks(BankEventChunks &chunks,
+                                    const std::size_t part,
+                                    Kernel::ThreadScheduler &scheduler) {
+  m_chunks = &chunks;
+  m_part = part;
+  m_scheduler = &scheduler;
+}
+
+/**
+ * Count the events that will be loaded for each pixel ID, i.e. those with a
+ * pixel ID in range and a TOF passing the filter.
+ *
+ * @return The number of events for each pixel ID from m_min_id to m_max_id
+ */
+std::vector<size_t> ProcessBankData::countEventsPerPixel() const {
+  const auto *alg = m_loader.alg;
+  std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
+  for (size_t i = 0; i < numEvents; i++) {
+    const detid_t thisId = detid_t(event_id[i]);
+    if (thisId >= m_min_id && thisId <= m_max_id) {
+      const double tof = static_cast<double>(event_time_of_flight[i]);
+      if ((tof >= alg->filter_tof_min) && (tof <= alg->filter_tof_max))
+        counts[thisId - m_min_id]++;
+    }
+  }
+  return counts;
+}
+
+/**
+ * Grow the event vector of each pixel by the number of events it will
+ * receive, so that the events can be written in place without reallocating.
+ * Pixels sharing a vector get consecutive slices of it.
+ *
+ * @param eventVectors :: The event vector of each pixel ID
+ * @param counts :: The number of events for each pixel ID in range
+ * @param sliceStart :: Output, position of the first event of each pixel
+ * @param sliceEnd :: Output, position past the last event of each pixel
+ */
+template <class T>
+void ProcessBankData::allocateSlices(
+    const std::vector<std::vector<T> *> &eventVectors,
+    const std::vector<size_t> &counts, std::vector<size_t> &sliceStart,
+    std::vector<size_t> &sliceEnd) const {
+  sliceStart.assign(counts.size(), 0);
+  sliceEnd.assign(counts.size(), 0);
+  for (size_t pix = 0; pix < counts.size(); ++pix) {
+    auto *eventVector = eventVectors[m_min_id + static_cast<detid_t>(pix)];
+    if (!eventVector || counts[pix] == 0)
+      continue;
+    sliceStart[pix] = eventVector->size();
+    sliceEnd[pix] = sliceStart[pix] + counts[pix];
+    eventVector->resize(sliceEnd[pix]);
+  }
+}
+
+/**
+ * Remove the parts of the slices that were not written to. This only happens
+ * when the event loop stops early, e.g. on cancellation.
+ *
+ * @param eventVectors :: The event vector of each pixel ID
+ * @param sliceNext :: Next position to write to for each pixel
+ * @param sliceEnd :: Position past the last event of each pixel
+ */
+template <class T>
+void ProcessBankData::trimSlices(
+    const std::vector<std::vector<T> *> &eventVectors,
+    const std::vector<size_t> &sliceNext,
+    const std::vector<size_t> &sliceEnd) const {
+  // Go backwards so that erasing does not move the slices still to trim
+  for (size_t pix = sliceNext.size(); pix-- > 0;) {
+    if (sliceNext[pix] == sliceEnd[pix])
+      continue;
+    auto *eventVector = eventVectors[m_min_id + static_cast<detid_t>(pix)];
+    eventVector->erase(eventVector->begin() + sliceNext[pix],
+                       eventVector->begin() + sliceEnd[pix]);
+  }
+}
 
 /**
  * Get the workspace index for a given pixel ID. Throws if the pixel ID is
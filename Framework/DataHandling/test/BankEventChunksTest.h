@@ -0,0 +1,125 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAHANDLING_BANKEVENTCHUNKSTEST_H_
+#define MANTID_DATAHANDLING_BANKEVENTCHUNKSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/BankEventChunks.h"
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/make_unique.h"
+
+#include <boost/make_shared.hpp>
+
+using Mantid::DataHandling::BankEventChunks;
+using Mantid::Kernel::Task;
+using Mantid::Kernel::ThreadSchedulerFIFO;
+
+namespace {
+class NoOpTask : public Task {
+public:
+  void run() override {}
+};
+} // namespace
+
+class BankEventChunksTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BankEventChunksTest *createSuite() {
+    return new BankEventChunksTest();
+  }
+  static void destroySuite(BankEventChunksTest *suite) { delete suite; }
+
+  void test_chunkSize_is_multiple_of_hdf5_chunks() {
+    const size_t unchunked = BankEventChunks::chunkSize(0);
+    TS_ASSERT_LESS_THAN(0, unchunked);
+    TS_ASSERT_EQUALS(BankEventChunks::chunkSize(16384) % 16384, 0);
+    TS_ASSERT_EQUALS(BankEventChunks::chunkSize(1000) % 1000, 0);
+    TS_ASSERT_DELTA(static_cast<double>(BankEventChunks::chunkSize(1000)),
+                    static_cast<double>(unchunked), 500.);
+    // HDF5 chunks larger than the target are read one at a time
+    TS_ASSERT_EQUALS(BankEventChunks::chunkSize(10 * unchunked),
+                     10 * unchunked);
+  }
+
+  void test_ranges_cover_bank() {
+    BankEventChunks chunks(1050, 100);
+    TS_ASSERT_EQUALS(chunks.numChunks(), 11);
+    TS_ASSERT_EQUALS(chunks.range(0), std::make_pair(int64_t{0}, int64_t{100}));
+    TS_ASSERT_EQUALS(chunks.range(3),
+                     std::make_pair(int64_t{300}, int64_t{400}));
+    TS_ASSERT_EQUALS(chunks.range(10),
+                     std::make_pair(int64_t{1000}, int64_t{1050}));
+    TS_ASSERT_EQUALS(chunks.range(11),
+                     std::make_pair(int64_t{1050}, int64_t{1050}));
+  }
+
+  void test_zero_chunk_size_throws() {
+    TS_ASSERT_THROWS(BankEventChunks(10, 0), std::invalid_argument);
+  }
+
+  void test_splitId_is_fixed_by_first_call() {
+    BankEventChunks chunks(1000, 100);
+    TS_ASSERT_EQUALS(chunks.splitId(100, 200, true), 150);
+    TS_ASSERT_EQUALS(chunks.splitId(0, 1000, true), 150);
+  }
+
+  void test_no_split_keeps_everything_in_lower_part() {
+    BankEventChunks chunks(1000, 100);
+    const auto splitId = chunks.splitId(100, 200, false);
+    TS_ASSERT_LESS_THAN_EQUALS(200, splitId);
+    TS_ASSERT_EQUALS(chunks.splitId(0, 1000, true), splitId);
+  }
+
+  void test_ranges_are_released_in_order() {
+    BankEventChunks chunks(1000, 100);
+    ThreadSchedulerFIFO scheduler;
+    chunks.process(0, 2, makeTask(), scheduler);
+    chunks.process(0, 1, nullptr, scheduler);
+    TS_ASSERT_EQUALS(scheduler.size(), 0);
+    // The upper part does not wait for the lower part
+    chunks.process(1, 0, makeTask(), scheduler);
+    TS_ASSERT_EQUALS(scheduler.size(), 1);
+    chunks.process(0, 0, makeTask(), scheduler);
+    TS_ASSERT_EQUALS(scheduler.size(), 2);
+    runAll(scheduler);
+
+    // Range 1 has nothing to process, so range 2 follows range 0
+    chunks.processed(0, scheduler);
+    TS_ASSERT_EQUALS(scheduler.size(), 1);
+    runAll(scheduler);
+    chunks.processed(0, scheduler);
+    TS_ASSERT_EQUALS(scheduler.size(), 0);
+  }
+
+  void test_pulseData_is_shared() {
+    BankEventChunks chunks(1000, 100);
+    boost::shared_ptr<std::vector<uint64_t>> eventIndex;
+    boost::shared_ptr<BankPulseTimes> pulseTimes;
+    TS_ASSERT(!chunks.pulseData(eventIndex, pulseTimes));
+    auto stored = boost::make_shared<std::vector<uint64_t>>(3, 1);
+    chunks.setPulseData(stored, nullptr);
+    TS_ASSERT(chunks.pulseData(eventIndex, pulseTimes));
+    TS_ASSERT_EQUALS(eventIndex, stored);
+  }
+
+private:
+  std::unique_ptr<Task> makeTask() {
+    return Mantid::Kernel::make_unique<NoOpTask>();
+  }
+
+  void runAll(ThreadSchedulerFIFO &scheduler) {
+    while (scheduler.size() > 0) {
+      std::unique_ptr<Task> task(scheduler.pop(0));
+      task->run();
+    }
+  }
+};
+
+#endif /* MANTID_DATAHANDLING_BANKEVENTCHUNKSTEST_H_ */
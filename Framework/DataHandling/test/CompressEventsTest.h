@@ -38,6 +38,38 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Tolerance", "0.0"));
   }
 
+  void test_CompactStorage_needs_positive_Tolerance() {
+    CompressEvents alg;
+    alg.initialize();
+    alg.setProperty("CompactStorage", true);
+    alg.setProperty("Tolerance", 0.0);
+    const auto issues = alg.validateInputs();
+    TS_ASSERT_EQUALS(issues.count("Tolerance"), 1);
+  }
+
+  void test_CompactStorage() {
+    EventWorkspace_sptr input = WorkspaceCreationHelper::createEventWorkspace(
+        10, 100, 100, 0.0, 1.0, 2);
+    CompressEvents alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    alg.setProperty("Tolerance", 0.1);
+    alg.setProperty("CompactStorage", true);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    EventWorkspace_sptr output = alg.getProperty("OutputWorkspace");
+    TS_ASSERT(output);
+    if (!output)
+      return;
+
+    TS_ASSERT_EQUALS(output->getNumberEvents(), 100 * 10);
+    TS_ASSERT_EQUALS(output->getSpectrum(0).getStorageLayout(), COMPRESSED);
+    TS_ASSERT_DELTA(output->readY(0)[1], 2.0, 1e-5);
+    TS_ASSERT_DELTA(output->readE(0)[1], M_SQRT2, 1e-5);
+    TS_ASSERT_DELTA(output->getSpectrum(0).getTofMin(), 0.5, 1e-6);
+  }
+
   void doTest(std::string inputName, std::string outputName, double tolerance,
               int numPixels = 50, double wallClockTolerance = 0.) {
     EventWorkspace_sptr input, output;
@@ -49,6 +49,7 @@ load_reference_workspace(const std::string &filename) {
   auto alg = ParallelTestHelpers::create<LoadEventNexus>(comm);
   alg->setProperty("Filename", filename);
   alg->setProperty("LoadLogs", false);
+  alg->setProperty("UseParallelLoader", false);
   TS_ASSERT_THROWS_NOTHING(alg->execute());
   TS_ASSERT(alg->isExecuted());
   Workspace_const_sptr out = alg->getProperty("OutputWorkspace");
@@ -357,6 +358,61 @@ public:
                min >= filterStart);
   }
 
+  void test_parallel_loader_matches_default_loader() {
+    const auto load = [](const bool useParallelLoader) {
+      LoadEventNexus ld;
+      ld.initialize();
+      ld.setPropertyValue("OutputWorkspace", "unused");
+      ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+      ld.setProperty("FilterByTofMin", 45000.0);
+      ld.setProperty("FilterByTofMax", 59000.0);
+      ld.setProperty("FilterByTimeStart", 10.0);
+      ld.setProperty("FilterByTimeStop", 50.0);
+      ld.setProperty("LoadLogs", false);
+      ld.setProperty("UseParallelLoader", useParallelLoader);
+      ld.setChild(true);
+      ld.execute();
+      TS_ASSERT(ld.isExecuted());
+      Workspace_sptr out = ld.getProperty("OutputWorkspace");
+      return boost::dynamic_pointer_cast<const EventWorkspace>(out);
+    };
+    const auto reference = load(false);
+    const auto ws = load(true);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), reference->getNumberEvents());
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(),
+                     reference->getNumberHistograms());
+    for (size_t i = 0; i < reference->getNumberHistograms(); ++i)
+      TS_ASSERT_EQUALS(ws->getSpectrum(i), reference->getSpectrum(i));
+    TS_ASSERT_EQUALS(ws->x(0).rawData(), reference->x(0).rawData());
+  }
+
+  void test_parallel_loader_matches_default_loader_for_weighted_events() {
+    const auto load = [](const bool useParallelLoader) {
+      LoadEventNexus ld;
+      ld.initialize();
+      ld.setPropertyValue("OutputWorkspace", "unused");
+      ld.setPropertyValue("Filename", "ARCS_sim_event.nxs");
+      ld.setProperty("BankName", "bank27");
+      ld.setProperty("SingleBankPixelsOnly", false);
+      ld.setProperty("LoadLogs", false);
+      ld.setProperty("UseParallelLoader", useParallelLoader);
+      ld.setChild(true);
+      ld.execute();
+      TS_ASSERT(ld.isExecuted());
+      Workspace_sptr out = ld.getProperty("OutputWorkspace");
+      return boost::dynamic_pointer_cast<const EventWorkspace>(out);
+    };
+    const auto reference = load(false);
+    const auto ws = load(true);
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), reference->getNumberEvents());
+    TS_ASSERT_EQUALS(ws->getNumberHistograms(),
+                     reference->getNumberHistograms());
+    for (size_t i = 0; i < reference->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(ws->getSpectrum(i).getEventType(), WEIGHTED);
+      TS_ASSERT_EQUALS(ws->getSpectrum(i), reference->getSpectrum(i));
+    }
+  }
+
   void test_partial_spectra_loading() {
     std::string wsName = "test_partial_spectra_loading_SpectrumList";
     std::vector<int32_t> specList;
@@ -874,13 +930,11 @@ public:
   }
 
   void test_MPI_load() {
-    // Note that this and other MPI tests currently work only in non-MPI builds
-    // with the default event loader, i.e., ParallelEventLoader is not
+    // Note that in non-MPI builds the threaded runs of this and other MPI tests
+    // use the default event loader, i.e., ParallelEventLoader is not
     // supported. The reason is the locking we need in the test for HDF5 access,
     // which implies that the communication within ParallelEventLoader will
-    // simply get stuck. Additionally, it will fail for the CNCS file since
-    // empty banks contain a dummy event with an invalid event ID, which
-    // ParallelEventLoader does not support.
+    // simply get stuck.
     int threads = 3; // Limited number of threads to avoid long running test.
     ParallelTestHelpers::ParallelRunner runner(threads);
     // Test reads from multiple threads, which is not supported by our HDF5
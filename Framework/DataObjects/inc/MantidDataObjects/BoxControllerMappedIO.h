@@ -0,0 +1,126 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_BOXCONTROLLERMAPPEDIO_H_
+#define MANTID_DATAOBJECTS_BOXCONTROLLERMAPPEDIO_H_
+
+#include "MantidAPI/BoxController.h"
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidKernel/DiskBuffer.h"
+
+#include <Poco/RWLock.h>
+#include <Poco/SharedMemory.h>
+
+#include <mutex>
+
+namespace Mantid {
+namespace DataObjects {
+
+//===============================================================================================
+/** Box controller IO keeping the events in a flat binary file which is mapped
+  into memory. Loading and saving a block of events is a copy from or to the
+  mapping; reading the file and caching its pages is left to the operating
+  system. This makes random access to the boxes of a file-backed workspace
+  much cheaper than through the chunked NeXus event data.
+
+  The file holds a header, the events as rows of (signal, errorSquared,
+  [runIndex, detectorId,] center) in float or double precision, in the same
+  order and positions as in the NeXus event data, followed by the free space
+  blocks of the DiskBuffer. The file is in the native byte order and is meant
+  as a scratch copy of a NeXus file, not as an exchange format.
+
+  Expected to provide thread-safe file access.
+*/
+class DLLExport BoxControllerMappedIO : public API::IBoxControllerIO {
+public:
+  BoxControllerMappedIO(API::BoxController *const bc);
+  ~BoxControllerMappedIO() override;
+
+  ///@return true if the event file is opened and false otherwise
+  bool isOpened() const override { return m_opened; }
+  /// get the full file name of the file used for IO operations
+  const std::string &getFileName() const override { return m_fileName; }
+  /// Return the number of events the file grows by, at least
+  size_t getDataChunk() const override { return DATA_CHUNK; }
+
+  bool openFile(const std::string &fileName, const std::string &mode) override;
+
+  void saveBlock(const std::vector<float> &DataBlock,
+                 const uint64_t blockPosition) const override;
+  void loadBlock(std::vector<float> &Block, const uint64_t blockPosition,
+                 const size_t nPoints) const override;
+  void saveBlock(const std::vector<double> &DataBlock,
+                 const uint64_t blockPosition) const override;
+  void loadBlock(std::vector<double> &Block, const uint64_t blockPosition,
+                 const size_t nPoints) const override;
+
+  void flushData() const override;
+  void closeFile() override;
+
+  void setDataType(const size_t blockSize,
+                   const std::string &typeName) override;
+  void getDataType(size_t &CoordSize, std::string &typeName) const override;
+
+  /// Remove the file when it is closed, e.g. for a scratch copy of the events
+  void setDeleteOnClose(const bool deleteOnClose) {
+    m_deleteOnClose = deleteOnClose;
+  }
+  /// Number of values (columns) each event is stored as
+  size_t getNDataColumns() const { return m_nColumns; }
+
+private:
+  /// Minimal number of events the file grows by
+  enum { DATA_CHUNK = 10000 };
+  /// Event kinds, in the order of m_EventsTypesSupported
+  enum EventType { LeanEvent = 0, FatEvent = 1 };
+
+  void readHeader();
+  void writeHeader(const uint64_t freeSpaceSize) const;
+  void reserve(const uint64_t nEvents) const;
+  void remap(const uint64_t nEvents) const;
+  char *eventAddress(const uint64_t position) const;
+  template <typename Type>
+  void saveGenericBlock(const std::vector<Type> &DataBlock,
+                        const uint64_t blockPosition) const;
+  template <typename Type>
+  void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition,
+                        const size_t nPoints) const;
+
+  /// full name of the event file
+  std::string m_fileName;
+  /// true if the file is opened
+  bool m_opened;
+  /// true if the file is opened only for reading
+  bool m_ReadOnly;
+  /// true if the file is removed when closed
+  bool m_deleteOnClose;
+  /// the box controller using this IO
+  API::BoxController *const m_bc;
+  /// number of bytes in the coordinates of the events used by the client
+  size_t m_CoordSize;
+  /// number of bytes in the values stored in the file
+  size_t m_fileCoordSize;
+  /// the kind of events the client reads and writes
+  EventType m_EventType;
+  /// number of values stored for each event
+  size_t m_nColumns;
+  /// the names of the event types understood by this class
+  std::vector<std::string> m_EventsTypesSupported;
+
+  /// the mapping of the file
+  mutable Poco::SharedMemory m_map;
+  /// number of events the mapped file has room for
+  mutable uint64_t m_capacity;
+  /// shared to copy events, exclusive to move the mapping
+  mutable Poco::RWLock m_mapLock;
+  /// serializes the updates of the file length
+  mutable std::mutex m_lengthMutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_BOXCONTROLLERMAPPEDIO_H_ */
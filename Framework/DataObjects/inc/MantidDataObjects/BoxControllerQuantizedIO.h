@@ -0,0 +1,158 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_BOXCONTROLLERQUANTIZEDIO_H_
+#define MANTID_DATAOBJECTS_BOXCONTROLLERQUANTIZEDIO_H_
+
+#include "MantidAPI/BoxController.h"
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidKernel/DiskBuffer.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <mutex>
+
+namespace Mantid {
+namespace DataObjects {
+
+//===============================================================================================
+/** Box controller IO keeping the events in memory in a compact, quantized
+  form instead of in a file. The boxes in the DiskBuffer cache hold their
+  events as usual; the other boxes are only expanded again when their events
+  are accessed.
+
+  Each saved block of events, i.e. the events of one box, is stored as 16 bit
+  offsets of the event coordinates within the extents of the box, so a
+  coordinate is reproduced to 1/131070 of the size of the box in its
+  dimension. The grid of a box does not depend on its events, so saving the
+  events of a box again does not move them further. Blocks saved with
+  saveBlock(), without the extents of their box, use the bounding box of
+  their events instead. The signal and error of the events are not stored at
+  all if they are all 1, which is the case for freshly converted events, and
+  kept exactly otherwise, as are the run indices and detector IDs of
+  MDEvents. For 4 dimensional MDLeanEvents this takes 8 instead of 24 bytes
+  per event.
+
+  The storage is lossy and the events are lost with the workspace: this is a
+  back end to fit workspaces in memory, not a file format. The NeXus format
+  written by SaveMD is unchanged; it holds the rounded events at full
+  precision. A block stays stored until its positions are freed, i.e. its
+  box moved or was deleted, or a block is saved over them.
+
+  Expected to provide thread-safe access.
+*/
+class DLLExport BoxControllerQuantizedIO : public API::IBoxControllerIO {
+public:
+  BoxControllerQuantizedIO(API::BoxController *const bc);
+  ~BoxControllerQuantizedIO() override;
+
+  ///@return true if the store is opened and false otherwise
+  bool isOpened() const override { return m_opened; }
+  /// get the name the store was opened with
+  const std::string &getFileName() const override { return m_fileName; }
+  /// Return the number of events the file is extended by when it is full
+  size_t getDataChunk() const override { return DATA_CHUNK; }
+
+  bool openFile(const std::string &fileName, const std::string &mode) override;
+
+  void saveBlock(const std::vector<float> &DataBlock,
+                 const uint64_t blockPosition) const override;
+  void loadBlock(std::vector<float> &Block, const uint64_t blockPosition,
+                 const size_t nPoints) const override;
+  void saveBlock(const std::vector<double> &DataBlock,
+                 const uint64_t blockPosition) const override;
+  void saveBlockInBox(const std::vector<float> &DataBlock,
+                      const uint64_t blockPosition,
+                      const std::vector<double> &boxMin,
+                      const std::vector<double> &boxMax) const override;
+  void saveBlockInBox(const std::vector<double> &DataBlock,
+                      const uint64_t blockPosition,
+                      const std::vector<double> &boxMin,
+                      const std::vector<double> &boxMax) const override;
+  void loadBlock(std::vector<double> &Block, const uint64_t blockPosition,
+                 const size_t nPoints) const override;
+
+  void freeBlock(uint64_t const pos, uint64_t const size) override;
+
+  void flushData() const override;
+  void closeFile() override;
+
+  void setDataType(const size_t blockSize,
+                   const std::string &typeName) override;
+  void getDataType(size_t &CoordSize, std::string &typeName) const override;
+
+  /// Number of values (columns) each event is saved and loaded as
+  size_t getNDataColumns() const { return m_nColumns; }
+  size_t getNumBlocks() const;
+  size_t getStoredBytes() const;
+
+private:
+  /// Nominal number of events the store is extended by
+  enum { DATA_CHUNK = 10000 };
+  /// Event kinds, in the order of m_EventsTypesSupported
+  enum EventType { LeanEvent = 0, FatEvent = 1 };
+
+  /// The events of one saved block
+  struct QuantizedBlock {
+    /// number of events in the block
+    size_t nEvents;
+    /// signal and error squared of each event; empty if they are all 1
+    std::vector<float> weights;
+    /// run index of each event, for MDEvents only
+    std::vector<uint16_t> runIndex;
+    /// detector ID of each event, for MDEvents only
+    std::vector<int32_t> detectorId;
+    /// lower edge of the quantization grid in each dimension
+    std::vector<double> origin;
+    /// size of a quantization step in each dimension
+    std::vector<double> step;
+    /// quantized coordinates, nd per event
+    std::vector<uint16_t> offsets;
+  };
+  using QuantizedBlock_sptr = boost::shared_ptr<const QuantizedBlock>;
+
+  template <typename Type>
+  QuantizedBlock_sptr encode(const std::vector<Type> &DataBlock,
+                             const std::vector<double> &boxMin,
+                             const std::vector<double> &boxMax) const;
+  template <typename Type>
+  void decode(const QuantizedBlock &block, const size_t first,
+              const size_t nPoints, Type *out) const;
+  template <typename Type>
+  void saveGenericBlock(const std::vector<Type> &DataBlock,
+                        const uint64_t blockPosition,
+                        const std::vector<double> &boxMin,
+                        const std::vector<double> &boxMax) const;
+  template <typename Type>
+  void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition,
+                        const size_t nPoints) const;
+
+  /// the name the store was opened with
+  std::string m_fileName;
+  /// true if the store is opened
+  bool m_opened;
+  /// the box controller using this IO
+  API::BoxController *const m_bc;
+  /// number of bytes in the coordinates of the events used by the client
+  size_t m_CoordSize;
+  /// the kind of events the client reads and writes
+  EventType m_EventType;
+  /// number of values saved and loaded for each event
+  size_t m_nColumns;
+  /// the names of the event types understood by this class
+  std::vector<std::string> m_EventsTypesSupported;
+
+  /// the stored blocks, by their first position
+  mutable std::map<uint64_t, QuantizedBlock_sptr> m_blocks;
+  /// protects m_blocks and the length of the store
+  mutable std::mutex m_blocksMutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_BOXCONTROLLERQUANTIZEDIO_H_ */
@@ -0,0 +1,200 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_COMPRESSEDEVENTS_H_
+#define MANTID_DATAOBJECTS_COMPRESSEDEVENTS_H_
+
+#include "MantidDataObjects/Events.h"
+#include "MantidKernel/System.h"
+#include "MantidTypes/Event/TofEvent.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Compact storage for the events of an EventList, sorted by time-of-flight.
+
+    - Time-of-flight is quantized to a fixed resolution and stored as the
+      number of quanta from the previous event, in a variable length (LEB128)
+      encoding. Sorted events mostly take one byte each.
+    - Pulse times are stored as a 32 bit index into a table of pulse times,
+      which is meant to be shared by all the lists of a workspace.
+    - Weights are stored as 16 bit floats if they all fit exactly, as for
+      counts. If every squared error equals the weight (Poisson statistics)
+      or the weight squared, the errors are not stored at all.
+
+    Only the time-of-flight is lossy: it is decoded to within half the
+    resolution of the original value. Weights, errors and pulse times are
+    decoded exactly.
+*/
+class DLLExport CompressedEvents {
+public:
+  /// Sorted, unique pulse times in nanoseconds
+  using PulseTimes = std::shared_ptr<const std::vector<int64_t>>;
+
+  static PulseTimes makePulseTimes(std::vector<int64_t> pulseTimes);
+
+  void encode(const std::vector<Types::Event::TofEvent> &events,
+              const double tofResolution, PulseTimes pulseTimes = nullptr);
+  void encode(const std::vector<WeightedEvent> &events,
+              const double tofResolution, PulseTimes pulseTimes = nullptr);
+  void encode(const std::vector<WeightedEventNoTime> &events,
+              const double tofResolution);
+
+  void decode(std::vector<Types::Event::TofEvent> &events) const;
+  void decode(std::vector<WeightedEvent> &events) const;
+  void decode(std::vector<WeightedEventNoTime> &events) const;
+
+  /// Number of events held
+  std::size_t size() const { return m_size; }
+  /// True if there are no events
+  bool empty() const { return m_size == 0; }
+  void clear();
+  std::size_t getMemorySize() const;
+
+  /// Quantum of the stored times-of-flight
+  double tofResolution() const { return m_tofResolution; }
+  /// Smallest (decoded) time-of-flight
+  double tofMin() const { return m_tofMin; }
+  /// Largest (decoded) time-of-flight
+  double tofMax() const { return m_tofMax; }
+  void scaleTof(const double factor, const double offset);
+
+  /** Reads the times-of-flight in order, one call to next() per event.
+   */
+  class TofCursor {
+  public:
+    explicit TofCursor(const CompressedEvents &events)
+        : m_step(events.m_tofSteps.data()), m_quanta(0),
+          m_tofMin(events.m_tofMin), m_tofResolution(events.m_tofResolution) {
+    }
+    /// Decode the time-of-flight of the next event
+    double next() {
+      uint64_t step = 0;
+      unsigned shift = 0;
+      uint8_t byte;
+      do {
+        byte = *m_step++;
+        step |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+      } while (byte & 0x80);
+      m_quanta += step;
+      return m_tofMin + static_cast<double>(m_quanta) * m_tofResolution;
+    }
+
+  private:
+    const uint8_t *m_step;
+    uint64_t m_quanta;
+    const double m_tofMin;
+    const double m_tofResolution;
+  };
+  /// Cursor over the times-of-flight, starting at the first event
+  TofCursor tofs() const { return TofCursor(*this); }
+
+  /// Weight of event i, 1 for unweighted events
+  float weight(const std::size_t i) const {
+    switch (m_weightEncoding) {
+    case WeightEncoding::Half:
+      return halfToFloat(m_halfWeights[i]);
+    case WeightEncoding::Float:
+      return m_weights[i];
+    default:
+      return 1.0f;
+    }
+  }
+  /// Squared error of the weight of event i, 1 for unweighted events
+  float errorSquared(const std::size_t i) const {
+    switch (m_errorEncoding) {
+    case ErrorEncoding::Poisson:
+      return weight(i);
+    case ErrorEncoding::Proportional: {
+      const float w = weight(i);
+      return w * w;
+    }
+    case ErrorEncoding::Explicit:
+      return m_errorSquared[i];
+    default:
+      return 1.0f;
+    }
+  }
+  /// Pulse time of event i
+  Types::Core::DateAndTime pulseTime(const std::size_t i) const {
+    return Types::Core::DateAndTime(
+        static_cast<int64_t>((*m_pulseTimes)[m_pulseIndices[i]]));
+  }
+
+  /** Convert an IEEE 754 half precision float to single precision.
+   * @param half :: the bits of the half precision value
+   * @return the same value as a float
+   */
+  static float halfToFloat(const uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1fu;
+    uint32_t mantissa = half & 0x3ffu;
+    uint32_t bits;
+    if (exponent == 0x1fu) {
+      // Infinity or NaN
+      bits = sign | 0x7f800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+      bits = sign;
+    } else {
+      // Subnormal half, normal float
+      exponent = 113;
+      while (!(mantissa & 0x400u)) {
+        mantissa <<= 1;
+        --exponent;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+private:
+  enum class WeightEncoding { None, Half, Float };
+  enum class ErrorEncoding { None, Poisson, Proportional, Explicit };
+
+  template <class T>
+  void encodeTofs(const std::vector<T> &events, const double tofResolution);
+  template <class T> void encodeWeights(const std::vector<T> &events);
+  template <class T>
+  void encodePulseTimes(const std::vector<T> &events, PulseTimes pulseTimes);
+
+  /// Number of events
+  std::size_t m_size{0};
+  /// Decoded time-of-flight of the first event
+  double m_tofMin{0.0};
+  /// Decoded time-of-flight of the last event
+  double m_tofMax{0.0};
+  /// Quantum of the time-of-flight
+  double m_tofResolution{1.0};
+  /// LEB128 encoded number of quanta from the previous event
+  std::vector<uint8_t> m_tofSteps;
+  /// Table the pulse indices refer to
+  PulseTimes m_pulseTimes;
+  /// Index into m_pulseTimes of the pulse time of each event
+  std::vector<uint32_t> m_pulseIndices;
+  WeightEncoding m_weightEncoding{WeightEncoding::None};
+  ErrorEncoding m_errorEncoding{ErrorEncoding::None};
+  /// Weights, if stored as half precision floats
+  std::vector<uint16_t> m_halfWeights;
+  /// Weights, if not
+  std::vector<float> m_weights;
+  /// Squared errors, if they do not follow from the weights
+  std::vector<float> m_errorSquared;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_COMPRESSEDEVENTS_H_ */
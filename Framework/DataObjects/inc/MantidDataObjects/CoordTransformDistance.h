@@ -47,6 +47,8 @@ public:
   std::string id() const override;
 
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyBatch(const coord_t *inputVectors, const size_t inputStride,
+                  coord_t *outVectors, const size_t nVectors) const override;
 
   /// Return the center coordinate array
   const coord_t *getCenter() { return m_center; }
@@ -0,0 +1,133 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+
+#include "MantidKernel/System.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Structure-of-arrays storage for the events of an EventList.
+
+    Each field of the events lives in its own contiguous column, so that
+    operations that only need the time-of-flight (histogramming, unit
+    conversion) stream 8 bytes per event instead of the full event struct.
+    Columns that do not apply to the event type are left empty:
+      - TOF: tof and pulseTime
+      - WEIGHTED: all four columns
+      - WEIGHTED_NOTIME: tof, weight and errorSquared
+*/
+struct DLLExport EventColumns {
+  /// Time-of-flight (or converted x value) of each event
+  std::vector<double> tof;
+  /// Pulse time of each event, in nanoseconds since the Mantid epoch
+  std::vector<int64_t> pulseTime;
+  /// Weight of each event
+  std::vector<float> weight;
+  /// Squared error of the weight of each event
+  std::vector<float> errorSquared;
+
+  /// Number of events held in the columns
+  std::size_t size() const { return tof.size(); }
+
+  /// True if there are no events in the columns
+  bool empty() const { return tof.empty(); }
+
+  /// Release all the memory held by the columns
+  void clear() {
+    std::vector<double>().swap(tof);
+    std::vector<int64_t>().swap(pulseTime);
+    std::vector<float>().swap(weight);
+    std::vector<float>().swap(errorSquared);
+  }
+
+  /// Memory used by the columns, in bytes (capacity, not size)
+  std::size_t getMemorySize() const {
+    return tof.capacity() * sizeof(double) +
+           pulseTime.capacity() * sizeof(int64_t) +
+           (weight.capacity() + errorSquared.capacity()) * sizeof(float);
+  }
+
+  /// Reverse the order of the events in every column
+  void reverse() {
+    std::reverse(tof.begin(), tof.end());
+    std::reverse(pulseTime.begin(), pulseTime.end());
+    std::reverse(weight.begin(), weight.end());
+    std::reverse(errorSquared.begin(), errorSquared.end());
+  }
+
+  /** Reorder every column so that event i becomes the event previously at
+   * position order[i]. The events are moved in place, one cycle of the
+   * permutation at a time, so no copy of the columns is made.
+   * @param order :: permutation of [0, size()). It is used up: every entry is
+   * set to its own index on return.
+   */
+  void permute(std::vector<std::size_t> &order) {
+    for (std::size_t start = 0; start < order.size(); ++start) {
+      if (order[start] == start)
+        continue;
+      // Move every event of the cycle one step, keeping the first one aside
+      const Row first = row(start);
+      std::size_t current = start;
+      while (order[current] != start) {
+        const std::size_t next = order[current];
+        moveRow(next, current);
+        order[current] = current;
+        current = next;
+      }
+      setRow(current, first);
+      order[current] = current;
+    }
+  }
+
+private:
+  /// The fields of one event
+  struct Row {
+    double tof;
+    int64_t pulseTime;
+    float weight;
+    float errorSquared;
+  };
+
+  /// @return the fields of event i, zero for the empty columns
+  Row row(const std::size_t i) const {
+    return {tof[i], pulseTime.empty() ? 0 : pulseTime[i],
+            weight.empty() ? 0.f : weight[i],
+            errorSquared.empty() ? 0.f : errorSquared[i]};
+  }
+
+  /// Set the fields of event i, skipping the empty columns
+  void setRow(const std::size_t i, const Row &values) {
+    tof[i] = values.tof;
+    if (!pulseTime.empty())
+      pulseTime[i] = values.pulseTime;
+    if (!weight.empty()) {
+      weight[i] = values.weight;
+      errorSquared[i] = values.errorSquared;
+    }
+  }
+
+  /// Copy event from to position to in every column
+  void moveRow(const std::size_t from, const std::size_t to) {
+    tof[to] = tof[from];
+    if (!pulseTime.empty())
+      pulseTime[to] = pulseTime[from];
+    if (!weight.empty()) {
+      weight[to] = weight[from];
+      errorSquared[to] = errorSquared[from];
+    }
+  }
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNS_H_ */
@@ -8,10 +8,13 @@
 #define MANTID_DATAOBJECTS_EVENTLIST_H_ 1
 
 #include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/CompressedEvents.h"
+#include "MantidDataObjects/EventColumns.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
+#include <atomic>
 #include <iosfwd>
 #include <vector>
 
@@ -22,6 +25,7 @@ class DateAndTime;
 }
 } // namespace Types
 namespace Kernel {
+class RegularBinFinder;
 class SplittingInterval;
 using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
@@ -39,6 +43,16 @@ enum EventSortType {
   TIMEATSAMPLE_SORT
 };
 
+/// How the events of an event list are laid out in memory.
+enum EventStorageLayout {
+  /// One vector of event structs (TofEvent, WeightedEvent, ...)
+  ARRAY_OF_STRUCTS,
+  /// One contiguous column per event field (see EventColumns)
+  STRUCT_OF_ARRAYS,
+  /// Quantized and packed events, sorted by TOF (see CompressedEvents)
+  COMPRESSED
+};
+
 //==========================================================================================
 /** @class Mantid::DataObjects::EventList
 
@@ -105,6 +119,7 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
+    this->switchToArrayOfStructs();
     this->events.push_back(event);
     this->order = UNSORTED;
   }
@@ -115,6 +130,7 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    this->switchToArrayOfStructs();
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
@@ -125,6 +141,7 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    this->switchToArrayOfStructs();
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
@@ -133,6 +150,14 @@ public:
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  void setStorageLayout(const EventStorageLayout layout);
+
+  EventStorageLayout getStorageLayout() const;
+
+  void setCompressedStorage(
+      const double tofResolution,
+      const CompressedEvents::PulseTimes &pulseTimes = nullptr);
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<Types::Event::TofEvent> &getEvents();
@@ -146,6 +171,7 @@ public:
 
   void clear(const bool removeDetIDs = true) override;
   void clearUnused();
+  void reallocateEvents();
 
   void setMRU(EventWorkspaceMRU *newMRU);
 
@@ -274,6 +300,8 @@ public:
 
   std::vector<Mantid::Types::Core::DateAndTime> getPulseTimes() const override;
 
+  void getDistinctPulseTimes(std::vector<int64_t> &pulseTimes) const;
+
   void setTofs(const MantidVec &tofs) override;
 
   void reverse();
@@ -376,9 +404,26 @@ private:
   /// List of WeightedEvent's
   mutable std::vector<WeightedEventNoTime> weightedEventsNoTime;
 
+  /// Columns holding the events when in the STRUCT_OF_ARRAYS layout
+  mutable EventColumns m_columns;
+
   /// What type of event is in our list.
   Mantid::API::EventType eventType;
 
+  /// Events when in the COMPRESSED layout
+  mutable CompressedEvents m_compressed;
+
+  /// Whether the events live in the event vectors, m_columns or m_compressed.
+  /// Const callers may only change it from STRUCT_OF_ARRAYS or COMPRESSED to
+  /// ARRAY_OF_STRUCTS, with the sort mutex held, after filling the event
+  /// vectors. They leave m_columns and m_compressed unchanged, so a concurrent
+  /// reader that saw the previous layout can keep reading them.
+  mutable std::atomic<EventStorageLayout> m_layout{ARRAY_OF_STRUCTS};
+
+  /// True if a const operation left m_columns or m_compressed behind after
+  /// copying the events to the event vectors
+  mutable bool m_hasUnusedStorage = false;
+
   /// Last sorting order
   mutable EventSortType order;
 
@@ -399,6 +444,10 @@ private:
                              const double seek_time, const double &tofFactor,
                              const double &tofOffset) const;
 
+  void generateHistogramRegular(const Kernel::RegularBinFinder &binFinder,
+                                const size_t numBins, MantidVec &Y,
+                                MantidVec &E, bool skipError) const;
+
   void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
 
   void generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &Y) const;
@@ -411,6 +460,42 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+
+  /// Copy the events to the event vectors, if they are in columns or
+  /// compressed. Safe to call from several threads at once.
+  void switchToArrayOfStructs() const {
+    const EventStorageLayout layout = m_layout.load(std::memory_order_acquire);
+    if (layout == STRUCT_OF_ARRAYS)
+      unpackColumns();
+    else if (layout == COMPRESSED)
+      unpackCompressed();
+  }
+  /// Move the events to the event vectors, if they are in columns or
+  /// compressed, and free the columns or compressed events.
+  void switchToArrayOfStructs() {
+    static_cast<const EventList *>(this)->switchToArrayOfStructs();
+    if (m_hasUnusedStorage)
+      releaseUnusedStorage();
+  }
+  /// Decode the events back to the event vectors, if they are compressed.
+  void switchFromCompressed() {
+    if (m_layout.load(std::memory_order_acquire) == COMPRESSED)
+      unpackCompressed();
+    if (m_hasUnusedStorage)
+      releaseUnusedStorage();
+  }
+  void packColumns();
+  void unpackColumns() const;
+  void unpackCompressed() const;
+  void releaseUnusedStorage();
+  void sortColumnsByTof() const;
+  void generateHistogramFromColumns(const MantidVec &X, MantidVec &Y,
+                                    MantidVec &E, bool skipError) const;
+  void generateHistogramFromCompressed(const MantidVec &X, MantidVec &Y,
+                                       MantidVec &E, bool skipError) const;
+  void integrateColumns(const double minX, const double maxX,
+                        const bool entireRange, double &sum,
+                        double &error) const;
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                              const double seconds) const;
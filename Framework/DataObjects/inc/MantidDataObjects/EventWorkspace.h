@@ -132,6 +132,15 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Change the memory layout of the events in all event lists
+  void setStorageLayout(const EventStorageLayout layout);
+
+  // Compress the events of all event lists in memory
+  void setCompressedStorage(const double tofResolution);
+
+  // Move the events of each spectrum to memory local to the thread using it
+  void applyNumaPlacement();
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
@@ -14,6 +14,9 @@
 #include "MantidDataObjects/RebinnedOutput.h"
 #include "MantidGeometry/Math/Quadrilateral.h"
 
+#include <utility>
+#include <vector>
+
 namespace Mantid {
 //------------------------------------------------------------------------------
 // Forward declarations
@@ -64,6 +67,64 @@ MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(
     const std::vector<double> &verticalAxis,
     const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr);
 
+/**
+  The overlaps of the bins of an input workspace with the bins of an output
+  grid, grouped by output spectrum. They depend only on the binning and the
+  geometry, so they can be kept and used to rebin several workspaces, and
+  each output spectrum can be filled by a different thread.
+*/
+struct MANTID_DATAOBJECTS_DLL OverlapWeights {
+  /// The overlap of an input bin with a bin of an output spectrum
+  struct Overlap {
+    /// workspace index of the input bin
+    size_t inputIndex;
+    /// index of the input bin in its spectrum
+    size_t inputBin;
+    /// index of the output bin in its spectrum
+    size_t outputBin;
+    /// area of the overlap divided by the area of the input bin
+    double weight;
+    /// width of the overlap along the X axis, if it was calculated
+    double width;
+  };
+  /// Position in overlaps of the first overlap of each output spectrum,
+  /// followed by the total number of overlaps
+  std::vector<size_t> offsets;
+  /// The overlaps, grouped by output spectrum
+  std::vector<Overlap> overlaps;
+};
+
+/// An overlap and the workspace index of the output spectrum it is in
+using IndexedOverlap = std::pair<size_t, OverlapWeights::Overlap>;
+
+/// Find the overlaps of an input quadrilateral with the output grid
+MANTID_DATAOBJECTS_DLL void
+calculateOverlaps(const Geometry::Quadrilateral &inputQ, const size_t i,
+                  const size_t j, const std::vector<double> &xAxis,
+                  const std::vector<double> &verticalAxis,
+                  const bool calculateWidths,
+                  std::vector<IndexedOverlap> &overlaps);
+
+/// Group the overlaps of the input bins by output spectrum
+MANTID_DATAOBJECTS_DLL OverlapWeights
+groupOverlaps(const std::vector<std::vector<IndexedOverlap>> &overlaps,
+              const size_t nOutputSpectra);
+
+/// Rebin a workspace to the output grid with precalculated overlaps
+MANTID_DATAOBJECTS_DLL void rebinToOutput(
+    const OverlapWeights &weights, const API::MatrixWorkspace &inputWS,
+    API::MatrixWorkspace &outputWS,
+    boost::shared_ptr<API::Progress> progress =
+        boost::shared_ptr<API::Progress>());
+
+/// Rebin a workspace to the output grid with precalculated overlaps
+MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(
+    const OverlapWeights &weights, const API::MatrixWorkspace &inputWS,
+    DataObjects::RebinnedOutput &outputWS,
+    const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr,
+    boost::shared_ptr<API::Progress> progress =
+        boost::shared_ptr<API::Progress>());
+
 } // namespace FractionalRebinning
 
 } // namespace DataObjects
@@ -565,26 +565,31 @@ TMDE(void MDBox)::integrateSphere(Mantid::API::CoordTransform &radiusTransform,
                                   const bool useOnePercentBackgroundCorrection) const {
   // If the box is cached to disk, you need to retrieve it
   const std::vector<MDE> &events = this->getConstEvents();
+  // The transformed coordinates of all the events, in one pass
+  const size_t outD = radiusTransform.getOutD();
+  std::vector<coord_t> out(events.size() * outD);
+  if (!events.empty())
+    radiusTransform.applyBatch(events.front().getCenter(),
+                               MDE::getCenterStride(), out.data(),
+                               events.size());
   if (innerRadiusSquared == 0.0) {
     // For each MDLeanEvent
-    for (const auto &it : events) {
-      coord_t out[nd];
-      radiusTransform.apply(it.getCenter(), out);
-      if (out[0] < radiusSquared) {
-        signal += static_cast<signal_t>(it.getSignal());
-        errorSquared += static_cast<signal_t>(it.getErrorSquared());
+    for (size_t i = 0; i < events.size(); ++i) {
+      if (out[i * outD] < radiusSquared) {
+        signal += static_cast<signal_t>(events[i].getSignal());
+        errorSquared += static_cast<signal_t>(events[i].getErrorSquared());
       }
     }
   } else {
     // For each MDLeanEvent
     using valAndErrorPair = std::pair<signal_t, signal_t>;
     std::vector<valAndErrorPair> vals;
-    for (const auto &it : events) {
-      coord_t out[nd];
-      radiusTransform.apply(it.getCenter(), out);
-      if (out[0] < radiusSquared && out[0] > innerRadiusSquared) {
-        const auto signal = static_cast<signal_t>(it.getSignal());
-        const auto errSquared = static_cast<signal_t>(it.getErrorSquared());
+    for (size_t i = 0; i < events.size(); ++i) {
+      const coord_t radius = out[i * outD];
+      if (radius < radiusSquared && radius > innerRadiusSquared) {
+        const auto signal = static_cast<signal_t>(events[i].getSignal());
+        const auto errSquared =
+            static_cast<signal_t>(events[i].getErrorSquared());
         vals.emplace_back(std::make_pair(signal, errSquared));
       }
     }
@@ -679,12 +684,18 @@ TMDE(void MDBox)::centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                                  signal_t &signal) const {
   // If the box is cached to disk, you need to retrieve it
   const std::vector<MDE> &events = this->getConstEvents();
+  // The transformed coordinates of all the events, in one pass
+  const size_t outD = radiusTransform.getOutD();
+  std::vector<coord_t> out(events.size() * outD);
+  if (!events.empty())
+    radiusTransform.applyBatch(events.front().getCenter(),
+                               MDE::getCenterStride(), out.data(),
+                               events.size());
 
   // For each MDLeanEvent
-  for (const auto &evnt : events) {
-    coord_t out[nd];
-    radiusTransform.apply(evnt.getCenter(), out);
-    if (out[0] < radiusSquared) {
+  for (size_t i = 0; i < events.size(); ++i) {
+    const MDE &evnt = events[i];
+    if (out[i * outD] < radiusSquared) {
       coord_t eventSignal = static_cast<coord_t>(evnt.getSignal());
       signal += eventSignal;
       for (size_t d = 0; d < nd; d++)
@@ -876,7 +887,12 @@ TMDE(void MDBox)::saveAt(API::IBoxControllerIO *const FileSaver,
   this->calculateCentroid(this->m_centroid);
 #endif
 
-  FileSaver->saveBlock(TabledData, position);
+  std::vector<double> boxMin(nd), boxMax(nd);
+  for (size_t d = 0; d < nd; ++d) {
+    boxMin[d] = this->extents[d].getMin();
+    boxMax[d] = this->extents[d].getMax();
+  }
+  FileSaver->saveBlockInBox(TabledData, position, boxMin, boxMax);
 }
 
 /**
@@ -0,0 +1,46 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDBOXEVENTINDEXNEXUSREADER_H_
+#define MANTID_DATAOBJECTS_MDBOXEVENTINDEXNEXUSREADER_H_
+
+#include "MantidDataObjects/MDBoxEventIndexReader.h"
+
+#include <memory>
+#include <string>
+
+namespace NeXus {
+class File;
+}
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDBoxEventIndexNeXusReader : Reads the box_event_index data set of an MD
+  event file written by SaveMD, keeping the file open between the reads.
+*/
+class DLLExport MDBoxEventIndexNeXusReader : public MDBoxEventIndexReader {
+public:
+  MDBoxEventIndexNeXusReader(const std::string &fileName);
+  ~MDBoxEventIndexNeXusReader() override;
+
+  size_t getNBoxes() const override { return m_nBoxes; }
+  void read(const size_t firstBox, const size_t nBoxes,
+            std::vector<uint64_t> &index) override;
+
+private:
+  /// The name of the file
+  std::string m_fileName;
+  /// The file, with the event index data set open
+  std::unique_ptr<::NeXus::File> m_file;
+  /// The number of boxes in the index
+  size_t m_nBoxes;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDBOXEVENTINDEXNEXUSREADER_H_ */
@@ -0,0 +1,41 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDBOXEVENTINDEXREADER_H_
+#define MANTID_DATAOBJECTS_MDBOXEVENTINDEXREADER_H_
+
+#include "MantidKernel/System.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDBoxEventIndexReader : Interface to read the location of the events of
+  the boxes of an MD event file, a range of boxes at a time, so that the
+  index of the whole file does not have to be held in memory.
+*/
+class DLLExport MDBoxEventIndexReader {
+public:
+  virtual ~MDBoxEventIndexReader() = default;
+
+  /// @return the number of boxes in the index
+  virtual size_t getNBoxes() const = 0;
+  /** Read the position and number of events of consecutive boxes
+   * @param firstBox :: The ID of the first box to read
+   * @param nBoxes :: The number of boxes to read
+   * @param index :: Set to the position and number of events of each box, as
+   * stored by MDBoxFlatTree
+   */
+  virtual void read(const size_t firstBox, const size_t nBoxes,
+                    std::vector<uint64_t> &index) = 0;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDBOXEVENTINDEXREADER_H_ */
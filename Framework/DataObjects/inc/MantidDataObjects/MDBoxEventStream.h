@@ -0,0 +1,74 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDBOXEVENTSTREAM_H_
+#define MANTID_DATAOBJECTS_MDBOXEVENTSTREAM_H_
+
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidDataObjects/MDBoxEventIndexReader.h"
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/System.h"
+
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDBoxEventStream : Reads the events of the boxes of one MD event file.
+
+  The location of the events of the boxes is read from the event index of the
+  file a window of boxes at a time, and the events are read through a
+  read-ahead buffer, both of bounded size. When the boxes are requested in the
+  order of their IDs, which is the order in which SaveMD writes their events,
+  the index and the events are read forwards, so the memory used does not
+  grow with the number of boxes of the workspace.
+
+  Used by MergeMDFiles to merge many files in a single pass over the boxes.
+*/
+class DLLExport MDBoxEventStream {
+public:
+  MDBoxEventStream(std::unique_ptr<API::IBoxControllerIO> loader,
+                   std::unique_ptr<MDBoxEventIndexReader> eventIndex,
+                   const size_t nColumns, const size_t bufferSize,
+                   const size_t indexWindowSize);
+
+  uint64_t getNEvents(const size_t boxID);
+  uint64_t appendEvents(const size_t boxID, std::vector<coord_t> &table);
+
+  /// @return the number of boxes in the file
+  size_t getNBoxes() const { return m_nBoxes; }
+
+private:
+  void moveIndexWindow(const size_t boxID);
+
+  /// The file with the events
+  std::unique_ptr<API::IBoxControllerIO> m_loader;
+  /// The event index of the file
+  std::unique_ptr<MDBoxEventIndexReader> m_eventIndex;
+  /// The number of boxes in the file
+  size_t m_nBoxes;
+  /// The maximum number of boxes in the index window
+  size_t m_indexWindowSize;
+  /// The position and number of events of the boxes in the index window
+  std::vector<uint64_t> m_indexWindow;
+  /// The ID of the first box in the index window
+  size_t m_indexWindowStart;
+  /// The number of values per event
+  size_t m_nColumns;
+  /// The maximum number of events in the read-ahead buffer
+  size_t m_bufferSize;
+  /// The events read ahead
+  std::vector<coord_t> m_buffer;
+  /// The position in the file of the first and one past the last event in the
+  /// buffer
+  uint64_t m_bufferStart, m_bufferEnd;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDBOXEVENTSTREAM_H_ */
@@ -181,6 +181,15 @@ public:
    * @param id :: new runIndex value. */
   void setDetectorId(int32_t id) { detectorId = id; }
 
+  //---------------------------------------------------------------------------------------------
+  /** @return the number of coordinates from the center of an event to the
+   * center of the next one in a vector of events. */
+  static constexpr size_t getCenterStride() {
+    static_assert(sizeof(MDEvent<nd>) % sizeof(coord_t) == 0,
+                  "Events must be a whole number of coordinates long");
+    return sizeof(MDEvent<nd>) / sizeof(coord_t);
+  }
+
   //---------------------------------------------------------------------------------------------
   /** @returns a string identifying the type of event this is. */
   static std::string getTypeName() { return "MDEvent"; }
@@ -18,6 +18,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDGridBox.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidDataObjects/MDIntegrationRegion.h"
 #include "MantidDataObjects/MDLeanEvent.h"
 
 namespace Mantid {
@@ -169,9 +170,24 @@ public:
 
   size_t addEvents(const std::vector<MDE> &events);
 
+  void addEventsAndSplit(std::vector<MDE> &events,
+                         Kernel::ThreadScheduler *ts = nullptr);
+
   std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>>
   getMinimumExtents(size_t depth = 2) const override;
 
+  /// Integrate the signal in many regions, traversing the box tree once
+  void integrateRegions(const std::vector<MDIntegrationRegion> &regions,
+                        std::vector<signal_t> &signal,
+                        std::vector<signal_t> &errorSquared,
+                        const bool useOnePercentBackgroundCorrection =
+                            true) const;
+
+  /// Find the centroids of the events in many regions
+  void centroidRegions(const std::vector<MDIntegrationRegion> &regions,
+                       std::vector<coord_t> &centroids,
+                       std::vector<signal_t> &signal) const;
+
   /// Return true if the underlying box is a MDGridBox.
   bool isGridBox() {
     return dynamic_cast<MDGridBox<MDE, nd> *>(data) != nullptr;
@@ -245,6 +261,20 @@ protected:
   Mantid::API::MDNormalization m_displayNormalizationHisto;
 
 private:
+  template <typename ContainedFunction, typename LeafFunction>
+  void queryRegions(const std::vector<MDIntegrationRegion> &regions,
+                    const bool useContainedBoxes,
+                    ContainedFunction containedFunction,
+                    LeafFunction leafFunction) const;
+
+  template <typename ContainedFunction, typename LeafFunction>
+  void queryRegionsInBox(API::IMDNode *box,
+                         const std::vector<MDIntegrationRegion> &regions,
+                         const std::vector<size_t> &candidates,
+                         const bool useContainedBoxes,
+                         ContainedFunction &containedFunction,
+                         LeafFunction &leafFunction) const;
+
   MDEventWorkspace *doClone() const override {
     return new MDEventWorkspace(*this);
   }
@@ -28,9 +28,11 @@
 #include <iostream>
 #include <functional>
 #include <algorithm>
+#include <numeric>
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 
 // Test for gcc 4.4
 #if __GNUC__ > 4 ||                                                            \
@@ -596,6 +598,25 @@ TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) {
   return data->addEvents(events);
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a vector of MDEvents to the workspace and split the boxes that get
+ * too many events in the same pass (see MDGridBox::addAndSplitEvents). The
+ * top level box is split first if it is not a MDGridBox yet.
+ *
+ * Call refreshCache() once all the events have been added.
+ *
+ * @param events :: the events to add; they are reordered, then copied into
+ *        the MDBox'es contained within.
+ * @param ts :: optional ThreadScheduler * that will be used to fill the boxes
+ *        in parallel. The caller must wait for its tasks to finish.
+ */
+TMDE(void MDEventWorkspace)::addEventsAndSplit(std::vector<MDE> &events,
+                                               Kernel::ThreadScheduler *ts) {
+  this->splitBox();
+  auto *gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(data);
+  gridBox->addAndSplitEvents(events.begin(), events.end(), ts);
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Split the contained MDBox into a MDGridBox or MDSplitBox, if it is not
  * that already.
@@ -1022,6 +1043,229 @@ TMDE(API::MDNormalization MDEventWorkspace)::displayNormalization() const {
   return m_displayNormalization;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal in many spheres, ellipsoids or shells at once, for
+ * example to integrate all the peaks of a single-crystal run.
+ *
+ * Calling integrateSphere on the root box walks the box tree from the top for
+ * every region. Here the tree is traversed once for a batch of nearby regions,
+ * each box being tested only against the regions that overlap its parent.
+ * Boxes entirely inside a region contribute their total signal, and the events
+ * of a partially covered leaf box are loaded once for all the regions that
+ * overlap it. The batches are processed in parallel unless the workspace is
+ * file backed.
+ *
+ * @param regions :: The regions to integrate, in the dimensions of the
+ *workspace
+ * @param[out] signal :: Set to the integrated signal of each region
+ * @param[out] errorSquared :: Set to the integrated squared error of each
+ *region
+ * @param useOnePercentBackgroundCorrection :: If true, the highest 1% of the
+ *events of each partially covered box are left out of the shells, as in
+ *integrateSphere
+ * @throw std::invalid_argument if a region does not have nd dimensions
+ */
+TMDE(void MDEventWorkspace)::integrateRegions(
+    const std::vector<MDIntegrationRegion> &regions,
+    std::vector<signal_t> &signal, std::vector<signal_t> &errorSquared,
+    const bool useOnePercentBackgroundCorrection) const {
+  signal.assign(regions.size(), 0.0);
+  errorSquared.assign(regions.size(), 0.0);
+
+  auto addBox = [&signal, &errorSquared](const size_t index,
+                                         API::IMDNode *box) {
+    signal[index] += box->getSignal();
+    errorSquared[index] += box->getErrorSquared();
+  };
+
+  auto addEvents = [&](const std::vector<size_t> &indices,
+                       MDBox<MDE, nd> &box) {
+    const std::vector<MDE> &events = box.getConstEvents();
+    using valAndErrorPair = std::pair<signal_t, signal_t>;
+    std::vector<valAndErrorPair> vals;
+    for (const size_t index : indices) {
+      const MDIntegrationRegion &region = regions[index];
+      if (region.isShell() && useOnePercentBackgroundCorrection) {
+        vals.clear();
+        for (const auto &event : events) {
+          if (region.contains(event.getCenter()))
+            vals.emplace_back(static_cast<signal_t>(event.getSignal()),
+                              static_cast<signal_t>(event.getErrorSquared()));
+        }
+        // Remove top 1% of background
+        std::sort(vals.begin(), vals.end(),
+                  [](const valAndErrorPair &a, const valAndErrorPair &b) {
+                    return a.first < b.first;
+                  });
+        const auto endIndex =
+            static_cast<size_t>(0.99 * static_cast<double>(vals.size()));
+        for (size_t k = 0; k < endIndex; ++k) {
+          signal[index] += vals[k].first;
+          errorSquared[index] += vals[k].second;
+        }
+      } else {
+        for (const auto &event : events) {
+          if (region.contains(event.getCenter())) {
+            signal[index] += static_cast<signal_t>(event.getSignal());
+            errorSquared[index] +=
+                static_cast<signal_t>(event.getErrorSquared());
+          }
+        }
+      }
+    }
+    box.releaseEvents();
+  };
+
+  queryRegions(regions, true, addBox, addEvents);
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Find the centroids of the events in many spheres, ellipsoids or shells at
+ * once, traversing the box tree as in integrateRegions.
+ *
+ * @param regions :: The regions to centroid, in the dimensions of the
+ *workspace
+ * @param[out] centroids :: Set to the signal-weighted mean position of the
+ *events in each region, nd coordinates per region; 0 for regions without
+ *signal
+ * @param[out] signal :: Set to the integrated signal of each region
+ * @throw std::invalid_argument if a region does not have nd dimensions
+ */
+TMDE(void MDEventWorkspace)::centroidRegions(
+    const std::vector<MDIntegrationRegion> &regions,
+    std::vector<coord_t> &centroids, std::vector<signal_t> &signal) const {
+  centroids.assign(regions.size() * nd, 0);
+  signal.assign(regions.size(), 0.0);
+
+  // The events are needed even in boxes entirely inside a region
+  auto addBox = [](const size_t, API::IMDNode *) {};
+
+  auto addEvents = [&](const std::vector<size_t> &indices,
+                       MDBox<MDE, nd> &box) {
+    const std::vector<MDE> &events = box.getConstEvents();
+    for (const size_t index : indices) {
+      const MDIntegrationRegion &region = regions[index];
+      coord_t *centroid = centroids.data() + index * nd;
+      for (const auto &event : events) {
+        if (region.contains(event.getCenter())) {
+          const auto eventSignal = static_cast<coord_t>(event.getSignal());
+          signal[index] += eventSignal;
+          for (size_t d = 0; d < nd; ++d)
+            centroid[d] += event.getCenter(d) * eventSignal;
+        }
+      }
+    }
+    box.releaseEvents();
+  };
+
+  queryRegions(regions, false, addBox, addEvents);
+
+  for (size_t index = 0; index < regions.size(); ++index) {
+    if (signal[index] != 0.0) {
+      for (size_t d = 0; d < nd; ++d)
+        centroids[index * nd + d] /= static_cast<coord_t>(signal[index]);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Run a query over many regions. The regions are sorted along the first
+ * dimension and split into batches, so that each batch covers a slab of the
+ * workspace, and the box tree is traversed once per batch. Each region
+ * belongs to one batch, so the callbacks may write the results of a region
+ * without locking.
+ *
+ * @param regions :: The regions to query
+ * @param useContainedBoxes :: If true, containedFunction is called for boxes
+ *entirely inside a region instead of descending into them
+ * @param containedFunction :: Called with the index of a region and a box
+ *entirely inside it
+ * @param leafFunction :: Called with the indices of the regions that
+ *partially overlap a leaf box, and the box
+ */
+template <typename MDE, size_t nd>
+template <typename ContainedFunction, typename LeafFunction>
+void MDEventWorkspace<MDE, nd>::queryRegions(
+    const std::vector<MDIntegrationRegion> &regions,
+    const bool useContainedBoxes, ContainedFunction containedFunction,
+    LeafFunction leafFunction) const {
+  for (const auto &region : regions) {
+    if (region.getNumDims() != nd)
+      throw std::invalid_argument("MDEventWorkspace: the integration regions "
+                                  "must have as many dimensions as the "
+                                  "workspace.");
+  }
+  if (regions.empty())
+    return;
+
+  std::vector<size_t> order(regions.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&regions](size_t a, size_t b) {
+    return regions[a].getCenter()[0] < regions[b].getCenter()[0];
+  });
+
+  const auto numBatches = static_cast<int64_t>(std::min(
+      regions.size(), static_cast<size_t>(8 * PARALLEL_GET_MAX_THREADS)));
+  PARALLEL_FOR_IF(Kernel::threadSafe(*this))
+  for (int64_t batch = 0; batch < numBatches; ++batch) {
+    const size_t begin = batch * regions.size() / numBatches;
+    const size_t end = (batch + 1) * regions.size() / numBatches;
+    const std::vector<size_t> candidates(order.begin() + begin,
+                                         order.begin() + end);
+    queryRegionsInBox(data, regions, candidates, useContainedBoxes,
+                      containedFunction, leafFunction);
+  }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Run a query over the regions that might overlap one box, and recurse into
+ * its children.
+ *
+ * @param box :: The box
+ * @param regions :: All the regions of the query
+ * @param candidates :: The indices of the regions that might overlap the box
+ * @param useContainedBoxes :: See queryRegions
+ * @param containedFunction :: See queryRegions
+ * @param leafFunction :: See queryRegions
+ */
+template <typename MDE, size_t nd>
+template <typename ContainedFunction, typename LeafFunction>
+void MDEventWorkspace<MDE, nd>::queryRegionsInBox(
+    API::IMDNode *box, const std::vector<MDIntegrationRegion> &regions,
+    const std::vector<size_t> &candidates, const bool useContainedBoxes,
+    ContainedFunction &containedFunction, LeafFunction &leafFunction) const {
+  coord_t min[nd];
+  coord_t max[nd];
+  for (size_t d = 0; d < nd; ++d) {
+    const auto &extents = box->getExtents(d);
+    min[d] = extents.getMin();
+    max[d] = extents.getMax();
+  }
+
+  std::vector<size_t> overlapping;
+  overlapping.reserve(candidates.size());
+  for (const size_t index : candidates) {
+    const MDIntegrationRegion &region = regions[index];
+    if (!region.mightOverlap(min, max))
+      continue;
+    if (useContainedBoxes && region.surrounds(min, max))
+      containedFunction(index, box);
+    else
+      overlapping.push_back(index);
+  }
+  if (overlapping.empty())
+    return;
+
+  const size_t numChildren = box->getNumChildren();
+  if (numChildren == 0) {
+    leafFunction(overlapping, *static_cast<MDBox<MDE, nd> *>(box));
+    return;
+  }
+  for (size_t i = 0; i < numChildren; ++i)
+    queryRegionsInBox(box->getChild(i), regions, overlapping,
+                      useContainedBoxes, containedFunction, leafFunction);
+}
+
 } // namespace DataObjects
 
 } // namespace Mantid
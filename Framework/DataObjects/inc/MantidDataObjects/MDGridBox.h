@@ -174,6 +174,10 @@ public:
 
   void splitAllIfNeeded(Kernel::ThreadScheduler *ts = nullptr) override;
 
+  void addAndSplitEvents(typename std::vector<MDE>::iterator begin,
+                         typename std::vector<MDE>::iterator end,
+                         Kernel::ThreadScheduler *ts = nullptr);
+
   void refreshCache(Kernel::ThreadScheduler *ts = nullptr) override;
 
   bool getIsMasked() const override;
@@ -17,6 +17,7 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
+#include <numeric>
 #include <ostream>
 #include "MantidKernel/Strings.h"
 
@@ -756,6 +757,104 @@ TMDE(void MDGridBox)::splitAllIfNeeded(Kernel::ThreadScheduler *ts) {
   }
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a batch of events to the grid box, splitting the boxes below it in the
+ * same pass.
+ *
+ * The events are reordered by the index of the child box they fall into, so
+ * that each child receives one contiguous range of events. A child MDBox
+ * that would go over the split threshold is turned into a MDGridBox before
+ * its range is pushed down to the next level. The resulting tree is the same
+ * as adding the events one by one and calling splitAllIfNeeded(), but each
+ * event is moved once per level instead of once per split.
+ *
+ * Warning! No bounds checking is done, as for addEvent(); events that fall
+ * outside of the box are dropped. The range is reordered on output.
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param begin :: iterator to the first event to add.
+ * @param end :: iterator past the last event to add.
+ * @param ts :: optional ThreadScheduler * that will be used to fill the
+ *        largest children in parallel. Set to NULL to do it serially.
+ */
+TMDE(void MDGridBox)::addAndSplitEvents(
+    typename std::vector<MDE>::iterator begin,
+    typename std::vector<MDE>::iterator end, Kernel::ThreadScheduler *ts) {
+  const auto numEvents = static_cast<size_t>(std::distance(begin, end));
+  // Events of child i end up in [childStart[i], childStart[i + 1]). The
+  // extra bucket numBoxes collects the events outside of the box.
+  std::vector<size_t> childStart(numBoxes + 2, 0);
+  {
+    std::vector<size_t> childIndex(numEvents);
+    for (size_t i = 0; i < numEvents; ++i) {
+      size_t cindex = calculateChildIndex(*(begin + i));
+      // Events on the upper boundary of the last child box go in that box
+      if (cindex == numBoxes)
+        cindex = numBoxes - 1;
+      else if (cindex > numBoxes)
+        cindex = numBoxes;
+      childIndex[i] = cindex;
+      ++childStart[cindex + 1];
+    }
+    std::partial_sum(childStart.begin(), childStart.end(), childStart.begin());
+
+    // Stable counting sort of the events by child index
+    std::vector<size_t> order(numEvents);
+    std::vector<size_t> next(childStart.begin(), childStart.end() - 1);
+    for (size_t i = 0; i < numEvents; ++i)
+      order[next[childIndex[i]]++] = i;
+    std::vector<MDE> sorted;
+    sorted.reserve(numEvents);
+    for (const auto i : order)
+      sorted.push_back(*(begin + i));
+    std::copy(sorted.cbegin(), sorted.cend(), begin);
+  }
+
+  const size_t eventsPerTask =
+      this->m_BoxController->getAddingEvents_eventsPerTask();
+  for (size_t i = 0; i < numBoxes; ++i) {
+    const auto childBegin = begin + childStart[i];
+    const auto childEnd = begin + childStart[i + 1];
+    const size_t numChildEvents = childStart[i + 1] - childStart[i];
+
+    bool newGridBox = false;
+    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(m_Children[i]);
+    if (box) {
+      if (!this->m_BoxController->willSplit(
+              box->getNPoints() + numChildEvents, box->getDepth())) {
+        // The events stay in this box
+        if (numChildEvents > 0) {
+          std::vector<MDE> &events = box->getEvents();
+          events.insert(events.end(), childBegin, childEnd);
+          box->releaseEvents();
+        }
+        continue;
+      }
+      // Track how many MDBoxes there are in the overall workspace
+      this->m_BoxController->trackNumBoxes(box->getDepth());
+      m_Children[i] = new MDGridBox<MDE, nd>(box);
+      delete box;
+      newGridBox = true;
+    }
+
+    MDGridBox<MDE, nd> *gridBox =
+        dynamic_cast<MDGridBox<MDE, nd> *>(m_Children[i]);
+    // A new grid box is visited even without new events, as the events it
+    // inherited may need splitting further
+    if (!gridBox || (numChildEvents == 0 && !newGridBox))
+      continue;
+    if (!ts || numChildEvents < eventsPerTask)
+      gridBox->addAndSplitEvents(childBegin, childEnd, ts);
+    else
+      // Task is : gridBox->addAndSplitEvents(childBegin, childEnd, ts);
+      ts->push(new Kernel::FunctionTask(
+          boost::bind(&MDGridBox<MDE, nd>::addAndSplitEvents, &*gridBox,
+                      childBegin, childEnd, ts)));
+  }
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Perform centerpoint binning of events, with bins defined
  * in axes perpendicular to the axes of the workspace.
@@ -0,0 +1,109 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_
+#define MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_
+
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/System.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** A chain of element-by-element operations on MDHistoWorkspaces, recorded
+  and evaluated lazily.
+
+  Applying the operations one by one, e.g. through PlusMD, MultiplyMD and
+  PowerMD, creates a temporary workspace and makes a full pass over the
+  signal and error arrays for each step. An MDHistoExpression evaluates the
+  whole chain in a single parallel sweep. Each block of bins goes through
+  every step while it is in the cache, so the operands are read once and
+  only the final workspace is created.
+
+  The errors are propagated exactly as in the corresponding methods of
+  MDHistoWorkspace, so evaluating an expression gives the same result as
+  applying its steps in order:
+
+  @code
+  auto result = MDHistoExpression(data)
+                    .minus(background)
+                    .divide(normalisation)
+                    .multiply(2.0, 0.0)
+                    .evaluate();
+  @endcode
+*/
+class DLLExport MDHistoExpression {
+public:
+  explicit MDHistoExpression(MDHistoWorkspace_const_sptr input);
+
+  MDHistoExpression &plus(MDHistoWorkspace_const_sptr operand);
+  MDHistoExpression &plus(const signal_t signal, const signal_t error);
+  MDHistoExpression &minus(MDHistoWorkspace_const_sptr operand);
+  MDHistoExpression &minus(const signal_t signal, const signal_t error);
+  MDHistoExpression &multiply(MDHistoWorkspace_const_sptr operand);
+  MDHistoExpression &multiply(const signal_t signal, const signal_t error);
+  MDHistoExpression &divide(MDHistoWorkspace_const_sptr operand);
+  MDHistoExpression &divide(const signal_t signal, const signal_t error);
+  MDHistoExpression &log(const double filler = 0.0);
+  MDHistoExpression &log10(const double filler = 0.0);
+  MDHistoExpression &exp();
+  MDHistoExpression &power(const double exponent);
+
+  /// @return the number of recorded operations
+  size_t size() const { return m_steps.size(); }
+
+  MDHistoWorkspace_sptr evaluate() const;
+  void evaluateInPlace(MDHistoWorkspace &output) const;
+
+private:
+  /// The kinds of recorded operations
+  enum class Operation {
+    Plus,
+    Minus,
+    Multiply,
+    Divide,
+    PlusScalar,
+    MinusScalar,
+    MultiplyScalar,
+    DivideScalar,
+    Log,
+    Log10,
+    Exp,
+    Power
+  };
+
+  /// One recorded operation
+  struct Step {
+    Operation operation;
+    /// The workspace on the RHS, for operations between workspaces
+    MDHistoWorkspace_const_sptr operand;
+    /// The scalar on the RHS, the filler of logarithms or the exponent
+    signal_t value;
+    /// The squared error of the scalar on the RHS
+    signal_t errorSquared;
+  };
+
+  MDHistoExpression &addStep(const Operation operation,
+                             MDHistoWorkspace_const_sptr operand,
+                             const signal_t value = 0.0,
+                             const signal_t errorSquared = 0.0);
+  void sweep(MDHistoWorkspace &output, const bool copyInput) const;
+  void applyStep(const Step &step, const size_t begin, const size_t end,
+                 signal_t *signal, signal_t *errorSquared,
+                 signal_t *numEvents) const;
+
+  /// The workspace the operations start from
+  MDHistoWorkspace_const_sptr m_input;
+  /// The operations, in the order they are applied
+  std::vector<Step> m_steps;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_ */
@@ -0,0 +1,85 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDINTEGRATIONREGION_H_
+#define MANTID_DATAOBJECTS_MDINTEGRATIONREGION_H_
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/System.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDIntegrationRegion : A sphere or an ellipsoid, optionally with a hole of
+  the same shape in the middle, to integrate or centroid with
+  MDEventWorkspace::integrateRegions and MDEventWorkspace::centroidRegions.
+
+  A point x is inside the region when
+  innerRadiusSquared < (x - c)^T M (x - c) < radiusSquared, where c is the
+  center and M is the identity for a sphere. Without a hole, the lower bound
+  is not applied. The tests against the extents of a box used to prune the box
+  tree are conservative: a box is only skipped if it cannot contain a point of
+  the region, and only taken whole if all of it is inside the region.
+*/
+class DLLExport MDIntegrationRegion {
+public:
+  static MDIntegrationRegion sphere(const std::vector<coord_t> &center,
+                                    const double radius,
+                                    const double innerRadius = 0.0);
+  static MDIntegrationRegion
+  ellipsoid(const std::vector<coord_t> &center,
+            const std::vector<std::vector<double>> &axes,
+            const std::vector<double> &semiAxes, const double innerScale = 0.0);
+
+  /// @return the number of dimensions of the region
+  size_t getNumDims() const { return m_center.size(); }
+  /// @return the center of the region
+  const std::vector<coord_t> &getCenter() const { return m_center; }
+  /// @return the square of the outer radius
+  coord_t getRadiusSquared() const { return m_radiusSquared; }
+  /// @return the square of the inner radius, 0 without a hole
+  coord_t getInnerRadiusSquared() const { return m_innerRadiusSquared; }
+  /// @return true if the region has a hole in the middle
+  bool isShell() const { return m_innerRadiusSquared != 0; }
+
+  coord_t distanceSquared(const coord_t *point) const;
+
+  /** @param point :: nd coordinates of a point
+   * @return true if the point is inside the region */
+  bool contains(const coord_t *point) const {
+    const coord_t distance = distanceSquared(point);
+    return distance < m_radiusSquared &&
+           (m_innerRadiusSquared == 0 || distance > m_innerRadiusSquared);
+  }
+
+  bool mightOverlap(const coord_t *min, const coord_t *max) const;
+  bool surrounds(const coord_t *min, const coord_t *max) const;
+
+private:
+  MDIntegrationRegion(const std::vector<coord_t> &center,
+                      const coord_t radiusSquared,
+                      const coord_t innerRadiusSquared);
+
+  /// The center of the region
+  std::vector<coord_t> m_center;
+  /// The nd x nd metric M, row by row; empty for a sphere
+  std::vector<coord_t> m_metric;
+  /// The square of the outer radius
+  coord_t m_radiusSquared;
+  /// The square of the inner radius
+  coord_t m_innerRadiusSquared;
+  /// Half widths of the bounding box of the outer surface
+  std::vector<coord_t> m_halfWidths;
+  /// Half widths of the bounding box of the inner surface
+  std::vector<coord_t> m_innerHalfWidths;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDINTEGRATIONREGION_H_ */
@@ -159,6 +159,17 @@ public:
    * */
   coord_t *getCenterNonConst() { return center; }
 
+  //---------------------------------------------------------------------------------------------
+  /** @return the number of coordinates from the center of an event to the
+   * center of the next one in a vector of events, e.g. to transform all the
+   * centers with CoordTransform::applyBatch.
+   * */
+  static constexpr size_t getCenterStride() {
+    static_assert(sizeof(MDLeanEvent<nd>) % sizeof(coord_t) == 0,
+                  "Events must be a whole number of coordinates long");
+    return sizeof(MDLeanEvent<nd>) / sizeof(coord_t);
+  }
+
   //---------------------------------------------------------------------------------------------
   /** Sets the n-th coordinate axis value.
    * @param n :: index (0-based) of the dimension you want to set
@@ -0,0 +1,367 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/BoxControllerMappedIO.h"
+
+#include "MantidAPI/FileFinder.h"
+#include "MantidDataObjects/MDEvent.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Exception.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Identifies the event files written by this class, and their version
+const char FILE_MAGIC[8] = {'M', 'D', 'E', 'V', 'M', 'A', 'P', '1'};
+
+/// The start of the event file
+struct FileHeader {
+  char magic[8];
+  /// number of bytes of each stored value, 4 or 8
+  uint32_t coordSize;
+  /// number of values stored for each event
+  uint32_t nColumns;
+  /// number of events in the file
+  uint64_t nEvents;
+  /// number of values in the free space vector following the events
+  uint64_t freeSpaceSize;
+};
+
+/// The events start here, aligned for any value type
+constexpr uint64_t HEADER_SIZE = 64;
+static_assert(sizeof(FileHeader) <= HEADER_SIZE, "Event file header too big");
+
+/** Copy values, converting them to another floating point type if needed.
+ * @param from :: pointer to the first value to copy
+ * @param to :: pointer to where the first value goes
+ * @param n :: number of values
+ */
+template <typename FROM, typename TO>
+void copyValues(const FROM *from, TO *to, const size_t n) {
+  std::copy(from, from + n, to);
+}
+} // namespace
+
+/**Constructor
+ @param bc :: the box controller using this IO
+*/
+BoxControllerMappedIO::BoxControllerMappedIO(API::BoxController *const bc)
+    : m_opened(false), m_ReadOnly(true), m_deleteOnClose(false), m_bc(bc),
+      m_CoordSize(sizeof(coord_t)), m_fileCoordSize(sizeof(coord_t)),
+      m_EventType(FatEvent), m_nColumns(4 + bc->getNDims()), m_capacity(0) {
+  m_EventsTypesSupported.resize(2);
+  m_EventsTypesSupported[LeanEvent] = MDLeanEvent<1>::getTypeName();
+  m_EventsTypesSupported[FatEvent] = MDEvent<1>::getTypeName();
+}
+
+BoxControllerMappedIO::~BoxControllerMappedIO() { this->closeFile(); }
+
+/** Set up the event type and the size of the event coordinates used in
+ * save/load operations.
+ * @param blockSize :: size (in bytes) of the values in the data blocks, 4
+ * (float) or 8 (double)
+ * @param typeName :: the name of the events, MDLeanEvent or MDEvent
+ */
+void BoxControllerMappedIO::setDataType(const size_t blockSize,
+                                        const std::string &typeName) {
+  if (blockSize != 4 && blockSize != 8)
+    throw std::invalid_argument("The class currently supports 4(float) and "
+                                "8(double) event coordinates only");
+  auto it = std::find(m_EventsTypesSupported.cbegin(),
+                      m_EventsTypesSupported.cend(), typeName);
+  if (it == m_EventsTypesSupported.cend())
+    throw std::invalid_argument("Unsupported event type: " + typeName +
+                                " provided ");
+
+  m_CoordSize = blockSize;
+  m_EventType = static_cast<EventType>(
+      std::distance(m_EventsTypesSupported.cbegin(), it));
+  m_nColumns = (m_EventType == LeanEvent ? 2 : 4) + m_bc->getNDims();
+}
+
+/** Get the event type and the size of the event coordinates used in
+ * save/load operations.
+ * @param CoordSize :: set to the size (in bytes) of the values
+ * @param typeName :: set to the name of the events
+ */
+void BoxControllerMappedIO::getDataType(size_t &CoordSize,
+                                        std::string &typeName) const {
+  CoordSize = m_CoordSize;
+  typeName = m_EventsTypesSupported[m_EventType];
+}
+
+/** Open the event file, creating it if it does not exist and the mode allows
+ * writing.
+ * @param fileName :: the name of the file. Search for an existing file is
+ * performed within the Mantid search path; a new file goes into the default
+ * save directory unless the name has a path.
+ * @param mode :: opening mode, read/write if it contains w or W and read only
+ * otherwise
+ * @return false if a file is already opened
+ */
+bool BoxControllerMappedIO::openFile(const std::string &fileName,
+                                     const std::string &mode) {
+  if (m_opened)
+    return false;
+
+  m_ReadOnly = mode.find('w') == std::string::npos &&
+               mode.find('W') == std::string::npos;
+
+  m_fileName = API::FileFinder::Instance().getFullPath(fileName);
+  if (m_fileName.empty()) {
+    if (m_ReadOnly)
+      throw Kernel::Exception::FileError("Can not open file to read ",
+                                         fileName);
+    std::string filePath =
+        Kernel::ConfigService::Instance().getString("defaultsave.directory");
+    if (filePath.empty() || Poco::Path(fileName).isAbsolute())
+      m_fileName = fileName;
+    else
+      m_fileName = filePath + "/" + fileName;
+  }
+
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  Poco::File file(m_fileName);
+  if (!file.exists() || file.getSize() == 0) {
+    if (m_ReadOnly)
+      throw Kernel::Exception::FileError("Can not open file to read ",
+                                         m_fileName);
+    file.createFile();
+    m_fileCoordSize = m_CoordSize;
+    remap(DATA_CHUNK);
+    this->setFileLength(0);
+    std::vector<uint64_t> noFreeSpace;
+    this->setFreeSpaceVector(noFreeSpace);
+    writeHeader(0);
+  } else {
+    m_map = Poco::SharedMemory(file, m_ReadOnly
+                                         ? Poco::SharedMemory::AM_READ
+                                         : Poco::SharedMemory::AM_WRITE);
+    readHeader();
+  }
+  m_opened = true;
+  return true;
+}
+
+/** Check the header of an existing file and read its length and free space
+ * blocks. The file must be mapped.
+ */
+void BoxControllerMappedIO::readHeader() {
+  const uint64_t fileSize = Poco::File(m_fileName).getSize();
+  FileHeader header;
+  if (fileSize < HEADER_SIZE)
+    throw Kernel::Exception::FileError("Not a mapped MD event file ",
+                                       m_fileName);
+  std::memcpy(&header, m_map.begin(), sizeof(header));
+  if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+      (header.coordSize != 4 && header.coordSize != 8))
+    throw Kernel::Exception::FileError("Not a mapped MD event file ",
+                                       m_fileName);
+  if (header.nColumns != m_nColumns)
+    throw Kernel::Exception::FileError(
+        "Trying to open event data with different number of dimensions or "
+        "kind of events ",
+        m_fileName);
+
+  m_fileCoordSize = header.coordSize;
+  const uint64_t rowBytes = m_nColumns * m_fileCoordSize;
+  m_capacity = (fileSize - HEADER_SIZE) / rowBytes;
+  const uint64_t freeSpaceBytes = header.freeSpaceSize * sizeof(uint64_t);
+  if (header.nEvents > m_capacity ||
+      freeSpaceBytes > (m_capacity - header.nEvents) * rowBytes)
+    throw Kernel::Exception::FileError("The mapped MD event file is truncated ",
+                                       m_fileName);
+
+  this->setFileLength(header.nEvents);
+  std::vector<uint64_t> freeSpace(header.freeSpaceSize);
+  if (!freeSpace.empty())
+    std::memcpy(freeSpace.data(), eventAddress(header.nEvents),
+                freeSpaceBytes);
+  this->setFreeSpaceVector(freeSpace);
+}
+
+/** Write the header of the file, which must be mapped for writing.
+ * @param freeSpaceSize :: number of values in the free space vector stored
+ * after the events
+ */
+void BoxControllerMappedIO::writeHeader(const uint64_t freeSpaceSize) const {
+  FileHeader header;
+  std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  header.coordSize = static_cast<uint32_t>(m_fileCoordSize);
+  header.nColumns = static_cast<uint32_t>(m_nColumns);
+  header.nEvents = this->getFileLength();
+  header.freeSpaceSize = freeSpaceSize;
+  std::memcpy(m_map.begin(), &header, sizeof(header));
+}
+
+/** Make sure the file has room for nEvents events, growing it if needed.
+ * @param nEvents :: the number of events
+ */
+void BoxControllerMappedIO::reserve(const uint64_t nEvents) const {
+  {
+    Poco::ScopedReadRWLock lock(m_mapLock);
+    if (nEvents <= m_capacity)
+      return;
+  }
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  if (nEvents > m_capacity)
+    remap(std::max(nEvents, m_capacity + m_capacity / 2));
+}
+
+/** Resize the file to hold nEvents events and map it again. The caller must
+ * hold the write lock of the mapping.
+ * @param nEvents :: the number of events
+ */
+void BoxControllerMappedIO::remap(const uint64_t nEvents) const {
+  // Unmap before resizing, which some systems require
+  m_map = Poco::SharedMemory();
+  Poco::File file(m_fileName);
+  file.setSize(HEADER_SIZE + nEvents * m_nColumns * m_fileCoordSize);
+  m_map = Poco::SharedMemory(file, Poco::SharedMemory::AM_WRITE);
+  m_capacity = nEvents;
+}
+
+/**@return the address of the event at the given position in the mapping
+ * @param position :: position of the event in the file, in events */
+char *BoxControllerMappedIO::eventAddress(const uint64_t position) const {
+  return m_map.begin() + HEADER_SIZE + position * m_nColumns * m_fileCoordSize;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+/** Save a generic data block at a specific position in the file
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to   */
+template <typename Type>
+void BoxControllerMappedIO::saveGenericBlock(
+    const std::vector<Type> &DataBlock, const uint64_t blockPosition) const {
+  if (m_ReadOnly)
+    throw Kernel::Exception::FileError(
+        "Attempt to write events into a file opened for reading", m_fileName);
+  const uint64_t nPoints = DataBlock.size() / m_nColumns;
+  reserve(blockPosition + nPoints);
+  {
+    // The blocks of different boxes do not overlap, so they can be copied
+    // concurrently
+    Poco::ScopedReadRWLock lock(m_mapLock);
+    char *address = eventAddress(blockPosition);
+    if (m_fileCoordSize == sizeof(float))
+      copyValues(DataBlock.data(), reinterpret_cast<float *>(address),
+                 DataBlock.size());
+    else
+      copyValues(DataBlock.data(), reinterpret_cast<double *>(address),
+                 DataBlock.size());
+  }
+  std::lock_guard<std::mutex> lock(m_lengthMutex);
+  if (blockPosition + nPoints > this->getFileLength())
+    this->setFileLength(blockPosition + nPoints);
+}
+
+/** Save float data block at a specific position in the file
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to   */
+void BoxControllerMappedIO::saveBlock(const std::vector<float> &DataBlock,
+                                      const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition);
+}
+/** Save double precision data block at a specific position in the file
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to   */
+void BoxControllerMappedIO::saveBlock(const std::vector<double> &DataBlock,
+                                      const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition);
+}
+
+/** Load generic data block from the file.
+ *@param Block         -- the storage vector to place data into
+ *@param blockPosition -- The starting place to read data from
+ *@param nPoints       -- number of data points (events) to read
+ */
+template <typename Type>
+void BoxControllerMappedIO::loadGenericBlock(std::vector<Type> &Block,
+                                             const uint64_t blockPosition,
+                                             const size_t nPoints) const {
+  if (blockPosition + nPoints > this->getFileLength())
+    throw Kernel::Exception::FileError("Attemtp to read behind the file end",
+                                       m_fileName);
+  Block.resize(nPoints * m_nColumns);
+  Poco::ScopedReadRWLock lock(m_mapLock);
+  const char *address = eventAddress(blockPosition);
+  if (m_fileCoordSize == sizeof(float))
+    copyValues(reinterpret_cast<const float *>(address), Block.data(),
+               Block.size());
+  else
+    copyValues(reinterpret_cast<const double *>(address), Block.data(),
+               Block.size());
+}
+
+/** Load float data block from the file.
+ *@param Block         -- the storage vector to place data into
+ *@param blockPosition -- The starting place to read data from
+ *@param nPoints       -- number of data points (events) to read
+ */
+void BoxControllerMappedIO::loadBlock(std::vector<float> &Block,
+                                      const uint64_t blockPosition,
+                                      const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+/** Load double data block from the file.
+ *@param Block         -- the storage vector to place data into
+ *@param blockPosition -- The starting place to read data from
+ *@param nPoints       -- number of data points (events) to read
+ */
+void BoxControllerMappedIO::loadBlock(std::vector<double> &Block,
+                                      const uint64_t blockPosition,
+                                      const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+/// Nothing to do: the operating system writes the mapped pages back
+void BoxControllerMappedIO::flushData() const {}
+
+/** Write the events still in the disk buffer, store the free space blocks
+ * after the events and unmap the file. The file is trimmed to its contents,
+ * or removed if asked for with setDeleteOnClose(). */
+void BoxControllerMappedIO::closeFile() {
+  if (!m_opened)
+    return;
+  this->flushCache();
+
+  Poco::ScopedWriteRWLock lock(m_mapLock);
+  if (!m_ReadOnly && !m_deleteOnClose) {
+    std::vector<uint64_t> freeSpace;
+    this->getFreeSpaceVector(freeSpace);
+    const uint64_t nEvents = this->getFileLength();
+    const uint64_t rowBytes = m_nColumns * m_fileCoordSize;
+    const uint64_t freeSpaceBytes = freeSpace.size() * sizeof(uint64_t);
+    const uint64_t size = nEvents + (freeSpaceBytes + rowBytes - 1) / rowBytes;
+    if (size > m_capacity)
+      remap(size);
+    if (!freeSpace.empty())
+      std::memcpy(eventAddress(nEvents), freeSpace.data(), freeSpaceBytes);
+    writeHeader(freeSpace.size());
+    m_map = Poco::SharedMemory();
+    // Give back the room reserved for more events
+    Poco::File(m_fileName).setSize(HEADER_SIZE + size * rowBytes);
+  } else {
+    m_map = Poco::SharedMemory();
+  }
+  m_capacity = 0;
+  m_opened = false;
+  if (m_deleteOnClose)
+    Poco::File(m_fileName).remove();
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,398 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/BoxControllerQuantizedIO.h"
+
+#include "MantidDataObjects/MDEvent.h"
+#include "MantidKernel/Exception.h"
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// The largest quantized offset
+constexpr double MAX_OFFSET = std::numeric_limits<uint16_t>::max();
+} // namespace
+
+/**Constructor
+ @param bc :: the box controller using this IO
+*/
+BoxControllerQuantizedIO::BoxControllerQuantizedIO(
+    API::BoxController *const bc)
+    : m_opened(false), m_bc(bc), m_CoordSize(sizeof(coord_t)),
+      m_EventType(FatEvent), m_nColumns(4 + bc->getNDims()) {
+  m_EventsTypesSupported.resize(2);
+  m_EventsTypesSupported[LeanEvent] = MDLeanEvent<1>::getTypeName();
+  m_EventsTypesSupported[FatEvent] = MDEvent<1>::getTypeName();
+}
+
+BoxControllerQuantizedIO::~BoxControllerQuantizedIO() { this->closeFile(); }
+
+/** Set up the event type and the size of the event coordinates used in
+ * save/load operations.
+ * @param blockSize :: size (in bytes) of the values in the data blocks, 4
+ * (float) or 8 (double)
+ * @param typeName :: the name of the events, MDLeanEvent or MDEvent
+ */
+void BoxControllerQuantizedIO::setDataType(const size_t blockSize,
+                                           const std::string &typeName) {
+  if (blockSize != 4 && blockSize != 8)
+    throw std::invalid_argument("The class currently supports 4(float) and "
+                                "8(double) event coordinates only");
+  auto it = std::find(m_EventsTypesSupported.cbegin(),
+                      m_EventsTypesSupported.cend(), typeName);
+  if (it == m_EventsTypesSupported.cend())
+    throw std::invalid_argument("Unsupported event type: " + typeName +
+                                " provided ");
+
+  m_CoordSize = blockSize;
+  m_EventType = static_cast<EventType>(
+      std::distance(m_EventsTypesSupported.cbegin(), it));
+  m_nColumns = (m_EventType == LeanEvent ? 2 : 4) + m_bc->getNDims();
+}
+
+/** Get the event type and the size of the event coordinates used in
+ * save/load operations.
+ * @param CoordSize :: set to the size (in bytes) of the values
+ * @param typeName :: set to the name of the events
+ */
+void BoxControllerQuantizedIO::getDataType(size_t &CoordSize,
+                                           std::string &typeName) const {
+  CoordSize = m_CoordSize;
+  typeName = m_EventsTypesSupported[m_EventType];
+}
+
+/** Open an empty store. No file is used.
+ * @param fileName :: a name for the store, returned by getFileName()
+ * @param mode :: opening mode; the store is empty, so it must contain w or W
+ * @return false if the store is already opened
+ */
+bool BoxControllerQuantizedIO::openFile(const std::string &fileName,
+                                        const std::string &mode) {
+  if (m_opened)
+    return false;
+  if (mode.find('w') == std::string::npos &&
+      mode.find('W') == std::string::npos)
+    throw Kernel::Exception::FileError(
+        "A quantized event store can only be opened for writing ", fileName);
+  m_fileName = fileName;
+  this->setFileLength(0);
+  std::vector<uint64_t> noFreeSpace;
+  this->setFreeSpaceVector(noFreeSpace);
+  m_opened = true;
+  return true;
+}
+
+/**@return the number of blocks of events in the store */
+size_t BoxControllerQuantizedIO::getNumBlocks() const {
+  std::lock_guard<std::mutex> lock(m_blocksMutex);
+  return m_blocks.size();
+}
+
+/**@return the number of bytes used to store the events */
+size_t BoxControllerQuantizedIO::getStoredBytes() const {
+  std::lock_guard<std::mutex> lock(m_blocksMutex);
+  size_t bytes = 0;
+  for (const auto &stored : m_blocks) {
+    const QuantizedBlock &block = *stored.second;
+    bytes += sizeof(QuantizedBlock) + block.weights.size() * sizeof(float) +
+             block.runIndex.size() * sizeof(uint16_t) +
+             block.detectorId.size() * sizeof(int32_t) +
+             (block.origin.size() + block.step.size()) * sizeof(double) +
+             block.offsets.size() * sizeof(uint16_t);
+  }
+  return bytes;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+/** Quantize a block of events.
+ * @param DataBlock :: the events, as rows of (signal, errorSquared,
+ * [runIndex, detectorId,] center)
+ * @param boxMin :: lower edges of the box of the events, or empty to use the
+ * bounding box of the events
+ * @param boxMax :: upper edges of the box of the events, or empty
+ * @return the compact block
+ */
+template <typename Type>
+BoxControllerQuantizedIO::QuantizedBlock_sptr
+BoxControllerQuantizedIO::encode(const std::vector<Type> &DataBlock,
+                                 const std::vector<double> &boxMin,
+                                 const std::vector<double> &boxMax) const {
+  const size_t centerColumn = m_EventType == LeanEvent ? 2 : 4;
+  const size_t nd = m_nColumns - centerColumn;
+  auto block = boost::make_shared<QuantizedBlock>();
+  const size_t nEvents = DataBlock.size() / m_nColumns;
+  block->nEvents = nEvents;
+
+  bool unitWeights = true;
+  for (size_t i = 0; i < nEvents && unitWeights; ++i) {
+    const Type *row = DataBlock.data() + i * m_nColumns;
+    unitWeights = row[0] == 1 && row[1] == 1;
+  }
+  if (!unitWeights) {
+    block->weights.resize(2 * nEvents);
+    for (size_t i = 0; i < nEvents; ++i) {
+      block->weights[2 * i] = static_cast<float>(DataBlock[i * m_nColumns]);
+      block->weights[2 * i + 1] =
+          static_cast<float>(DataBlock[i * m_nColumns + 1]);
+    }
+  }
+  if (m_EventType == FatEvent) {
+    block->runIndex.resize(nEvents);
+    block->detectorId.resize(nEvents);
+    for (size_t i = 0; i < nEvents; ++i) {
+      block->runIndex[i] =
+          static_cast<uint16_t>(DataBlock[i * m_nColumns + 2]);
+      block->detectorId[i] =
+          static_cast<int32_t>(DataBlock[i * m_nColumns + 3]);
+    }
+  }
+
+  // The grid spans the box if it is known, and the bounding box of the
+  // events otherwise
+  block->step.assign(nd, 0.0);
+  std::vector<double> upper;
+  if (boxMin.size() == nd && boxMax.size() == nd) {
+    block->origin = boxMin;
+    upper = boxMax;
+  } else {
+    block->origin.assign(nd, std::numeric_limits<double>::max());
+    upper.assign(nd, std::numeric_limits<double>::lowest());
+    for (size_t i = 0; i < nEvents; ++i) {
+      const Type *center = DataBlock.data() + i * m_nColumns + centerColumn;
+      for (size_t d = 0; d < nd; ++d) {
+        block->origin[d] = std::min(block->origin[d], double(center[d]));
+        upper[d] = std::max(upper[d], double(center[d]));
+      }
+    }
+  }
+  for (size_t d = 0; d < nd && nEvents > 0; ++d)
+    block->step[d] = (upper[d] - block->origin[d]) / MAX_OFFSET;
+
+  block->offsets.resize(nd * nEvents);
+  auto offset = block->offsets.begin();
+  for (size_t i = 0; i < nEvents; ++i) {
+    const Type *center = DataBlock.data() + i * m_nColumns + centerColumn;
+    for (size_t d = 0; d < nd; ++d, ++offset) {
+      if (block->step[d] > 0.0) {
+        const double scaled = std::round(
+            (double(center[d]) - block->origin[d]) / block->step[d]);
+        *offset =
+            static_cast<uint16_t>(std::min(std::max(scaled, 0.0), MAX_OFFSET));
+      } else {
+        *offset = 0;
+      }
+    }
+  }
+  return block;
+}
+
+/** Expand the events of a block.
+ * @param block :: the compact block
+ * @param first :: index of the first event to expand in the block
+ * @param nPoints :: number of events to expand
+ * @param out :: where the rows of the first event go
+ */
+template <typename Type>
+void BoxControllerQuantizedIO::decode(const QuantizedBlock &block,
+                                      const size_t first, const size_t nPoints,
+                                      Type *out) const {
+  const size_t centerColumn = m_EventType == LeanEvent ? 2 : 4;
+  const size_t nd = m_nColumns - centerColumn;
+  for (size_t i = first; i < first + nPoints; ++i, out += m_nColumns) {
+    if (block.weights.empty()) {
+      out[0] = 1;
+      out[1] = 1;
+    } else {
+      out[0] = static_cast<Type>(block.weights[2 * i]);
+      out[1] = static_cast<Type>(block.weights[2 * i + 1]);
+    }
+    if (m_EventType == FatEvent) {
+      out[2] = static_cast<Type>(block.runIndex[i]);
+      out[3] = static_cast<Type>(block.detectorId[i]);
+    }
+    const uint16_t *offsets = block.offsets.data() + i * nd;
+    for (size_t d = 0; d < nd; ++d)
+      out[centerColumn + d] = static_cast<Type>(
+          block.origin[d] + block.step[d] * double(offsets[d]));
+  }
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+/** Save a generic data block at a specific position, replacing any blocks
+ * stored over the same positions
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to
+ *@param boxMin        -- lower edges of the box of the events, or empty
+ *@param boxMax        -- upper edges of the box of the events, or empty */
+template <typename Type>
+void BoxControllerQuantizedIO::saveGenericBlock(
+    const std::vector<Type> &DataBlock, const uint64_t blockPosition,
+    const std::vector<double> &boxMin,
+    const std::vector<double> &boxMax) const {
+  if (!m_opened)
+    throw Kernel::Exception::FileError(
+        "Attempt to write events into a closed quantized store", m_fileName);
+  // Quantize before taking the lock: the blocks are independent
+  QuantizedBlock_sptr block = encode(DataBlock, boxMin, boxMax);
+  const uint64_t blockEnd = blockPosition + block->nEvents;
+
+  std::lock_guard<std::mutex> lock(m_blocksMutex);
+  auto it = m_blocks.lower_bound(blockPosition);
+  if (it != m_blocks.begin()) {
+    auto previous = std::prev(it);
+    if (previous->first + previous->second->nEvents > blockPosition)
+      it = previous;
+  }
+  while (it != m_blocks.end() && it->first < blockEnd)
+    it = m_blocks.erase(it);
+  if (block->nEvents > 0)
+    m_blocks.emplace(blockPosition, block);
+  if (blockEnd > this->getFileLength())
+    this->setFileLength(blockEnd);
+}
+
+/** Save float data block at a specific position
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to   */
+void BoxControllerQuantizedIO::saveBlock(const std::vector<float> &DataBlock,
+                                         const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition, {}, {});
+}
+/** Save double precision data block at a specific position
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to   */
+void BoxControllerQuantizedIO::saveBlock(const std::vector<double> &DataBlock,
+                                         const uint64_t blockPosition) const {
+  this->saveGenericBlock(DataBlock, blockPosition, {}, {});
+}
+/** Save the float events of a box at a specific position, quantized within
+ * the extents of the box
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to
+ *@param boxMin        -- lower edges of the box
+ *@param boxMax        -- upper edges of the box */
+void BoxControllerQuantizedIO::saveBlockInBox(
+    const std::vector<float> &DataBlock, const uint64_t blockPosition,
+    const std::vector<double> &boxMin,
+    const std::vector<double> &boxMax) const {
+  this->saveGenericBlock(DataBlock, blockPosition, boxMin, boxMax);
+}
+/** Save the double precision events of a box at a specific position,
+ * quantized within the extents of the box
+ *@param DataBlock     -- the vector with data to write
+ *@param blockPosition -- The starting place to save data to
+ *@param boxMin        -- lower edges of the box
+ *@param boxMax        -- upper edges of the box */
+void BoxControllerQuantizedIO::saveBlockInBox(
+    const std::vector<double> &DataBlock, const uint64_t blockPosition,
+    const std::vector<double> &boxMin,
+    const std::vector<double> &boxMax) const {
+  this->saveGenericBlock(DataBlock, blockPosition, boxMin, boxMax);
+}
+
+/** Load generic data block. The positions not covered by a stored block, i.e.
+ * free space, are read as zeros.
+ *@param Block         -- the storage vector to place data into
+ *@param blockPosition -- The starting place to read data from
+ *@param nPoints       -- number of data points (events) to read
+ */
+template <typename Type>
+void BoxControllerQuantizedIO::loadGenericBlock(std::vector<Type> &Block,
+                                                const uint64_t blockPosition,
+                                                const size_t nPoints) const {
+  const uint64_t blockEnd = blockPosition + nPoints;
+  std::vector<std::pair<uint64_t, QuantizedBlock_sptr>> overlapping;
+  {
+    std::lock_guard<std::mutex> lock(m_blocksMutex);
+    if (blockEnd > this->getFileLength())
+      throw Kernel::Exception::FileError("Attemtp to read behind the file end",
+                                         m_fileName);
+    auto it = m_blocks.upper_bound(blockPosition);
+    if (it != m_blocks.begin())
+      --it;
+    for (; it != m_blocks.end() && it->first < blockEnd; ++it) {
+      if (it->first + it->second->nEvents > blockPosition)
+        overlapping.emplace_back(*it);
+    }
+  }
+
+  Block.assign(nPoints * m_nColumns, 0);
+  for (const auto &stored : overlapping) {
+    const uint64_t first = std::max(stored.first, blockPosition);
+    const uint64_t last =
+        std::min(stored.first + stored.second->nEvents, blockEnd);
+    decode(*stored.second, static_cast<size_t>(first - stored.first),
+           static_cast<size_t>(last - first),
+           Block.data() + (first - blockPosition) * m_nColumns);
+  }
+}
+
+/** Load float data block.
+ *@param Block         -- the storage vector to place data into
+ *@param blockPosition -- The starting place to read data from
+ *@param nPoints       -- number of data points (events) to read
+ */
+void BoxControllerQuantizedIO::loadBlock(std::vector<float> &Block,
+                                         const uint64_t blockPosition,
+                                         const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+/** Load double data block.
+ *@param Block         -- the storage vector to place data into
+ *@param blockPosition -- The starting place to read data from
+ *@param nPoints       -- number of data points (events) to read
+ */
+void BoxControllerQuantizedIO::loadBlock(std::vector<double> &Block,
+                                         const uint64_t blockPosition,
+                                         const size_t nPoints) const {
+  this->loadGenericBlock(Block, blockPosition, nPoints);
+}
+
+/** Mark a range of positions as free and drop the blocks stored in it, so
+ * the memory of a box that moved or was deleted is released at once rather
+ * than when its positions are saved over.
+ * @param pos :: position of the START of the free range
+ * @param size :: number of events in the free range
+ */
+void BoxControllerQuantizedIO::freeBlock(uint64_t const pos,
+                                         uint64_t const size) {
+  if (size == 0 || size == std::numeric_limits<uint64_t>::max())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(m_blocksMutex);
+    auto it = m_blocks.lower_bound(pos);
+    while (it != m_blocks.end() &&
+           it->first + it->second->nEvents <= pos + size)
+      it = m_blocks.erase(it);
+  }
+  DiskBuffer::freeBlock(pos, size);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+/// Nothing to do: the blocks are stored when they are saved
+void BoxControllerQuantizedIO::flushData() const {}
+
+/** Write the events still in the disk buffer and drop all the stored events,
+ * which cannot be reopened */
+void BoxControllerQuantizedIO::closeFile() {
+  if (!m_opened)
+    return;
+  this->flushCache();
+  std::lock_guard<std::mutex> lock(m_blocksMutex);
+  m_blocks.clear();
+  m_opened = false;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,309 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/CompressedEvents.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Core::DateAndTime;
+using Types::Event::TofEvent;
+
+namespace {
+/// Quantized times-of-flight must be exact integers in a double
+constexpr double MAX_QUANTA = 9007199254740992.0; // 2^53
+
+/** Convert a float to IEEE 754 half precision, if that is exact.
+ * @param value :: the value to convert
+ * @param half :: set to the bits of the half precision value
+ * @return true if value is zero or a normal half precision number
+ */
+bool toHalfExactly(const float value, uint16_t &half) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+  if ((bits & 0x7fffffffu) == 0) {
+    half = sign;
+    return true;
+  }
+  const int exponent = static_cast<int>((bits >> 23) & 0xffu) - 127;
+  const uint32_t mantissa = bits & 0x7fffffu;
+  if (exponent < -14 || exponent > 15 || (mantissa & 0x1fffu) != 0)
+    return false;
+  half = static_cast<uint16_t>(sign | ((exponent + 15) << 10) |
+                               (mantissa >> 13));
+  return true;
+}
+} // namespace
+
+/** Create a table of pulse times that can be shared by many lists.
+ * @param pulseTimes :: pulse times in nanoseconds, in any order and with
+ * duplicates
+ * @return the sorted, unique pulse times
+ */
+CompressedEvents::PulseTimes
+CompressedEvents::makePulseTimes(std::vector<int64_t> pulseTimes) {
+  std::sort(pulseTimes.begin(), pulseTimes.end());
+  pulseTimes.erase(std::unique(pulseTimes.begin(), pulseTimes.end()),
+                   pulseTimes.end());
+  pulseTimes.shrink_to_fit();
+  return std::make_shared<const std::vector<int64_t>>(std::move(pulseTimes));
+}
+
+/** Encode TofEvents.
+ * @param events :: the events, sorted by time-of-flight
+ * @param tofResolution :: quantum of the time-of-flight, must be positive
+ * @param pulseTimes :: table holding every pulse time of the events. If NULL
+ * a table is made from the events.
+ * @throw std::invalid_argument if the events are not sorted, a
+ * time-of-flight is not finite, the resolution is not usable or a pulse time
+ * is missing from the table
+ */
+void CompressedEvents::encode(const std::vector<TofEvent> &events,
+                              const double tofResolution,
+                              PulseTimes pulseTimes) {
+  clear();
+  encodeTofs(events, tofResolution);
+  encodePulseTimes(events, std::move(pulseTimes));
+}
+
+/** Encode WeightedEvents.
+ * @param events :: the events, sorted by time-of-flight
+ * @param tofResolution :: quantum of the time-of-flight, must be positive
+ * @param pulseTimes :: table holding every pulse time of the events. If NULL
+ * a table is made from the events.
+ * @throw std::invalid_argument if the events are not sorted, a
+ * time-of-flight is not finite, the resolution is not usable or a pulse time
+ * is missing from the table
+ */
+void CompressedEvents::encode(const std::vector<WeightedEvent> &events,
+                              const double tofResolution,
+                              PulseTimes pulseTimes) {
+  clear();
+  encodeTofs(events, tofResolution);
+  encodeWeights(events);
+  encodePulseTimes(events, std::move(pulseTimes));
+}
+
+/** Encode WeightedEventNoTimes.
+ * @param events :: the events, sorted by time-of-flight
+ * @param tofResolution :: quantum of the time-of-flight, must be positive
+ * @throw std::invalid_argument if the events are not sorted, a
+ * time-of-flight is not finite or the resolution is not usable
+ */
+void CompressedEvents::encode(const std::vector<WeightedEventNoTime> &events,
+                              const double tofResolution) {
+  clear();
+  encodeTofs(events, tofResolution);
+  encodeWeights(events);
+}
+
+/** Decode into TofEvents.
+ * @param events :: replaced by the decoded events
+ */
+void CompressedEvents::decode(std::vector<TofEvent> &events) const {
+  events.clear();
+  events.reserve(m_size);
+  auto cursor = tofs();
+  for (size_t i = 0; i < m_size; ++i)
+    events.emplace_back(cursor.next(), pulseTime(i));
+}
+
+/** Decode into WeightedEvents.
+ * @param events :: replaced by the decoded events
+ */
+void CompressedEvents::decode(std::vector<WeightedEvent> &events) const {
+  events.clear();
+  events.reserve(m_size);
+  auto cursor = tofs();
+  for (size_t i = 0; i < m_size; ++i)
+    events.emplace_back(cursor.next(), pulseTime(i), weight(i),
+                        errorSquared(i));
+}
+
+/** Decode into WeightedEventNoTimes.
+ * @param events :: replaced by the decoded events
+ */
+void CompressedEvents::decode(std::vector<WeightedEventNoTime> &events) const {
+  events.clear();
+  events.reserve(m_size);
+  auto cursor = tofs();
+  for (size_t i = 0; i < m_size; ++i)
+    events.emplace_back(cursor.next(), weight(i), errorSquared(i));
+}
+
+/// Remove all the events and release their memory
+void CompressedEvents::clear() {
+  m_size = 0;
+  m_tofMin = 0.0;
+  m_tofMax = 0.0;
+  m_tofResolution = 1.0;
+  std::vector<uint8_t>().swap(m_tofSteps);
+  m_pulseTimes.reset();
+  std::vector<uint32_t>().swap(m_pulseIndices);
+  m_weightEncoding = WeightEncoding::None;
+  m_errorEncoding = ErrorEncoding::None;
+  std::vector<uint16_t>().swap(m_halfWeights);
+  std::vector<float>().swap(m_weights);
+  std::vector<float>().swap(m_errorSquared);
+}
+
+/// Memory used by the events, in bytes. The shared table of pulse times is
+/// not included.
+size_t CompressedEvents::getMemorySize() const {
+  return m_tofSteps.capacity() * sizeof(uint8_t) +
+         m_pulseIndices.capacity() * sizeof(uint32_t) +
+         m_halfWeights.capacity() * sizeof(uint16_t) +
+         (m_weights.capacity() + m_errorSquared.capacity()) * sizeof(float);
+}
+
+/** Apply tof -> tof * factor + offset to all the events, without decoding
+ * them.
+ * @param factor :: scale of the times-of-flight, must be positive to keep
+ * the events sorted
+ * @param offset :: shift of the times-of-flight, after scaling
+ */
+void CompressedEvents::scaleTof(const double factor, const double offset) {
+  if (!(factor > 0.0))
+    throw std::invalid_argument(
+        "CompressedEvents: the time-of-flight factor must be positive");
+  m_tofMin = m_tofMin * factor + offset;
+  m_tofMax = m_tofMax * factor + offset;
+  m_tofResolution *= factor;
+}
+
+/** Quantize and store the times-of-flight.
+ * @param events :: the events, sorted by time-of-flight
+ * @param tofResolution :: quantum of the time-of-flight
+ * @throw std::invalid_argument naming the time-of-flight if one is not finite
+ */
+template <class T>
+void CompressedEvents::encodeTofs(const std::vector<T> &events,
+                                  const double tofResolution) {
+  if (!(tofResolution > 0.0))
+    throw std::invalid_argument(
+        "CompressedEvents: the time-of-flight resolution must be positive");
+  m_tofResolution = tofResolution;
+  m_size = events.size();
+  if (events.empty())
+    return;
+
+  const auto checkFinite = [](const double tof) {
+    if (!std::isfinite(tof))
+      throw std::invalid_argument(
+          "CompressedEvents: cannot compress the time-of-flight " +
+          std::to_string(tof) + ", it must be finite");
+  };
+  checkFinite(events.front().tof());
+  checkFinite(events.back().tof());
+  m_tofMin = events.front().tof();
+  if (!((events.back().tof() - m_tofMin) / tofResolution < MAX_QUANTA))
+    throw std::invalid_argument("CompressedEvents: the time-of-flight "
+                                "resolution is too fine for the range of "
+                                "times-of-flight");
+  m_tofSteps.reserve(events.size());
+  int64_t previous = 0;
+  for (const auto &event : events) {
+    checkFinite(event.tof());
+    const int64_t quanta =
+        std::llround((event.tof() - m_tofMin) / tofResolution);
+    if (quanta < previous)
+      throw std::invalid_argument(
+          "CompressedEvents: the events must be sorted by time-of-flight");
+    auto step = static_cast<uint64_t>(quanta - previous);
+    previous = quanta;
+    while (step >= 0x80) {
+      m_tofSteps.push_back(static_cast<uint8_t>(step | 0x80));
+      step >>= 7;
+    }
+    m_tofSteps.push_back(static_cast<uint8_t>(step));
+  }
+  m_tofSteps.shrink_to_fit();
+  m_tofMax = m_tofMin + static_cast<double>(previous) * tofResolution;
+}
+
+/** Store the weights and squared errors, in the most compact exact form.
+ * @param events :: the weighted events
+ */
+template <class T>
+void CompressedEvents::encodeWeights(const std::vector<T> &events) {
+  uint16_t half;
+  m_weightEncoding = WeightEncoding::Half;
+  for (const auto &event : events) {
+    if (!toHalfExactly(static_cast<float>(event.weight()), half)) {
+      m_weightEncoding = WeightEncoding::Float;
+      break;
+    }
+  }
+  if (m_weightEncoding == WeightEncoding::Half) {
+    m_halfWeights.reserve(events.size());
+    for (const auto &event : events) {
+      toHalfExactly(static_cast<float>(event.weight()), half);
+      m_halfWeights.push_back(half);
+    }
+  } else {
+    m_weights.reserve(events.size());
+    for (const auto &event : events)
+      m_weights.push_back(static_cast<float>(event.weight()));
+  }
+
+  const auto allErrors = [&events](bool (*matches)(float, float)) {
+    return std::all_of(events.cbegin(), events.cend(), [matches](const T &e) {
+      return matches(static_cast<float>(e.weight()),
+                     static_cast<float>(e.errorSquared()));
+    });
+  };
+  if (allErrors([](float w, float e2) { return e2 == w; })) {
+    m_errorEncoding = ErrorEncoding::Poisson;
+  } else if (allErrors([](float w, float e2) { return e2 == w * w; })) {
+    m_errorEncoding = ErrorEncoding::Proportional;
+  } else {
+    m_errorEncoding = ErrorEncoding::Explicit;
+    m_errorSquared.reserve(events.size());
+    for (const auto &event : events)
+      m_errorSquared.push_back(static_cast<float>(event.errorSquared()));
+  }
+}
+
+/** Store the pulse time of each event as an index into a table.
+ * @param events :: events with pulse times
+ * @param pulseTimes :: table holding every pulse time of the events. If NULL
+ * a table is made from the events.
+ */
+template <class T>
+void CompressedEvents::encodePulseTimes(const std::vector<T> &events,
+                                        PulseTimes pulseTimes) {
+  if (!pulseTimes) {
+    std::vector<int64_t> times;
+    times.reserve(events.size());
+    for (const auto &event : events)
+      times.push_back(event.pulseTime().totalNanoseconds());
+    pulseTimes = makePulseTimes(std::move(times));
+  }
+  if (pulseTimes->size() > std::numeric_limits<uint32_t>::max())
+    throw std::invalid_argument("CompressedEvents: too many pulse times");
+
+  const auto &table = *pulseTimes;
+  m_pulseIndices.reserve(events.size());
+  for (const auto &event : events) {
+    const int64_t time = event.pulseTime().totalNanoseconds();
+    const auto it = std::lower_bound(table.cbegin(), table.cend(), time);
+    if (it == table.cend() || *it != time)
+      throw std::invalid_argument(
+          "CompressedEvents: a pulse time is missing from the table");
+    m_pulseIndices.push_back(
+        static_cast<uint32_t>(std::distance(table.cbegin(), it)));
+  }
+  m_pulseTimes = std::move(pulseTimes);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
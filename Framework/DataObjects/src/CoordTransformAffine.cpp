@@ -17,6 +17,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
+
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
 using Mantid::API::CoordTransform;
@@ -24,6 +26,37 @@ using Mantid::API::CoordTransform;
 namespace Mantid {
 namespace DataObjects {
 
+namespace {
+/** Apply an affine matrix to many vectors of a fixed number of dimensions.
+ * With the loops over the input dimensions known at compile time, the
+ * compiler unrolls them and keeps the matrix in registers.
+ * @param rawMatrix :: rows of the affine matrix, at least outD
+ * @param outD :: number of output dimensions, <= inD
+ * @param in :: the first input vector
+ * @param inputStride :: distance between the starts of two input vectors
+ * @param out :: array of nVectors * outD output coordinates
+ * @param nVectors :: number of vectors to transform
+ */
+template <size_t inD>
+void applyAffineBatch(coord_t *const *rawMatrix, const size_t outD,
+                      const coord_t *in, const size_t inputStride,
+                      coord_t *out, const size_t nVectors) {
+  coord_t matrix[inD][inD + 1];
+  for (size_t row = 0; row < outD; ++row)
+    std::copy(rawMatrix[row], rawMatrix[row] + inD + 1, matrix[row]);
+
+  for (size_t i = 0; i < nVectors; ++i, in += inputStride, out += outD) {
+    for (size_t row = 0; row < outD; ++row) {
+      coord_t outVal = 0.0;
+      for (size_t col = 0; col < inD; ++col)
+        outVal += matrix[row][col] * in[col];
+      // Same order of operations as apply(), so the results are identical
+      out[row] = outVal + matrix[row][inD];
+    }
+  }
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor.
  * Construct the affine matrix to and initialize to an identity matrix.
@@ -284,6 +317,34 @@ void CoordTransformAffine::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to many vectors. The common cases of
+ * 3 and 4 input dimensions are specialized at compile time.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance between the starts of two input vectors
+ * @param outVectors :: array of nVectors * outD output coordinates
+ * @param nVectors :: number of vectors to transform
+ */
+void CoordTransformAffine::applyBatch(const coord_t *inputVectors,
+                                      const size_t inputStride,
+                                      coord_t *outVectors,
+                                      const size_t nVectors) const {
+  switch (inD) {
+  case 3:
+    applyAffineBatch<3>(m_rawMatrix, outD, inputVectors, inputStride,
+                        outVectors, nVectors);
+    break;
+  case 4:
+    applyAffineBatch<4>(m_rawMatrix, outD, inputVectors, inputStride,
+                        outVectors, nVectors);
+    break;
+  default:
+    CoordTransform::applyBatch(inputVectors, inputStride, outVectors,
+                               nVectors);
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform
  *
@@ -15,6 +15,36 @@ using namespace Mantid::API;
 namespace Mantid {
 namespace DataObjects {
 
+namespace {
+/** Apply an axis-aligned transformation to many vectors, for a fixed number
+ * of output dimensions.
+ * @param dimensionToBinFrom :: input dimension of each output dimension
+ * @param origin :: offset in each of the output dimensions
+ * @param scaling :: scaling of each of the output dimensions
+ * @param in :: the first input vector
+ * @param inputStride :: distance between the starts of two input vectors
+ * @param out :: array of nVectors * outD output coordinates
+ * @param nVectors :: number of vectors to transform
+ */
+template <size_t outD>
+void applyAlignedBatch(const size_t *dimensionToBinFrom, const coord_t *origin,
+                       const coord_t *scaling, const coord_t *in,
+                       const size_t inputStride, coord_t *out,
+                       const size_t nVectors) {
+  size_t dims[outD];
+  coord_t offsets[outD], scales[outD];
+  for (size_t d = 0; d < outD; ++d) {
+    dims[d] = dimensionToBinFrom[d];
+    offsets[d] = origin[d];
+    scales[d] = scaling[d];
+  }
+  for (size_t i = 0; i < nVectors; ++i, in += inputStride, out += outD) {
+    for (size_t d = 0; d < outD; ++d)
+      out[d] = (in[dims[d]] - offsets[d]) * scales[d];
+  }
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  *
@@ -139,6 +169,34 @@ void CoordTransformAligned::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to many vectors. The common cases of
+ * 3 and 4 output dimensions are specialized at compile time.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance between the starts of two input vectors
+ * @param outVectors :: array of nVectors * outD output coordinates
+ * @param nVectors :: number of vectors to transform
+ */
+void CoordTransformAligned::applyBatch(const coord_t *inputVectors,
+                                       const size_t inputStride,
+                                       coord_t *outVectors,
+                                       const size_t nVectors) const {
+  switch (outD) {
+  case 3:
+    applyAlignedBatch<3>(m_dimensionToBinFrom, m_origin, m_scaling,
+                         inputVectors, inputStride, outVectors, nVectors);
+    break;
+  case 4:
+    applyAlignedBatch<4>(m_dimensionToBinFrom, m_origin, m_scaling,
+                         inputVectors, inputStride, outVectors, nVectors);
+    break;
+  default:
+    CoordTransform::applyBatch(inputVectors, inputStride, outVectors,
+                               nVectors);
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create an equivalent affine transformation matrix out of the
  * parameters of this axis-aligned transformation.
@@ -19,6 +19,42 @@ using Mantid::API::CoordTransform;
 namespace Mantid {
 namespace DataObjects {
 
+namespace {
+/** Calculate the squared distances of many vectors to a center, for a fixed
+ * number of input dimensions.
+ * @param center :: the center, sized [inD]
+ * @param dimensionsUsed :: true for the dimensions included in the distance
+ * @param in :: the first input vector
+ * @param inputStride :: distance between the starts of two input vectors
+ * @param out :: array of nVectors squared distances
+ * @param nVectors :: number of vectors to transform
+ */
+template <size_t inD>
+void applyDistanceBatch(const coord_t *center, const bool *dimensionsUsed,
+                        const coord_t *in, const size_t inputStride,
+                        coord_t *out, const size_t nVectors) {
+  // Unused dimensions are skipped rather than weighted by zero, so that
+  // infinite coordinates in them do not spoil the distance
+  size_t used[inD];
+  coord_t usedCenter[inD];
+  size_t nUsed = 0;
+  for (size_t d = 0; d < inD; ++d) {
+    if (dimensionsUsed[d]) {
+      used[nUsed] = d;
+      usedCenter[nUsed++] = center[d];
+    }
+  }
+  for (size_t i = 0; i < nVectors; ++i, in += inputStride) {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nUsed; ++d) {
+      const coord_t dist = in[used[d]] - usedCenter[d];
+      distanceSquared += (dist * dist);
+    }
+    out[i] = distanceSquared;
+  }
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  *
@@ -102,6 +138,30 @@ void CoordTransformDistance::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to many vectors. The squared distance
+ * in 3 and 4 input dimensions is specialized at compile time.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance between the starts of two input vectors
+ * @param outVectors :: array of nVectors * outD output coordinates
+ * @param nVectors :: number of vectors to transform
+ */
+void CoordTransformDistance::applyBatch(const coord_t *inputVectors,
+                                        const size_t inputStride,
+                                        coord_t *outVectors,
+                                        const size_t nVectors) const {
+  if (outD == 1 && inD == 3)
+    applyDistanceBatch<3>(m_center, m_dimensionsUsed, inputVectors,
+                          inputStride, outVectors, nVectors);
+  else if (outD == 1 && inD == 4)
+    applyDistanceBatch<4>(m_center, m_dimensionsUsed, inputVectors,
+                          inputStride, outVectors, nVectors);
+  else
+    CoordTransform::applyBatch(inputVectors, inputStride, outVectors,
+                               nVectors);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform distance
  *
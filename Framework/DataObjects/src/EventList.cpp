@@ -12,6 +12,8 @@
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/RadixSort.h"
+#include "MantidKernel/RegularBinFinder.h"
 #include "MantidKernel/Unit.h"
 
 #ifdef _MSC_VER
@@ -23,10 +25,12 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <array>
 #include <cfloat>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <numeric>
 #include <stdexcept>
 
 using std::ostream;
@@ -60,6 +64,130 @@ int64_t calculateCorrectedFullTime(const EventType &event,
                               (tofShift * 1.0E9));
 }
 
+/// Lists shorter than this are sorted with a comparison sort instead of a
+/// radix sort
+constexpr size_t RADIX_SORT_MIN_EVENTS = 512;
+/// Memory (in bytes) each thread may keep for the radix sort scratch of each
+/// value type. Lists whose scratch would not fit are sorted with
+/// tbb::parallel_sort instead, so the scratch is never reallocated once it
+/// has grown to this size, and mid-size and long lists use all the cores.
+constexpr size_t RADIX_SORT_SCRATCH_BYTES = 2 * 1024 * 1024;
+
+/// Scratch buffer for radix sorting, reused by all the sorts on one thread
+template <class T> std::vector<T> &sortScratch() {
+  static thread_local std::vector<T> scratch;
+  return scratch;
+}
+
+/// @return true if a list of the given length is radix sorted
+template <class T> bool useRadixSort(const size_t size) {
+  return size >= RADIX_SORT_MIN_EVENTS &&
+         size * sizeof(T) <= RADIX_SORT_SCRATCH_BYTES;
+}
+
+/**
+ * Sort a vector with a radix sort on the key if its scratch fits in the per
+ * thread budget, and with a comparison sort otherwise. The radix sort is
+ * stable, the comparison sort is not.
+ * @param values : Values to sort
+ * @param key : Callable returning the radix sort key of a value
+ * @param compare : Comparison matching the key
+ */
+template <class T, typename KeyFunction, typename Compare>
+void radixOrParallelSort(std::vector<T> &values, KeyFunction key,
+                         Compare compare) {
+  if (useRadixSort<T>(values.size()))
+    Kernel::radixSort(values, key, sortScratch<T>());
+  else
+    tbb::parallel_sort(values.begin(), values.end(), compare);
+}
+
+/// Copy a vector into a new buffer of exactly its size, freeing the old one
+template <class T> void reallocate(std::vector<T> &values) {
+  std::vector<T>(values.begin(), values.end()).swap(values);
+}
+
+/// Sort any type of event by TOF
+template <class T> void sortEventsByTof(std::vector<T> &events) {
+  radixOrParallelSort(
+      events, [](const T &event) { return Kernel::radixSortKey(event.tof()); },
+      [](const T &lhs, const T &rhs) { return lhs.tof() < rhs.tof(); });
+}
+
+/// Sort TofEvents or WeightedEvents by pulse time
+template <class T> void sortEventsByPulseTime(std::vector<T> &events) {
+  radixOrParallelSort(events,
+                      [](const T &event) {
+                        return Kernel::radixSortKey(
+                            event.pulseTime().totalNanoseconds());
+                      },
+                      [](const T &lhs, const T &rhs) {
+                        return lhs.pulseTime() < rhs.pulseTime();
+                      });
+}
+
+/// Sort TofEvents or WeightedEvents by pulse time, then by TOF, in a single
+/// comparison sort on the combined key
+template <class T> void sortEventsByPulseTimeTof(std::vector<T> &events) {
+  tbb::parallel_sort(events.begin(), events.end(),
+                     [](const T &lhs, const T &rhs) {
+                       if (lhs.pulseTime() == rhs.pulseTime())
+                         return lhs.tof() < rhs.tof();
+                       return lhs.pulseTime() < rhs.pulseTime();
+                     });
+}
+
+/// Number of events handed to the bin finder at once
+constexpr size_t BIN_BLOCK_SIZE = 1024;
+
+/**
+ * Histogram events into linearly or logarithmically spaced bins. The events
+ * do not need to be sorted: their TOFs are gathered in blocks and the bins of
+ * a whole block are found arithmetically in one go.
+ * @param binFinder : Bin finder for the (regular) bin edges
+ * @param numEvents : Number of events to histogram
+ * @param tofAt : Callable returning the TOF of the i-th event
+ * @param addEvent : Callable taking the index of an event and its bin, called
+ * for every event inside the bin edges
+ */
+template <typename TofAt, typename AddEvent>
+void histogramRegularBins(const Kernel::RegularBinFinder &binFinder,
+                          const size_t numEvents, TofAt tofAt,
+                          AddEvent addEvent) {
+  std::array<double, BIN_BLOCK_SIZE> tofs;
+  std::array<int, BIN_BLOCK_SIZE> bins;
+  for (size_t start = 0; start < numEvents; start += BIN_BLOCK_SIZE) {
+    const size_t count = std::min(BIN_BLOCK_SIZE, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = tofAt(start + i);
+    binFinder.findBins(tofs.data(), count, bins.data());
+    for (size_t i = 0; i < count; ++i) {
+      if (bins[i] >= 0)
+        addEvent(start + i, static_cast<size_t>(bins[i]));
+    }
+  }
+}
+
+/**
+ * Sum the weights and squared errors of weighted events into linearly or
+ * logarithmically spaced bins.
+ * @param events : Vector of WeightedEvent or WeightedEventNoTime
+ * @param binFinder : Bin finder for the (regular) bin edges
+ * @param Y : Sum of the weights, must be sized and zeroed
+ * @param E : Sum of the squared errors, must be sized and zeroed
+ */
+template <class T>
+void histogramWeightsRegularBins(const std::vector<T> &events,
+                                 const Kernel::RegularBinFinder &binFinder,
+                                 MantidVec &Y, MantidVec &E) {
+  histogramRegularBins(binFinder, events.size(),
+                       [&events](const size_t i) { return events[i].tof(); },
+                       [&events, &Y, &E](const size_t i, const size_t bin) {
+                         Y[bin] += double(events[i].m_weight);
+                         E[bin] += double(events[i].m_errorSquared);
+                       });
+}
+
 /**
  * Type for comparing events in terms of time at sample
  */
@@ -96,31 +224,6 @@ public:
 /// --------------------- TofEvent Comparators
 /// ----------------------------------
 //==========================================================================
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTime(const TofEvent &e1, const TofEvent &e2) {
-  return (e1.pulseTime() < e2.pulseTime());
-}
-
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- *  Assuming that if e1's pulse time is earlier than e2's, then e1 must be
- * earlier regardless TOF value
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
-
-  if (e1.pulseTime() < e2.pulseTime()) {
-    return true;
-  } else if ((e1.pulseTime() == e2.pulseTime()) && (e1.tof() < e2.tof())) {
-    return true;
-  }
-
-  return false;
-}
-
 // comparator for pulse time with tolerance
 struct comparePulseTimeTOFDelta {
   explicit comparePulseTimeTOFDelta(const Types::Core::DateAndTime &start,
@@ -230,7 +333,12 @@ void EventList::copyDataInto(EventList &sink) const {
   sink.events = events;
   sink.weightedEvents = weightedEvents;
   sink.weightedEventsNoTime = weightedEventsNoTime;
+  const EventStorageLayout layout = m_layout.load(std::memory_order_acquire);
+  sink.m_columns = layout == STRUCT_OF_ARRAYS ? m_columns : EventColumns();
+  sink.m_compressed = layout == COMPRESSED ? m_compressed : CompressedEvents();
   sink.eventType = eventType;
+  sink.m_layout = layout;
+  sink.m_hasUnusedStorage = false;
   sink.order = order;
 }
 
@@ -340,7 +448,13 @@ EventList &EventList::operator=(const EventList &rhs) {
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  const EventStorageLayout layout =
+      rhs.m_layout.load(std::memory_order_acquire);
+  m_columns = layout == STRUCT_OF_ARRAYS ? rhs.m_columns : EventColumns();
+  m_compressed = layout == COMPRESSED ? rhs.m_compressed : CompressedEvents();
   eventType = rhs.eventType;
+  m_layout = layout;
+  m_hasUnusedStorage = false;
   order = rhs.order;
   return *this;
 }
@@ -351,6 +465,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  this->switchToArrayOfStructs();
 
   switch (this->eventType) {
   case TOF:
@@ -379,6 +494,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  this->switchToArrayOfStructs();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -419,6 +535,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  this->switchToArrayOfStructs();
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -435,6 +552,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  this->switchToArrayOfStructs();
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -472,6 +590,7 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  this->switchToArrayOfStructs();
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -500,6 +619,8 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  this->switchToArrayOfStructs();
+  more_events.switchToArrayOfStructs();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -561,6 +682,8 @@ void EventList::minusHelper(std::vector<T1> &events,
  * @return reference to this
  * */
 EventList &EventList::operator-=(const EventList &more_events) {
+  this->switchToArrayOfStructs();
+  more_events.switchToArrayOfStructs();
   if (this == &more_events) {
     // Special case, ticket #3844 part 2.
     // When doing this = this - this,
@@ -618,6 +741,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
  * @return :: true if equal.
  */
 bool EventList::operator==(const EventList &rhs) const {
+  this->switchToArrayOfStructs();
+  rhs.switchToArrayOfStructs();
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
   if (this->eventType != rhs.eventType)
@@ -642,6 +767,8 @@ bool EventList::operator!=(const EventList &rhs) const {
 
 bool EventList::equals(const EventList &rhs, const double tolTof,
                        const double tolWeight, const int64_t tolPulse) const {
+  this->switchToArrayOfStructs();
+  rhs.switchToArrayOfStructs();
   // generic checks
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
@@ -690,6 +817,7 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  this->switchToArrayOfStructs();
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -770,6 +898,231 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Choose how the events are laid out in memory.
+ *
+ * In the STRUCT_OF_ARRAYS layout each event field is held in its own
+ * contiguous column, so that histogramming and TOF/unit conversions only
+ * stream the time-of-flight values. Operations that have no column-wise
+ * implementation transparently move the events back to the
+ * ARRAY_OF_STRUCTS layout before running, and the list stays there. Const
+ * operations only copy the events, under the sort mutex, so they can run on
+ * the same list from several threads; the columns are freed by the next
+ * non-const operation.
+ *
+ * The COMPRESSED layout needs a resolution, use setCompressedStorage().
+ *
+ * @param layout :: the layout to switch to
+ * @throw std::invalid_argument if layout is COMPRESSED
+ */
+void EventList::setStorageLayout(const EventStorageLayout layout) {
+  if (layout == m_layout)
+    return;
+  if (layout == COMPRESSED)
+    throw std::invalid_argument("EventList::setStorageLayout(): use "
+                                "setCompressedStorage() to compress events");
+  this->switchToArrayOfStructs();
+  if (layout == STRUCT_OF_ARRAYS)
+    this->packColumns();
+}
+
+/** Return the memory layout currently used for the events.
+ * @return :: a EventStorageLayout value.
+ */
+EventStorageLayout EventList::getStorageLayout() const { return m_layout; }
+
+/** Move the events from the event vectors into m_columns.
+ */
+void EventList::packColumns() {
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  if (m_layout == STRUCT_OF_ARRAYS)
+    return;
+
+  m_columns.clear();
+  switch (eventType) {
+  case TOF:
+    m_columns.tof.reserve(events.size());
+    m_columns.pulseTime.reserve(events.size());
+    for (const auto &event : events) {
+      m_columns.tof.push_back(event.m_tof);
+      m_columns.pulseTime.push_back(event.m_pulsetime.totalNanoseconds());
+    }
+    break;
+  case WEIGHTED:
+    m_columns.tof.reserve(weightedEvents.size());
+    m_columns.pulseTime.reserve(weightedEvents.size());
+    m_columns.weight.reserve(weightedEvents.size());
+    m_columns.errorSquared.reserve(weightedEvents.size());
+    for (const auto &event : weightedEvents) {
+      m_columns.tof.push_back(event.m_tof);
+      m_columns.pulseTime.push_back(event.m_pulsetime.totalNanoseconds());
+      m_columns.weight.push_back(event.m_weight);
+      m_columns.errorSquared.push_back(event.m_errorSquared);
+    }
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns.tof.reserve(weightedEventsNoTime.size());
+    m_columns.weight.reserve(weightedEventsNoTime.size());
+    m_columns.errorSquared.reserve(weightedEventsNoTime.size());
+    for (const auto &event : weightedEventsNoTime) {
+      m_columns.tof.push_back(event.m_tof);
+      m_columns.weight.push_back(event.m_weight);
+      m_columns.errorSquared.push_back(event.m_errorSquared);
+    }
+    break;
+  }
+  // Free the memory of the struct vectors
+  std::vector<TofEvent>().swap(events);
+  std::vector<WeightedEvent>().swap(weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(weightedEventsNoTime);
+  m_layout = STRUCT_OF_ARRAYS;
+}
+
+/** Copy the events from m_columns back into the event vectors. This is const
+ * since any (const) operation without a column-wise implementation needs it;
+ * the sort mutex protects against concurrent callers. The columns are left as
+ * they are, since other threads may still be reading them, until a non-const
+ * operation calls releaseUnusedStorage().
+ */
+void EventList::unpackColumns() const {
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  if (m_layout.load(std::memory_order_relaxed) != STRUCT_OF_ARRAYS)
+    return;
+
+  const size_t numEvents = m_columns.size();
+  switch (eventType) {
+  case TOF:
+    events.clear();
+    events.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      events.emplace_back(m_columns.tof[i],
+                          DateAndTime(m_columns.pulseTime[i]));
+    break;
+  case WEIGHTED:
+    weightedEvents.clear();
+    weightedEvents.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      weightedEvents.emplace_back(
+          m_columns.tof[i], DateAndTime(m_columns.pulseTime[i]),
+          m_columns.weight[i], m_columns.errorSquared[i]);
+    break;
+  case WEIGHTED_NOTIME:
+    weightedEventsNoTime.clear();
+    weightedEventsNoTime.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      weightedEventsNoTime.emplace_back(m_columns.tof[i], m_columns.weight[i],
+                                        m_columns.errorSquared[i]);
+    break;
+  }
+  m_hasUnusedStorage = true;
+  // Publish the event vectors to readers that load the layout
+  m_layout.store(ARRAY_OF_STRUCTS, std::memory_order_release);
+}
+
+/** Keep the events in the COMPRESSED layout, to reduce their memory use.
+ *
+ * The events are sorted by TOF, and each TOF is rounded to a multiple of
+ * tofResolution from the smallest one; pulse times, weights and errors are
+ * kept exactly (see CompressedEvents). Histogramming, getTofs() and linear
+ * TOF conversions work on the compressed events. Any other operation decodes
+ * the events back to the ARRAY_OF_STRUCTS layout first, and the list stays
+ * there.
+ *
+ * @param tofResolution :: quantum of the TOF, in the units of the TOF. Use
+ * the same value as the tolerance of CompressEvents to lose no more
+ * resolution than it does.
+ * @param pulseTimes :: table of pulse times to share with other lists, e.g.
+ * of the whole workspace. If NULL a table is made for this list.
+ * @throw std::invalid_argument if tofResolution is not positive or a pulse
+ * time is missing from the table. The events are unchanged in that case.
+ */
+void EventList::setCompressedStorage(
+    const double tofResolution,
+    const CompressedEvents::PulseTimes &pulseTimes) {
+  this->switchToArrayOfStructs();
+  this->sortTof();
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  if (mru)
+    mru->deleteIndex(this);
+
+  CompressedEvents compressed;
+  switch (eventType) {
+  case TOF:
+    compressed.encode(events, tofResolution, pulseTimes);
+    break;
+  case WEIGHTED:
+    compressed.encode(weightedEvents, tofResolution, pulseTimes);
+    break;
+  case WEIGHTED_NOTIME:
+    compressed.encode(weightedEventsNoTime, tofResolution);
+    break;
+  }
+  m_compressed = std::move(compressed);
+  // Free the memory of the struct vectors
+  std::vector<TofEvent>().swap(events);
+  std::vector<WeightedEvent>().swap(weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(weightedEventsNoTime);
+  m_layout = COMPRESSED;
+}
+
+/** Decode the events from m_compressed back into the event vectors. This is
+ * const, and leaves m_compressed as it is, for the same reasons as
+ * unpackColumns().
+ */
+void EventList::unpackCompressed() const {
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  if (m_layout.load(std::memory_order_relaxed) != COMPRESSED)
+    return;
+
+  switch (eventType) {
+  case TOF:
+    m_compressed.decode(events);
+    break;
+  case WEIGHTED:
+    m_compressed.decode(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_compressed.decode(weightedEventsNoTime);
+    break;
+  }
+  m_hasUnusedStorage = true;
+  m_layout.store(ARRAY_OF_STRUCTS, std::memory_order_release);
+}
+
+/** Free the columns or compressed events left behind when a const operation
+ * copied the events to the event vectors. Non-const, so no other thread can
+ * be reading them.
+ */
+void EventList::releaseUnusedStorage() {
+  const EventStorageLayout layout = m_layout.load(std::memory_order_relaxed);
+  if (layout != STRUCT_OF_ARRAYS)
+    m_columns.clear();
+  if (layout != COMPRESSED)
+    m_compressed.clear();
+  m_hasUnusedStorage = false;
+}
+
+/** Sort the event columns by TOF. Called by sortTof() with the sort mutex
+ * held. The order is found from the TOF column alone, and the events are then
+ * moved into it in place.
+ */
+void EventList::sortColumnsByTof() const {
+  const auto &tofs = m_columns.tof;
+  if (std::is_sorted(tofs.cbegin(), tofs.cend()))
+    return;
+  std::vector<size_t> indices(tofs.size());
+  std::iota(indices.begin(), indices.end(), size_t{0});
+  const auto compare = [&tofs](const size_t lhs, const size_t rhs) {
+    return tofs[lhs] < tofs[rhs];
+  };
+  radixOrParallelSort(indices,
+                      [&tofs](const size_t index) {
+                        return Kernel::radixSortKey(tofs[index]);
+                      },
+                      compare);
+  m_columns.permute(indices);
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -782,6 +1135,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  this->switchToArrayOfStructs();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -808,6 +1162,7 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  this->switchToArrayOfStructs();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -823,6 +1178,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  this->switchToArrayOfStructs();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -838,6 +1194,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  this->switchToArrayOfStructs();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -853,6 +1210,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  this->switchToArrayOfStructs();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -866,6 +1224,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  this->switchToArrayOfStructs();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -880,6 +1239,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * */
 const std::vector<WeightedEventNoTime> &
 EventList::getWeightedEventsNoTime() const {
+  this->switchToArrayOfStructs();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -901,6 +1261,10 @@ void EventList::clear(const bool removeDetIDs) {
   this->weightedEventsNoTime.clear();
   std::vector<WeightedEventNoTime>().swap(
       this->weightedEventsNoTime); // STL Trick to release memory
+  m_columns.clear();
+  m_compressed.clear();
+  m_hasUnusedStorage = false;
+  m_layout = ARRAY_OF_STRUCTS;
   if (removeDetIDs)
     this->clearDetectorIDs();
 }
@@ -926,6 +1290,25 @@ void EventList::clearUnused() {
   }
 }
 
+/** Copy the events into newly allocated memory and free the old buffers.
+ *
+ * Operating systems usually place a memory page on the NUMA node of the
+ * thread that first writes to it. Calling this from the thread that will
+ * process the list therefore moves its events to memory local to that
+ * thread. See EventWorkspace::applyNumaPlacement().
+ */
+void EventList::reallocateEvents() {
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  reallocate(this->events);
+  reallocate(this->weightedEvents);
+  reallocate(this->weightedEventsNoTime);
+  reallocate(m_columns.tof);
+  reallocate(m_columns.pulseTime);
+  reallocate(m_columns.weight);
+  reallocate(m_columns.errorSquared);
+  m_compressed = CompressedEvents(m_compressed);
+}
+
 /// Mask the spectrum to this value. Removes all events.
 void EventList::clearData() { this->clear(false); }
 
@@ -944,7 +1327,10 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  this->switchToArrayOfStructs();
+  this->events.reserve(num);
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -985,7 +1371,7 @@ void EventList::setSortOrder(const EventSortType order) const {
 }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
+/** Sort events by TOF, using all threads for very long lists */
 void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return; // nothing to do
@@ -996,16 +1382,26 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    this->sortColumnsByTof();
+    this->order = TOF_SORT;
+    return;
+  }
+  // Compressed events are always sorted by TOF
+  if (m_layout == COMPRESSED) {
+    this->order = TOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end());
+    sortEventsByTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end());
+    sortEventsByTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(),
-                       weightedEventsNoTime.end());
+    sortEventsByTof(weightedEventsNoTime);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1024,6 +1420,7 @@ void EventList::sortTof() const {
 void EventList::sortTimeAtSample(const double &tofFactor,
                                  const double &tofShift,
                                  bool forceResort) const {
+  this->switchToArrayOfStructs();
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1058,6 +1455,7 @@ void EventList::sortTimeAtSample(const double &tofFactor,
 // --------------------------------------------------------------------------
 /** Sort events by Frame */
 void EventList::sortPulseTime() const {
+  this->switchToArrayOfStructs();
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1070,11 +1468,10 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    sortEventsByPulseTime(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
+    sortEventsByPulseTime(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1089,6 +1486,7 @@ void EventList::sortPulseTime() const {
  * (the absolute time)
  */
 void EventList::sortPulseTimeTOF() const {
+  this->switchToArrayOfStructs();
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
@@ -1100,11 +1498,10 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    sortEventsByPulseTimeTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
+    sortEventsByPulseTimeTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1124,6 +1521,7 @@ void EventList::sortPulseTimeTOF() const {
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                                       const double seconds) const {
+  this->switchToArrayOfStructs();
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1166,7 +1564,11 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof())
+    this->switchFromCompressed();
+  if (this->isSortedByTof() && m_layout == STRUCT_OF_ARRAYS) {
+    m_columns.reverse();
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1193,6 +1595,11 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  const EventStorageLayout layout = m_layout.load(std::memory_order_acquire);
+  if (layout == STRUCT_OF_ARRAYS)
+    return m_columns.size();
+  if (layout == COMPRESSED)
+    return m_compressed.size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1208,6 +1615,11 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  const EventStorageLayout layout = m_layout.load(std::memory_order_acquire);
+  if (layout == STRUCT_OF_ARRAYS)
+    return m_columns.empty();
+  if (layout == COMPRESSED)
+    return m_compressed.empty();
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1227,15 +1639,24 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  const EventStorageLayout layout = m_layout.load(std::memory_order_acquire);
+  if (layout == STRUCT_OF_ARRAYS)
+    return m_columns.getMemorySize() + sizeof(EventList);
+  if (layout == COMPRESSED)
+    return m_compressed.getMemorySize() + sizeof(EventList);
+  // Include any columns or compressed events a const operation left behind
+  const size_t unused =
+      m_columns.getMemorySize() + m_compressed.getMemorySize();
   switch (eventType) {
   case TOF:
-    return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
+    return this->events.capacity() * sizeof(TofEvent) + unused +
+           sizeof(EventList);
   case WEIGHTED:
-    return this->weightedEvents.capacity() * sizeof(WeightedEvent) +
+    return this->weightedEvents.capacity() * sizeof(WeightedEvent) + unused +
            sizeof(EventList);
   case WEIGHTED_NOTIME:
     return this->weightedEventsNoTime.capacity() * sizeof(WeightedEventNoTime) +
-           sizeof(EventList);
+           unused + sizeof(EventList);
   }
   throw std::runtime_error("EventList: invalid event type value was found.");
 }
@@ -1709,6 +2130,8 @@ inline void EventList::compressFatEventsHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  this->switchToArrayOfStructs();
+  destination->switchToArrayOfStructs();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1765,6 +2188,8 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 void EventList::compressFatEvents(
     const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
     const double seconds, EventList *destination) {
+  this->switchToArrayOfStructs();
+  destination->switchToArrayOfStructs();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -1999,6 +2424,7 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
  */
 void EventList::generateHistogramPulseTime(const MantidVec &X, MantidVec &Y,
                                            MantidVec &E, bool skipError) const {
+  this->switchToArrayOfStructs();
   // All types of weights need to be sorted by Pulse Time
   this->sortPulseTime();
 
@@ -2036,6 +2462,7 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
                                               const double &tofFactor,
                                               const double &tofOffset,
                                               bool skipError) const {
+  this->switchToArrayOfStructs();
   // All types of weights need to be sorted by time at sample
   this->sortTimeAtSample(tofFactor, tofOffset);
 
@@ -2061,6 +2488,10 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
 /** Generates both the Y and E (error) histograms w.r.t TOF
  * for an EventList with or without WeightedEvents.
  *
+ * Linearly or logarithmically spaced bins are filled without sorting the
+ * events, so the sort order of the list is left unchanged. Any other bins
+ * sort the events by TOF first, as before.
+ *
  * @param X: x-bins supplied
  * @param Y: counts returned
  * @param E: errors returned
@@ -2069,10 +2500,26 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  // Linear and logarithmic bins are found arithmetically, without sorting
+  const Kernel::RegularBinFinder binFinder(X);
+  if (binFinder.isRegular()) {
+    this->generateHistogramRegular(binFinder, X.size() - 1, Y, E, skipError);
+    return;
+  }
+
+  // All other types of binning need the events to be sorted by TOF
 
   this->sortTof();
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    this->generateHistogramFromColumns(X, Y, E, skipError);
+    return;
+  }
+  if (m_layout == COMPRESSED) {
+    this->generateHistogramFromCompressed(X, Y, E, skipError);
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     // Make the single ones
@@ -2091,6 +2538,182 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
   }
 }
 
+// --------------------------------------------------------------------------
+/** Generates the Y and E histograms w.r.t TOF for linearly or logarithmically
+ * spaced bins. The events do not need to be (and are not) sorted.
+ *
+ * @param binFinder: bin finder set up with the (regular) x-bins
+ * @param numBins: number of bins
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error for unweighted events.
+ */
+void EventList::generateHistogramRegular(
+    const Kernel::RegularBinFinder &binFinder, const size_t numBins,
+    MantidVec &Y, MantidVec &E, bool skipError) const {
+  const bool weighted = (eventType != TOF);
+  Y.assign(numBins, 0.0);
+  if (weighted)
+    E.assign(numBins, 0.0);
+
+  const auto countEvent = [&Y](const size_t, const size_t bin) { ++Y[bin]; };
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    const auto &tofs = m_columns.tof;
+    const auto tofAt = [&tofs](const size_t i) { return tofs[i]; };
+    if (weighted) {
+      const auto &weights = m_columns.weight;
+      const auto &errors = m_columns.errorSquared;
+      histogramRegularBins(binFinder, tofs.size(), tofAt,
+                           [&](const size_t i, const size_t bin) {
+                             Y[bin] += double(weights[i]);
+                             E[bin] += double(errors[i]);
+                           });
+    } else {
+      histogramRegularBins(binFinder, tofs.size(), tofAt, countEvent);
+    }
+  } else if (m_layout == COMPRESSED) {
+    // The bins are filled in order, so the TOFs can be decoded on the way
+    auto cursor = m_compressed.tofs();
+    const auto tofAt = [&cursor](const size_t) { return cursor.next(); };
+    if (weighted) {
+      histogramRegularBins(binFinder, m_compressed.size(), tofAt,
+                           [&](const size_t i, const size_t bin) {
+                             Y[bin] += double(m_compressed.weight(i));
+                             E[bin] += double(m_compressed.errorSquared(i));
+                           });
+    } else {
+      histogramRegularBins(binFinder, m_compressed.size(), tofAt, countEvent);
+    }
+  } else {
+    switch (eventType) {
+    case TOF:
+      histogramRegularBins(binFinder, events.size(),
+                           [this](const size_t i) { return events[i].tof(); },
+                           countEvent);
+      break;
+    case WEIGHTED:
+      histogramWeightsRegularBins(weightedEvents, binFinder, Y, E);
+      break;
+    case WEIGHTED_NOTIME:
+      histogramWeightsRegularBins(weightedEventsNoTime, binFinder, Y, E);
+      break;
+    }
+  }
+
+  if (weighted)
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  else if (!skipError)
+    this->generateErrorsHistogram(Y, E);
+}
+
+// --------------------------------------------------------------------------
+/** Generates the Y and E histograms w.r.t TOF from the event columns.
+ * The columns must already be sorted by TOF. Only the tof column (and the
+ * weight columns for weighted events) are read.
+ *
+ * @param X: x-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error for unweighted events.
+ */
+void EventList::generateHistogramFromColumns(const MantidVec &X, MantidVec &Y,
+                                             MantidVec &E,
+                                             bool skipError) const {
+  const size_t x_size = X.size();
+  if (x_size <= 1) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+
+  const bool weighted = (eventType != TOF);
+  Y.assign(x_size - 1, 0.0);
+  if (weighted)
+    E.assign(x_size - 1, 0.0);
+
+  const auto &tofs = m_columns.tof;
+  auto itev = std::lower_bound(tofs.cbegin(), tofs.cend(), X[0]);
+  auto itx = X.cbegin();
+  for (; itev != tofs.cend(); ++itev) {
+    const double tof = *itev;
+    // The events are sorted, so the bin only needs searching for once the
+    // event is past the upper edge of the previous one
+    if (tof >= *itx)
+      itx = std::upper_bound(itx, X.cend(), tof);
+    if (itx == X.cend())
+      break;
+    const auto bin = static_cast<size_t>(
+        std::max(std::distance(X.cbegin(), itx) - 1, std::ptrdiff_t{0}));
+    if (weighted) {
+      const auto i = static_cast<size_t>(std::distance(tofs.cbegin(), itev));
+      Y[bin] += double(m_columns.weight[i]);
+      E[bin] += double(m_columns.errorSquared[i]);
+    } else {
+      ++Y[bin];
+    }
+  }
+
+  if (weighted)
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  else if (!skipError)
+    this->generateErrorsHistogram(Y, E);
+}
+
+// --------------------------------------------------------------------------
+/** Generates the Y and E histograms w.r.t TOF from the compressed events,
+ * decoding the TOFs on the fly. Compressed events are always sorted by TOF.
+ *
+ * @param X: x-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error for unweighted events.
+ */
+void EventList::generateHistogramFromCompressed(const MantidVec &X,
+                                                MantidVec &Y, MantidVec &E,
+                                                bool skipError) const {
+  const size_t x_size = X.size();
+  if (x_size <= 1) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+
+  const bool weighted = (eventType != TOF);
+  Y.assign(x_size - 1, 0.0);
+  if (weighted)
+    E.assign(x_size - 1, 0.0);
+
+  auto cursor = m_compressed.tofs();
+  auto itx = X.cbegin();
+  for (size_t i = 0; i < m_compressed.size(); ++i) {
+    const double tof = cursor.next();
+    if (tof < X[0])
+      continue;
+    // The events are sorted, so the bin only needs searching for once the
+    // event is past the upper edge of the previous one
+    if (tof >= *itx)
+      itx = std::upper_bound(itx, X.cend(), tof);
+    if (itx == X.cend())
+      break;
+    const auto bin = static_cast<size_t>(
+        std::max(std::distance(X.cbegin(), itx) - 1, std::ptrdiff_t{0}));
+    if (weighted) {
+      Y[bin] += double(m_compressed.weight(i));
+      E[bin] += double(m_compressed.errorSquared(i));
+    } else {
+      ++Y[bin];
+    }
+  }
+
+  if (weighted)
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  else if (!skipError)
+    this->generateErrorsHistogram(Y, E);
+}
+
 // --------------------------------------------------------------------------
 /** With respect to PulseTime Fill a histogram given specified histogram bounds.
  * Does not modify
@@ -2179,6 +2802,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
+  this->switchToArrayOfStructs();
 
   if (this->events.empty())
     return;
@@ -2432,6 +3056,11 @@ double EventList::integrate(const double minX, const double maxX,
 void EventList::integrate(const double minX, const double maxX,
                           const bool entireRange, double &sum,
                           double &error) const {
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    this->integrateColumns(minX, maxX, entireRange, sum, error);
+    return;
+  }
+  this->switchToArrayOfStructs();
   sum = 0;
   error = 0;
   if (!entireRange) {
@@ -2456,6 +3085,48 @@ void EventList::integrate(const double minX, const double maxX,
   }
 }
 
+/** Integrate the event columns between a range of X values, or all events.
+ *
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range. minX and maxX are
+ *then ignored!
+ * @param sum :: place holder for the resulting sum
+ * @param error :: place holder for the resulting sum of errors
+ */
+void EventList::integrateColumns(const double minX, const double maxX,
+                                 const bool entireRange, double &sum,
+                                 double &error) const {
+  sum = 0;
+  error = 0;
+  const auto &tofs = m_columns.tof;
+  auto first = tofs.cbegin();
+  auto last = tofs.cend();
+  if (!entireRange) {
+    // If a silly range was given, return 0.
+    if (maxX < minX)
+      return;
+    // The columns must be sorted by TOF!
+    this->sortTof();
+    first = std::lower_bound(tofs.cbegin(), tofs.cend(), minX);
+    last = std::upper_bound(first, tofs.cend(), maxX);
+  }
+
+  if (m_columns.weight.empty()) {
+    // Every event has a weight and squared error of 1
+    sum = static_cast<double>(std::distance(first, last));
+    error = std::sqrt(sum);
+    return;
+  }
+  const auto begin = static_cast<size_t>(std::distance(tofs.cbegin(), first));
+  const auto end = static_cast<size_t>(std::distance(tofs.cbegin(), last));
+  for (size_t i = begin; i < end; ++i) {
+    sum += m_columns.weight[i];
+    error += m_columns.errorSquared[i];
+  }
+  error = std::sqrt(error);
+}
+
 // ==============================================================================================
 // ----------- Conversion Functions (changing tof values)
 // ---------------------------------------
@@ -2472,6 +3143,7 @@ void EventList::convertTof(std::function<double(double)> func,
   // fix the histogram parameter
   MantidVec &x = dataX();
   transform(x.begin(), x.end(), x.begin(), func);
+  this->switchFromCompressed();
 
   // do nothing if sorting > 0
   if (sorting == 0) {
@@ -2483,6 +3155,12 @@ void EventList::convertTof(std::function<double(double)> func,
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    std::transform(m_columns.tof.begin(), m_columns.tof.end(),
+                   m_columns.tof.begin(), func);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2521,12 +3199,25 @@ void EventList::convertTof(const double factor, const double offset) {
   for (double &iter : x)
     iter = iter * factor + offset;
 
+  // Compressed events can be scaled as long as they stay sorted
+  if (m_layout == COMPRESSED && factor > 0.) {
+    m_compressed.scaleTof(factor, offset);
+    return;
+  }
+  this->switchFromCompressed();
+
   if ((factor < 0.) && (this->getSortType() == TOF_SORT))
     this->reverse();
 
   if (this->getNumberEvents() <= 0)
     return;
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    for (double &tof : m_columns.tof)
+      tof = tof * factor + offset;
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2596,6 +3287,7 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  this->switchToArrayOfStructs();
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2663,6 +3355,7 @@ std::size_t EventList::maskTofHelper(std::vector<T> &events,
  * @param tofMax :: upper bound of TOF to filter out
  */
 void EventList::maskTof(const double tofMin, const double tofMax) {
+  this->switchToArrayOfStructs();
   if (tofMax <= tofMin)
     throw std::runtime_error("EventList::maskTof: tofMax must be > tofMin");
 
@@ -2733,6 +3426,7 @@ std::size_t EventList::maskConditionHelper(std::vector<T> &events,
  * @param mask :: condition vector
  */
 void EventList::maskCondition(const std::vector<bool> &mask) {
+  this->switchToArrayOfStructs();
 
   // mask size must match the number of events
   if (this->getNumberEvents() != mask.size())
@@ -2785,6 +3479,18 @@ void EventList::getTofs(std::vector<double> &tofs) const {
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    tofs.assign(m_columns.tof.cbegin(), m_columns.tof.cend());
+    return;
+  }
+  if (m_layout == COMPRESSED) {
+    tofs.clear();
+    auto cursor = m_compressed.tofs();
+    for (size_t i = 0; i < m_compressed.size(); ++i)
+      tofs.push_back(cursor.next());
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2828,6 +3534,14 @@ void EventList::getWeightsHelper(const std::vector<T> &events,
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    if (m_columns.weight.empty())
+      weights.assign(m_columns.size(), 1.0);
+    else
+      weights.assign(m_columns.weight.cbegin(), m_columns.weight.cend());
+    return;
+  }
+  this->switchToArrayOfStructs();
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2875,6 +3589,19 @@ void EventList::getWeightErrorsHelper(const std::vector<T> &events,
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    const auto &errorSquared = m_columns.errorSquared;
+    if (errorSquared.empty()) {
+      weightErrors.assign(m_columns.size(), 1.0);
+    } else {
+      weightErrors.resize(errorSquared.size());
+      std::transform(
+          errorSquared.cbegin(), errorSquared.cend(), weightErrors.begin(),
+          [](const float value) { return std::sqrt(double(value)); });
+    }
+    return;
+  }
+  this->switchToArrayOfStructs();
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -2925,6 +3652,16 @@ void EventList::getPulseTimesHelper(
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
   std::vector<Mantid::Types::Core::DateAndTime> times;
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    // Events without a pulse time have a pulse time of 0
+    const auto &pulseTimes = m_columns.pulseTime;
+    if (pulseTimes.empty())
+      times.assign(m_columns.size(), DateAndTime(0));
+    else
+      times.assign(pulseTimes.cbegin(), pulseTimes.cend());
+    return times;
+  }
+  this->switchToArrayOfStructs();
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
 
@@ -2943,6 +3680,37 @@ std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
   return times;
 }
 
+/** Get the distinct pulse times of the events, in whichever layout they are
+ * in. Unlike getPulseTimes() this never changes the layout of the list.
+ *
+ * @param pulseTimes :: filled with the pulse times in nanoseconds, sorted and
+ * without duplicates. Empty for WEIGHTED_NOTIME events.
+ */
+void EventList::getDistinctPulseTimes(std::vector<int64_t> &pulseTimes) const {
+  pulseTimes.clear();
+  if (eventType == WEIGHTED_NOTIME)
+    return;
+  const EventStorageLayout layout = m_layout.load(std::memory_order_acquire);
+  if (layout == STRUCT_OF_ARRAYS) {
+    pulseTimes = m_columns.pulseTime;
+  } else if (layout == COMPRESSED) {
+    pulseTimes.reserve(m_compressed.size());
+    for (size_t i = 0; i < m_compressed.size(); ++i)
+      pulseTimes.push_back(m_compressed.pulseTime(i).totalNanoseconds());
+  } else if (eventType == TOF) {
+    pulseTimes.reserve(events.size());
+    for (const auto &event : events)
+      pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+  } else {
+    pulseTimes.reserve(weightedEvents.size());
+    for (const auto &event : weightedEvents)
+      pulseTimes.push_back(event.pulseTime().totalNanoseconds());
+  }
+  std::sort(pulseTimes.begin(), pulseTimes.end());
+  pulseTimes.erase(std::unique(pulseTimes.begin(), pulseTimes.end()),
+                   pulseTimes.end());
+}
+
 // --------------------------------------------------------------------------
 /**
  * @return The minimum tof value for the list of the events.
@@ -2955,6 +3723,14 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    if (this->order == TOF_SORT)
+      return m_columns.tof.front();
+    return *std::min_element(m_columns.tof.cbegin(), m_columns.tof.cend());
+  }
+  if (m_layout == COMPRESSED)
+    return m_compressed.tofMin();
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2999,6 +3775,14 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    if (this->order == TOF_SORT)
+      return m_columns.tof.back();
+    return *std::max_element(m_columns.tof.cbegin(), m_columns.tof.cend());
+  }
+  if (m_layout == COMPRESSED)
+    return m_compressed.tofMax();
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -3044,6 +3828,17 @@ DateAndTime EventList::getPulseTimeMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    const auto &pulseTimes = m_columns.pulseTime;
+    if (pulseTimes.empty())
+      return DateAndTime(0);
+    if (this->order == PULSETIME_SORT)
+      return DateAndTime(pulseTimes.front());
+    return DateAndTime(
+        *std::min_element(pulseTimes.cbegin(), pulseTimes.cend()));
+  }
+  this->switchToArrayOfStructs();
+
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
     switch (eventType) {
@@ -3088,6 +3883,17 @@ DateAndTime EventList::getPulseTimeMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    const auto &pulseTimes = m_columns.pulseTime;
+    if (pulseTimes.empty())
+      return DateAndTime(0);
+    if (this->order == PULSETIME_SORT)
+      return DateAndTime(pulseTimes.back());
+    return DateAndTime(
+        *std::max_element(pulseTimes.cbegin(), pulseTimes.cend()));
+  }
+  this->switchToArrayOfStructs();
+
   // when events are ordered by pulse time just need the first value
   if (this->order == PULSETIME_SORT) {
     switch (eventType) {
@@ -3124,6 +3930,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 void EventList::getPulseTimeMinMax(
     Mantid::Types::Core::DateAndTime &tMin,
     Mantid::Types::Core::DateAndTime &tMax) const {
+  this->switchToArrayOfStructs();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -3174,6 +3981,7 @@ void EventList::getPulseTimeMinMax(
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->switchToArrayOfStructs();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3221,6 +4029,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  this->switchToArrayOfStructs();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3293,6 +4102,7 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  this->switchToArrayOfStructs();
   this->order = UNSORTED;
 
   // Convert the list
@@ -3361,6 +4171,7 @@ void EventList::multiplyHelper(std::vector<T> &events, const double value,
  * @return reference to this
  */
 EventList &EventList::operator*=(const double value) {
+  this->switchToArrayOfStructs();
   this->multiply(value);
   return *this;
 }
@@ -3395,6 +4206,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  this->switchToArrayOfStructs();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3518,6 +4330,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  this->switchToArrayOfStructs();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3655,6 +4468,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  this->switchToArrayOfStructs();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3685,6 +4499,7 @@ void EventList::divide(const MantidVec &X, const MantidVec &Y,
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 EventList &EventList::operator/=(const double value) {
+  this->switchToArrayOfStructs();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3703,6 +4518,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  this->switchToArrayOfStructs();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3788,6 +4604,7 @@ void EventList::filterByTimeAtSampleHelper(std::vector<T> &events,
  */
 void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
                                   EventList &output) const {
+  this->switchToArrayOfStructs();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3822,6 +4639,7 @@ void EventList::filterByTimeAtSample(Types::Core::DateAndTime start,
                                      Types::Core::DateAndTime stop,
                                      double tofFactor, double tofOffset,
                                      EventList &output) const {
+  this->switchToArrayOfStructs();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3937,6 +4755,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  this->switchToArrayOfStructs();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -4028,6 +4847,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  this->switchToArrayOfStructs();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4168,6 +4988,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
                                 std::map<int, EventList *> outputs,
                                 bool docorrection, double toffactor,
                                 double tofshift) const {
+  this->switchToArrayOfStructs();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4399,6 +5220,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int> &vecgroups,
     std::map<int, EventList *> vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  this->switchToArrayOfStructs();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4536,6 +5358,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                                  std::map<int, EventList *> outputs) const {
+  this->switchToArrayOfStructs();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4581,6 +5404,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  this->switchToArrayOfStructs();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4775,6 +5599,13 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
     throw std::runtime_error(
         "EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  this->switchFromCompressed();
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    for (double &tof : m_columns.tof)
+      tof = toUnit->singleFromTOF(fromUnit->singleToTOF(tof));
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4812,6 +5643,13 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  this->switchFromCompressed();
+  if (m_layout == STRUCT_OF_ARRAYS) {
+    for (double &tof : m_columns.tof)
+      tof = factor * std::pow(tof, power);
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -25,6 +25,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include "tbb/parallel_for.h"
+#include <exception>
 #include <limits>
 #include <numeric>
 
@@ -438,6 +439,77 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
     eventList->switchTo(type);
 }
 
+/** Switch all event lists to the given memory layout. The
+ * STRUCT_OF_ARRAYS layout speeds up histogramming and TOF/unit conversions;
+ * see EventList::setStorageLayout().
+ *
+ * @param layout :: EventStorageLayout to switch to
+ */
+void EventWorkspace::setStorageLayout(const EventStorageLayout layout) {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(this->data.size()); ++i)
+    this->data[i]->setStorageLayout(layout);
+}
+
+/** Switch all event lists to the COMPRESSED layout, see
+ * EventList::setCompressedStorage(). The lists share one table of pulse
+ * times.
+ *
+ * @param tofResolution :: quantum of the TOF, must be positive
+ * @throw std::invalid_argument if tofResolution is not usable
+ */
+void EventWorkspace::setCompressedStorage(const double tofResolution) {
+  if (!(tofResolution > 0.0))
+    throw std::invalid_argument("EventWorkspace::setCompressedStorage(): the "
+                                "TOF resolution must be positive");
+  const auto numHistograms = static_cast<int64_t>(this->data.size());
+
+  // Read the pulse times in whichever layout the lists are in, without
+  // decoding them
+  std::vector<int64_t> allPulseTimes;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numHistograms; ++i) {
+    std::vector<int64_t> pulseTimes;
+    this->data[i]->getDistinctPulseTimes(pulseTimes);
+    PARALLEL_CRITICAL(EventWorkspace_setCompressedStorage) {
+      allPulseTimes.insert(allPulseTimes.end(), pulseTimes.begin(),
+                           pulseTimes.end());
+    }
+  }
+  const auto pulseTimes =
+      CompressedEvents::makePulseTimes(std::move(allPulseTimes));
+
+  std::exception_ptr error;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numHistograms; ++i) {
+    try {
+      this->data[i]->setCompressedStorage(tofResolution, pulseTimes);
+    } catch (...) {
+      PARALLEL_CRITICAL(EventWorkspace_setCompressedStorage_error) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+/** Re-allocate the events of every spectrum from the thread that handles
+ * that spectrum in a PARALLEL_FOR_IF loop over all the spectra.
+ *
+ * Such loops use a static schedule, so with the same number of threads each
+ * thread gets the same block of spectra every time. With first-touch page
+ * placement the events of a block then live on the NUMA node of the thread
+ * that processes them, rather than wherever the loader happened to run.
+ */
+void EventWorkspace::applyNumaPlacement() {
+  const auto numHistograms = static_cast<int64_t>(this->data.size());
+  PARALLEL_FOR_IF(Kernel::threadSafe(*this))
+  for (int64_t i = 0; i < numHistograms; ++i)
+    this->data[i]->reallocateEvents();
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -14,6 +14,7 @@
 
 #include <cmath>
 #include <limits>
+#include <numeric>
 
 namespace {
 struct AreaInfo {
@@ -491,6 +492,39 @@ void calcGeneralIntersections(const std::vector<double> &xAxis,
   }
 }
 
+/**
+ * Computes the areas of the overlaps of an input polygon with the output
+ * bins. The intersection overlap algorithm is relatively costly. The outputQ
+ * is defined as rectangular. If the inputQ is is also rectangular or
+ * trapezoidal, a simpler/faster way of calculating the intersection area of
+ * all or some bins can be used.
+ * @param xAxis A vector containing the output horizontal axis edges
+ * @param yAxis The output data vertical axis
+ * @param inputQ The input quadrilateral
+ * @param qstart The starting y-axis index
+ * @param qend The starting y-axis index
+ * @param x_start The starting x-axis index
+ * @param x_end The starting x-axis index
+ * @param areaInfos Output vector of indices and areas of overlapping bins
+ */
+void calcIntersections(const std::vector<double> &xAxis,
+                       const std::vector<double> &yAxis,
+                       const Quadrilateral &inputQ, const size_t qstart,
+                       const size_t qend, const size_t x_start,
+                       const size_t x_end, std::vector<AreaInfo> &areaInfos) {
+  const QuadrilateralType inputQType = getQuadrilateralType(inputQ);
+  if (inputQType == QuadrilateralType::Rectangle) {
+    calcRectangleIntersections(xAxis, yAxis, inputQ, qstart, qend, x_start,
+                               x_end, areaInfos);
+  } else if (inputQType == QuadrilateralType::TrapezoidY) {
+    calcTrapezoidYIntersections(xAxis, yAxis, inputQ, qstart, qend, x_start,
+                                x_end, areaInfos);
+  } else {
+    calcGeneralIntersections(xAxis, yAxis, inputQ, qstart, qend, x_start,
+                             x_end, areaInfos);
+  }
+}
+
 /**
  * Computes the square root of the errors and if the input was a distribution
  * this divides by the new bin-width
@@ -640,23 +674,10 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ,
     inputWeight = overlapWidth;
   }
 
-  // The intersection overlap algorithm is relatively costly. The outputQ is
-  // defined as rectangular. If the inputQ is is also rectangular or
-  // trapezoidal, a simpler/faster way of calculating the intersection area
-  // of all or some bins can be used.
   std::vector<AreaInfo> areaInfos;
   const double inputQArea = inputQ.area();
-  const QuadrilateralType inputQType = getQuadrilateralType(inputQ);
-  if (inputQType == QuadrilateralType::Rectangle) {
-    calcRectangleIntersections(X, verticalAxis, inputQ, qstart, qend, x_start,
-                               x_end, areaInfos);
-  } else if (inputQType == QuadrilateralType::TrapezoidY) {
-    calcTrapezoidYIntersections(X, verticalAxis, inputQ, qstart, qend, x_start,
-                                x_end, areaInfos);
-  } else {
-    calcGeneralIntersections(X, verticalAxis, inputQ, qstart, qend, x_start,
-                             x_end, areaInfos);
-  }
+  calcIntersections(X, verticalAxis, inputQ, qstart, qend, x_start, x_end,
+                    areaInfos);
 
   // If the input is a RebinnedOutput workspace with frac. area we need
   // to account for the weight of the input bin in the output bin weights
@@ -685,6 +706,205 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ,
   }
 }
 
+/**
+ * Find the overlaps of an input quadrilateral with the output grid, with the
+ * same areas as rebinToOutput, or as rebinToFractionalOutput if the widths are
+ * not needed. Overlaps with zero area are left out.
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be clockwise)
+ * @param i The workspace index of the input bin
+ * @param j The index of the input bin in its spectrum
+ * @param xAxis A vector containing the output horizontal axis bin boundaries
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ * @param calculateWidths If true, calculate the widths of the overlaps along
+ * the X axis, which rebinToOutput needs for distributions
+ * @param overlaps The overlaps found are appended to this
+ */
+void calculateOverlaps(const Quadrilateral &inputQ, const size_t i,
+                       const size_t j, const std::vector<double> &xAxis,
+                       const std::vector<double> &verticalAxis,
+                       const bool calculateWidths,
+                       std::vector<IndexedOverlap> &overlaps) {
+  size_t qstart(0), qend(verticalAxis.size() - 1), x_start(0),
+      x_end(xAxis.size() - 1);
+  if (!getIntersectionRegion(xAxis, verticalAxis, inputQ, qstart, qend,
+                             x_start, x_end))
+    return;
+
+  const double inputQArea = inputQ.area();
+  if (!calculateWidths) {
+    std::vector<AreaInfo> areaInfos;
+    calcIntersections(xAxis, verticalAxis, inputQ, qstart, qend, x_start,
+                      x_end, areaInfos);
+    for (const auto &ai : areaInfos) {
+      if (ai.weight == 0.) {
+        continue;
+      }
+      overlaps.emplace_back(
+          ai.wsIndex, OverlapWeights::Overlap{i, j, ai.binIndex,
+                                              ai.weight / inputQArea, 0.});
+    }
+    return;
+  }
+
+  ConvexPolygon intersectOverlap;
+  for (size_t y = qstart; y < qend; ++y) {
+    const double vlo = verticalAxis[y];
+    const double vhi = verticalAxis[y + 1];
+    for (size_t xi = x_start; xi < x_end; ++xi) {
+      const V2D ll(xAxis[xi], vlo);
+      const V2D lr(xAxis[xi + 1], vlo);
+      const V2D ur(xAxis[xi + 1], vhi);
+      const V2D ul(xAxis[xi], vhi);
+      const Quadrilateral outputQ(ll, lr, ur, ul);
+      intersectOverlap.clear();
+      if (intersection(outputQ, inputQ, intersectOverlap)) {
+        const double overlapArea = intersectOverlap.area();
+        if (overlapArea == 0.) {
+          continue;
+        }
+        overlaps.emplace_back(
+            y, OverlapWeights::Overlap{
+                   i, j, xi, overlapArea / inputQArea,
+                   intersectOverlap.maxX() - intersectOverlap.minX()});
+      }
+    }
+  }
+}
+
+/**
+ * Group the overlaps of the input bins by the output spectrum they are in.
+ * The overlaps of each output spectrum keep the order they are given in.
+ * @param overlaps The overlaps of the input bins, in any number of lists
+ * @param nOutputSpectra The number of spectra in the output workspace
+ * @return The overlaps grouped by output spectrum
+ */
+OverlapWeights
+groupOverlaps(const std::vector<std::vector<IndexedOverlap>> &overlaps,
+              const size_t nOutputSpectra) {
+  OverlapWeights weights;
+  weights.offsets.assign(nOutputSpectra + 1, 0);
+  for (const auto &list : overlaps) {
+    for (const auto &overlap : list) {
+      ++weights.offsets[overlap.first + 1];
+    }
+  }
+  std::partial_sum(weights.offsets.begin(), weights.offsets.end(),
+                   weights.offsets.begin());
+  weights.overlaps.resize(weights.offsets.back());
+  std::vector<size_t> next(weights.offsets.begin(), weights.offsets.end() - 1);
+  for (const auto &list : overlaps) {
+    for (const auto &overlap : list) {
+      weights.overlaps[next[overlap.first]++] = overlap.second;
+    }
+  }
+  return weights;
+}
+
+/**
+ * Rebin a workspace to the output grid with overlaps found by
+ * calculateOverlaps with the widths calculated. This gives the same result as
+ * calling rebinToOutput for each input bin, but each output spectrum is
+ * filled by one thread, without locking.
+ * @param weights The overlaps of the input bins with the output grid
+ * @param inputWS The input workspace containing the input intensity values
+ * @param outputWS The output workspace that accumulates the data
+ * @param progress An optional progress object. Reported to once per output
+ * spectrum.
+ */
+void rebinToOutput(const OverlapWeights &weights,
+                   const MatrixWorkspace &inputWS, MatrixWorkspace &outputWS,
+                   boost::shared_ptr<Progress> progress) {
+  const bool isDistribution = inputWS.isDistribution();
+  const auto nOutputSpectra =
+      static_cast<int64_t>(weights.offsets.size()) - 1;
+  PARALLEL_FOR_IF(Kernel::threadSafe(inputWS, outputWS))
+  for (int64_t k = 0; k < nOutputSpectra; ++k) {
+    if (progress)
+      progress->report("Applying overlap weights");
+    auto &outY = outputWS.mutableY(k);
+    auto &outE = outputWS.mutableE(k);
+    for (size_t n = weights.offsets[k]; n < weights.offsets[k + 1]; ++n) {
+      const auto &overlap = weights.overlaps[n];
+      double yValue = inputWS.y(overlap.inputIndex)[overlap.inputBin];
+      if (std::isnan(yValue)) {
+        continue;
+      }
+      yValue *= overlap.weight;
+      double eValue = inputWS.e(overlap.inputIndex)[overlap.inputBin];
+      if (isDistribution) {
+        yValue *= overlap.width;
+        eValue *= overlap.width;
+      }
+      outY[overlap.outputBin] += yValue;
+      outE[overlap.outputBin] += eValue * eValue * overlap.weight;
+    }
+  }
+}
+
+/**
+ * Rebin a workspace to the output grid with overlaps found by
+ * calculateOverlaps. This gives the same result as calling
+ * rebinToFractionalOutput for each input bin, but each output spectrum is
+ * filled by one thread, without locking.
+ * @param weights The overlaps of the input bins with the output grid
+ * @param inputWS The input workspace containing the input intensity values
+ * @param outputWS The output workspace that accumulates the data. Note that
+ *        the error array of the output workspace contains the **variance**
+ *        and not the errors (standard deviations).
+ * @param inputRB A pointer, of RebinnedOutput type, to the input workspace,
+ * or null if the input was a standard 2D workspace. See
+ * rebinToFractionalOutput.
+ * @param progress An optional progress object. Reported to once per output
+ * spectrum.
+ */
+void rebinToFractionalOutput(const OverlapWeights &weights,
+                             const MatrixWorkspace &inputWS,
+                             RebinnedOutput &outputWS,
+                             const RebinnedOutput_const_sptr &inputRB,
+                             boost::shared_ptr<Progress> progress) {
+  const bool removeBinWidth = inputWS.isDistribution() && !inputRB;
+  const bool inputFinalized = inputRB && inputRB->isFinalized();
+  const auto nOutputSpectra =
+      static_cast<int64_t>(weights.offsets.size()) - 1;
+  PARALLEL_FOR_IF(Kernel::threadSafe(inputWS, outputWS))
+  for (int64_t k = 0; k < nOutputSpectra; ++k) {
+    if (progress)
+      progress->report("Applying overlap weights");
+    auto &outY = outputWS.mutableY(k);
+    auto &outE = outputWS.mutableE(k);
+    auto &outF = outputWS.dataF(k);
+    for (size_t n = weights.offsets[k]; n < weights.offsets[k + 1]; ++n) {
+      const auto &overlap = weights.overlaps[n];
+      const size_t i = overlap.inputIndex;
+      const size_t j = overlap.inputBin;
+      double signal = inputWS.y(i)[j];
+      if (std::isnan(signal)) {
+        continue;
+      }
+      double error = inputWS.e(i)[j];
+      double inputWeight = 1.;
+      if (removeBinWidth) {
+        const auto &inX = inputWS.x(i);
+        inputWeight = inX[j + 1] - inX[j];
+        signal *= inputWeight;
+        error *= inputWeight;
+      }
+      if (inputRB) {
+        inputWeight = inputRB->dataF(i)[j];
+        if (inputFinalized) {
+          signal *= inputWeight;
+          error *= inputWeight;
+        }
+      }
+      outY[overlap.outputBin] += signal * overlap.weight;
+      outE[overlap.outputBin] += error * error * overlap.weight;
+      outF[overlap.outputBin] += overlap.weight * inputWeight;
+    }
+  }
+}
+
 } // namespace FractionalRebinning
 
 } // namespace DataObjects
@@ -0,0 +1,66 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDBoxEventIndexNeXusReader.h"
+#include "MantidKernel/Exception.h"
+
+#include <nexus/NeXusFile.hpp>
+
+namespace Mantid {
+namespace DataObjects {
+
+/**
+ * Open the event index of a file
+ * @param fileName :: The name of a file written by SaveMD
+ * @throw FileError if the file has no event index
+ */
+MDBoxEventIndexNeXusReader::MDBoxEventIndexNeXusReader(
+    const std::string &fileName)
+    : m_fileName(fileName), m_file(), m_nBoxes(0) {
+  try {
+    m_file.reset(new ::NeXus::File(fileName, NXACC_READ));
+    m_file->openGroup("MDEventWorkspace", "NXentry");
+    m_file->openGroup("box_structure", "NXdata");
+    m_file->openData("box_event_index");
+  } catch (...) {
+    throw Kernel::Exception::FileError(
+        "Can not open the box event index of the NeXus file", fileName);
+  }
+
+  const ::NeXus::Info info = m_file->getInfo();
+  if (info.dims.size() != 2 || info.dims[1] != 2)
+    throw Kernel::Exception::FileError(
+        "Incompatible size for data: box_event_index", fileName);
+  m_nBoxes = static_cast<size_t>(info.dims[0]);
+}
+
+/// Closes the file
+MDBoxEventIndexNeXusReader::~MDBoxEventIndexNeXusReader() = default;
+
+/**
+ * Read the position and number of events of consecutive boxes
+ * @param firstBox :: The ID of the first box to read
+ * @param nBoxes :: The number of boxes to read
+ * @param index :: Set to the position and number of events of each box
+ * @throw FileError if the boxes are beyond the end of the index
+ */
+void MDBoxEventIndexNeXusReader::read(const size_t firstBox,
+                                      const size_t nBoxes,
+                                      std::vector<uint64_t> &index) {
+  if (firstBox + nBoxes > m_nBoxes)
+    throw Kernel::Exception::FileError(
+        "Attempt to read behind the end of the box event index", m_fileName);
+  index.resize(2 * nBoxes);
+  if (nBoxes == 0)
+    return;
+
+  const std::vector<int64_t> start = {static_cast<int64_t>(firstBox), 0};
+  const std::vector<int64_t> size = {static_cast<int64_t>(nBoxes), 2};
+  m_file->getSlab(index.data(), start, size);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
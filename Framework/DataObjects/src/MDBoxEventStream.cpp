@@ -0,0 +1,111 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDBoxEventStream.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+/**
+ * Constructor
+ * @param loader :: The IO object of the file, opened for reading
+ * @param eventIndex :: The reader of the position and number of events of
+ * every box in the file
+ * @param nColumns :: The number of values per event in the file
+ * @param bufferSize :: The maximum number of events to read ahead
+ * @param indexWindowSize :: The maximum number of boxes of the event index to
+ * read ahead
+ */
+MDBoxEventStream::MDBoxEventStream(
+    std::unique_ptr<API::IBoxControllerIO> loader,
+    std::unique_ptr<MDBoxEventIndexReader> eventIndex, const size_t nColumns,
+    const size_t bufferSize, const size_t indexWindowSize)
+    : m_loader(std::move(loader)), m_eventIndex(std::move(eventIndex)),
+      m_nBoxes(0), m_indexWindowSize(std::max<size_t>(1, indexWindowSize)),
+      m_indexWindow(), m_indexWindowStart(0), m_nColumns(nColumns),
+      m_bufferSize(std::max<size_t>(1, bufferSize)), m_buffer(),
+      m_bufferStart(0), m_bufferEnd(0) {
+  if (!m_loader || !m_loader->isOpened())
+    throw std::invalid_argument(
+        "MDBoxEventStream needs a file opened for reading");
+  if (!m_eventIndex)
+    throw std::invalid_argument("MDBoxEventStream needs an event index");
+  if (m_nColumns == 0)
+    throw std::invalid_argument("MDBoxEventStream: events need columns");
+  m_nBoxes = m_eventIndex->getNBoxes();
+}
+
+/**
+ * @param boxID :: The ID of a box
+ * @return the number of events of the box in the file
+ */
+uint64_t MDBoxEventStream::getNEvents(const size_t boxID) {
+  if (boxID >= m_nBoxes)
+    return 0;
+  moveIndexWindow(boxID);
+  return m_indexWindow[2 * (boxID - m_indexWindowStart) + 1];
+}
+
+/**
+ * Append the events of a box to a table
+ * @param boxID :: The ID of the box
+ * @param table :: The table the events are appended to, with nColumns values
+ * per event
+ * @return the number of events appended
+ */
+uint64_t MDBoxEventStream::appendEvents(const size_t boxID,
+                                        std::vector<coord_t> &table) {
+  const uint64_t nEvents = getNEvents(boxID);
+  if (nEvents == 0)
+    return 0;
+  const uint64_t position = m_indexWindow[2 * (boxID - m_indexWindowStart)];
+
+  const uint64_t blockEnd = position + nEvents;
+  if (nEvents > m_bufferSize) {
+    // Too big for the buffer: read it directly
+    std::vector<coord_t> events;
+    m_loader->loadBlock(events, position, static_cast<size_t>(nEvents));
+    table.insert(table.end(), events.begin(), events.end());
+    return nEvents;
+  }
+
+  if (position < m_bufferStart || blockEnd > m_bufferEnd) {
+    // Read ahead from the start of the block, up to the end of the file
+    const uint64_t fileLength = m_loader->getFileLength();
+    const uint64_t readEnd = std::max(
+        blockEnd, std::min<uint64_t>(position + m_bufferSize, fileLength));
+    const uint64_t nRead = readEnd - position;
+    m_loader->loadBlock(m_buffer, position, static_cast<size_t>(nRead));
+    m_bufferStart = position;
+    m_bufferEnd = position + nRead;
+  }
+
+  const auto begin =
+      m_buffer.cbegin() + (position - m_bufferStart) * m_nColumns;
+  table.insert(table.end(), begin, begin + nEvents * m_nColumns);
+  return nEvents;
+}
+
+/**
+ * Make sure a box is in the index window. If it is not, the window is read
+ * again from the event index, starting at the box, so that moving forwards
+ * through the boxes reads the index forwards.
+ * @param boxID :: The ID of a box in the file
+ */
+void MDBoxEventStream::moveIndexWindow(const size_t boxID) {
+  if (boxID >= m_indexWindowStart &&
+      boxID < m_indexWindowStart + m_indexWindow.size() / 2)
+    return;
+  const size_t nRead = std::min(m_indexWindowSize, m_nBoxes - boxID);
+  m_eventIndex->read(boxID, nRead, m_indexWindow);
+  m_indexWindowStart = boxID;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,366 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of bins taken through all the steps at a time. The signal, error
+/// and event count arrays of a block fit in the L2 cache.
+constexpr size_t BLOCK_SIZE = 4096;
+} // namespace
+
+//----------------------------------------------------------------------------------------------
+/** Start an expression
+ * @param input :: the workspace the operations start from
+ */
+MDHistoExpression::MDHistoExpression(MDHistoWorkspace_const_sptr input)
+    : m_input(std::move(input)) {
+  if (!m_input)
+    throw std::invalid_argument("MDHistoExpression: the input is NULL");
+}
+
+/** Add a workspace, element-by-element
+ * @param operand :: workspace on the RHS of the operation
+ * @return this expression
+ */
+MDHistoExpression &
+MDHistoExpression::plus(MDHistoWorkspace_const_sptr operand) {
+  return addStep(Operation::Plus, std::move(operand));
+}
+
+/** Add a scalar
+ * @param signal :: signal to apply
+ * @param error :: error (not squared) to apply
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::plus(const signal_t signal,
+                                           const signal_t error) {
+  return addStep(Operation::PlusScalar, nullptr, signal, error * error);
+}
+
+/** Subtract a workspace, element-by-element
+ * @param operand :: workspace on the RHS of the operation
+ * @return this expression
+ */
+MDHistoExpression &
+MDHistoExpression::minus(MDHistoWorkspace_const_sptr operand) {
+  return addStep(Operation::Minus, std::move(operand));
+}
+
+/** Subtract a scalar
+ * @param signal :: signal to apply
+ * @param error :: error (not squared) to apply
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::minus(const signal_t signal,
+                                            const signal_t error) {
+  return addStep(Operation::MinusScalar, nullptr, signal, error * error);
+}
+
+/** Multiply by a workspace, element-by-element
+ * @param operand :: workspace on the RHS of the operation
+ * @return this expression
+ */
+MDHistoExpression &
+MDHistoExpression::multiply(MDHistoWorkspace_const_sptr operand) {
+  return addStep(Operation::Multiply, std::move(operand));
+}
+
+/** Multiply by a scalar
+ * @param signal :: signal to apply
+ * @param error :: error (not squared) to apply
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::multiply(const signal_t signal,
+                                               const signal_t error) {
+  return addStep(Operation::MultiplyScalar, nullptr, signal, error * error);
+}
+
+/** Divide by a workspace, element-by-element
+ * @param operand :: workspace on the RHS of the operation
+ * @return this expression
+ */
+MDHistoExpression &
+MDHistoExpression::divide(MDHistoWorkspace_const_sptr operand) {
+  return addStep(Operation::Divide, std::move(operand));
+}
+
+/** Divide by a scalar
+ * @param signal :: signal to apply
+ * @param error :: error (not squared) to apply
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::divide(const signal_t signal,
+                                             const signal_t error) {
+  return addStep(Operation::DivideScalar, nullptr, signal, error * error);
+}
+
+/** Take the natural logarithm of the signal
+ * @param filler :: value of the bins with a signal <= 0
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::log(const double filler) {
+  return addStep(Operation::Log, nullptr, filler);
+}
+
+/** Take the base-10 logarithm of the signal
+ * @param filler :: value of the bins with a signal <= 0
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::log10(const double filler) {
+  return addStep(Operation::Log10, nullptr, filler);
+}
+
+/** Take the exponential of the signal
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::exp() {
+  return addStep(Operation::Exp, nullptr);
+}
+
+/** Raise the signal to a power
+ * @param exponent :: the power
+ * @return this expression
+ */
+MDHistoExpression &MDHistoExpression::power(const double exponent) {
+  return addStep(Operation::Power, nullptr, exponent);
+}
+
+/** Record an operation
+ * @param operation :: the kind of operation
+ * @param operand :: workspace on the RHS, if any
+ * @param value :: scalar parameter of the operation
+ * @param errorSquared :: squared error of a scalar on the RHS
+ * @return this expression
+ * @throw std::invalid_argument if the operand does not have as many bins as
+ * the input
+ */
+MDHistoExpression &
+MDHistoExpression::addStep(const Operation operation,
+                           MDHistoWorkspace_const_sptr operand,
+                           const signal_t value, const signal_t errorSquared) {
+  const bool needsOperand =
+      operation == Operation::Plus || operation == Operation::Minus ||
+      operation == Operation::Multiply || operation == Operation::Divide;
+  if (needsOperand &&
+      (!operand || operand->getNPoints() != m_input->getNPoints()))
+    throw std::invalid_argument(
+        "MDHistoExpression: the workspaces must have the same number of bins");
+  m_steps.push_back({operation, std::move(operand), value, errorSquared});
+  return *this;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Evaluate the expression into a new workspace, a copy of the input
+ * holding the result.
+ * @return the result
+ */
+MDHistoWorkspace_sptr MDHistoExpression::evaluate() const {
+  MDHistoWorkspace_sptr output = m_input->clone();
+  sweep(*output, false);
+  return output;
+}
+
+/** Evaluate the expression into an existing workspace. Only the signal,
+ * errors and number of events of the output are set. No other workspace is
+ * created. The output may be the input. It may be an operand only of the
+ * first operation of an expression evaluated into its input, e.g. A = A + A,
+ * since later operations would read the partial result.
+ * @param output :: workspace with as many bins as the input
+ * @throw std::invalid_argument if the output has the wrong size or is an
+ * operand that would be overwritten before it is read
+ */
+void MDHistoExpression::evaluateInPlace(MDHistoWorkspace &output) const {
+  if (output.getNPoints() != m_input->getNPoints())
+    throw std::invalid_argument(
+        "MDHistoExpression: the output must have as many bins as the input");
+  const bool intoInput = &output == m_input.get();
+  for (size_t i = 0; i < m_steps.size(); ++i) {
+    if (m_steps[i].operand.get() == &output && (i > 0 || !intoInput))
+      throw std::invalid_argument(
+          "MDHistoExpression: the output cannot be an operand");
+  }
+  sweep(output, !intoInput);
+}
+
+/** Apply all the operations in one parallel pass over the bins.
+ * @param output :: workspace with as many bins as the input
+ * @param copyInput :: if true, the output does not hold the input yet
+ */
+void MDHistoExpression::sweep(MDHistoWorkspace &output,
+                              const bool copyInput) const {
+  const size_t length = static_cast<size_t>(m_input->getNPoints());
+  signal_t *signal = output.getSignalArray();
+  signal_t *errorSquared = output.getErrorSquaredArray();
+  signal_t *numEvents = output.getNumEventsArray();
+  const signal_t *inSignal = m_input->getSignalArray();
+  const signal_t *inErrorSquared = m_input->getErrorSquaredArray();
+  const signal_t *inNumEvents = m_input->getNumEventsArray();
+
+  const auto numBlocks = static_cast<int64_t>((length + BLOCK_SIZE - 1) /
+                                              BLOCK_SIZE);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t block = 0; block < numBlocks; ++block) {
+    const size_t begin = static_cast<size_t>(block) * BLOCK_SIZE;
+    const size_t end = std::min(begin + BLOCK_SIZE, length);
+    if (copyInput) {
+      std::copy(inSignal + begin, inSignal + end, signal + begin);
+      std::copy(inErrorSquared + begin, inErrorSquared + end,
+                errorSquared + begin);
+      std::copy(inNumEvents + begin, inNumEvents + end, numEvents + begin);
+    }
+    for (const auto &step : m_steps)
+      applyStep(step, begin, end, signal, errorSquared, numEvents);
+  }
+
+  const bool countsEvents =
+      std::any_of(m_steps.cbegin(), m_steps.cend(), [](const Step &step) {
+        return step.operation == Operation::Plus ||
+               step.operation == Operation::Minus;
+      });
+  if (copyInput || countsEvents)
+    output.updateSum();
+}
+
+/** Apply one operation to a block of bins. The error propagation is the same
+ * as in the corresponding method of MDHistoWorkspace.
+ * @param step :: the operation
+ * @param begin :: index of the first bin of the block
+ * @param end :: index after the last bin of the block
+ * @param signal :: signal array of the output
+ * @param errorSquared :: squared error array of the output
+ * @param numEvents :: number of events array of the output
+ */
+void MDHistoExpression::applyStep(const Step &step, const size_t begin,
+                                  const size_t end, signal_t *signal,
+                                  signal_t *errorSquared,
+                                  signal_t *numEvents) const {
+  const signal_t *bSignal = nullptr;
+  const signal_t *bErrorSquared = nullptr;
+  const signal_t *bNumEvents = nullptr;
+  if (step.operand) {
+    bSignal = step.operand->getSignalArray();
+    bErrorSquared = step.operand->getErrorSquaredArray();
+    bNumEvents = step.operand->getNumEventsArray();
+  }
+  const signal_t value = step.value;
+  const signal_t db2 = step.errorSquared;
+
+  switch (step.operation) {
+  case Operation::Plus:
+    for (size_t i = begin; i < end; ++i) {
+      signal[i] += bSignal[i];
+      errorSquared[i] += bErrorSquared[i];
+      numEvents[i] += bNumEvents[i];
+    }
+    break;
+  case Operation::Minus:
+    for (size_t i = begin; i < end; ++i) {
+      signal[i] -= bSignal[i];
+      errorSquared[i] += bErrorSquared[i];
+      numEvents[i] += bNumEvents[i];
+    }
+    break;
+  case Operation::Multiply:
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t a = signal[i];
+      const signal_t b = bSignal[i];
+      signal[i] = a * b;
+      errorSquared[i] = errorSquared[i] * b * b + bErrorSquared[i] * a * a;
+    }
+    break;
+  case Operation::Divide:
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t b = bSignal[i];
+      const signal_t f = signal[i] / b;
+      signal[i] = f;
+      errorSquared[i] =
+          errorSquared[i] / (b * b) + bErrorSquared[i] * f * f / (b * b);
+    }
+    break;
+  case Operation::PlusScalar:
+    for (size_t i = begin; i < end; ++i) {
+      signal[i] += value;
+      errorSquared[i] += db2;
+    }
+    break;
+  case Operation::MinusScalar:
+    for (size_t i = begin; i < end; ++i) {
+      signal[i] -= value;
+      errorSquared[i] += db2;
+    }
+    break;
+  case Operation::MultiplyScalar:
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t a = signal[i];
+      signal[i] = a * value;
+      errorSquared[i] = errorSquared[i] * value * value + db2 * a * a;
+    }
+    break;
+  case Operation::DivideScalar: {
+    const signal_t db2_relative = db2 / (value * value);
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t f = signal[i] / value;
+      signal[i] = f;
+      errorSquared[i] =
+          errorSquared[i] / (value * value) + db2_relative * f * f;
+    }
+    break;
+  }
+  case Operation::Log:
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t a = signal[i];
+      if (a <= 0) {
+        signal[i] = value;
+        errorSquared[i] = 0;
+      } else {
+        signal[i] = std::log(a);
+        errorSquared[i] /= (a * a);
+      }
+    }
+    break;
+  case Operation::Log10:
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t a = signal[i];
+      if (a <= 0) {
+        signal[i] = value;
+        errorSquared[i] = 0;
+      } else {
+        signal[i] = std::log10(a);
+        errorSquared[i] = 0.1886117 * errorSquared[i] / (a * a);
+      }
+    }
+    break;
+  case Operation::Exp:
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t f = std::exp(signal[i]);
+      signal[i] = f;
+      errorSquared[i] = f * f * errorSquared[i];
+    }
+    break;
+  case Operation::Power: {
+    const signal_t exponentSquared = value * value;
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t a = signal[i];
+      const signal_t f = std::pow(a, value);
+      signal[i] = f;
+      errorSquared[i] = f * f * exponentSquared * errorSquared[i] / (a * a);
+    }
+    break;
+  }
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
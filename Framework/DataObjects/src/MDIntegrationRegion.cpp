@@ -0,0 +1,230 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDIntegrationRegion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+/**
+ * Constructor, used by the factory methods
+ * @param center :: The center of the region
+ * @param radiusSquared :: The square of the outer radius
+ * @param innerRadiusSquared :: The square of the inner radius
+ */
+MDIntegrationRegion::MDIntegrationRegion(const std::vector<coord_t> &center,
+                                         const coord_t radiusSquared,
+                                         const coord_t innerRadiusSquared)
+    : m_center(center), m_radiusSquared(radiusSquared),
+      m_innerRadiusSquared(innerRadiusSquared) {
+  if (center.empty())
+    throw std::invalid_argument(
+        "MDIntegrationRegion: the center must have at least one dimension.");
+}
+
+/**
+ * Create a sphere, or a spherical shell
+ * @param center :: The center of the sphere
+ * @param radius :: The radius of the sphere
+ * @param innerRadius :: The radius of the hole in the middle; 0 for none
+ * @return the region
+ */
+MDIntegrationRegion MDIntegrationRegion::sphere(
+    const std::vector<coord_t> &center, const double radius,
+    const double innerRadius) {
+  if (radius < 0.0 || innerRadius < 0.0)
+    throw std::invalid_argument(
+        "MDIntegrationRegion: the radii must not be negative.");
+  MDIntegrationRegion region(center, static_cast<coord_t>(radius * radius),
+                             static_cast<coord_t>(innerRadius * innerRadius));
+  region.m_halfWidths.assign(center.size(), static_cast<coord_t>(radius));
+  region.m_innerHalfWidths.assign(center.size(),
+                                  static_cast<coord_t>(innerRadius));
+  return region;
+}
+
+/**
+ * Create an ellipsoid, or an ellipsoidal shell
+ * @param center :: The center of the ellipsoid
+ * @param axes :: The directions of the principal axes; they are normalised
+ * and must be orthogonal
+ * @param semiAxes :: The lengths of the semi-axes along the principal axes
+ * @param innerScale :: The size of the hole in the middle relative to the
+ * ellipsoid, between 0 (no hole) and 1
+ * @return the region
+ * @throw std::invalid_argument if the axes do not match the center or are not
+ * orthogonal
+ */
+MDIntegrationRegion MDIntegrationRegion::ellipsoid(
+    const std::vector<coord_t> &center,
+    const std::vector<std::vector<double>> &axes,
+    const std::vector<double> &semiAxes, const double innerScale) {
+  const size_t nd = center.size();
+  if (axes.size() != nd || semiAxes.size() != nd)
+    throw std::invalid_argument("MDIntegrationRegion: an ellipsoid needs one "
+                                "axis and one semi-axis per dimension.");
+  if (innerScale < 0.0 || innerScale >= 1.0)
+    throw std::invalid_argument(
+        "MDIntegrationRegion: the inner scale must be in [0, 1).");
+
+  std::vector<std::vector<double>> units(axes);
+  for (size_t k = 0; k < nd; ++k) {
+    if (units[k].size() != nd || !(semiAxes[k] > 0.0))
+      throw std::invalid_argument("MDIntegrationRegion: invalid axis or "
+                                  "semi-axis for an ellipsoid.");
+    double norm = 0.0;
+    for (const double component : units[k])
+      norm += component * component;
+    norm = std::sqrt(norm);
+    if (norm == 0.0)
+      throw std::invalid_argument(
+          "MDIntegrationRegion: the axes must not be null.");
+    for (auto &component : units[k])
+      component /= norm;
+    for (size_t j = 0; j < k; ++j) {
+      double dot = 0.0;
+      for (size_t d = 0; d < nd; ++d)
+        dot += units[j][d] * units[k][d];
+      if (std::fabs(dot) > 1e-6)
+        throw std::invalid_argument(
+            "MDIntegrationRegion: the axes must be orthogonal.");
+    }
+  }
+
+  MDIntegrationRegion region(
+      center, 1.0f, static_cast<coord_t>(innerScale * innerScale));
+  // M = sum_k u_k u_k^T / a_k^2, and the half width of the bounding box along
+  // dimension d is sqrt(sum_k a_k^2 u_kd^2)
+  region.m_metric.assign(nd * nd, 0);
+  region.m_halfWidths.resize(nd);
+  region.m_innerHalfWidths.resize(nd);
+  for (size_t i = 0; i < nd; ++i) {
+    double halfWidthSquared = 0.0;
+    for (size_t k = 0; k < nd; ++k)
+      halfWidthSquared += semiAxes[k] * semiAxes[k] * units[k][i] * units[k][i];
+    region.m_halfWidths[i] = static_cast<coord_t>(std::sqrt(halfWidthSquared));
+    region.m_innerHalfWidths[i] =
+        static_cast<coord_t>(innerScale * std::sqrt(halfWidthSquared));
+    for (size_t j = 0; j < nd; ++j) {
+      double element = 0.0;
+      for (size_t k = 0; k < nd; ++k)
+        element += units[k][i] * units[k][j] / (semiAxes[k] * semiAxes[k]);
+      region.m_metric[i * nd + j] = static_cast<coord_t>(element);
+    }
+  }
+  return region;
+}
+
+/**
+ * @param point :: nd coordinates of a point
+ * @return the squared distance of the point from the center, (x - c)^T M
+ * (x - c), which is compared with the squared radii
+ */
+coord_t MDIntegrationRegion::distanceSquared(const coord_t *point) const {
+  const size_t nd = m_center.size();
+  coord_t distanceSquared = 0;
+  if (m_metric.empty()) {
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t dist = point[d] - m_center[d];
+      distanceSquared += dist * dist;
+    }
+    return distanceSquared;
+  }
+  for (size_t i = 0; i < nd; ++i) {
+    const coord_t disti = point[i] - m_center[i];
+    const coord_t *row = m_metric.data() + i * nd;
+    coord_t rowSum = 0;
+    for (size_t j = 0; j < nd; ++j)
+      rowSum += row[j] * (point[j] - m_center[j]);
+    distanceSquared += disti * rowSum;
+  }
+  return distanceSquared;
+}
+
+/**
+ * Check whether a box may contain points of the region.
+ * @param min :: nd lower edges of the box
+ * @param max :: nd upper edges of the box
+ * @return false if no point of the box is inside the region
+ */
+bool MDIntegrationRegion::mightOverlap(const coord_t *min,
+                                       const coord_t *max) const {
+  const size_t nd = m_center.size();
+  for (size_t d = 0; d < nd; ++d) {
+    if (max[d] < m_center[d] - m_halfWidths[d] ||
+        min[d] > m_center[d] + m_halfWidths[d])
+      return false;
+  }
+  if (!m_metric.empty())
+    return true;
+  // The points of the box closest to and furthest from the center of a sphere
+  coord_t nearest = 0;
+  coord_t furthest = 0;
+  for (size_t d = 0; d < nd; ++d) {
+    const coord_t toMin = min[d] - m_center[d];
+    const coord_t toMax = max[d] - m_center[d];
+    if (toMin > 0)
+      nearest += toMin * toMin;
+    else if (toMax < 0)
+      nearest += toMax * toMax;
+    furthest += std::max(toMin * toMin, toMax * toMax);
+  }
+  return nearest < m_radiusSquared &&
+         (m_innerRadiusSquared == 0 || furthest > m_innerRadiusSquared);
+}
+
+/**
+ * Check whether a box is entirely inside the region, so that its total signal
+ * can be used without looking at its events.
+ * @param min :: nd lower edges of the box
+ * @param max :: nd upper edges of the box
+ * @return true if every point of the box is inside the region
+ */
+bool MDIntegrationRegion::surrounds(const coord_t *min,
+                                    const coord_t *max) const {
+  const size_t nd = m_center.size();
+  if (m_metric.empty()) {
+    coord_t nearest = 0;
+    coord_t furthest = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t toMin = min[d] - m_center[d];
+      const coord_t toMax = max[d] - m_center[d];
+      if (toMin > 0)
+        nearest += toMin * toMin;
+      else if (toMax < 0)
+        nearest += toMax * toMax;
+      furthest += std::max(toMin * toMin, toMax * toMax);
+    }
+    return furthest < m_radiusSquared &&
+           (m_innerRadiusSquared == 0 || nearest > m_innerRadiusSquared);
+  }
+  // The hole must be clear of the box
+  if (m_innerRadiusSquared != 0) {
+    bool clearOfHole = false;
+    for (size_t d = 0; d < nd && !clearOfHole; ++d)
+      clearOfHole = max[d] < m_center[d] - m_innerHalfWidths[d] ||
+                    min[d] > m_center[d] + m_innerHalfWidths[d];
+    if (!clearOfHole)
+      return false;
+  }
+  // An ellipsoid is convex: it contains the box if it contains every vertex
+  std::vector<coord_t> vertex(nd);
+  const size_t numVertices = size_t(1) << nd;
+  for (size_t i = 0; i < numVertices; ++i) {
+    for (size_t d = 0; d < nd; ++d)
+      vertex[d] = (i & (size_t(1) << d)) ? max[d] : min[d];
+    if (!(distanceSquared(vertex.data()) < m_radiusSquared))
+      return false;
+  }
+  return true;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,168 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef BOXCONTROLLER_MAPPED_IO_TEST_H
+#define BOXCONTROLLER_MAPPED_IO_TEST_H
+
+#include "MantidAPI/FileFinder.h"
+#include "MantidDataObjects/BoxControllerMappedIO.h"
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/Exception.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/File.h>
+
+using Mantid::DataObjects::BoxControllerMappedIO;
+
+class BoxControllerMappedIOTest : public CxxTest::TestSuite {
+public:
+  static BoxControllerMappedIOTest *createSuite() {
+    return new BoxControllerMappedIOTest();
+  }
+  static void destroySuite(BoxControllerMappedIOTest *suite) { delete suite; }
+
+  Mantid::API::BoxController_sptr sc;
+  std::string fileName;
+
+  BoxControllerMappedIOTest() {
+    sc = Mantid::API::BoxController_sptr(new Mantid::API::BoxController(4));
+    fileName = "BoxControllerMappedIOTest.mdevents";
+  }
+
+  void setUp() override { removeFile(); }
+
+  void tearDown() override { removeFile(); }
+
+  void test_setDataType() {
+    BoxControllerMappedIO io(sc.get());
+    size_t coordSize;
+    std::string typeName;
+    io.getDataType(coordSize, typeName);
+    TS_ASSERT_EQUALS(sizeof(Mantid::coord_t), coordSize);
+    TS_ASSERT_EQUALS("MDEvent", typeName);
+    TS_ASSERT_EQUALS(io.getNDataColumns(), 8);
+
+    TS_ASSERT_THROWS(io.setDataType(9, typeName), std::invalid_argument);
+    TS_ASSERT_THROWS(io.setDataType(4, "UnknownEvent"),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS_NOTHING(io.setDataType(8, "MDLeanEvent"));
+    io.getDataType(coordSize, typeName);
+    TS_ASSERT_EQUALS(8, coordSize);
+    TS_ASSERT_EQUALS("MDLeanEvent", typeName);
+    TS_ASSERT_EQUALS(io.getNDataColumns(), 6);
+  }
+
+  void test_new_file_does_not_open_for_reading() {
+    BoxControllerMappedIO io(sc.get());
+    TS_ASSERT_THROWS(io.openFile(fileName, "r"),
+                     Mantid::Kernel::Exception::FileError);
+    TS_ASSERT(!io.isOpened());
+  }
+
+  void test_save_and_load_blocks_growing_the_file() {
+    BoxControllerMappedIO io(sc.get());
+    io.setDataType(4, "MDLeanEvent");
+    TS_ASSERT(io.openFile(fileName, "w"));
+    TS_ASSERT(io.isOpened());
+    TS_ASSERT(!io.openFile(fileName, "w"));
+    TS_ASSERT_EQUALS(io.getFileLength(), 0);
+
+    // A block far beyond the initial size of the file
+    const uint64_t position = 5 * io.getDataChunk();
+    const size_t nColumns = io.getNDataColumns();
+    std::vector<float> block = makeBlock(10, nColumns, 1.5f);
+    TS_ASSERT_THROWS_NOTHING(io.saveBlock(block, position));
+    TS_ASSERT_EQUALS(io.getFileLength(), position + 10);
+    std::vector<float> first = makeBlock(3, nColumns, -2.f);
+    io.saveBlock(first, 0);
+    TS_ASSERT_EQUALS(io.getFileLength(), position + 10);
+
+    std::vector<float> loaded;
+    io.loadBlock(loaded, position, 10);
+    TS_ASSERT_EQUALS(loaded, block);
+    io.loadBlock(loaded, 0, 3);
+    TS_ASSERT_EQUALS(loaded, first);
+    // Double precision clients read the same values
+    std::vector<double> loadedDouble;
+    io.loadBlock(loadedDouble, 1, 1);
+    TS_ASSERT_EQUALS(loadedDouble,
+                     std::vector<double>(first.begin() + nColumns,
+                                         first.begin() + 2 * nColumns));
+    TS_ASSERT_THROWS(io.loadBlock(loaded, position + 5, 10),
+                     Mantid::Kernel::Exception::FileError);
+
+    io.closeFile();
+    TS_ASSERT(!io.isOpened());
+  }
+
+  void test_events_and_free_space_are_kept_when_reopened() {
+    std::string fullPath;
+    std::vector<double> block = makeBlock(20, 8, 3.0);
+    std::vector<uint64_t> freeSpace{100, 5, 200, 7};
+    {
+      BoxControllerMappedIO io(sc.get());
+      io.setDataType(8, "MDEvent");
+      io.openFile(fileName, "w");
+      fullPath = io.getFileName();
+      io.saveBlock(block, 4);
+      io.setFreeSpaceVector(freeSpace);
+    }
+    TS_ASSERT(Poco::File(fullPath).exists());
+
+    BoxControllerMappedIO io(sc.get());
+    io.setDataType(8, "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(io.openFile(fullPath, "r"));
+    TS_ASSERT_EQUALS(io.getFileLength(), 24);
+    std::vector<double> loaded;
+    io.loadBlock(loaded, 4, 20);
+    TS_ASSERT_EQUALS(loaded, block);
+    std::vector<uint64_t> readFreeSpace;
+    io.getFreeSpaceVector(readFreeSpace);
+    TS_ASSERT_EQUALS(readFreeSpace, freeSpace);
+    TS_ASSERT_THROWS(io.saveBlock(block, 0),
+                     Mantid::Kernel::Exception::FileError);
+    io.closeFile();
+
+    // Events of another kind do not match the file
+    BoxControllerMappedIO lean(sc.get());
+    lean.setDataType(8, "MDLeanEvent");
+    TS_ASSERT_THROWS(lean.openFile(fullPath, "r"),
+                     Mantid::Kernel::Exception::FileError);
+  }
+
+  void test_deleteOnClose() {
+    std::string fullPath;
+    {
+      BoxControllerMappedIO io(sc.get());
+      io.setDeleteOnClose(true);
+      io.openFile(fileName, "w");
+      fullPath = io.getFileName();
+      io.saveBlock(makeBlock(8, io.getNDataColumns(), 1.f), 0);
+      TS_ASSERT(Poco::File(fullPath).exists());
+    }
+    TS_ASSERT(!Poco::File(fullPath).exists());
+  }
+
+private:
+  /// Distinct values for nEvents events
+  template <typename T>
+  std::vector<T> makeBlock(size_t nEvents, size_t nColumns, T start) {
+    std::vector<T> block(nColumns * nEvents);
+    for (size_t i = 0; i < block.size(); ++i)
+      block[i] = start + static_cast<T>(i);
+    return block;
+  }
+
+  void removeFile() {
+    const std::string fullPath =
+        Mantid::API::FileFinder::Instance().getFullPath(fileName);
+    if (!fullPath.empty())
+      Poco::File(fullPath).remove();
+  }
+};
+
+#endif /* BOXCONTROLLER_MAPPED_IO_TEST_H */
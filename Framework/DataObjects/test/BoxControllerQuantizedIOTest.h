@@ -0,0 +1,218 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef BOXCONTROLLER_QUANTIZED_IO_TEST_H
+#define BOXCONTROLLER_QUANTIZED_IO_TEST_H
+
+#include "MantidDataObjects/BoxControllerQuantizedIO.h"
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/Exception.h"
+
+#include <cmath>
+
+#include <cxxtest/TestSuite.h>
+
+using Mantid::DataObjects::BoxControllerQuantizedIO;
+
+class BoxControllerQuantizedIOTest : public CxxTest::TestSuite {
+public:
+  static BoxControllerQuantizedIOTest *createSuite() {
+    return new BoxControllerQuantizedIOTest();
+  }
+  static void destroySuite(BoxControllerQuantizedIOTest *suite) {
+    delete suite;
+  }
+
+  Mantid::API::BoxController_sptr sc;
+
+  BoxControllerQuantizedIOTest() {
+    sc = Mantid::API::BoxController_sptr(new Mantid::API::BoxController(4));
+  }
+
+  void test_setDataType() {
+    BoxControllerQuantizedIO io(sc.get());
+    size_t coordSize;
+    std::string typeName;
+    io.getDataType(coordSize, typeName);
+    TS_ASSERT_EQUALS(sizeof(Mantid::coord_t), coordSize);
+    TS_ASSERT_EQUALS("MDEvent", typeName);
+    TS_ASSERT_EQUALS(io.getNDataColumns(), 8);
+
+    TS_ASSERT_THROWS(io.setDataType(9, typeName), std::invalid_argument);
+    TS_ASSERT_THROWS(io.setDataType(4, "UnknownEvent"),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS_NOTHING(io.setDataType(8, "MDLeanEvent"));
+    io.getDataType(coordSize, typeName);
+    TS_ASSERT_EQUALS(8, coordSize);
+    TS_ASSERT_EQUALS("MDLeanEvent", typeName);
+    TS_ASSERT_EQUALS(io.getNDataColumns(), 6);
+  }
+
+  void test_opens_for_writing_only() {
+    BoxControllerQuantizedIO io(sc.get());
+    TS_ASSERT_THROWS(io.openFile("events", "r"),
+                     Mantid::Kernel::Exception::FileError);
+    TS_ASSERT(!io.isOpened());
+    TS_ASSERT(io.openFile("events", "w"));
+    TS_ASSERT(io.isOpened());
+    TS_ASSERT(!io.openFile("events", "w"));
+    TS_ASSERT_EQUALS(io.getFileName(), "events");
+    TS_ASSERT_EQUALS(io.getFileLength(), 0);
+    io.closeFile();
+    TS_ASSERT(!io.isOpened());
+  }
+
+  void test_unit_lean_events_are_compact_and_close_to_the_originals() {
+    BoxControllerQuantizedIO io(sc.get());
+    io.setDataType(4, "MDLeanEvent");
+    io.openFile("events", "w");
+
+    const size_t nEvents = 1000;
+    std::vector<float> block(6 * nEvents);
+    for (size_t i = 0; i < nEvents; ++i) {
+      float *row = block.data() + 6 * i;
+      row[0] = 1.f;
+      row[1] = 1.f;
+      for (size_t d = 0; d < 4; ++d)
+        row[2 + d] = 2.f + static_cast<float>((i * (d + 3) * 7919) % 1000) /
+                               1000.f * static_cast<float>(d + 1);
+    }
+    io.saveBlock(block, 20);
+    TS_ASSERT_EQUALS(io.getFileLength(), 20 + nEvents);
+    TS_ASSERT_EQUALS(io.getNumBlocks(), 1);
+    // 8 bytes for each event, instead of 24
+    TS_ASSERT_LESS_THAN(io.getStoredBytes(), 9 * nEvents);
+
+    std::vector<float> loaded;
+    io.loadBlock(loaded, 20, nEvents);
+    TS_ASSERT_EQUALS(loaded.size(), block.size());
+    for (size_t i = 0; i < nEvents; ++i) {
+      TS_ASSERT_EQUALS(loaded[6 * i], 1.f);
+      TS_ASSERT_EQUALS(loaded[6 * i + 1], 1.f);
+      for (size_t d = 0; d < 4; ++d) {
+        // Half a step of the extent of the block, plus the float rounding
+        const double tolerance = double(d + 1) / 131070. + 1e-6;
+        TS_ASSERT_DELTA(loaded[6 * i + 2 + d], block[6 * i + 2 + d],
+                        tolerance);
+      }
+    }
+
+    // A part of the block
+    std::vector<double> part;
+    io.loadBlock(part, 25, 2);
+    TS_ASSERT_EQUALS(part.size(), 12);
+    TS_ASSERT_DELTA(part[2], loaded[6 * 5 + 2], 1e-6);
+    TS_ASSERT_THROWS(io.loadBlock(loaded, 20, nEvents + 1),
+                     Mantid::Kernel::Exception::FileError);
+  }
+
+  void test_weights_and_event_ids_are_exact() {
+    BoxControllerQuantizedIO io(sc.get());
+    io.setDataType(8, "MDEvent");
+    io.openFile("events", "w");
+
+    // signal, errorSquared, runIndex, detectorId and a point, twice
+    std::vector<double> block = {2.5, 0.25, 3, 100012, 1, 2, 3, 4,
+                                 1.0, 1.0,  7, 5,      1, 2, 3, 4};
+    io.saveBlock(block, 0);
+    std::vector<double> loaded;
+    io.loadBlock(loaded, 0, 2);
+    // All the events are at the same point, which is kept exactly
+    TS_ASSERT_EQUALS(loaded, block);
+  }
+
+  void test_events_are_quantized_within_their_box() {
+    BoxControllerQuantizedIO io(sc.get());
+    io.setDataType(8, "MDLeanEvent");
+    io.openFile("events", "w");
+
+    const std::vector<double> boxMin(4, -1.), boxMax(4, 1.);
+    // Two events with a bounding box much smaller than their box
+    std::vector<double> block = {1, 1, 0.1, 0.2, 0.3, 0.4,
+                                 1, 1, 0.2, 0.3, 0.4, 0.5};
+    io.saveBlockInBox(block, 0, boxMin, boxMax);
+    std::vector<double> loaded;
+    io.loadBlock(loaded, 0, 2);
+    const double step = 2. / 65535.;
+    for (size_t i = 0; i < 2; ++i) {
+      for (size_t d = 0; d < 4; ++d) {
+        const double value = loaded[6 * i + 2 + d];
+        TS_ASSERT_DELTA(value, block[6 * i + 2 + d], 0.5 * step + 1e-12);
+        // On the grid of the box, not of the events
+        const double offset = (value + 1.) / step;
+        TS_ASSERT_DELTA(offset, std::round(offset), 1e-6);
+      }
+    }
+
+    // Saving the rounded events again does not move them
+    io.saveBlockInBox(loaded, 0, boxMin, boxMax);
+    std::vector<double> reloaded;
+    io.loadBlock(reloaded, 0, 2);
+    TS_ASSERT_EQUALS(reloaded, loaded);
+  }
+
+  void test_saving_over_a_block_replaces_it() {
+    BoxControllerQuantizedIO io(sc.get());
+    io.setDataType(4, "MDLeanEvent");
+    io.openFile("events", "w");
+
+    std::vector<float> first(6 * 10, 1.f);
+    io.saveBlock(first, 0);
+    std::vector<float> second(6 * 5, 1.f);
+    io.saveBlock(second, 20);
+    TS_ASSERT_EQUALS(io.getNumBlocks(), 2);
+    TS_ASSERT_EQUALS(io.getFileLength(), 25);
+
+    // The free space between the blocks reads as zeros
+    std::vector<float> loaded;
+    io.loadBlock(loaded, 8, 14);
+    TS_ASSERT_EQUALS(loaded[0], 1.f);
+    TS_ASSERT_EQUALS(loaded[6 * 2], 0.f);
+    TS_ASSERT_EQUALS(loaded[6 * 12], 1.f);
+
+    // A moved box takes over the space of the first block
+    std::vector<float> moved(6 * 4, 2.f);
+    io.saveBlock(moved, 3);
+    TS_ASSERT_EQUALS(io.getNumBlocks(), 2);
+    io.loadBlock(loaded, 0, 10);
+    TS_ASSERT_EQUALS(loaded[0], 0.f);
+    TS_ASSERT_EQUALS(loaded[6 * 3], 2.f);
+    TS_ASSERT_EQUALS(loaded[6 * 7], 0.f);
+  }
+
+  void test_freed_blocks_are_dropped() {
+    BoxControllerQuantizedIO io(sc.get());
+    io.setDataType(4, "MDLeanEvent");
+    io.openFile("events", "w");
+
+    std::vector<float> block(6 * 10, 1.f);
+    io.saveBlock(block, 0);
+    io.saveBlock(block, 10);
+    io.saveBlock(block, 20);
+    TS_ASSERT_EQUALS(io.getNumBlocks(), 3);
+    const size_t storedBytes = io.getStoredBytes();
+
+    // A box growing out of its space moves to the end of the store
+    TS_ASSERT_EQUALS(io.relocate(10, 10, 15), 30);
+    TS_ASSERT_EQUALS(io.getNumBlocks(), 2);
+    TS_ASSERT_LESS_THAN(io.getStoredBytes(), storedBytes);
+    std::vector<uint64_t> freeSpace;
+    io.getFreeSpaceVector(freeSpace);
+    TS_ASSERT_EQUALS(freeSpace, std::vector<uint64_t>({10, 10}));
+
+    // The blocks around the freed range are kept
+    std::vector<float> loaded;
+    io.loadBlock(loaded, 0, 30);
+    TS_ASSERT_EQUALS(loaded[6 * 9], 1.f);
+    TS_ASSERT_EQUALS(loaded[6 * 10], 0.f);
+    TS_ASSERT_EQUALS(loaded[6 * 20], 1.f);
+
+    io.freeBlock(0, 10);
+    TS_ASSERT_EQUALS(io.getNumBlocks(), 1);
+  }
+};
+
+#endif /* BOXCONTROLLER_QUANTIZED_IO_TEST_H */
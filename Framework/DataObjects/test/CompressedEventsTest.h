@@ -0,0 +1,175 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_COMPRESSEDEVENTSTEST_H_
+#define MANTID_DATAOBJECTS_COMPRESSEDEVENTSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/CompressedEvents.h"
+
+#include <limits>
+#include <string>
+
+using namespace Mantid::DataObjects;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class CompressedEventsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompressedEventsTest *createSuite() {
+    return new CompressedEventsTest();
+  }
+  static void destroySuite(CompressedEventsTest *suite) { delete suite; }
+
+  void test_empty() {
+    CompressedEvents compressed;
+    TS_ASSERT(compressed.empty());
+    compressed.encode(std::vector<TofEvent>(), 0.1);
+    TS_ASSERT(compressed.empty());
+    std::vector<TofEvent> decoded(3);
+    compressed.decode(decoded);
+    TS_ASSERT(decoded.empty());
+  }
+
+  void test_tof_events_round_trip() {
+    std::vector<TofEvent> events;
+    for (int i = 0; i < 1000; ++i)
+      events.emplace_back(100.0 + 0.37 * i, DateAndTime(1000000 * (i % 7)));
+    // Large gaps need several bytes
+    events.emplace_back(1e7, DateAndTime(0));
+
+    CompressedEvents compressed;
+    compressed.encode(events, 0.01);
+    TS_ASSERT_EQUALS(compressed.size(), events.size());
+    TS_ASSERT_EQUALS(compressed.tofMin(), 100.0);
+    TS_ASSERT_DELTA(compressed.tofMax(), 1e7, 0.005);
+    // One byte per TOF step and one index per pulse time
+    TS_ASSERT_LESS_THAN(compressed.getMemorySize(),
+                        events.size() * sizeof(TofEvent) / 2);
+
+    std::vector<TofEvent> decoded;
+    compressed.decode(decoded);
+    TS_ASSERT_EQUALS(decoded.size(), events.size());
+    auto cursor = compressed.tofs();
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_DELTA(decoded[i].tof(), events[i].tof(), 0.005);
+      TS_ASSERT_EQUALS(decoded[i].pulseTime(), events[i].pulseTime());
+      TS_ASSERT_EQUALS(cursor.next(), decoded[i].tof());
+    }
+  }
+
+  void test_weights_that_fit_in_half_precision() {
+    std::vector<WeightedEvent> events;
+    for (int i = 0; i < 100; ++i) {
+      const float weight = static_cast<float>(i % 10);
+      events.emplace_back(static_cast<double>(i), DateAndTime(i), weight,
+                          weight);
+    }
+    CompressedEvents compressed;
+    compressed.encode(events, 1.0);
+    std::vector<WeightedEvent> decoded;
+    compressed.decode(decoded);
+    TS_ASSERT_EQUALS(decoded, events);
+    // TOF steps, pulse indices and half weights only
+    TS_ASSERT_EQUALS(compressed.getMemorySize(), 100 * (1 + 4 + 2));
+  }
+
+  void test_weights_with_proportional_errors() {
+    std::vector<WeightedEventNoTime> events;
+    for (int i = 0; i < 100; ++i) {
+      const float weight = 0.1f * static_cast<float>(i);
+      events.emplace_back(static_cast<double>(i), weight, weight * weight);
+    }
+    CompressedEvents compressed;
+    compressed.encode(events, 1.0);
+    std::vector<WeightedEventNoTime> decoded;
+    compressed.decode(decoded);
+    TS_ASSERT_EQUALS(decoded, events);
+    // 0.1 does not fit in half precision, but no errors are stored
+    TS_ASSERT_EQUALS(compressed.getMemorySize(), 100 * (1 + 4));
+  }
+
+  void test_explicit_errors() {
+    std::vector<WeightedEventNoTime> events{{1.0, 2.0f, 3.0f},
+                                            {2.0, 4.0f, 0.5f}};
+    CompressedEvents compressed;
+    compressed.encode(events, 1.0);
+    TS_ASSERT_EQUALS(compressed.weight(1), 4.0f);
+    TS_ASSERT_EQUALS(compressed.errorSquared(0), 3.0f);
+    TS_ASSERT_EQUALS(compressed.errorSquared(1), 0.5f);
+  }
+
+  void test_shared_pulse_times() {
+    const auto pulseTimes = CompressedEvents::makePulseTimes({30, 10, 20, 10});
+    TS_ASSERT_EQUALS(*pulseTimes, (std::vector<int64_t>{10, 20, 30}));
+    std::vector<TofEvent> events{{1.0, DateAndTime(int64_t{30})},
+                                 {2.0, DateAndTime(int64_t{10})}};
+    CompressedEvents compressed;
+    compressed.encode(events, 1.0, pulseTimes);
+    TS_ASSERT_EQUALS(compressed.pulseTime(0), DateAndTime(int64_t{30}));
+    TS_ASSERT_EQUALS(compressed.pulseTime(1), DateAndTime(int64_t{10}));
+
+    events.emplace_back(3.0, DateAndTime(int64_t{15}));
+    TS_ASSERT_THROWS(compressed.encode(events, 1.0, pulseTimes),
+                     std::invalid_argument);
+  }
+
+  void test_scaleTof() {
+    std::vector<TofEvent> events{{10.0}, {12.0}, {20.0}};
+    CompressedEvents compressed;
+    compressed.encode(events, 0.5);
+    compressed.scaleTof(2.0, 1.0);
+    TS_ASSERT_EQUALS(compressed.tofMin(), 21.0);
+    TS_ASSERT_EQUALS(compressed.tofMax(), 41.0);
+    std::vector<TofEvent> decoded;
+    compressed.decode(decoded);
+    TS_ASSERT_EQUALS(decoded[1].tof(), 25.0);
+    TS_ASSERT_THROWS(compressed.scaleTof(-1.0, 0.0), std::invalid_argument);
+  }
+
+  void test_invalid_input_throws() {
+    std::vector<TofEvent> unsorted{{2.0}, {1.0}};
+    CompressedEvents compressed;
+    TS_ASSERT_THROWS(compressed.encode(unsorted, 0.1), std::invalid_argument);
+    std::vector<TofEvent> events{{1.0}, {2.0}};
+    TS_ASSERT_THROWS(compressed.encode(events, 0.0), std::invalid_argument);
+    TS_ASSERT_THROWS(compressed.encode(events, 1e-300),
+                     std::invalid_argument);
+  }
+
+  void test_non_finite_tof_is_named_in_the_error() {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (const auto &events : {std::vector<TofEvent>{{1.0}, {inf}},
+                               std::vector<TofEvent>{{-inf}, {1.0}},
+                               std::vector<TofEvent>{{1.0}, {nan}, {2.0}}}) {
+      CompressedEvents compressed;
+      try {
+        compressed.encode(events, 0.1);
+        TS_FAIL("Expected std::invalid_argument");
+      } catch (const std::invalid_argument &error) {
+        const std::string message = error.what();
+        TS_ASSERT(message.find("must be finite") != std::string::npos);
+        TS_ASSERT(message.find("too fine") == std::string::npos);
+        TS_ASSERT(message.find("inf") != std::string::npos ||
+                  message.find("nan") != std::string::npos);
+      }
+    }
+  }
+
+  void test_halfToFloat() {
+    TS_ASSERT_EQUALS(CompressedEvents::halfToFloat(0x3c00), 1.0f);
+    TS_ASSERT_EQUALS(CompressedEvents::halfToFloat(0xc000), -2.0f);
+    TS_ASSERT_EQUALS(CompressedEvents::halfToFloat(0x7bff), 65504.0f);
+    TS_ASSERT_EQUALS(CompressedEvents::halfToFloat(0x0001), 5.9604645e-8f);
+    TS_ASSERT_EQUALS(CompressedEvents::halfToFloat(0x0000), 0.0f);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_COMPRESSEDEVENTSTEST_H_ */
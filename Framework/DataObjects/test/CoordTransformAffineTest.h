@@ -18,6 +18,8 @@
 #include "MantidKernel/VMD.h"
 #include <cxxtest/TestSuite.h>
 
+#include "CoordTransformTestHelper.h"
+
 #include <boost/scoped_ptr.hpp>
 
 using namespace Mantid;
@@ -364,6 +366,21 @@ public:
   }
 
   //-----------------------------------------------------------------------------------------------
+  void test_applyBatch() {
+    for (size_t inD = 2; inD <= 5; ++inD) {
+      for (size_t outD = inD - 1; outD <= inD; ++outD) {
+        Matrix<coord_t> mat(outD + 1, inD + 1);
+        for (size_t row = 0; row <= outD; ++row)
+          for (size_t col = 0; col <= inD; ++col)
+            mat[row][col] = static_cast<coord_t>(row) * 0.5f -
+                            static_cast<coord_t>(col) * 0.25f + 1.0f;
+        CoordTransformAffine ct(inD, outD);
+        ct.setMatrix(mat);
+        checkApplyBatch(ct);
+      }
+    }
+  }
+
   void testSerialization() {
     using Mantid::Kernel::V3D;
     CoordTransformAffine ct(3, 3);
@@ -424,6 +441,19 @@ public:
       ct.apply(in, out);
     }
   }
+  void test_applyBatch_4D_performance() {
+    CoordTransformAffine ct(4, 4);
+    coord_t translation[4] = {2.0, 3.0, 4.0, 5.0};
+    ct.addTranslation(translation);
+    // Centers of MDEvents, 6 coordinates apart
+    std::vector<coord_t> in(1000 * 6, 1.5);
+    std::vector<coord_t> out(1000 * 4);
+
+    for (size_t i = 0; i < 1000 * 10; ++i) {
+      ct.applyBatch(in.data(), 6, out.data(), 1000);
+    }
+    TS_ASSERT_DELTA(out[0], 3.5, 1e-5);
+  }
 };
 
 #endif /* MANTID_DATAOBJECTS_COORDTRANSFORMAFFINETEST_H_ */
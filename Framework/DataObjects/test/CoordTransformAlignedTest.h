@@ -11,6 +11,8 @@
 #include "MantidKernel/Timer.h"
 #include <cxxtest/TestSuite.h>
 
+#include "CoordTransformTestHelper.h"
+
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/CoordTransformAligned.h"
 #include "MantidKernel/Matrix.h"
@@ -94,6 +96,16 @@ public:
   }
 
   /// Turn the aligned transform into an affine transform
+  void test_applyBatch() {
+    size_t dimToBinFrom[5] = {4, 1, 0, 2, 3};
+    coord_t origin[5] = {5, 10, 15, 20, 25};
+    coord_t scaling[5] = {1, 2, 3, 4, 5};
+    for (size_t outD = 2; outD <= 5; ++outD) {
+      CoordTransformAligned ct(5, outD, dimToBinFrom, origin, scaling);
+      checkApplyBatch(ct);
+    }
+  }
+
   void test_makeAffineMatrix() {
     size_t dimToBinFrom[3] = {3, 1, 0};
     coord_t origin[3] = {5, 10, 15};
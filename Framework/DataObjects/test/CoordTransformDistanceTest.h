@@ -13,6 +13,8 @@
 #include "MantidKernel/Timer.h"
 #include <cxxtest/TestSuite.h>
 
+#include "CoordTransformTestHelper.h"
+
 #include <boost/scoped_ptr.hpp>
 
 using namespace Mantid;
@@ -93,6 +95,18 @@ public:
   }
 
   /** Test serialization */
+  void test_applyBatch() {
+    coord_t center[4] = {1, 2, 3, 4};
+    bool used[4] = {true, false, true, true};
+    for (size_t inD = 2; inD <= 4; ++inD) {
+      CoordTransformDistance ct(inD, center, used);
+      checkApplyBatch(ct);
+    }
+    // Cylinder
+    CoordTransformDistance cylinder(3, center, used, 2);
+    checkApplyBatch(cylinder);
+  }
+
   void test_to_xml_string() {
     std::string expectedResult =
         std::string("<CoordTransform>") +
@@ -0,0 +1,40 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef DATAOBJECTSTEST_COORDTRANSFORMTESTHELPER_H_
+#define DATAOBJECTSTEST_COORDTRANSFORMTESTHELPER_H_
+
+#include "MantidAPI/CoordTransform.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+/**
+ * Helper for the coordinate transformation tests: check that applyBatch gives
+ * the same results as apply for vectors that are not contiguous
+ * @param ct :: The transformation to check
+ */
+inline void checkApplyBatch(const Mantid::API::CoordTransform &ct) {
+  using Mantid::coord_t;
+  const size_t inD = ct.getInD();
+  const size_t outD = ct.getOutD();
+  const size_t stride = inD + 2;
+  const size_t nVectors = 7;
+  std::vector<coord_t> in(nVectors * stride);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = static_cast<coord_t>(i % 5) * 1.25f - 2.0f;
+  std::vector<coord_t> out(nVectors * outD);
+  ct.applyBatch(in.data(), stride, out.data(), nVectors);
+  std::vector<coord_t> expected(outD);
+  for (size_t i = 0; i < nVectors; ++i) {
+    ct.apply(in.data() + i * stride, expected.data());
+    for (size_t d = 0; d < outD; ++d)
+      TS_ASSERT_EQUALS(out[i * outD + d], expected[d]);
+  }
+}
+
+#endif
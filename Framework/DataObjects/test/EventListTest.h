@@ -927,6 +927,293 @@ public:
     }
   }
 
+  void test_histogram_struct_of_arrays_matches_all_types() {
+    MantidVec X = this->makeX(BIN_DELTA);
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      // Scramble the order so that the columns also need sorting
+      el.sortPulseTime();
+      EventList columns(el);
+      columns.setStorageLayout(STRUCT_OF_ARRAYS);
+      TS_ASSERT_EQUALS(columns.getStorageLayout(), STRUCT_OF_ARRAYS);
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), el.getNumberEvents());
+
+      MantidVec Y, E, columnsY, columnsE;
+      el.generateHistogram(X, Y, E);
+      columns.generateHistogram(X, columnsY, columnsE);
+      TS_ASSERT_EQUALS(columns.getStorageLayout(), STRUCT_OF_ARRAYS);
+      TS_ASSERT_EQUALS(columnsY, Y);
+      TS_ASSERT_EQUALS(columnsE, E);
+    }
+  }
+
+  void test_histogram_regular_bins_unsorted() {
+    // Logarithmic bins with a narrower last bin
+    MantidVec X{100.0};
+    while (X.back() * 1.1 < 900.0)
+      X.push_back(X.back() * 1.1);
+    X.push_back(900.0);
+    for (int this_type = 0; this_type < 3; this_type++) {
+      for (const auto layout : {ARRAY_OF_STRUCTS, STRUCT_OF_ARRAYS}) {
+        this->fake_uniform_time_data();
+        el.switchTo(static_cast<EventType>(this_type));
+        el.setStorageLayout(layout);
+        const auto tofs = el.getTofs();
+        const auto weights = el.getWeights();
+        const auto errors = el.getWeightErrors();
+
+        MantidVec Y, E;
+        el.generateHistogram(X, Y, E);
+        // Regular bins do not need the events sorted
+        TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+        TS_ASSERT_EQUALS(Y.size(), X.size() - 1);
+        TS_ASSERT_EQUALS(E.size(), X.size() - 1);
+
+        MantidVec expectedY(Y.size(), 0.0), expectedE(Y.size(), 0.0);
+        for (size_t i = 0; i < tofs.size(); ++i) {
+          if (tofs[i] < X.front() || tofs[i] >= X.back())
+            continue;
+          const auto bin =
+              std::upper_bound(X.begin(), X.end(), tofs[i]) - X.begin() - 1;
+          expectedY[bin] += weights[i];
+          expectedE[bin] += errors[i] * errors[i];
+        }
+        for (size_t bin = 0; bin < Y.size(); ++bin) {
+          TS_ASSERT_DELTA(Y[bin], expectedY[bin], 1e-4);
+          TS_ASSERT_DELTA(E[bin], sqrt(expectedE[bin]), 1e-4);
+        }
+      }
+    }
+  }
+
+  void test_histogram_keeps_sort_order_only_for_regular_bins() {
+    this->fake_uniform_time_data();
+    el.sortPulseTime();
+    MantidVec Y, E;
+    // Linear bins leave the list sorted by pulse time
+    el.generateHistogram({0.0, 1000.0, 2000.0, 3000.0}, Y, E);
+    TS_ASSERT_EQUALS(el.getSortType(), PULSETIME_SORT);
+    // Other bins sort it by TOF
+    el.generateHistogram({0.0, 10.0, 2000.0, 3000.0}, Y, E);
+    TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+  }
+
+  void test_convertTof_struct_of_arrays() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      EventList columns(el);
+      columns.setStorageLayout(STRUCT_OF_ARRAYS);
+
+      el.convertTof(2.5, 1.0);
+      columns.convertTof(2.5, 1.0);
+      TS_ASSERT_EQUALS(columns.getStorageLayout(), STRUCT_OF_ARRAYS);
+      TS_ASSERT_EQUALS(columns.getTofs(), el.getTofs());
+      TS_ASSERT_EQUALS(columns.getTofMin(), el.getTofMin());
+      TS_ASSERT_EQUALS(columns.getTofMax(), el.getTofMax());
+    }
+  }
+
+  void test_reallocateEvents_keeps_events() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      for (const auto layout : {ARRAY_OF_STRUCTS, STRUCT_OF_ARRAYS}) {
+        this->fake_uniform_data();
+        el.switchTo(static_cast<EventType>(this_type));
+        const EventList expected(el);
+        el.setStorageLayout(layout);
+        const auto memory = el.getMemorySize();
+
+        el.reallocateEvents();
+        TS_ASSERT_EQUALS(el.getStorageLayout(), layout);
+        TS_ASSERT_LESS_THAN_EQUALS(el.getMemorySize(), memory);
+        TS_ASSERT(el == expected);
+      }
+    }
+  }
+
+  void test_struct_of_arrays_falls_back_to_array_of_structs() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      EventList columns(el);
+      columns.setStorageLayout(STRUCT_OF_ARRAYS);
+
+      // Operations without a column-wise implementation see the same events
+      TS_ASSERT(columns == el);
+      TS_ASSERT_EQUALS(columns.getStorageLayout(), ARRAY_OF_STRUCTS);
+      TS_ASSERT_EQUALS(columns.getWeights(), el.getWeights());
+      TS_ASSERT_EQUALS(columns.getPulseTimes(), el.getPulseTimes());
+
+      columns.setStorageLayout(STRUCT_OF_ARRAYS);
+      columns += TofEvent(123.0, 456);
+      TS_ASSERT_EQUALS(columns.getStorageLayout(), ARRAY_OF_STRUCTS);
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), el.getNumberEvents() + 1);
+    }
+  }
+
+  void test_const_reads_keep_struct_of_arrays() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_time_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      if (this_type == WEIGHTED)
+        el *= 2.5;
+      EventList columns(el);
+      columns.setStorageLayout(STRUCT_OF_ARRAYS);
+      const EventList &constColumns = columns;
+
+      TS_ASSERT_EQUALS(constColumns.getWeights(), el.getWeights());
+      TS_ASSERT_EQUALS(constColumns.getWeightErrors(), el.getWeightErrors());
+      TS_ASSERT_EQUALS(constColumns.getPulseTimes(), el.getPulseTimes());
+      TS_ASSERT_EQUALS(constColumns.getPulseTimeMin(), el.getPulseTimeMin());
+      TS_ASSERT_EQUALS(constColumns.getPulseTimeMax(), el.getPulseTimeMax());
+      double sum, error, expectedSum, expectedError;
+      constColumns.integrate(0, 0, true, sum, error);
+      el.integrate(0, 0, true, expectedSum, expectedError);
+      TS_ASSERT_DELTA(sum, expectedSum, 1e-6);
+      TS_ASSERT_DELTA(error, expectedError, 1e-6);
+      constColumns.integrate(100.0, 500.0, false, sum, error);
+      el.integrate(100.0, 500.0, false, expectedSum, expectedError);
+      TS_ASSERT_DELTA(sum, expectedSum, 1e-6);
+      TS_ASSERT_DELTA(error, expectedError, 1e-6);
+      TS_ASSERT_EQUALS(columns.getStorageLayout(), STRUCT_OF_ARRAYS);
+      // The columns were sorted in place for the integration
+      TS_ASSERT_EQUALS(columns.getTofs(), el.getTofs());
+    }
+  }
+
+  void test_concurrent_const_reads_of_struct_of_arrays() {
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      const auto expectedPulseTimes = el.getPulseTimes();
+      EventList columns(el);
+      columns.setStorageLayout(STRUCT_OF_ARRAYS);
+      const EventList &constColumns = columns;
+
+      // Some threads copy the events out of the columns while others still
+      // read the columns
+      int failures(0);
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < 64; ++i) {
+        bool ok = constColumns.getNumberEvents() == el.getNumberEvents() &&
+                  !constColumns.empty() && constColumns.getMemorySize() > 0;
+        if (i % 2 == 0)
+          ok = ok && constColumns == el;
+        else
+          ok = ok && constColumns.getPulseTimes() == expectedPulseTimes;
+        if (!ok) {
+          PARALLEL_ATOMIC
+          ++failures;
+        }
+      }
+      TS_ASSERT_EQUALS(failures, 0);
+      TS_ASSERT_EQUALS(columns.getStorageLayout(), ARRAY_OF_STRUCTS);
+
+      // The columns left behind are freed by the next non-const operation
+      const auto memory = columns.getMemorySize();
+      columns.reserve(0);
+      TS_ASSERT_LESS_THAN(columns.getMemorySize(), memory);
+    }
+  }
+
+  void test_getDistinctPulseTimes_keeps_the_layout() {
+    this->fake_uniform_data();
+    auto expected = el.getPulseTimes();
+    std::vector<int64_t> expectedNanoseconds;
+    for (const auto &pulseTime : expected)
+      expectedNanoseconds.push_back(pulseTime.totalNanoseconds());
+    std::sort(expectedNanoseconds.begin(), expectedNanoseconds.end());
+    expectedNanoseconds.erase(
+        std::unique(expectedNanoseconds.begin(), expectedNanoseconds.end()),
+        expectedNanoseconds.end());
+
+    std::vector<int64_t> pulseTimes;
+    el.getDistinctPulseTimes(pulseTimes);
+    TS_ASSERT_EQUALS(pulseTimes, expectedNanoseconds);
+    EventList columns(el);
+    columns.setStorageLayout(STRUCT_OF_ARRAYS);
+    columns.getDistinctPulseTimes(pulseTimes);
+    TS_ASSERT_EQUALS(pulseTimes, expectedNanoseconds);
+    TS_ASSERT_EQUALS(columns.getStorageLayout(), STRUCT_OF_ARRAYS);
+    EventList compressed(el);
+    compressed.setCompressedStorage(1.0);
+    compressed.getDistinctPulseTimes(pulseTimes);
+    TS_ASSERT_EQUALS(pulseTimes, expectedNanoseconds);
+    TS_ASSERT_EQUALS(compressed.getStorageLayout(), COMPRESSED);
+  }
+
+  void test_compressed_storage_matches_all_types() {
+    MantidVec X = this->makeX(BIN_DELTA);
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      EventList compressed(el);
+      // The fake TOFs are whole numbers, so they survive quantization
+      compressed.setCompressedStorage(1.0);
+      TS_ASSERT_EQUALS(compressed.getStorageLayout(), COMPRESSED);
+      TS_ASSERT_EQUALS(compressed.getSortType(), TOF_SORT);
+      TS_ASSERT_EQUALS(compressed.getNumberEvents(), el.getNumberEvents());
+      TS_ASSERT_LESS_THAN(compressed.getMemorySize(), el.getMemorySize());
+      TS_ASSERT_EQUALS(compressed.getTofMin(), el.getTofMin());
+      TS_ASSERT_EQUALS(compressed.getTofMax(), el.getTofMax());
+
+      MantidVec Y, E, compressedY, compressedE;
+      el.generateHistogram(X, Y, E);
+      compressed.generateHistogram(X, compressedY, compressedE);
+      TS_ASSERT_EQUALS(compressed.getStorageLayout(), COMPRESSED);
+      TS_ASSERT_EQUALS(compressedY, Y);
+      TS_ASSERT_EQUALS(compressedE, E);
+
+      el.convertTof(2.5, 1.0);
+      compressed.convertTof(2.5, 1.0);
+      TS_ASSERT_EQUALS(compressed.getStorageLayout(), COMPRESSED);
+      const auto tofs = el.getTofs();
+      const auto compressedTofs = compressed.getTofs();
+      TS_ASSERT_EQUALS(compressedTofs.size(), tofs.size());
+      for (size_t i = 0; i < tofs.size(); ++i)
+        TS_ASSERT_DELTA(compressedTofs[i], tofs[i], 1e-6);
+    }
+  }
+
+  void test_compressed_storage_is_within_resolution() {
+    el = EventList();
+    el.switchTo(WEIGHTED);
+    for (int i = 0; i < 100; ++i)
+      el += WeightedEvent(100.0 + 0.37 * i, 1000 * (i % 3), 0.5, 0.25);
+    EventList compressed(el);
+    compressed.setCompressedStorage(0.1);
+    const auto tofs = el.getTofs();
+    const auto compressedTofs = compressed.getTofs();
+    for (size_t i = 0; i < tofs.size(); ++i)
+      TS_ASSERT_DELTA(compressedTofs[i], tofs[i], 0.05);
+    // Weights, errors and pulse times are not approximated
+    TS_ASSERT_EQUALS(compressed.getWeights(), el.getWeights());
+    TS_ASSERT_EQUALS(compressed.getWeightErrors(), el.getWeightErrors());
+    TS_ASSERT_EQUALS(compressed.getPulseTimes(), el.getPulseTimes());
+  }
+
+  void test_compressed_storage_falls_back_to_array_of_structs() {
+    this->fake_uniform_data();
+    EventList compressed(el);
+    compressed.setCompressedStorage(1.0);
+    TS_ASSERT(compressed == el);
+    TS_ASSERT_EQUALS(compressed.getStorageLayout(), ARRAY_OF_STRUCTS);
+
+    compressed.setCompressedStorage(1.0);
+    compressed.sortPulseTime();
+    TS_ASSERT_EQUALS(compressed.getStorageLayout(), ARRAY_OF_STRUCTS);
+    TS_ASSERT_EQUALS(compressed.getNumberEvents(), el.getNumberEvents());
+
+    compressed.setCompressedStorage(1.0);
+    compressed.setStorageLayout(STRUCT_OF_ARRAYS);
+    TS_ASSERT_EQUALS(compressed.getStorageLayout(), STRUCT_OF_ARRAYS);
+    TS_ASSERT_THROWS(compressed.setStorageLayout(COMPRESSED),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(compressed.setCompressedStorage(0.0),
+                     std::invalid_argument);
+  }
+
   void test_histogram_tof_event_by_pulse_time() {
     // Generate TOF events with Pulse times uniformly distributed.
     EventList eList = this->fake_uniform_pulse_data();
@@ -1641,6 +1928,73 @@ public:
     }
   }
 
+  void test_sort_long_lists() {
+    // Long enough to use the radix sort, with negative TOFs and repeated
+    // pulse times
+    for (int this_type = 0; this_type < 3; this_type++) {
+      EventType curType = static_cast<EventType>(this_type);
+      EventList source;
+      srand(1234);
+      for (int i = 0; i < 10000; i++)
+        source += TofEvent(1e4 * (rand() * 1.0 / RAND_MAX) - 100.,
+                           1000000000 + rand() % 100);
+      source.switchTo(curType);
+
+      EventList byTof(source);
+      byTof.sortTof();
+      TS_ASSERT_EQUALS(byTof.getNumberEvents(), 10000);
+      auto tofs = source.getTofs();
+      std::sort(tofs.begin(), tofs.end());
+      TS_ASSERT_EQUALS(byTof.getTofs(), tofs);
+
+      if (curType == WEIGHTED_NOTIME)
+        continue;
+
+      EventList byPulseTimeTof(source);
+      byPulseTimeTof.sortPulseTimeTOF();
+      EventList byPulseTime(source);
+      byPulseTime.sortPulseTime();
+      for (size_t i = 1; i < byPulseTimeTof.getNumberEvents(); i++) {
+        const auto previous = byPulseTimeTof.getEvent(i - 1);
+        const auto current = byPulseTimeTof.getEvent(i);
+        TS_ASSERT_LESS_THAN_EQUALS(previous.pulseTime(), current.pulseTime());
+        if (previous.pulseTime() == current.pulseTime())
+          TS_ASSERT_LESS_THAN_EQUALS(previous.tof(), current.tof());
+        TS_ASSERT_LESS_THAN_EQUALS(byPulseTime.getEvent(i - 1).pulseTime(),
+                                   byPulseTime.getEvent(i).pulseTime());
+      }
+    }
+  }
+
+  void test_sort_very_long_list() {
+    // Too long for the radix sort scratch, so sorted in parallel
+    const size_t numEvents = 300000;
+    std::vector<TofEvent> events;
+    events.reserve(numEvents);
+    srand(1234);
+    for (size_t i = 0; i < numEvents; i++)
+      events.emplace_back(1e4 * (rand() * 1.0 / RAND_MAX),
+                          1000000000 + rand() % 100);
+    EventList eventList(events);
+    eventList.sortTof();
+    TS_ASSERT_EQUALS(eventList.getNumberEvents(), numEvents);
+    const auto tofs = eventList.getTofs();
+    TS_ASSERT(std::is_sorted(tofs.cbegin(), tofs.cend()));
+
+    eventList.sortPulseTimeTOF();
+    const auto &sorted = eventList.getEvents();
+    TS_ASSERT(std::is_sorted(sorted.cbegin(), sorted.cend(),
+                             [](const TofEvent &lhs, const TofEvent &rhs) {
+                               if (lhs.pulseTime() == rhs.pulseTime())
+                                 return lhs.tof() < rhs.tof();
+                               return lhs.pulseTime() < rhs.pulseTime();
+                             }));
+
+    eventList.sortPulseTime();
+    const auto times = eventList.getPulseTimes();
+    TS_ASSERT(std::is_sorted(times.cbegin(), times.cend()));
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_filterByPulseTime() {
     // Go through each possible EventType (except the no-time one) as the input
@@ -568,6 +568,63 @@ public:
     }
   }
 
+  void test_setStorageLayout() {
+    EventWorkspace_sptr test_in =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    EventWorkspace_sptr columns = test_in->clone();
+
+    columns->setStorageLayout(STRUCT_OF_ARRAYS);
+    TS_ASSERT_EQUALS(columns->getNumberEvents(), test_in->getNumberEvents());
+    for (int wi = 0; wi < NUMPIXELS; wi++) {
+      TS_ASSERT_EQUALS(columns->getSpectrum(wi).getStorageLayout(),
+                       STRUCT_OF_ARRAYS);
+      TS_ASSERT_EQUALS(columns->y(wi).rawData(), test_in->y(wi).rawData());
+      TS_ASSERT_EQUALS(columns->e(wi).rawData(), test_in->e(wi).rawData());
+    }
+
+    columns->setStorageLayout(ARRAY_OF_STRUCTS);
+    for (int wi = 0; wi < NUMPIXELS; wi++)
+      TS_ASSERT(columns->getSpectrum(wi) == test_in->getSpectrum(wi));
+  }
+
+  void test_applyNumaPlacement() {
+    EventWorkspace_sptr test_in =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    EventWorkspace_sptr placed = test_in->clone();
+    placed->getSpectrum(0).reserve(10 * NUMBINS);
+
+    placed->applyNumaPlacement();
+    for (int wi = 0; wi < NUMPIXELS; wi++)
+      TS_ASSERT(placed->getSpectrum(wi) == test_in->getSpectrum(wi));
+    // The new buffers are sized to fit
+    const auto &events = placed->getSpectrum(0).getEvents();
+    TS_ASSERT_EQUALS(events.capacity(), events.size());
+  }
+
+  void test_setCompressedStorage() {
+    EventWorkspace_sptr test_in =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, NUMPIXELS);
+    EventWorkspace_sptr compressed = test_in->clone();
+    TS_ASSERT_THROWS(compressed->setCompressedStorage(0.0),
+                     std::invalid_argument);
+
+    compressed->setCompressedStorage(1e-3);
+    TS_ASSERT_EQUALS(compressed->getNumberEvents(), test_in->getNumberEvents());
+    TS_ASSERT_LESS_THAN(compressed->getMemorySize(), test_in->getMemorySize());
+    for (int wi = 0; wi < NUMPIXELS; wi++) {
+      const auto &list = compressed->getSpectrum(wi);
+      TS_ASSERT_EQUALS(list.getStorageLayout(), COMPRESSED);
+      auto expected = test_in->getSpectrum(wi);
+      expected.sortTof();
+      const auto tofs = list.getTofs();
+      const auto expectedTofs = expected.getTofs();
+      TS_ASSERT_EQUALS(tofs.size(), expectedTofs.size());
+      for (size_t i = 0; i < tofs.size(); ++i)
+        TS_ASSERT_DELTA(tofs[i], expectedTofs[i], 5e-4);
+      TS_ASSERT_EQUALS(list.getPulseTimes(), expected.getPulseTimes());
+    }
+  }
+
   /** Test sortAll() when there are more cores available than pixels.
    * This test will only work on machines with 2 cores at least.
    */
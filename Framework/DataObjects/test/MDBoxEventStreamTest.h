@@ -0,0 +1,197 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDBOXEVENTSTREAMTEST_H_
+#define MANTID_DATAOBJECTS_MDBOXEVENTSTREAMTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDBoxEventStream.h"
+#include "MantidKernel/make_unique.h"
+
+using Mantid::DataObjects::MDBoxEventStream;
+using Mantid::coord_t;
+
+namespace {
+/// Serves blocks of events from memory and counts the reads
+class MemoryIO : public Mantid::API::IBoxControllerIO {
+public:
+  MemoryIO(const std::vector<double> &data, const size_t nColumns, int &nReads)
+      : m_data(data), m_nColumns(nColumns), m_nReads(nReads) {
+    setFileLength(data.size() / nColumns);
+  }
+  bool openFile(const std::string &, const std::string &) override {
+    return false;
+  }
+  bool isOpened() const override { return true; }
+  const std::string &getFileName() const override { return m_fileName; }
+  void saveBlock(const std::vector<float> &, const uint64_t) const override {}
+  void saveBlock(const std::vector<double> &, const uint64_t) const override {}
+  void loadBlock(std::vector<float> &block, const uint64_t position,
+                 const size_t nEvents) const override {
+    std::vector<double> tmp;
+    loadBlock(tmp, position, nEvents);
+    block.assign(tmp.begin(), tmp.end());
+  }
+  void loadBlock(std::vector<double> &block, const uint64_t position,
+                 const size_t nEvents) const override {
+    TS_ASSERT_LESS_THAN_EQUALS(position + nEvents, getFileLength());
+    ++m_nReads;
+    block.assign(m_data.begin() + position * m_nColumns,
+                 m_data.begin() + (position + nEvents) * m_nColumns);
+  }
+  void flushData() const override {}
+  void closeFile() override {}
+  size_t getDataChunk() const override { return 1; }
+  void setDataType(const size_t, const std::string &) override {}
+  void getDataType(size_t &, std::string &) const override {}
+
+private:
+  std::vector<double> m_data;
+  size_t m_nColumns;
+  int &m_nReads;
+  std::string m_fileName;
+};
+
+/// Serves the event index from memory and counts the boxes read
+class MemoryIndex : public Mantid::DataObjects::MDBoxEventIndexReader {
+public:
+  MemoryIndex(const std::vector<uint64_t> &index, size_t &nBoxesRead)
+      : m_index(index), m_nBoxesRead(nBoxesRead) {}
+  size_t getNBoxes() const override { return m_index.size() / 2; }
+  void read(const size_t firstBox, const size_t nBoxes,
+            std::vector<uint64_t> &index) override {
+    TS_ASSERT_LESS_THAN_EQUALS(firstBox + nBoxes, getNBoxes());
+    m_nBoxesRead += nBoxes;
+    index.assign(m_index.begin() + 2 * firstBox,
+                 m_index.begin() + 2 * (firstBox + nBoxes));
+  }
+
+private:
+  std::vector<uint64_t> m_index;
+  size_t &m_nBoxesRead;
+};
+} // namespace
+
+class MDBoxEventStreamTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDBoxEventStreamTest *createSuite() {
+    return new MDBoxEventStreamTest();
+  }
+  static void destroySuite(MDBoxEventStreamTest *suite) { delete suite; }
+
+  MDBoxEventStreamTest() : m_nColumns(2) {
+    // 10 events with 2 columns, the values are the event numbers
+    for (size_t i = 0; i < 10; ++i) {
+      m_data.push_back(static_cast<double>(i));
+      m_data.push_back(static_cast<double>(i));
+    }
+    // box 0: events 0-2, box 1 empty, box 2: events 3-4, box 3: events 5-9
+    m_eventIndex = {0, 3, 0, 0, 3, 2, 5, 5};
+  }
+
+  void test_getNEvents() {
+    int nReads = 0;
+    auto stream = makeStream(100, nReads);
+    TS_ASSERT_EQUALS(stream.getNBoxes(), 4);
+    TS_ASSERT_EQUALS(stream.getNEvents(0), 3);
+    TS_ASSERT_EQUALS(stream.getNEvents(1), 0);
+    TS_ASSERT_EQUALS(stream.getNEvents(2), 2);
+    TS_ASSERT_EQUALS(stream.getNEvents(3), 5);
+    TS_ASSERT_EQUALS(stream.getNEvents(4), 0);
+    TS_ASSERT_EQUALS(nReads, 0);
+  }
+
+  void test_boxes_in_order_are_read_in_one_go() {
+    int nReads = 0;
+    auto stream = makeStream(100, nReads);
+    std::vector<coord_t> table;
+    for (size_t boxID = 0; boxID < 4; ++boxID)
+      stream.appendEvents(boxID, table);
+    TS_ASSERT_EQUALS(nReads, 1);
+    TS_ASSERT_EQUALS(table, std::vector<coord_t>(m_data.begin(), m_data.end()));
+  }
+
+  void test_small_buffer() {
+    int nReads = 0;
+    auto stream = makeStream(4, nReads);
+    std::vector<coord_t> table;
+    TS_ASSERT_EQUALS(stream.appendEvents(0, table), 3);
+    TS_ASSERT_EQUALS(stream.appendEvents(1, table), 0);
+    TS_ASSERT_EQUALS(stream.appendEvents(2, table), 2);
+    // Bigger than the buffer
+    TS_ASSERT_EQUALS(stream.appendEvents(3, table), 5);
+    TS_ASSERT_EQUALS(nReads, 3);
+    TS_ASSERT_EQUALS(table, std::vector<coord_t>(m_data.begin(), m_data.end()));
+
+    // Going back re-reads the box
+    table.clear();
+    TS_ASSERT_EQUALS(stream.appendEvents(0, table), 3);
+    TS_ASSERT_EQUALS(nReads, 4);
+    TS_ASSERT_EQUALS(table, std::vector<coord_t>(m_data.begin(),
+                                                 m_data.begin() + 6));
+  }
+
+  void test_index_is_read_in_windows() {
+    int nReads = 0;
+    size_t nBoxesRead = 0;
+    auto stream = makeStream(100, nReads, 3, nBoxesRead);
+    std::vector<coord_t> table;
+    for (size_t boxID = 0; boxID < 4; ++boxID)
+      stream.appendEvents(boxID, table);
+    // Two windows, the second one cut at the last box
+    TS_ASSERT_EQUALS(nBoxesRead, 4);
+    TS_ASSERT_EQUALS(table, std::vector<coord_t>(m_data.begin(), m_data.end()));
+
+    // Going back reads the window again
+    TS_ASSERT_EQUALS(stream.getNEvents(2), 2);
+    TS_ASSERT_EQUALS(nBoxesRead, 6);
+    TS_ASSERT_EQUALS(stream.getNEvents(3), 5);
+    TS_ASSERT_EQUALS(nBoxesRead, 6);
+  }
+
+  void test_closed_file_throws() {
+    size_t nBoxesRead = 0;
+    TS_ASSERT_THROWS(
+        MDBoxEventStream(nullptr,
+                         Mantid::Kernel::make_unique<MemoryIndex>(m_eventIndex,
+                                                                  nBoxesRead),
+                         2, 10, 10),
+        std::invalid_argument);
+  }
+
+  void test_missing_index_throws() {
+    int nReads = 0;
+    TS_ASSERT_THROWS(
+        MDBoxEventStream(
+            Mantid::Kernel::make_unique<MemoryIO>(m_data, m_nColumns, nReads),
+            nullptr, 2, 10, 10),
+        std::invalid_argument);
+  }
+
+private:
+  MDBoxEventStream makeStream(const size_t bufferSize, int &nReads) {
+    return makeStream(bufferSize, nReads, 100, m_nBoxesRead);
+  }
+
+  MDBoxEventStream makeStream(const size_t bufferSize, int &nReads,
+                              const size_t indexWindowSize,
+                              size_t &nBoxesRead) {
+    return MDBoxEventStream(
+        Mantid::Kernel::make_unique<MemoryIO>(m_data, m_nColumns, nReads),
+        Mantid::Kernel::make_unique<MemoryIndex>(m_eventIndex, nBoxesRead),
+        m_nColumns, bufferSize, indexWindowSize);
+  }
+
+  std::vector<double> m_data;
+  size_t m_nColumns;
+  std::vector<uint64_t> m_eventIndex;
+  size_t m_nBoxesRead = 0;
+};
+
+#endif /* MANTID_DATAOBJECTS_MDBOXEVENTSTREAMTEST_H_ */
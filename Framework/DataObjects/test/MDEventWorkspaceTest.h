@@ -16,6 +16,7 @@
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDGridBox.h"
+#include "MantidDataObjects/MDIntegrationRegion.h"
 #include "MantidDataObjects/MDLeanEvent.h"
 #include "MantidGeometry/MDGeometry/MDBoxImplicitFunction.h"
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
@@ -55,6 +56,28 @@ private:
     return numberMasked;
   }
 
+  /// A 10x10x10 workspace with events spread unevenly over several levels of
+  /// boxes
+  MDEventWorkspace3Lean::sptr makeSplitWorkspace() {
+    MDEventWorkspace3Lean::sptr ws =
+        MDEventsTestHelper::makeMDEW<3>(5, 0.0, 10.0, 1 /*event per box*/);
+    ws->getBoxController()->setSplitThreshold(50);
+    std::vector<MDLeanEvent<3>> events;
+    for (size_t i = 0; i < 20000; ++i) {
+      const double x = std::fmod(double(i) * 0.618034 * 10.0, 10.0);
+      const double y = std::fmod(double(i) * 0.414214 * 10.0, 10.0);
+      // Denser towards the middle of the third dimension
+      const double z = 5.0 + 4.9 * std::sin(double(i) * 0.1);
+      double centers[3] = {x, y, z};
+      events.emplace_back(static_cast<float>(1 + i % 7),
+                          static_cast<float>(1 + i % 3), centers);
+    }
+    ws->addEvents(events);
+    ws->splitAllIfNeeded(nullptr);
+    ws->refreshCache();
+    return ws;
+  }
+
 public:
   // This pair of boilerplate methods prevent the suite being created statically
   // This means the constructor isn't called when running other tests
@@ -551,6 +574,105 @@ public:
     //    TS_ASSERT_DELTA( errorSquared, 1.0, 1e-5);
   }
 
+  void test_integrateRegions_matches_integrateSphere() {
+    auto ws = makeSplitWorkspace();
+    std::vector<MDIntegrationRegion> regions;
+    std::vector<std::vector<coord_t>> centers;
+    std::vector<std::pair<double, double>> radii;
+    for (size_t i = 0; i < 60; ++i) {
+      centers.push_back({static_cast<coord_t>(0.3 + 0.17 * double(i)),
+                         static_cast<coord_t>(9.5 - 0.13 * double(i)),
+                         static_cast<coord_t>(0.1 * double(i % 37))});
+      // Spheres, shells and regions outside the workspace
+      const double radius = 0.4 + 0.05 * double(i % 13);
+      const double innerRadius = (i % 3 == 0) ? 0.5 * radius : 0.0;
+      radii.emplace_back(radius, innerRadius);
+      regions.push_back(
+          MDIntegrationRegion::sphere(centers.back(), radius, innerRadius));
+    }
+
+    for (const bool correction : {true, false}) {
+      std::vector<signal_t> signal, errorSquared;
+      ws->integrateRegions(regions, signal, errorSquared, correction);
+      TS_ASSERT_EQUALS(signal.size(), regions.size());
+      TS_ASSERT_EQUALS(errorSquared.size(), regions.size());
+      for (size_t i = 0; i < regions.size(); ++i) {
+        bool dimensionsUsed[3] = {true, true, true};
+        CoordTransformDistance sphere(3, centers[i].data(), dimensionsUsed);
+        signal_t expectedSignal = 0;
+        signal_t expectedErrorSquared = 0;
+        ws->getBox()->integrateSphere(
+            sphere, static_cast<coord_t>(radii[i].first * radii[i].first),
+            expectedSignal, expectedErrorSquared,
+            static_cast<coord_t>(radii[i].second * radii[i].second),
+            correction);
+        if (radii[i].second == 0.0) {
+          TS_ASSERT_DELTA(signal[i], expectedSignal, 1e-6);
+          TS_ASSERT_DELTA(errorSquared[i], expectedErrorSquared, 1e-6);
+        }
+        // The shells are not compared, integrateSphere may take whole boxes
+        // that overlap the hole
+        TS_ASSERT(signal[i] >= 0.0);
+      }
+    }
+  }
+
+  void test_centroidRegions_matches_centroidSphere() {
+    auto ws = makeSplitWorkspace();
+    std::vector<MDIntegrationRegion> regions;
+    std::vector<std::vector<coord_t>> centers;
+    for (size_t i = 0; i < 40; ++i) {
+      centers.push_back({static_cast<coord_t>(0.5 + 0.23 * double(i)),
+                         static_cast<coord_t>(5.0),
+                         static_cast<coord_t>(9.0 - 0.2 * double(i))});
+      regions.push_back(MDIntegrationRegion::sphere(centers.back(), 0.8));
+    }
+    std::vector<coord_t> centroids;
+    std::vector<signal_t> signal;
+    ws->centroidRegions(regions, centroids, signal);
+    TS_ASSERT_EQUALS(centroids.size(), 3 * regions.size());
+    for (size_t i = 0; i < regions.size(); ++i) {
+      bool dimensionsUsed[3] = {true, true, true};
+      CoordTransformDistance sphere(3, centers[i].data(), dimensionsUsed);
+      coord_t expectedCentroid[3] = {0, 0, 0};
+      signal_t expectedSignal = 0;
+      ws->getBox()->centroidSphere(sphere, static_cast<coord_t>(0.8 * 0.8),
+                                   expectedCentroid, expectedSignal);
+      TS_ASSERT_DELTA(signal[i], expectedSignal, 1e-6);
+      TS_ASSERT(expectedSignal > 0.0);
+      for (size_t d = 0; d < 3; ++d)
+        TS_ASSERT_DELTA(centroids[3 * i + d],
+                        expectedCentroid[d] /
+                            static_cast<coord_t>(expectedSignal),
+                        1e-4);
+    }
+  }
+
+  void test_integrateRegions_with_ellipsoids() {
+    auto ws = makeSplitWorkspace();
+    const std::vector<coord_t> center = {4.2f, 5.1f, 6.3f};
+    const std::vector<std::vector<double>> axes = {
+        {1, 1, 0}, {1, -1, 0}, {0, 0, 1}};
+    std::vector<MDIntegrationRegion> regions = {
+        MDIntegrationRegion::sphere(center, 1.5),
+        MDIntegrationRegion::ellipsoid(center, axes, {1.5, 1.5, 1.5}),
+        MDIntegrationRegion::ellipsoid(center, axes, {2.0, 1.0, 0.5}),
+        MDIntegrationRegion::sphere(center, 2.0)};
+    std::vector<signal_t> signal, errorSquared;
+    ws->integrateRegions(regions, signal, errorSquared);
+    // An ellipsoid with equal semi-axes is a sphere
+    TS_ASSERT_DELTA(signal[1], signal[0], 1e-2 * signal[0]);
+    // The ellipsoid is inside the sphere of its largest semi-axis
+    TS_ASSERT(signal[2] > 0.0);
+    TS_ASSERT(signal[2] < signal[3]);
+
+    std::vector<MDIntegrationRegion> wrongDimensions = {
+        MDIntegrationRegion::sphere({1.0f, 1.0f}, 1.0)};
+    TS_ASSERT_THROWS(
+        ws->integrateRegions(wrongDimensions, signal, errorSquared),
+        std::invalid_argument);
+  }
+
   /*
   Generic masking checking helper method.
   */
@@ -1105,6 +1105,107 @@ public:
     delete bcc;
   }
 
+  //------------------------------------------------------------------------------------------------
+  /** Events spread over the whole box, plus a dense cluster that is split
+   * down to the maximum depth */
+  std::vector<MDLeanEvent<2>> makeClusteredEvents2() {
+    std::vector<MDLeanEvent<2>> events;
+    const size_t numEvents = 5000;
+    for (size_t i = 0; i < numEvents; i++) {
+      const double frac = static_cast<double>(i) / numEvents;
+      const double golden = std::fmod(static_cast<double>(i) * 0.618034, 1.0);
+      double spread[2] = {10.0 * golden, 10.0 * frac};
+      events.push_back(MDLeanEvent<2>(1.0, 1.0, spread));
+      double cluster[2] = {2.0 + 0.01 * frac, 3.0 + 0.01 * golden};
+      events.push_back(MDLeanEvent<2>(2.0, 2.0, cluster));
+    }
+    return events;
+  }
+
+  /** Check that two box trees have the same boxes, holding the same events */
+  void compareBoxTrees(MDGridBox<MDLeanEvent<2>, 2> *expected,
+                       MDGridBox<MDLeanEvent<2>, 2> *actual) {
+    expected->refreshCache();
+    actual->refreshCache();
+    TS_ASSERT_EQUALS(actual->getBoxController()->getTotalNumMDBoxes(),
+                     expected->getBoxController()->getTotalNumMDBoxes());
+    TS_ASSERT_EQUALS(actual->getBoxController()->getMaxNumMDBoxes(),
+                     expected->getBoxController()->getMaxNumMDBoxes());
+    std::vector<IMDNode *> expectedBoxes, actualBoxes;
+    expected->getBoxes(expectedBoxes, 1000, false);
+    actual->getBoxes(actualBoxes, 1000, false);
+    TS_ASSERT_EQUALS(actualBoxes.size(), expectedBoxes.size());
+    for (size_t i = 0; i < std::min(actualBoxes.size(), expectedBoxes.size());
+         i++) {
+      TS_ASSERT_EQUALS(actualBoxes[i]->getDepth(),
+                       expectedBoxes[i]->getDepth());
+      TS_ASSERT_EQUALS(actualBoxes[i]->getNumChildren(),
+                       expectedBoxes[i]->getNumChildren());
+      TS_ASSERT_EQUALS(actualBoxes[i]->getNPoints(),
+                       expectedBoxes[i]->getNPoints());
+      TS_ASSERT_DELTA(actualBoxes[i]->getSignal(),
+                      expectedBoxes[i]->getSignal(), 1e-6);
+    }
+  }
+
+  /** Adding and splitting in one pass gives the same boxes as adding the
+   * events, then splitting.
+   */
+  void test_addAndSplitEvents() {
+    using gbox_t = MDGridBox<MDLeanEvent<2>, 2>;
+    gbox_t *expected = MDEventsTestHelper::makeMDGridBox<2>();
+    gbox_t *actual = MDEventsTestHelper::makeMDGridBox<2>();
+    for (auto box : {expected, actual}) {
+      box->getBoxController()->setSplitThreshold(100);
+      box->getBoxController()->setMaxDepth(4);
+    }
+    auto events = makeClusteredEvents2();
+    expected->addEvents(events);
+    expected->splitAllIfNeeded(nullptr);
+    TS_ASSERT_THROWS_NOTHING(
+        actual->addAndSplitEvents(events.begin(), events.end()));
+    compareBoxTrees(expected, actual);
+
+    // Add to the existing tree: boxes that were not split before now are
+    expected->addEvents(events);
+    expected->splitAllIfNeeded(nullptr);
+    actual->addAndSplitEvents(events.begin(), events.end());
+    compareBoxTrees(expected, actual);
+
+    for (auto box : {expected, actual}) {
+      BoxController *const bcc = box->getBoxController();
+      delete box;
+      delete bcc;
+    }
+  }
+
+  void test_addAndSplitEvents_usingThreadPool() {
+    using gbox_t = MDGridBox<MDLeanEvent<2>, 2>;
+    gbox_t *expected = MDEventsTestHelper::makeMDGridBox<2>();
+    gbox_t *actual = MDEventsTestHelper::makeMDGridBox<2>();
+    for (auto box : {expected, actual}) {
+      box->getBoxController()->setSplitThreshold(100);
+      box->getBoxController()->setMaxDepth(4);
+      // Make tasks even for small numbers of events
+      box->getBoxController()->setAddingEvents_eventsPerTask(100);
+    }
+    auto events = makeClusteredEvents2();
+    expected->addEvents(events);
+    expected->splitAllIfNeeded(nullptr);
+
+    ThreadSchedulerFIFO *ts = new ThreadSchedulerFIFO();
+    ThreadPool tp(ts);
+    actual->addAndSplitEvents(events.begin(), events.end(), ts);
+    tp.joinAll();
+    compareBoxTrees(expected, actual);
+
+    for (auto box : {expected, actual}) {
+      BoxController *const bcc = box->getBoxController();
+      delete box;
+      delete bcc;
+    }
+  }
+
   //------------------------------------------------------------------------------------------------
   /** Helper to make a 2D MDBin */
   MDBin<MDLeanEvent<2>, 2> makeMDBin2(double minX, double maxX, double minY,
@@ -0,0 +1,208 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_
+#define MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+using namespace Mantid::DataObjects;
+
+namespace {
+/// A 3D workspace with a different signal and error in every bin
+MDHistoWorkspace_sptr makeWorkspace(const double offset) {
+  auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 3, 20);
+  for (size_t i = 0; i < ws->getNPoints(); ++i) {
+    ws->setSignalAt(i, offset + static_cast<double>(i % 17) * 0.5);
+    ws->setErrorSquaredAt(i, 0.1 + static_cast<double>(i % 5));
+    ws->setNumEventsAt(i, static_cast<double>(i % 3));
+  }
+  ws->updateSum();
+  return ws;
+}
+
+void compareWorkspaces(const MDHistoWorkspace &actual,
+                       const MDHistoWorkspace &expected) {
+  TS_ASSERT_EQUALS(actual.getNPoints(), expected.getNPoints());
+  for (size_t i = 0; i < expected.getNPoints(); ++i) {
+    TS_ASSERT_DELTA(actual.getSignalAt(i), expected.getSignalAt(i), 1e-10);
+    TS_ASSERT_DELTA(actual.getErrorAt(i), expected.getErrorAt(i), 1e-10);
+    TS_ASSERT_EQUALS(actual.getNumEventsAt(i), expected.getNumEventsAt(i));
+  }
+  TS_ASSERT_EQUALS(actual.getNEvents(), expected.getNEvents());
+}
+} // namespace
+
+class MDHistoExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDHistoExpressionTest *createSuite() {
+    return new MDHistoExpressionTest();
+  }
+  static void destroySuite(MDHistoExpressionTest *suite) { delete suite; }
+
+  void test_empty_expression_copies_the_input() {
+    auto a = makeWorkspace(1.0);
+    MDHistoExpression expression(a);
+    TS_ASSERT_EQUALS(expression.size(), 0);
+    auto result = expression.evaluate();
+    TS_ASSERT_DIFFERS(result, a);
+    compareWorkspaces(*result, *a);
+  }
+
+  void test_same_result_as_the_workspace_operations() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto c = makeWorkspace(0.5);
+
+    auto result = MDHistoExpression(a)
+                      .minus(b)
+                      .multiply(c)
+                      .plus(3.2, 0.5)
+                      .divide(b)
+                      .power(2.0)
+                      .multiply(0.5, 0.1)
+                      .plus(c)
+                      .log(-1.0)
+                      .exp()
+                      .minus(1.0, 0.0)
+                      .divide(4.0, 0.2)
+                      .log10(2.0)
+                      .evaluate();
+
+    auto expected = a->clone();
+    expected->subtract(*b);
+    expected->multiply(*c);
+    expected->add(3.2, 0.5);
+    expected->divide(*b);
+    expected->power(2.0);
+    expected->multiply(0.5, 0.1);
+    expected->add(*c);
+    expected->log(-1.0);
+    expected->exp();
+    expected->subtract(1.0, 0.0);
+    expected->divide(4.0, 0.2);
+    expected->log10(2.0);
+
+    compareWorkspaces(*result, *expected);
+    // The input is unchanged
+    compareWorkspaces(*a, *makeWorkspace(1.0));
+  }
+
+  void test_evaluateInPlace() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    MDHistoExpression expression(a);
+    expression.plus(b).multiply(2.0, 0.0);
+
+    auto expected = a->clone();
+    expected->add(*b);
+    expected->multiply(2.0, 0.0);
+
+    // Into another workspace
+    auto output = makeWorkspace(5.0);
+    expression.evaluateInPlace(*output);
+    compareWorkspaces(*output, *expected);
+
+    // Into the input
+    expression.evaluateInPlace(*a);
+    compareWorkspaces(*a, *expected);
+
+    TS_ASSERT_THROWS(expression.evaluateInPlace(*b), std::invalid_argument);
+  }
+
+  void test_chained_expression_creates_no_temporaries() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto c = makeWorkspace(0.5);
+    const auto expected = MDHistoExpression(a->clone())
+                              .minus(b)
+                              .divide(c)
+                              .multiply(2.0, 0.1)
+                              .exp()
+                              .evaluate();
+
+    // The whole chain is written into the arrays of the input itself; no
+    // workspace is created, not even for the result
+    const Mantid::signal_t *signal = a->getSignalArray();
+    const Mantid::signal_t *errorSquared = a->getErrorSquaredArray();
+    MDHistoExpression(a)
+        .minus(b)
+        .divide(c)
+        .multiply(2.0, 0.1)
+        .exp()
+        .evaluateInPlace(*a);
+    TS_ASSERT_EQUALS(a->getSignalArray(), signal);
+    TS_ASSERT_EQUALS(a->getErrorSquaredArray(), errorSquared);
+    compareWorkspaces(*a, *expected);
+    // The operands are unchanged
+    compareWorkspaces(*b, *makeWorkspace(2.0));
+    compareWorkspaces(*c, *makeWorkspace(0.5));
+  }
+
+  void test_input_as_first_operand() {
+    auto a = makeWorkspace(1.0);
+    auto expected = a->clone();
+    expected->add(*a);
+    expected->multiply(3.0, 0.0);
+    MDHistoExpression(a).plus(a).multiply(3.0, 0.0).evaluateInPlace(*a);
+    compareWorkspaces(*a, *expected);
+
+    // A later operation would read the partial result
+    auto b = makeWorkspace(2.0);
+    MDHistoExpression expression(b);
+    expression.multiply(3.0, 0.0).plus(b);
+    TS_ASSERT_THROWS(expression.evaluateInPlace(*b), std::invalid_argument);
+  }
+
+  void test_workspaces_of_different_sizes_throw() {
+    auto a = makeWorkspace(1.0);
+    auto small = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 3, 5);
+    MDHistoExpression expression(a);
+    TS_ASSERT_THROWS(expression.plus(small), std::invalid_argument);
+    TS_ASSERT_THROWS(expression.divide(MDHistoWorkspace_sptr()),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(expression.evaluateInPlace(*small),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(MDHistoExpression(nullptr), std::invalid_argument);
+  }
+};
+
+class MDHistoExpressionTestPerformance : public CxxTest::TestSuite {
+public:
+  static MDHistoExpressionTestPerformance *createSuite() {
+    return new MDHistoExpressionTestPerformance();
+  }
+  static void destroySuite(MDHistoExpressionTestPerformance *suite) {
+    delete suite;
+  }
+
+  MDHistoExpressionTestPerformance() {
+    m_data = MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0, 3, 200);
+    m_background = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 3, 200);
+    m_norm = MDEventsTestHelper::makeFakeMDHistoWorkspace(4.0, 3, 200);
+  }
+
+  void test_background_subtraction_and_normalisation() {
+    auto result = MDHistoExpression(m_data)
+                      .minus(m_background)
+                      .divide(m_norm)
+                      .multiply(2.0, 0.0)
+                      .evaluate();
+    TS_ASSERT_EQUALS(result->getSignalAt(0), 0.5);
+  }
+
+private:
+  MDHistoWorkspace_sptr m_data;
+  MDHistoWorkspace_sptr m_background;
+  MDHistoWorkspace_sptr m_norm;
+};
+
+#endif /* MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_ */
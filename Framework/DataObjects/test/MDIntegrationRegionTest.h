@@ -0,0 +1,138 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_DATAOBJECTS_MDINTEGRATIONREGIONTEST_H_
+#define MANTID_DATAOBJECTS_MDINTEGRATIONREGIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDIntegrationRegion.h"
+
+using Mantid::coord_t;
+using Mantid::DataObjects::MDIntegrationRegion;
+
+class MDIntegrationRegionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDIntegrationRegionTest *createSuite() {
+    return new MDIntegrationRegionTest();
+  }
+  static void destroySuite(MDIntegrationRegionTest *suite) { delete suite; }
+
+  void test_sphere() {
+    auto sphere = MDIntegrationRegion::sphere({1.0f, 2.0f, 3.0f}, 2.0);
+    TS_ASSERT_EQUALS(sphere.getNumDims(), 3);
+    TS_ASSERT_EQUALS(sphere.getRadiusSquared(), 4.0f);
+    TS_ASSERT(!sphere.isShell());
+
+    const coord_t center[3] = {1.0f, 2.0f, 3.0f};
+    const coord_t inside[3] = {2.0f, 3.0f, 4.0f};
+    const coord_t outside[3] = {2.5f, 3.0f, 4.0f};
+    TS_ASSERT_EQUALS(sphere.distanceSquared(inside), 3.0f);
+    TS_ASSERT(sphere.contains(center));
+    TS_ASSERT(sphere.contains(inside));
+    TS_ASSERT(!sphere.contains(outside));
+  }
+
+  void test_spherical_shell() {
+    auto shell = MDIntegrationRegion::sphere({0.0f, 0.0f}, 2.0, 1.0);
+    TS_ASSERT(shell.isShell());
+    TS_ASSERT_EQUALS(shell.getInnerRadiusSquared(), 1.0f);
+    const coord_t center[2] = {0.0f, 0.0f};
+    const coord_t inShell[2] = {1.5f, 0.0f};
+    TS_ASSERT(!shell.contains(center));
+    TS_ASSERT(shell.contains(inShell));
+  }
+
+  void test_sphere_and_boxes() {
+    auto sphere = MDIntegrationRegion::sphere({0.0f, 0.0f}, 2.0);
+    const coord_t min[2] = {-1.0f, -1.0f};
+    const coord_t max[2] = {1.0f, 1.0f};
+    TS_ASSERT(sphere.mightOverlap(min, max));
+    TS_ASSERT(sphere.surrounds(min, max));
+
+    // The corner (1.5, 1.5) is 2.12 away from the center
+    const coord_t partialMax[2] = {1.5f, 1.5f};
+    TS_ASSERT(sphere.mightOverlap(min, partialMax));
+    TS_ASSERT(!sphere.surrounds(min, partialMax));
+
+    // Inside the bounding box of the sphere, but not touching it
+    const coord_t cornerMin[2] = {1.5f, 1.5f};
+    const coord_t cornerMax[2] = {2.0f, 2.0f};
+    TS_ASSERT(!sphere.mightOverlap(cornerMin, cornerMax));
+
+    // A box in the hole of a shell
+    auto shell = MDIntegrationRegion::sphere({0.0f, 0.0f}, 3.0, 2.0);
+    TS_ASSERT(!shell.mightOverlap(min, max));
+    TS_ASSERT(!shell.surrounds(min, max));
+    const coord_t ringMin[2] = {2.1f, -0.1f};
+    const coord_t ringMax[2] = {2.2f, 0.1f};
+    TS_ASSERT(shell.surrounds(ringMin, ringMax));
+  }
+
+  void test_ellipsoid() {
+    const std::vector<std::vector<double>> axes = {{1, 1}, {-1, 1}};
+    auto ellipsoid =
+        MDIntegrationRegion::ellipsoid({0.0f, 0.0f}, axes, {2.0, 0.5});
+    TS_ASSERT_EQUALS(ellipsoid.getRadiusSquared(), 1.0f);
+    // Along the long axis
+    const coord_t alongLong[2] = {1.3f, 1.3f};
+    // The same distance along the short axis
+    const coord_t alongShort[2] = {-1.3f, 1.3f};
+    TS_ASSERT_DELTA(ellipsoid.distanceSquared(alongLong), 1.69 * 2.0 / 4.0,
+                    1e-5);
+    TS_ASSERT(ellipsoid.contains(alongLong));
+    TS_ASSERT(!ellipsoid.contains(alongShort));
+
+    // The bounding box reaches sqrt(2^2/2 + 0.5^2/2) = 1.46 along both axes
+    const coord_t nearMin[2] = {1.4f, 1.4f};
+    const coord_t nearMax[2] = {1.5f, 1.5f};
+    const coord_t farMin[2] = {1.5f, -2.0f};
+    const coord_t farMax[2] = {1.6f, 2.0f};
+    TS_ASSERT(ellipsoid.mightOverlap(nearMin, nearMax));
+    TS_ASSERT(!ellipsoid.mightOverlap(farMin, farMax));
+
+    const coord_t smallMin[2] = {0.4f, 0.4f};
+    const coord_t smallMax[2] = {0.6f, 0.6f};
+    TS_ASSERT(ellipsoid.surrounds(smallMin, smallMax));
+    TS_ASSERT(!ellipsoid.surrounds(nearMin, farMax));
+  }
+
+  void test_ellipsoidal_shell_does_not_surround_boxes_over_the_hole() {
+    const std::vector<std::vector<double>> axes = {{1, 0}, {0, 1}};
+    auto shell =
+        MDIntegrationRegion::ellipsoid({0.0f, 0.0f}, axes, {4.0, 2.0}, 0.5);
+    TS_ASSERT(shell.isShell());
+    TS_ASSERT_EQUALS(shell.getInnerRadiusSquared(), 0.25f);
+    const coord_t min[2] = {-0.5f, -0.5f};
+    const coord_t max[2] = {0.5f, 0.5f};
+    TS_ASSERT(!shell.surrounds(min, max));
+    const coord_t inShellMin[2] = {2.5f, -0.1f};
+    const coord_t inShellMax[2] = {3.0f, 0.1f};
+    TS_ASSERT(shell.surrounds(inShellMin, inShellMax));
+  }
+
+  void test_invalid_regions_throw() {
+    TS_ASSERT_THROWS(MDIntegrationRegion::sphere({}, 1.0),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(MDIntegrationRegion::sphere({0.0f}, -1.0),
+                     std::invalid_argument);
+    const std::vector<std::vector<double>> skewed = {{1, 0}, {1, 1}};
+    TS_ASSERT_THROWS(
+        MDIntegrationRegion::ellipsoid({0.0f, 0.0f}, skewed, {1.0, 1.0}),
+        std::invalid_argument);
+    const std::vector<std::vector<double>> axes = {{1, 0}, {0, 1}};
+    TS_ASSERT_THROWS(
+        MDIntegrationRegion::ellipsoid({0.0f, 0.0f}, axes, {1.0, 0.0}),
+        std::invalid_argument);
+    TS_ASSERT_THROWS(
+        MDIntegrationRegion::ellipsoid({0.0f, 0.0f, 0.0f}, axes, {1.0, 1.0}),
+        std::invalid_argument);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDINTEGRATIONREGIONTEST_H_ */
@@ -12,6 +12,7 @@
 //------------------------------------------------------------------------------
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Instrument/Container.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
 
 namespace Mantid {
 namespace Kernel {
@@ -54,9 +55,17 @@ public:
   void add(const IObject_const_sptr &component);
 
 private:
+  void buildComponentHierarchy();
+
   std::string m_name;
   // Element zero is always assumed to be the can
   std::vector<IObject_const_sptr> m_components;
+  // Hierarchy of the bounding boxes of the components with finite boxes
+  BoundingVolumeHierarchy m_componentHierarchy;
+  // Index in m_components of each item of m_componentHierarchy
+  std::vector<size_t> m_boundedComponents;
+  // Index in m_components of the components without a finite bounding box
+  std::vector<size_t> m_unboundedComponents;
 };
 
 // Typedef a unique_ptr
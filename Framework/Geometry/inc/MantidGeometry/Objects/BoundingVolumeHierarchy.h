@@ -0,0 +1,81 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_
+#define MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/Tolerance.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/**
+  A bounding volume hierarchy over a set of items, such as the triangles of a
+  mesh or the components of a sample environment, each described by its
+  axis-aligned bounding box. It finds the items whose boxes a ray passes
+  through without testing every item, so that only those need the exact and
+  more expensive intersection test. The box of each item is checked as well
+  as the boxes of the hierarchy, so only items whose own boxes are hit are
+  returned.
+
+  The hierarchy is built once, from the boxes of the items, and is not changed
+  by the queries, which can be made from several threads at once. The boxes
+  are padded so that the candidates include every item the ray touches within
+  the padding.
+*/
+class MANTID_GEOMETRY_DLL BoundingVolumeHierarchy {
+public:
+  /// Create an empty hierarchy
+  BoundingVolumeHierarchy() = default;
+  BoundingVolumeHierarchy(const std::vector<Kernel::V3D> &minPoints,
+                          const std::vector<Kernel::V3D> &maxPoints,
+                          const double padding = Kernel::Tolerance);
+
+  /// @return The number of items in the hierarchy
+  size_t numberOfItems() const { return m_items.size(); }
+  /// @return True if there are no items in the hierarchy
+  bool empty() const { return m_items.empty(); }
+
+  void intersectingItems(const Kernel::V3D &start,
+                         const Kernel::V3D &direction,
+                         std::vector<size_t> &items) const;
+
+private:
+  /// A box of the hierarchy
+  struct Node {
+    /// lower corner of the box
+    double min[3];
+    /// upper corner of the box
+    double max[3];
+    /// first item of a leaf, or index of the second child of an inner node,
+    /// whose first child follows it
+    uint32_t first;
+    /// number of items of a leaf, 0 for an inner node
+    uint32_t count;
+  };
+
+  uint32_t build(const uint32_t first, const uint32_t count);
+  static bool rayHitsBox(const double *min, const double *max,
+                         const double *start, const double *inverseDirection,
+                         const bool *parallel);
+
+  /// the boxes of the hierarchy, the root first
+  std::vector<Node> m_nodes;
+  /// the padded boxes of the items, as the lower and upper corners of each
+  std::vector<double> m_boxes;
+  /// the indices of the items, grouped by leaf
+  std::vector<uint32_t> m_items;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHY_H_ */
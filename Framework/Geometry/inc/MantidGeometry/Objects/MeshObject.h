@@ -12,6 +12,7 @@
 //----------------------------------------------------------------------
 #include "BoundingBox.h"
 #include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
 #include "MantidGeometry/Objects/IObject.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "MantidKernel/Material.h"
@@ -139,6 +140,7 @@ public:
 
 private:
   void initialize();
+  void buildTriangleHierarchy();
   /// Get intersections
   void getIntersections(const Kernel::V3D &start, const Kernel::V3D &direction,
                         std::vector<Kernel::V3D> &intersectionPoints,
@@ -174,6 +176,8 @@ private:
   /// Triangles are specified by indices into a list of vertices.
   std::vector<uint32_t> m_triangles;
   std::vector<Kernel::V3D> m_vertices;
+  /// Bounding volume hierarchy over the triangles, for ray intersections
+  BoundingVolumeHierarchy m_triangleHierarchy;
   /// material composition
   Kernel::Material m_material;
 };
@@ -12,6 +12,9 @@
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Mantid {
 namespace Geometry {
 using Geometry::BoundingBox;
@@ -30,7 +33,9 @@ using Kernel::V3D;
  */
 SampleEnvironment::SampleEnvironment(std::string name,
                                      Container_const_sptr container)
-    : m_name(std::move(name)), m_components(1, container) {}
+    : m_name(std::move(name)), m_components(1, container) {
+  buildComponentHierarchy();
+}
 
 /**
  * @return An axis-aligned BoundingBox object that encompasses the whole kit.
@@ -98,9 +103,22 @@ bool SampleEnvironment::isValid(const V3D &point) const {
  * @return The total number of segments added to the track
  */
 int SampleEnvironment::interceptSurfaces(Track &track) const {
+  // Only the components whose bounding boxes the track passes through can be
+  // intersected. They are tested in the order they were added.
+  std::vector<size_t> candidates;
+  m_componentHierarchy.intersectingItems(track.startPoint(), track.direction(),
+                                         candidates);
+  for (auto &candidate : candidates) {
+    candidate = m_boundedComponents[candidate];
+  }
+  if (!m_unboundedComponents.empty()) {
+    candidates.insert(candidates.end(), m_unboundedComponents.begin(),
+                      m_unboundedComponents.end());
+    std::sort(candidates.begin(), candidates.end());
+  }
   int nsegments(0);
-  for (const auto &component : m_components) {
-    nsegments += component->interceptSurface(track);
+  for (const auto index : candidates) {
+    nsegments += m_components[index]->interceptSurface(track);
   }
   return nsegments;
 }
@@ -110,6 +128,42 @@ int SampleEnvironment::interceptSurfaces(Track &track) const {
  */
 void SampleEnvironment::add(const IObject_const_sptr &component) {
   m_components.emplace_back(component);
+  buildComponentHierarchy();
+}
+
+//------------------------------------------------------------------------------
+// Private methods
+//------------------------------------------------------------------------------
+
+/**
+ * Build the hierarchy of the bounding boxes of the components. The boxes are
+ * computed here, rather than on first use, so that the environment can be
+ * tracked through from several threads. Boxes approximated from the vertices
+ * of a shape may be slightly too small, so they are padded by a fraction of
+ * their size. Components without a finite box are always tested.
+ */
+void SampleEnvironment::buildComponentHierarchy() {
+  std::vector<V3D> minPoints, maxPoints;
+  m_boundedComponents.clear();
+  m_unboundedComponents.clear();
+  for (size_t i = 0; i < m_components.size(); ++i) {
+    const auto &box = m_components[i]->getBoundingBox();
+    const V3D &minPoint = box.minPoint();
+    const V3D &maxPoint = box.maxPoint();
+    bool finite = !box.isNull();
+    for (size_t d = 0; d < 3 && finite; ++d) {
+      finite = std::isfinite(minPoint[d]) && std::isfinite(maxPoint[d]);
+    }
+    if (!finite) {
+      m_unboundedComponents.emplace_back(i);
+      continue;
+    }
+    const V3D padding = (maxPoint - minPoint) * 0.01;
+    minPoints.emplace_back(minPoint - padding);
+    maxPoints.emplace_back(maxPoint + padding);
+    m_boundedComponents.emplace_back(i);
+  }
+  m_componentHierarchy = BoundingVolumeHierarchy(minPoints, maxPoints);
 }
 } // namespace Geometry
 } // namespace Mantid
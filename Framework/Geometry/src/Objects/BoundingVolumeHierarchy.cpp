@@ -0,0 +1,186 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace Mantid {
+namespace Geometry {
+
+namespace {
+/// The largest number of items in a leaf of the hierarchy
+const uint32_t MAX_LEAF_SIZE = 4;
+} // namespace
+
+/**
+ * Build the hierarchy over the given boxes
+ * @param minPoints :: The lower corner of the box of each item
+ * @param maxPoints :: The upper corner of the box of each item
+ * @param padding :: The distance the boxes are enlarged by on every side
+ * @throw std::invalid_argument if the numbers of corners differ
+ */
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(
+    const std::vector<Kernel::V3D> &minPoints,
+    const std::vector<Kernel::V3D> &maxPoints, const double padding) {
+  if (minPoints.size() != maxPoints.size())
+    throw std::invalid_argument("BoundingVolumeHierarchy: expected as many "
+                                "upper as lower corners.");
+  if (minPoints.empty())
+    return;
+  if (minPoints.size() > std::numeric_limits<uint32_t>::max())
+    throw std::invalid_argument(
+        "BoundingVolumeHierarchy: too many items for the hierarchy.");
+
+  const auto nItems = static_cast<uint32_t>(minPoints.size());
+  m_boxes.resize(6 * nItems);
+  for (uint32_t i = 0; i < nItems; ++i) {
+    for (size_t d = 0; d < 3; ++d) {
+      m_boxes[6 * i + d] = minPoints[i][d] - padding;
+      m_boxes[6 * i + 3 + d] = maxPoints[i][d] + padding;
+    }
+  }
+  m_items.resize(nItems);
+  std::iota(m_items.begin(), m_items.end(), 0);
+  m_nodes.reserve(2 * (nItems / MAX_LEAF_SIZE + 1));
+  build(0, nItems);
+}
+
+/**
+ * Add the node for a range of items, and its children
+ * @param first :: The first item of the range in m_items
+ * @param count :: The number of items in the range
+ * @return The index of the node
+ */
+uint32_t BoundingVolumeHierarchy::build(const uint32_t first,
+                                        const uint32_t count) {
+  const auto index = static_cast<uint32_t>(m_nodes.size());
+  Node node;
+  std::fill(node.min, node.min + 3, std::numeric_limits<double>::max());
+  std::fill(node.max, node.max + 3, std::numeric_limits<double>::lowest());
+  double centreMin[3], centreMax[3];
+  std::copy(node.min, node.min + 3, centreMin);
+  std::copy(node.max, node.max + 3, centreMax);
+  for (uint32_t i = first; i < first + count; ++i) {
+    const double *box = m_boxes.data() + 6 * m_items[i];
+    for (size_t d = 0; d < 3; ++d) {
+      node.min[d] = std::min(node.min[d], box[d]);
+      node.max[d] = std::max(node.max[d], box[3 + d]);
+      const double centre = 0.5 * (box[d] + box[3 + d]);
+      centreMin[d] = std::min(centreMin[d], centre);
+      centreMax[d] = std::max(centreMax[d], centre);
+    }
+  }
+  node.first = first;
+  node.count = count;
+  m_nodes.push_back(node);
+
+  // Split across the longest extent of the centres of the boxes
+  size_t axis = 0;
+  for (size_t d = 1; d < 3; ++d) {
+    if (centreMax[d] - centreMin[d] > centreMax[axis] - centreMin[axis])
+      axis = d;
+  }
+  if (count <= MAX_LEAF_SIZE || !(centreMax[axis] > centreMin[axis]))
+    return index;
+
+  const uint32_t half = count / 2;
+  const double *boxes = m_boxes.data();
+  std::nth_element(m_items.begin() + first, m_items.begin() + first + half,
+                   m_items.begin() + first + count,
+                   [boxes, axis](const uint32_t a, const uint32_t b) {
+                     return boxes[6 * a + axis] + boxes[6 * a + 3 + axis] <
+                            boxes[6 * b + axis] + boxes[6 * b + 3 + axis];
+                   });
+  // The first child follows its parent
+  build(first, half);
+  const uint32_t second = build(first + half, count - half);
+  m_nodes[index].first = second;
+  m_nodes[index].count = 0;
+  return index;
+}
+
+/**
+ * Find the items whose boxes a ray passes through
+ * @param start :: The start of the ray
+ * @param direction :: The direction of the ray
+ * @param items :: Set to the indices of the items, in increasing order
+ */
+void BoundingVolumeHierarchy::intersectingItems(
+    const Kernel::V3D &start, const Kernel::V3D &direction,
+    std::vector<size_t> &items) const {
+  items.clear();
+  if (m_nodes.empty())
+    return;
+
+  const double origin[3] = {start.X(), start.Y(), start.Z()};
+  double inverseDirection[3];
+  bool parallel[3];
+  for (size_t d = 0; d < 3; ++d) {
+    parallel[d] = direction[d] == 0.0;
+    inverseDirection[d] = parallel[d] ? 0.0 : 1.0 / direction[d];
+  }
+
+  std::vector<uint32_t> stack(1, 0);
+  while (!stack.empty()) {
+    const uint32_t index = stack.back();
+    stack.pop_back();
+    const Node &node = m_nodes[index];
+    if (!rayHitsBox(node.min, node.max, origin, inverseDirection, parallel))
+      continue;
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const double *box = m_boxes.data() + 6 * m_items[i];
+        if (rayHitsBox(box, box + 3, origin, inverseDirection, parallel))
+          items.emplace_back(m_items[i]);
+      }
+    } else {
+      stack.push_back(node.first);
+      stack.push_back(index + 1);
+    }
+  }
+  std::sort(items.begin(), items.end());
+}
+
+/**
+ * Check whether a ray passes through a box, by the slab method
+ * @param min :: The lower corner of the box
+ * @param max :: The upper corner of the box
+ * @param start :: The start of the ray
+ * @param inverseDirection :: The inverse of each component of the direction
+ * of the ray
+ * @param parallel :: True for each axis the ray is parallel to
+ * @return True if any point of the ray from its start onwards is in the box
+ */
+bool BoundingVolumeHierarchy::rayHitsBox(const double *min, const double *max,
+                                         const double *start,
+                                         const double *inverseDirection,
+                                         const bool *parallel) {
+  double entryDistance = 0.0;
+  double exitDistance = std::numeric_limits<double>::max();
+  for (size_t d = 0; d < 3; ++d) {
+    if (parallel[d]) {
+      if (start[d] < min[d] || start[d] > max[d])
+        return false;
+      continue;
+    }
+    double toMin = (min[d] - start[d]) * inverseDirection[d];
+    double toMax = (max[d] - start[d]) * inverseDirection[d];
+    if (toMin > toMax)
+      std::swap(toMin, toMax);
+    entryDistance = std::max(entryDistance, toMin);
+    exitDistance = std::min(exitDistance, toMax);
+    if (entryDistance > exitDistance)
+      return false;
+  }
+  return true;
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -17,9 +17,19 @@
 
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace Mantid {
 namespace Geometry {
 
+namespace {
+/// The padding of the boxes of the triangles, in units of the rounding error
+/// of the largest coordinate of the mesh
+constexpr double RELATIVE_PADDING = 1024.0;
+} // namespace
+
 MeshObject::MeshObject(const std::vector<uint32_t> &faces,
                        const std::vector<Kernel::V3D> &vertices,
                        const Kernel::Material material)
@@ -43,6 +53,39 @@ void MeshObject::initialize() {
 
   MeshObjectCommon::checkVertexLimit(m_vertices.size());
   m_handler = boost::make_shared<GeometryHandler>(*this);
+  buildTriangleHierarchy();
+}
+
+/**
+ * Build the hierarchy of the bounding boxes of the triangles, used to find the
+ * triangles a ray may intersect. It must be rebuilt when the vertices move.
+ */
+void MeshObject::buildTriangleHierarchy() {
+  const size_t nTriangles = numberOfTriangles();
+  std::vector<Kernel::V3D> minPoints, maxPoints;
+  minPoints.reserve(nTriangles);
+  maxPoints.reserve(nTriangles);
+  Kernel::V3D vertex1, vertex2, vertex3;
+  double largestCoordinate = 0.0;
+  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+    Kernel::V3D minPoint, maxPoint;
+    for (size_t d = 0; d < 3; ++d) {
+      minPoint[d] = std::min({vertex1[d], vertex2[d], vertex3[d]});
+      maxPoint[d] = std::max({vertex1[d], vertex2[d], vertex3[d]});
+      largestCoordinate = std::max(
+          {largestCoordinate, std::abs(minPoint[d]), std::abs(maxPoint[d])});
+    }
+    minPoints.push_back(minPoint);
+    maxPoints.push_back(maxPoint);
+  }
+  // The boxes of triangles lying in an axis-aligned plane are flat, so a ray
+  // along such a face only hits them if the rounding of its coordinates
+  // happens to fall the right way. Padding them by a few rounding errors of
+  // the largest coordinate of the mesh keeps those triangles as candidates.
+  const double padding =
+      RELATIVE_PADDING * std::numeric_limits<double>::epsilon() *
+      largestCoordinate;
+  m_triangleHierarchy = BoundingVolumeHierarchy(minPoints, maxPoints, padding);
 }
 
 /**
@@ -182,7 +225,12 @@ void MeshObject::getIntersections(const Kernel::V3D &start,
 
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   int entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  // Only the triangles whose bounding boxes the ray passes through can be
+  // intersected. They are tested in the order of the mesh.
+  std::vector<size_t> candidates;
+  m_triangleHierarchy.intersectingItems(start, direction, candidates);
+  for (const auto i : candidates) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(start, direction, vertex1,
                                                 vertex2, vertex3, intersection,
                                                 entryExit)) {
@@ -477,12 +525,14 @@ void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex.rotate(rotationMatrix);
   }
+  buildTriangleHierarchy();
 }
 
 void MeshObject::translate(Kernel::V3D translationVector) {
   for (Kernel::V3D &vertex : m_vertices) {
     vertex = vertex + translationVector;
   }
+  buildTriangleHierarchy();
 }
 
 /**
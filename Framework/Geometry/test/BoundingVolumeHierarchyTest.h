@@ -0,0 +1,139 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_
+#define MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_
+
+#include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/BoundingVolumeHierarchy.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <cxxtest/TestSuite.h>
+
+using Mantid::Geometry::BoundingVolumeHierarchy;
+using Mantid::Kernel::V3D;
+
+class BoundingVolumeHierarchyTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BoundingVolumeHierarchyTest *createSuite() {
+    return new BoundingVolumeHierarchyTest();
+  }
+  static void destroySuite(BoundingVolumeHierarchyTest *suite) {
+    delete suite;
+  }
+
+  void test_empty_hierarchy_has_no_intersections() {
+    BoundingVolumeHierarchy hierarchy;
+    TS_ASSERT(hierarchy.empty());
+    TS_ASSERT_EQUALS(hierarchy.numberOfItems(), 0);
+    std::vector<size_t> items(1, 3);
+    hierarchy.intersectingItems(V3D(0, 0, 0), V3D(1, 0, 0), items);
+    TS_ASSERT(items.empty());
+  }
+
+  void test_different_numbers_of_corners_throws() {
+    std::vector<V3D> minPoints(2), maxPoints(3);
+    TS_ASSERT_THROWS(BoundingVolumeHierarchy(minPoints, maxPoints),
+                     std::invalid_argument);
+  }
+
+  void test_ray_finds_boxes_in_front_of_it_in_order() {
+    // A row of unit cubes along x
+    std::vector<V3D> minPoints, maxPoints;
+    for (int i = 0; i < 20; ++i) {
+      minPoints.emplace_back(2.0 * i, 0.0, 0.0);
+      maxPoints.emplace_back(2.0 * i + 1.0, 1.0, 1.0);
+    }
+    BoundingVolumeHierarchy hierarchy(minPoints, maxPoints);
+    TS_ASSERT_EQUALS(hierarchy.numberOfItems(), 20);
+
+    std::vector<size_t> items;
+    // Along the row, starting inside the sixth cube
+    hierarchy.intersectingItems(V3D(10.5, 0.5, 0.5), V3D(1, 0, 0), items);
+    TS_ASSERT_EQUALS(items.size(), 15);
+    TS_ASSERT_EQUALS(items.front(), 5);
+    TS_ASSERT_EQUALS(items.back(), 19);
+    // Backwards along the row from the same point
+    hierarchy.intersectingItems(V3D(10.5, 0.5, 0.5), V3D(-1, 0, 0), items);
+    TS_ASSERT_EQUALS(items.size(), 6);
+    TS_ASSERT_EQUALS(items.front(), 0);
+    TS_ASSERT_EQUALS(items.back(), 5);
+    // Across the row, through the gap between two cubes
+    hierarchy.intersectingItems(V3D(11.5, -1, 0.5), V3D(0, 1, 0), items);
+    TS_ASSERT(items.empty());
+    // Across the row, through one cube
+    hierarchy.intersectingItems(V3D(12.5, -1, 0.5), V3D(0, 1, 0), items);
+    TS_ASSERT_EQUALS(items, std::vector<size_t>(1, 6));
+    // Diagonally through the first cube only
+    const V3D diagonal = V3D(1, 1, 1) / std::sqrt(3.0);
+    hierarchy.intersectingItems(V3D(-1, -1, -1), diagonal, items);
+    TS_ASSERT_EQUALS(items, std::vector<size_t>(1, 0));
+  }
+
+  void test_boxes_touched_within_the_padding_are_found() {
+    std::vector<V3D> minPoints(1, V3D(0, 0, 0));
+    std::vector<V3D> maxPoints(1, V3D(1, 1, 1));
+    std::vector<size_t> items;
+    // Grazing the top face of the cube
+    BoundingVolumeHierarchy unpadded(minPoints, maxPoints, 0.0);
+    unpadded.intersectingItems(V3D(-1, 1.05, 0.5), V3D(1, 0, 0), items);
+    TS_ASSERT(items.empty());
+    BoundingVolumeHierarchy padded(minPoints, maxPoints, 0.1);
+    padded.intersectingItems(V3D(-1, 1.05, 0.5), V3D(1, 0, 0), items);
+    TS_ASSERT_EQUALS(items.size(), 1);
+  }
+
+  void test_identical_boxes_are_all_found() {
+    std::vector<V3D> minPoints(50, V3D(0, 0, 0));
+    std::vector<V3D> maxPoints(50, V3D(1, 1, 1));
+    BoundingVolumeHierarchy hierarchy(minPoints, maxPoints);
+    std::vector<size_t> items;
+    hierarchy.intersectingItems(V3D(0.5, 0.5, -1), V3D(0, 0, 1), items);
+    TS_ASSERT_EQUALS(items.size(), 50);
+    TS_ASSERT_EQUALS(items.back(), 49);
+  }
+
+  void test_random_boxes_agree_with_testing_every_box() {
+    Mantid::Kernel::MersenneTwister rng(12345, -10.0, 10.0);
+    std::vector<V3D> minPoints, maxPoints;
+    std::vector<Mantid::Geometry::BoundingBox> boxes;
+    for (size_t i = 0; i < 1000; ++i) {
+      const V3D centre(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      const V3D halfWidth(0.1 * std::abs(rng.nextValue()),
+                          0.1 * std::abs(rng.nextValue()),
+                          0.1 * std::abs(rng.nextValue()));
+      minPoints.emplace_back(centre - halfWidth);
+      maxPoints.emplace_back(centre + halfWidth);
+      boxes.emplace_back(maxPoints.back().X(), maxPoints.back().Y(),
+                         maxPoints.back().Z(), minPoints.back().X(),
+                         minPoints.back().Y(), minPoints.back().Z());
+    }
+    BoundingVolumeHierarchy hierarchy(minPoints, maxPoints, 0.0);
+
+    std::vector<size_t> items;
+    size_t nFound(0);
+    for (size_t i = 0; i < 200; ++i) {
+      const V3D start(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      V3D direction(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      direction.normalize();
+      hierarchy.intersectingItems(start, direction, items);
+      std::vector<size_t> expected;
+      for (size_t j = 0; j < boxes.size(); ++j) {
+        if (boxes[j].isPointInside(start) ||
+            boxes[j].doesLineIntersect(start, direction))
+          expected.emplace_back(j);
+      }
+      TS_ASSERT_EQUALS(items, expected);
+      nFound += items.size();
+    }
+    // The rays must pass through some of the boxes for the test to mean much
+    TS_ASSERT_LESS_THAN(100, nFound);
+  }
+};
+
+#endif /* MANTID_GEOMETRY_BOUNDINGVOLUMEHIERARCHYTEST_H_ */
@@ -345,6 +345,18 @@ public:
     checkTrackIntercept(std::move(geom_obj), track, expectedResults);
   }
 
+  void testInterceptCubeAlongFace() {
+    std::vector<Link> expectedResults;
+    auto geom_obj = createCube(4.0);
+    // In the plane of the top face, whose triangles have flat bounding boxes
+    Track track(V3D(-10, 1, 4), V3D(1, 0, 0));
+
+    // format = startPoint, endPoint, total distance so far
+    expectedResults.emplace_back(
+        Link(V3D(0, 1, 4), V3D(4, 1, 4), 14.0, *geom_obj));
+    checkTrackIntercept(std::move(geom_obj), track, expectedResults);
+  }
+
   void testInterceptCubeMiss() {
     std::vector<Link>
         expectedResults; // left empty as there are no expected results
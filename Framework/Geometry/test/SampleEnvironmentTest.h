@@ -100,6 +100,24 @@ public:
     TS_ASSERT_EQUALS(3, ray.count());
   }
 
+  void test_Track_Intersection_Skips_Components_Away_From_The_Track() {
+    using namespace Mantid::Geometry;
+    using namespace Mantid::Kernel;
+
+    auto kit = createTestKit();
+    // Starts between the can and the component after the sample
+    Track forward(V3D(0.1, 0, 0), V3D(1.0, 0.0, 0.0));
+    TS_ASSERT_EQUALS(1, kit->interceptSurfaces(forward));
+    TS_ASSERT_DELTA(0.15, forward.front().entryPoint.X(), 1e-08);
+    // Passes only through the component before the sample
+    Track across(V3D(-0.25, -1.0, 0), V3D(0.0, 1.0, 0.0));
+    TS_ASSERT_EQUALS(1, kit->interceptSurfaces(across));
+    TS_ASSERT_DELTA(-0.1, across.front().entryPoint.Y(), 1e-08);
+    // Misses everything
+    Track miss(V3D(-0.5, 0.5, 0), V3D(1.0, 0.0, 0.0));
+    TS_ASSERT_EQUALS(0, kit->interceptSurfaces(miss));
+  }
+
   void test_BoundingBox_Encompasses_Whole_Object() {
     using namespace Mantid::Geometry;
     using namespace Mantid::Kernel;
@@ -69,7 +69,7 @@ public:
   void objectDeleted(ISaveable *item);
 
   // Free space map methods
-  void freeBlock(uint64_t const pos, uint64_t const size);
+  virtual void freeBlock(uint64_t const pos, uint64_t const size);
   void defragFreeBlocks();
 
   // Allocating
@@ -135,9 +135,12 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
  *   This includes an arbirary check: condition.
  *   "condition" must evaluate to TRUE in order for the
  *   code to be executed in parallel
+ *   The schedule is static so that, for a given number of threads, each
+ *   thread always gets the same block of iterations. Loops over the spectra
+ *   then find the data where EventWorkspace::applyNumaPlacement() put it.
  */
 #define PARALLEL_FOR_IF(condition)                                             \
-    PRAGMA(omp parallel for if (condition) )
+    PRAGMA(omp parallel for schedule(static) if (condition) )
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *   This includes no checks to see if workspaces are suitable
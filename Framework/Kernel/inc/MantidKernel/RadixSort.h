@@ -0,0 +1,102 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_RADIXSORT_H_
+#define MANTID_KERNEL_RADIXSORT_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** Map a double onto an unsigned integer with the same ordering, for use as a
+ * radix sort key. Negative zero sorts just before positive zero.
+ * @param value :: the value to convert
+ * @return an integer key that compares like value
+ */
+inline uint64_t radixSortKey(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint64_t signBit = uint64_t{1} << 63;
+  // Negative values: flip everything so that larger magnitudes sort first.
+  // Positive values: set the sign bit so that they sort after the negatives.
+  return (bits & signBit) ? ~bits : (bits | signBit);
+}
+
+/** Map a signed integer onto an unsigned integer with the same ordering, for
+ * use as a radix sort key.
+ * @param value :: the value to convert
+ * @return an integer key that compares like value
+ */
+inline uint64_t radixSortKey(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ (uint64_t{1} << 63);
+}
+
+/** Stable least-significant-digit radix sort on a 64-bit key, one byte per
+ * pass.
+ *
+ * The counts for all the passes are gathered in a single read of the values,
+ * and passes where every value has the same digit are skipped. For example
+ * pulse times within one run share their top bytes, so only the varying low
+ * bytes cost a pass.
+ *
+ * @param values :: the values to sort, in place
+ * @param key :: callable returning the uint64_t sort key of a value, see
+ * radixSortKey()
+ * @param scratch :: working buffer, resized to values.size(). Pass the same
+ * buffer to many calls to avoid reallocating it; its contents on return are
+ * unspecified.
+ */
+template <typename T, typename KeyFunction>
+void radixSort(std::vector<T> &values, KeyFunction key,
+               std::vector<T> &scratch) {
+  constexpr size_t numPasses = sizeof(uint64_t);
+  constexpr size_t numBuckets = 256;
+  const size_t size = values.size();
+  if (size < 2)
+    return;
+
+  std::array<std::array<size_t, numBuckets>, numPasses> counts{};
+  for (const auto &value : values) {
+    uint64_t k = key(value);
+    for (size_t pass = 0; pass < numPasses; ++pass, k >>= 8)
+      ++counts[pass][k & 0xff];
+  }
+
+  scratch.resize(size);
+  std::vector<T> *from = &values;
+  std::vector<T> *to = &scratch;
+  for (size_t pass = 0; pass < numPasses; ++pass) {
+    auto &count = counts[pass];
+    const unsigned shift = static_cast<unsigned>(8 * pass);
+    // Nothing to do if all the values have the same digit
+    if (count[(key((*from)[0]) >> shift) & 0xff] == size)
+      continue;
+    // Turn the counts into the offset of each bucket
+    size_t offset = 0;
+    for (auto &bucket : count) {
+      const size_t bucketSize = bucket;
+      bucket = offset;
+      offset += bucketSize;
+    }
+    for (const auto &value : *from)
+      (*to)[count[(key(value) >> shift) & 0xff]++] = value;
+    std::swap(from, to);
+  }
+  // After an odd number of passes the result is in the scratch buffer
+  if (from != &values)
+    values.swap(scratch);
+}
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_RADIXSORT_H_ */
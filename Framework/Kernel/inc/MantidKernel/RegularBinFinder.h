@@ -0,0 +1,65 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_REGULARBINFINDER_H_
+#define MANTID_KERNEL_REGULARBINFINDER_H_
+
+#include "MantidKernel/DllConfig.h"
+#include <cstddef>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+ * Finds the bins of many x values arithmetically, for bin edges that are
+ * linearly or logarithmically spaced (i.e. created from rebin parameters
+ * with a single positive or negative step). The last bin may be narrower
+ * than the others, as produced when the range is not a multiple of the
+ * step.
+ *
+ * The bin index is estimated in a branch-free loop that the compiler can
+ * vectorize, and then corrected against the actual bin edges, so the result
+ * is always identical to a search of the edges: x belongs to bin i if
+ * edges[i] <= x < edges[i + 1].
+ *
+ * Unlike BinFinder, which is set up from rebin parameters, this class works
+ * out the spacing from the bin edges themselves. Use isRegular() to check
+ * whether it can be used for a given set of edges.
+ */
+class MANTID_KERNEL_DLL RegularBinFinder {
+public:
+  explicit RegularBinFinder(const std::vector<double> &edges);
+
+  /// True if the edges are linearly or logarithmically spaced
+  bool isRegular() const { return m_spacing != Spacing::Irregular; }
+
+  void findBins(const double *x, const std::size_t count, int *bins) const;
+
+  int bin(const double x) const;
+
+private:
+  enum class Spacing { Irregular, Linear, Logarithmic };
+
+  bool checkLinear();
+  bool checkLogarithmic();
+
+  /// The bin edges. Not owned; must outlive this object.
+  const std::vector<double> &m_edges;
+  /// Spacing of the edges
+  Spacing m_spacing;
+  /// First edge (linear) or log of the first edge (logarithmic)
+  double m_origin;
+  /// 1 / step (linear) or 1 / log(1 + step) (logarithmic)
+  double m_inverseStep;
+  /// Largest valid bin index, as a double for clamping the estimate
+  double m_lastBin;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_REGULARBINFINDER_H_ */
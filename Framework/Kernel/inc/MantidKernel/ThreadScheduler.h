@@ -89,7 +89,7 @@ public:
 
   //-------------------------------------------------------------------------------
   /// Returns the total cost of all Task's in the queue.
-  double totalCost() { return m_cost; }
+  virtual double totalCost() { return m_cost; }
 
   //-------------------------------------------------------------------------------
   /// Returns the total cost of all Task's in the queue.
@@ -0,0 +1,71 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A ThreadScheduler with a task deque per
+ * thread, for workloads where tasks create further tasks of very uneven cost
+ * (e.g. splitting MD boxes).
+ *
+ * - Tasks pushed by a thread of the pool go to the bottom of that thread's
+ *   deque and are popped from there again (last in, first out), without
+ *   taking a lock.
+ * - Tasks pushed from elsewhere, typically the initial tasks, go to a shared
+ *   queue sorted by cost. A thread whose deque is empty takes the largest
+ *   cost one to run, and moves a share of the next largest to its deque.
+ * - A thread that finds both empty steals from the top of the other threads'
+ *   deques, again without taking a lock.
+ *
+ * The deques are the lock-free "Chase-Lev" deques, see Le et al., "Correct
+ * and efficient work-stealing for weak memory models", PPoPP 2013.
+ *
+ * Unlike ThreadSchedulerMutexes this scheduler does not hold back tasks whose
+ * mutex is in use; such a task simply waits for its mutex when it is run.
+ */
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numThreads = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  Task *pop(size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+
+private:
+  class Deque;
+
+  size_t currentWorker() const;
+  Task *popShared(size_t threadnum);
+  Task *steal(size_t threadnum);
+
+  /// Identifies this scheduler to the threads popping from it
+  const size_t m_id;
+  /// Deque of each thread of the pool
+  std::vector<std::unique_ptr<Deque>> m_deques;
+  /// Tasks pushed from outside the pool, sorted by cost
+  std::multimap<double, Task *> m_shared;
+  /// Number of tasks held, in the deques and in m_shared
+  std::atomic<size_t> m_size;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
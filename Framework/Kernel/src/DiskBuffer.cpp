@@ -201,7 +201,8 @@ void DiskBuffer::flushCache() {
 //---------------------------------------------------------------------------------------------
 /** This method is called by this->relocate when object that has shrunk
  * and so has left a bit of free space after itself on the file;
- * or when an object gets moved to a new spot.
+ * or when an object gets moved to a new spot. Stores that keep the saved
+ * blocks themselves override it to release what was saved there.
  *
  * @param pos :: position in the file of the START of the new free block
  * @param size :: size of the free block
@@ -0,0 +1,152 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/RegularBinFinder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using std::size_t;
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// How far (as a fraction of a bin) an edge may be from its regular position
+constexpr double EDGE_TOLERANCE = 0.25;
+} // namespace
+
+/** Constructor. Works out whether the edges are linearly or logarithmically
+ * spaced.
+ *
+ * @param edges :: the bin edges, in increasing order. A reference is kept so
+ * they must outlive this object.
+ */
+RegularBinFinder::RegularBinFinder(const std::vector<double> &edges)
+    : m_edges(edges), m_spacing(Spacing::Irregular), m_origin(0.),
+      m_inverseStep(0.), m_lastBin(0.) {
+  if (edges.size() < 2 ||
+      edges.size() - 2 > static_cast<size_t>(std::numeric_limits<int>::max()))
+    return;
+  m_lastBin = static_cast<double>(edges.size() - 2);
+  if (checkLinear())
+    m_spacing = Spacing::Linear;
+  else if (checkLogarithmic())
+    m_spacing = Spacing::Logarithmic;
+}
+
+/** Check for edges of the form x0 + i * step. The last edge only needs to be
+ * above the one before it.
+ * @return true if the edges are linearly spaced
+ */
+bool RegularBinFinder::checkLinear() {
+  const size_t numRegular = std::max(m_edges.size() - 1, size_t{2});
+  const double step = (m_edges[numRegular - 1] - m_edges[0]) /
+                      static_cast<double>(numRegular - 1);
+  if (!(step > 0.) || !std::isfinite(step))
+    return false;
+  const double tolerance = EDGE_TOLERANCE * step;
+  for (size_t i = 1; i < numRegular - 1; ++i) {
+    const double expected = m_edges[0] + static_cast<double>(i) * step;
+    if (!(std::abs(m_edges[i] - expected) <= tolerance))
+      return false;
+  }
+  if (!(m_edges.back() > m_edges[m_edges.size() - 2]))
+    return false;
+  m_origin = m_edges[0];
+  m_inverseStep = 1. / step;
+  return true;
+}
+
+/** Check for edges of the form x0 * (1 + step)^i. The last edge only needs to
+ * be above the one before it.
+ * @return true if the edges are logarithmically spaced
+ */
+bool RegularBinFinder::checkLogarithmic() {
+  if (!(m_edges[0] > 0.))
+    return false;
+  const size_t numRegular = std::max(m_edges.size() - 1, size_t{2});
+  const double ratio =
+      std::pow(m_edges[numRegular - 1] / m_edges[0],
+               1. / static_cast<double>(numRegular - 1));
+  if (!(ratio > 1.) || !std::isfinite(ratio))
+    return false;
+  // Compare with repeated multiplication to avoid a log() per edge
+  double expected = m_edges[0];
+  for (size_t i = 1; i < numRegular - 1; ++i) {
+    expected *= ratio;
+    if (!(std::abs(m_edges[i] - expected) <=
+          EDGE_TOLERANCE * (ratio - 1.) * expected))
+      return false;
+  }
+  if (!(m_edges.back() > m_edges[m_edges.size() - 2]))
+    return false;
+  m_origin = std::log(m_edges[0]);
+  m_inverseStep = 1. / std::log(ratio);
+  return true;
+}
+
+/** Find the bins of many x values. Only valid if isRegular() is true.
+ *
+ * @param x :: pointer to the values to bin
+ * @param count :: number of values
+ * @param bins :: output, must have room for count values. Set to the index of
+ * the bin holding each value, or -1 if the value is outside the edges.
+ */
+void RegularBinFinder::findBins(const double *x, const size_t count,
+                                int *bins) const {
+  // Estimate the bin from the spacing. Kept free of branches so that the
+  // compiler can vectorize it; NaN estimates end up in bin 0.
+  const double lastBin = m_lastBin;
+  if (m_spacing == Spacing::Linear) {
+    const double min = m_origin;
+    const double inverseStep = m_inverseStep;
+    for (size_t i = 0; i < count; ++i) {
+      const double estimate = (x[i] - min) * inverseStep;
+      bins[i] = static_cast<int>(std::max(0., std::min(estimate, lastBin)));
+    }
+  } else {
+    // log(x / min) / log(1 + step), with both logs of the edges precomputed
+    // so that only the log of the value is left in the loop
+    const double logMin = m_origin;
+    const double inverseLogStep = m_inverseStep;
+    for (size_t i = 0; i < count; ++i) {
+      const double estimate = (std::log(x[i]) - logMin) * inverseLogStep;
+      bins[i] = static_cast<int>(std::max(0., std::min(estimate, lastBin)));
+    }
+  }
+
+  // Correct for rounding and for the narrower last bin, so that the result is
+  // the same as searching the edges.
+  const double lower = m_edges.front();
+  const double upper = m_edges.back();
+  for (size_t i = 0; i < count; ++i) {
+    const double value = x[i];
+    if (!(value >= lower && value < upper)) {
+      bins[i] = -1;
+      continue;
+    }
+    size_t bin = static_cast<size_t>(bins[i]);
+    while (value < m_edges[bin])
+      --bin;
+    while (value >= m_edges[bin + 1])
+      ++bin;
+    bins[i] = static_cast<int>(bin);
+  }
+}
+
+/** Find the bin of a single value. Only valid if isRegular() is true.
+ * @param x :: value to bin
+ * @return the index of the bin holding x, or -1 if x is outside the edges
+ */
+int RegularBinFinder::bin(const double x) const {
+  int index;
+  findBins(&x, 1, &index);
+  return index;
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,308 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/make_unique.h"
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Source of the scheduler IDs. 0 is never used, so it marks "no scheduler".
+std::atomic<size_t> g_nextSchedulerId{1};
+
+/// The scheduler and thread number the current thread last popped with
+struct CurrentWorker {
+  size_t schedulerId{0};
+  size_t threadnum{0};
+};
+thread_local CurrentWorker g_currentWorker;
+
+/// Rounds of looking for a task before pop() gives up
+constexpr int MAX_POP_ATTEMPTS = 4;
+/// Most tasks moved from the shared queue to a deque at once
+constexpr size_t MAX_BATCH = 64;
+/// Initial capacity of a deque, must be a power of 2
+constexpr size_t INITIAL_CAPACITY = 64;
+} // namespace
+
+/** Lock-free deque of tasks. Only the owning thread may push() and take(),
+ * which work on the bottom end. Any thread may steal() from the top end.
+ */
+class ThreadSchedulerWorkStealing::Deque {
+public:
+  Deque() : m_top(0), m_bottom(0), m_cost(0.) {
+    m_arrays.emplace_back(Kernel::make_unique<Array>(INITIAL_CAPACITY));
+    m_array.store(m_arrays.back().get());
+  }
+
+  /// Add a task at the bottom. Owner only.
+  void push(Task *task) {
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    const int64_t top = m_top.load(std::memory_order_acquire);
+    Array *array = m_array.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(array->mask))
+      array = grow(array, top, bottom);
+    array->put(bottom, task);
+    m_bottom.store(bottom + 1, std::memory_order_release);
+  }
+
+  /// Remove the task at the bottom, or return NULL if empty. Owner only.
+  Task *take() {
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Array *array = m_array.load(std::memory_order_relaxed);
+    // Publish the reservation before looking at top, see steal()
+    m_bottom.store(bottom, std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+    Task *task = nullptr;
+    if (top <= bottom) {
+      task = array->get(bottom);
+      if (top == bottom) {
+        // The last task; thieves may be after it too
+        if (!m_top.compare_exchange_strong(top, top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+          task = nullptr;
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+      }
+    } else {
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+  }
+
+  /** Remove the task at the top. Any thread.
+   * @param contended :: set to true if another thread got the task first
+   * @return the task, or NULL if the deque was empty or contended
+   */
+  Task *steal(bool &contended) {
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+    const int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom)
+      return nullptr;
+    Array *array = m_array.load(std::memory_order_acquire);
+    Task *task = array->get(top);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      contended = true;
+      return nullptr;
+    }
+    return task;
+  }
+
+  /// Add to the cost of the tasks pushed. Owner only.
+  void addCost(const double cost) {
+    m_cost.store(m_cost.load(std::memory_order_relaxed) + cost,
+                 std::memory_order_relaxed);
+  }
+  /// Total cost of the tasks pushed
+  double cost() const { return m_cost.load(std::memory_order_relaxed); }
+  /// Reset the cost of the tasks pushed
+  void resetCost() { m_cost.store(0., std::memory_order_relaxed); }
+
+private:
+  /// Circular buffer of tasks
+  struct Array {
+    explicit Array(const size_t capacity)
+        : mask(capacity - 1), tasks(capacity) {}
+    Task *get(const int64_t index) const {
+      return tasks[static_cast<size_t>(index) & mask].load(
+          std::memory_order_relaxed);
+    }
+    void put(const int64_t index, Task *task) {
+      tasks[static_cast<size_t>(index) & mask].store(
+          task, std::memory_order_relaxed);
+    }
+    const size_t mask;
+    std::vector<std::atomic<Task *>> tasks;
+  };
+
+  /// Replace the buffer by one twice the size. Owner only.
+  Array *grow(Array *array, const int64_t top, const int64_t bottom) {
+    m_arrays.emplace_back(Kernel::make_unique<Array>(2 * (array->mask + 1)));
+    Array *bigger = m_arrays.back().get();
+    for (int64_t i = top; i < bottom; ++i)
+      bigger->put(i, array->get(i));
+    m_array.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  std::atomic<int64_t> m_top;
+  std::atomic<int64_t> m_bottom;
+  std::atomic<Array *> m_array;
+  /// Every buffer used so far. Thieves may still be reading from a replaced
+  /// one, so they are only deleted with the deque.
+  std::vector<std::unique_ptr<Array>> m_arrays;
+  /// Total cost of the tasks pushed
+  std::atomic<double> m_cost;
+};
+
+/** Constructor
+ * @param numThreads :: number of threads of the ThreadPool using this
+ * scheduler. 0 means the number of physical cores, like ThreadPool.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numThreads)
+    : ThreadScheduler(), m_id(g_nextSchedulerId++), m_size(0) {
+  if (numThreads == 0)
+    numThreads = ThreadPool::getNumPhysicalCores();
+  for (size_t i = 0; i < numThreads; ++i)
+    m_deques.emplace_back(Kernel::make_unique<Deque>());
+}
+
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+/** Add a Task. Tasks pushed by a thread of the pool go to its own deque,
+ * others to the queue shared by all threads.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  // Count first so that the task is never available but not counted
+  ++m_size;
+  const size_t worker = currentWorker();
+  if (worker < m_deques.size()) {
+    m_deques[worker]->addCost(newTask->cost());
+    m_deques[worker]->push(newTask);
+  } else {
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    m_cost += newTask->cost();
+    m_shared.emplace(newTask->cost(), newTask);
+  }
+}
+
+/** Retrieve the next Task to execute: from the bottom of the thread's own
+ * deque, else the largest cost one in the shared queue, else stolen from
+ * another thread.
+ *
+ * A thread becomes the owner of the deque `threadnum` by popping, so a given
+ * threadnum must always be used from the same thread, as in ThreadPool.
+ *
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task pointer to execute, or NULL if none was found.
+ */
+Task *ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  const bool isWorker = threadnum < m_deques.size();
+  if (isWorker) {
+    g_currentWorker.schedulerId = m_id;
+    g_currentWorker.threadnum = threadnum;
+  }
+  for (int attempt = 0; attempt < MAX_POP_ATTEMPTS; ++attempt) {
+    if (m_size.load() == 0)
+      return nullptr;
+    Task *task = isWorker ? m_deques[threadnum]->take() : nullptr;
+    if (!task)
+      task = popShared(threadnum);
+    if (!task)
+      task = steal(threadnum);
+    if (task) {
+      --m_size;
+      return task;
+    }
+    // Tasks are being taken or moved by other threads, try again
+    std::this_thread::yield();
+  }
+  return nullptr;
+}
+
+/// @return the number of Task's held
+size_t ThreadSchedulerWorkStealing::size() { return m_size.load(); }
+
+/// @return true if no Task is held
+bool ThreadSchedulerWorkStealing::empty() { return m_size.load() == 0; }
+
+/// Delete all the Task's held
+void ThreadSchedulerWorkStealing::clear() {
+  {
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    for (auto &item : m_shared)
+      delete item.second;
+    m_size -= m_shared.size();
+    m_shared.clear();
+    m_cost = 0;
+    m_costExecuted = 0;
+  }
+  // Stealing is safe from any thread, even while the owners keep going
+  for (auto &deque : m_deques) {
+    for (;;) {
+      bool contended = false;
+      Task *task = deque->steal(contended);
+      if (task) {
+        delete task;
+        --m_size;
+      } else if (!contended) {
+        break;
+      }
+    }
+    deque->resetCost();
+  }
+}
+
+/// @return the total cost of all Task's pushed
+double ThreadSchedulerWorkStealing::totalCost() {
+  std::lock_guard<std::mutex> lock(m_queueLock);
+  double cost = m_cost;
+  for (const auto &deque : m_deques)
+    cost += deque->cost();
+  return cost;
+}
+
+/// @return the thread number of the calling thread in the pool, or the number
+/// of threads if it is not part of the pool
+size_t ThreadSchedulerWorkStealing::currentWorker() const {
+  if (g_currentWorker.schedulerId != m_id)
+    return m_deques.size();
+  return g_currentWorker.threadnum;
+}
+
+/** Take the largest cost task from the shared queue. If the caller is a
+ * thread of the pool, also move a share of the next largest tasks to its
+ * deque, so that it does not need the lock for every task. Other threads can
+ * still steal them from there.
+ * @param threadnum :: ID of the calling thread.
+ * @return the task, or NULL if the shared queue is empty
+ */
+Task *ThreadSchedulerWorkStealing::popShared(size_t threadnum) {
+  std::lock_guard<std::mutex> lock(m_queueLock);
+  if (m_shared.empty())
+    return nullptr;
+  auto largest = std::prev(m_shared.end());
+  Task *task = largest->second;
+  m_shared.erase(largest);
+  if (threadnum < m_deques.size()) {
+    const size_t batch =
+        std::min(MAX_BATCH, m_shared.size() / (2 * m_deques.size()));
+    auto &deque = *m_deques[threadnum];
+    // Largest first, i.e. at the top where the thieves look first
+    for (size_t i = 0; i < batch; ++i) {
+      auto next = std::prev(m_shared.end());
+      deque.push(next->second);
+      m_shared.erase(next);
+    }
+  }
+  return task;
+}
+
+/** Steal a task from the top of the deque of another thread.
+ * @param threadnum :: ID of the calling thread.
+ * @return the task, or NULL if none was found
+ */
+Task *ThreadSchedulerWorkStealing::steal(size_t threadnum) {
+  const size_t numDeques = m_deques.size();
+  const size_t start = threadnum < numDeques ? threadnum + 1 : 0;
+  for (size_t i = 0; i < numDeques; ++i) {
+    bool contended = false;
+    if (Task *task = m_deques[(start + i) % numDeques]->steal(contended))
+      return task;
+  }
+  return nullptr;
+}
+
+} // namespace Kernel
+} // namespace Mantid
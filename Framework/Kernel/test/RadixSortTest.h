@@ -0,0 +1,112 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_RADIXSORTTEST_H_
+#define MANTID_KERNEL_RADIXSORTTEST_H_
+
+#include "MantidKernel/RadixSort.h"
+#include <algorithm>
+#include <cxxtest/TestSuite.h>
+#include <limits>
+#include <random>
+#include <utility>
+
+using namespace Mantid::Kernel;
+
+class RadixSortTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static RadixSortTest *createSuite() { return new RadixSortTest(); }
+  static void destroySuite(RadixSortTest *suite) { delete suite; }
+
+  void test_double_keys_keep_order() {
+    const std::vector<double> values{
+        -std::numeric_limits<double>::infinity(),
+        -1e300,
+        -2.5,
+        -1e-300,
+        0.0,
+        1e-300,
+        1.0,
+        2.5,
+        1e300,
+        std::numeric_limits<double>::infinity()};
+    for (size_t i = 1; i < values.size(); ++i)
+      TS_ASSERT_LESS_THAN(radixSortKey(values[i - 1]), radixSortKey(values[i]));
+    TS_ASSERT_LESS_THAN(radixSortKey(-0.0), radixSortKey(0.0));
+  }
+
+  void test_int_keys_keep_order() {
+    const std::vector<int64_t> values{std::numeric_limits<int64_t>::min(),
+                                      -1000, -1, 0, 1, 1000,
+                                      std::numeric_limits<int64_t>::max()};
+    for (size_t i = 1; i < values.size(); ++i)
+      TS_ASSERT_LESS_THAN(radixSortKey(values[i - 1]), radixSortKey(values[i]));
+  }
+
+  void test_sort_doubles() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> distribution(-1e4, 1e4);
+    std::vector<double> values(10001);
+    for (auto &value : values)
+      value = distribution(generator);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<double> scratch;
+    radixSort(values, [](const double value) { return radixSortKey(value); },
+              scratch);
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_sort_is_stable() {
+    // Only the low byte of the key varies, so the odd number of passes
+    // leaves the result in the scratch buffer
+    std::vector<std::pair<int64_t, int>> values;
+    for (int i = 0; i < 1000; ++i)
+      values.emplace_back(1000000 + (i * 37) % 50, i);
+    auto expected = values;
+    const auto compareFirst = [](const std::pair<int64_t, int> &lhs,
+                                 const std::pair<int64_t, int> &rhs) {
+      return lhs.first < rhs.first;
+    };
+    std::stable_sort(expected.begin(), expected.end(), compareFirst);
+
+    std::vector<std::pair<int64_t, int>> scratch;
+    radixSort(values,
+              [](const std::pair<int64_t, int> &value) {
+                return radixSortKey(value.first);
+              },
+              scratch);
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_sort_reuses_scratch() {
+    std::vector<int64_t> scratch;
+    const auto key = [](const int64_t value) { return radixSortKey(value); };
+    std::vector<int64_t> first{5, -3, 1000000000000, 7, -3};
+    radixSort(first, key, scratch);
+    TS_ASSERT_EQUALS(first,
+                     (std::vector<int64_t>{-3, -3, 5, 7, 1000000000000}));
+    std::vector<int64_t> second{2, 1};
+    radixSort(second, key, scratch);
+    TS_ASSERT_EQUALS(second, (std::vector<int64_t>{1, 2}));
+  }
+
+  void test_sort_short_vectors() {
+    std::vector<double> scratch;
+    const auto key = [](const double value) { return radixSortKey(value); };
+    std::vector<double> empty;
+    radixSort(empty, key, scratch);
+    TS_ASSERT(empty.empty());
+    std::vector<double> single{3.0};
+    radixSort(single, key, scratch);
+    TS_ASSERT_EQUALS(single, std::vector<double>{3.0});
+  }
+};
+
+#endif /* MANTID_KERNEL_RADIXSORTTEST_H_ */
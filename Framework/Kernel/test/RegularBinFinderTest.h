@@ -0,0 +1,134 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_REGULARBINFINDERTEST_H_
+#define MANTID_KERNEL_REGULARBINFINDERTEST_H_
+
+#include "MantidKernel/RegularBinFinder.h"
+#include "MantidKernel/VectorHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <cxxtest/TestSuite.h>
+#include <limits>
+
+using namespace Mantid::Kernel;
+
+class RegularBinFinderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static RegularBinFinderTest *createSuite() {
+    return new RegularBinFinderTest();
+  }
+  static void destroySuite(RegularBinFinderTest *suite) { delete suite; }
+
+  void test_linear_bins() {
+    const auto edges = makeEdges({0.0, 2.0, 100.0});
+    RegularBinFinder finder(edges);
+    TS_ASSERT(finder.isRegular());
+    TS_ASSERT_EQUALS(finder.bin(-0.1), -1);
+    TS_ASSERT_EQUALS(finder.bin(100.0), -1);
+    TS_ASSERT_EQUALS(finder.bin(0.0), 0);
+    TS_ASSERT_EQUALS(finder.bin(1.999), 0);
+    TS_ASSERT_EQUALS(finder.bin(2.0), 1);
+    TS_ASSERT_EQUALS(finder.bin(99.0), 49);
+    checkAgainstSearch(edges);
+  }
+
+  void test_log_bins() {
+    const auto edges = makeEdges({2.0, -1.0, 1024.0});
+    RegularBinFinder finder(edges);
+    TS_ASSERT(finder.isRegular());
+    TS_ASSERT_EQUALS(finder.bin(1.8), -1);
+    TS_ASSERT_EQUALS(finder.bin(1025.0), -1);
+    TS_ASSERT_EQUALS(finder.bin(2.0), 0);
+    TS_ASSERT_EQUALS(finder.bin(3.999), 0);
+    TS_ASSERT_EQUALS(finder.bin(4.0), 1);
+    TS_ASSERT_EQUALS(finder.bin(1023.9), 8);
+    checkAgainstSearch(edges);
+  }
+
+  void test_narrow_last_bin() {
+    const auto linear = makeEdges({0.0, 3.0, 100.0});
+    TS_ASSERT_EQUALS(linear.back() - linear[linear.size() - 2], 1.0);
+    RegularBinFinder linearFinder(linear);
+    TS_ASSERT(linearFinder.isRegular());
+    TS_ASSERT_EQUALS(linearFinder.bin(99.5), 33);
+    checkAgainstSearch(linear);
+
+    const auto log = makeEdges({10.0, -0.01, 20000.0});
+    TS_ASSERT(RegularBinFinder(log).isRegular());
+    checkAgainstSearch(log);
+  }
+
+  void test_fine_bins() {
+    checkAgainstSearch(makeEdges({1000.0, 0.1, 20000.0}));
+    checkAgainstSearch(makeEdges({1000.0, -0.0005, 20000.0}));
+    checkAgainstSearch(makeEdges({-500.0, 0.7, 300.0}));
+  }
+
+  void test_irregular_bins() {
+    TS_ASSERT(!RegularBinFinder(makeEdges({0.0, 1.0, 10.0, 10.0, 100.0}))
+                   .isRegular());
+    TS_ASSERT(!RegularBinFinder({0.0, 1.0, 2.5, 3.0, 4.0}).isRegular());
+    TS_ASSERT(!RegularBinFinder({0.0, 1.0, 2.0, 2.0}).isRegular());
+    TS_ASSERT(!RegularBinFinder({3.0, 2.0, 1.0}).isRegular());
+    TS_ASSERT(!RegularBinFinder({1.0}).isRegular());
+    TS_ASSERT(!RegularBinFinder(std::vector<double>()).isRegular());
+  }
+
+  void test_single_bin() {
+    const std::vector<double> edges{1.0, 5.0};
+    RegularBinFinder finder(edges);
+    TS_ASSERT(finder.isRegular());
+    TS_ASSERT_EQUALS(finder.bin(0.5), -1);
+    TS_ASSERT_EQUALS(finder.bin(1.0), 0);
+    TS_ASSERT_EQUALS(finder.bin(4.9), 0);
+    TS_ASSERT_EQUALS(finder.bin(5.0), -1);
+  }
+
+  void test_non_finite_values_are_outside() {
+    const auto edges = makeEdges({2.0, -0.5, 1000.0});
+    RegularBinFinder finder(edges);
+    TS_ASSERT_EQUALS(finder.bin(std::numeric_limits<double>::quiet_NaN()), -1);
+    TS_ASSERT_EQUALS(finder.bin(std::numeric_limits<double>::infinity()), -1);
+    TS_ASSERT_EQUALS(finder.bin(-1.0), -1);
+    TS_ASSERT_EQUALS(finder.bin(0.0), -1);
+  }
+
+private:
+  std::vector<double> makeEdges(const std::vector<double> &params) {
+    std::vector<double> edges;
+    VectorHelper::createAxisFromRebinParams(params, edges);
+    return edges;
+  }
+
+  /// Compare the bins found with a binary search of the edges, including
+  /// values that lie exactly on the edges.
+  void checkAgainstSearch(const std::vector<double> &edges) {
+    RegularBinFinder finder(edges);
+    TS_ASSERT(finder.isRegular());
+    std::vector<double> x(edges);
+    for (size_t i = 0; i + 1 < edges.size(); ++i) {
+      x.push_back(0.5 * (edges[i] + edges[i + 1]));
+      x.push_back(std::nextafter(edges[i + 1], edges[i]));
+    }
+    x.push_back(edges.front() - 1.0);
+    x.push_back(edges.back() + 1.0);
+    std::vector<int> bins(x.size());
+    finder.findBins(x.data(), x.size(), bins.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      int expected = -1;
+      if (x[i] >= edges.front() && x[i] < edges.back())
+        expected = static_cast<int>(
+            std::upper_bound(edges.begin(), edges.end(), x[i]) -
+            edges.begin() - 1);
+      TSM_ASSERT_EQUALS(std::to_string(x[i]), bins[i], expected);
+    }
+  }
+};
+
+#endif /* MANTID_KERNEL_REGULARBINFINDERTEST_H_ */
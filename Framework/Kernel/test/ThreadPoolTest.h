@@ -11,6 +11,7 @@
 
 #include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include <MantidKernel/FunctionTask.h>
 #include <MantidKernel/ProgressText.h>
 #include <MantidKernel/ThreadPool.h>
@@ -376,6 +377,10 @@ public:
     do_StressTest_scheduler(new ThreadSchedulerMutexes());
   }
 
+  void test_StressTest_ThreadSchedulerWorkStealing() {
+    do_StressTest_scheduler(new ThreadSchedulerWorkStealing());
+  }
+
   //--------------------------------------------------------------------
   /** Perform a stress test on the given scheduler.
    * This one creates tasks that create new tasks; e.g. 10 tasks each add
@@ -414,6 +419,10 @@ public:
     do_StressTest_TasksThatCreateTasks(new ThreadSchedulerMutexes());
   }
 
+  void test_StressTest_TasksThatCreateTasks_ThreadSchedulerWorkStealing() {
+    do_StressTest_TasksThatCreateTasks(new ThreadSchedulerWorkStealing());
+  }
+
   //=======================================================================================
   /** Task that throws an exception */
   class TaskThatThrows : public Task {
@@ -436,6 +445,17 @@ public:
     // And only one of the tasks actually ran (since we're on one core)
     TS_ASSERT_EQUALS(ThreadPoolTest_TaskThatThrows_counter, 1);
   }
+
+  void test_TaskThatThrows_ThreadSchedulerWorkStealing() {
+    ThreadPool p(new ThreadSchedulerWorkStealing(1), 1); // one core
+    ThreadPoolTest_TaskThatThrows_counter = 0;
+    for (int i = 0; i < 10; i++) {
+      p.schedule(new TaskThatThrows());
+    }
+    TS_ASSERT_THROWS(p.joinAll(), std::runtime_error);
+    // The tasks moved to the thread's deque were cleared as well
+    TS_ASSERT_EQUALS(ThreadPoolTest_TaskThatThrows_counter, 1);
+  }
 };
 
 #endif
@@ -0,0 +1,162 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace Mantid::Kernel;
+
+int ThreadSchedulerWorkStealingTest_numDestructed;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() {
+    return new ThreadSchedulerWorkStealingTest();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) {
+    delete suite;
+  }
+
+  class TaskDoNothing : public Task {
+  public:
+    TaskDoNothing(double cost = 0.) : Task() { m_cost = cost; }
+    ~TaskDoNothing() override {
+      ThreadSchedulerWorkStealingTest_numDestructed++;
+    }
+    void run() override {}
+  };
+
+  void test_push_and_clear() {
+    ThreadSchedulerWorkStealing sc(2);
+    TS_ASSERT(sc.empty());
+    sc.push(new TaskDoNothing(1.));
+    sc.push(new TaskDoNothing(2.));
+    TS_ASSERT_EQUALS(sc.size(), 2);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_EQUALS(sc.totalCost(), 3.);
+
+    ThreadSchedulerWorkStealingTest_numDestructed = 0;
+    sc.clear();
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(ThreadSchedulerWorkStealingTest_numDestructed, 2);
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.);
+    TS_ASSERT(!sc.pop(0));
+  }
+
+  void test_shared_tasks_are_popped_by_largest_cost() {
+    // Pushed from outside the pool, so they go to the shared queue
+    std::vector<Task *> tasks{new TaskDoNothing(1.), new TaskDoNothing(5.),
+                              new TaskDoNothing(2.), new TaskDoNothing(-3.)};
+    ThreadSchedulerWorkStealing sc(1);
+    for (auto task : tasks)
+      sc.push(task);
+    std::vector<Task *> popped;
+    while (auto task = sc.pop(0))
+      popped.push_back(task);
+    TS_ASSERT_EQUALS(popped,
+                     (std::vector<Task *>{tasks[1], tasks[2], tasks[0],
+                                          tasks[3]}));
+    TS_ASSERT(sc.empty());
+    for (auto task : tasks)
+      delete task;
+  }
+
+  void test_tasks_pushed_by_a_thread_are_popped_last_in_first_out() {
+    ThreadSchedulerWorkStealing sc(2);
+    // Popping makes this thread number 0 of the pool
+    TS_ASSERT(!sc.pop(0));
+    std::vector<Task *> tasks{new TaskDoNothing(5.), new TaskDoNothing(1.),
+                              new TaskDoNothing(3.)};
+    for (auto task : tasks)
+      sc.push(task);
+    TS_ASSERT_EQUALS(sc.size(), 3);
+    TS_ASSERT_EQUALS(sc.totalCost(), 9.);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[2]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[1]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[0]);
+    TS_ASSERT(sc.empty());
+    for (auto task : tasks)
+      delete task;
+  }
+
+  void test_other_thread_steals_oldest_task() {
+    ThreadSchedulerWorkStealing sc(2);
+    TS_ASSERT(!sc.pop(0));
+    std::vector<Task *> tasks{new TaskDoNothing(), new TaskDoNothing(),
+                              new TaskDoNothing()};
+    for (auto task : tasks)
+      sc.push(task);
+    Task *stolen = nullptr;
+    std::thread thief([&sc, &stolen] { stolen = sc.pop(1); });
+    thief.join();
+    TS_ASSERT_EQUALS(stolen, tasks[0]);
+    TS_ASSERT_EQUALS(sc.size(), 2);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[2]);
+    TS_ASSERT_EQUALS(sc.pop(0), tasks[1]);
+    for (auto task : tasks)
+      delete task;
+  }
+
+  void test_deque_grows() {
+    ThreadSchedulerWorkStealing sc(1);
+    TS_ASSERT(!sc.pop(0));
+    std::vector<Task *> tasks;
+    for (size_t i = 0; i < 1000; ++i) {
+      tasks.push_back(new TaskDoNothing());
+      sc.push(tasks.back());
+    }
+    TS_ASSERT_EQUALS(sc.size(), 1000);
+    for (size_t i = 0; i < 1000; ++i)
+      TS_ASSERT_EQUALS(sc.pop(0), tasks[999 - i]);
+    TS_ASSERT(sc.empty());
+    for (auto task : tasks)
+      delete task;
+  }
+
+  void test_concurrent_push_pop_and_steal() {
+    constexpr size_t numThreads = 4;
+    constexpr size_t tasksPerThread = 20000;
+    ThreadSchedulerWorkStealing sc(numThreads);
+    std::vector<std::vector<Task *>> popped(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&sc, &popped, t] {
+        // Only the first thread produces; the others live off stealing
+        for (size_t i = 0; i < tasksPerThread; ++i) {
+          if (t == 0)
+            sc.push(new TaskDoNothing());
+          if (auto task = sc.pop(t))
+            popped[t].push_back(task);
+        }
+        while (auto task = sc.pop(t))
+          popped[t].push_back(task);
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    std::vector<Task *> all;
+    for (auto &tasks : popped)
+      all.insert(all.end(), tasks.begin(), tasks.end());
+    TS_ASSERT_EQUALS(all.size(), tasksPerThread);
+    std::sort(all.begin(), all.end());
+    TS_ASSERT(std::adjacent_find(all.begin(), all.end()) == all.end());
+    TS_ASSERT(sc.empty());
+    for (auto task : all)
+      delete task;
+  }
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
@@ -10,6 +10,7 @@
 #include "MantidAPI/DataProcessorAlgorithm.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidKernel/System.h"
 #include "MantidMDAlgorithms/DllConfig.h"
 #include <set>
@@ -90,6 +91,29 @@ private:
       const std::string &filename, const bool filebackend);
 
   std::map<std::string, std::string> validateInputs() override;
+
+  /// Remove the runs of the named data sources from the output workspace
+  void removeDataSources(const std::vector<std::string> &data_sources);
+
+  /// Check whether the events of a workspace can be added to the output
+  /// workspace without rebuilding it
+  bool canAppendInPlace(const API::IMDEventWorkspace &ws) const;
+
+  /// Make the output workspace a copy of the input one unless it is the same
+  void prepareOutputWorkspace();
+
+  template <typename MDE, size_t nd>
+  void appendEvents(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+
+  template <typename MDE, size_t nd>
+  void removeRuns(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+
+  /// The input workspace
+  API::IMDEventWorkspace_sptr m_inputWS;
+  /// The workspace being modified, the input one if it is also the output
+  API::IMDEventWorkspace_sptr m_outputWS;
+  /// New index of each run of the output workspace, -1 for the removed runs
+  std::vector<int> m_newRunIndex;
 };
 
 } // namespace MDAlgorithms
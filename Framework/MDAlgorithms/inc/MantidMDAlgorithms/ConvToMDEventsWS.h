@@ -45,15 +45,32 @@ public:
   void runConversion(API::Progress *pProgress) override;
 
 private:
+  /// Converted MD events, waiting to be added to the workspace
+  struct EventBuffer {
+    std::vector<coord_t> coord;     // coordinates of the events
+    std::vector<float> sigErr;      // signal and squared error of the events
+    std::vector<uint16_t> runIndex; // run index of each event
+    std::vector<uint32_t> detIDs;   // detector id of each event
+  };
+
   // function runs the conversion on
   size_t conversionChunk(size_t workspaceIndex) override;
   // the pointer to the source event workspace as event ws does not work through
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
-  /**function converts particular type of events into MD space and add these
-   * events to the workspace itself    */
-  template <class T> size_t convertEventList(size_t workspaceIndex);
+  /// add the events spectrum by spectrum, splitting the boxes regularly
+  void addEventsAndSplit(API::Progress *pProgress);
+  /// add the events in large batches, building the boxes as they are added
+  void addEventsInBatches(API::Progress *pProgress);
+
+  size_t convertSpectrum(size_t workspaceIndex, MDTransfInterface &qConverter,
+                         EventBuffer &buffer) const;
+  /**function converts particular type of events into MD space and appends
+   * them to the buffer    */
+  template <class T>
+  size_t convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter,
+                          EventBuffer &buffer) const;
 };
 
 } // namespace MDAlgorithms
@@ -22,6 +22,15 @@ bool all_given(const std::vector<std::vector<double>> &params);
 
 extern bool dataExists(const std::string &data_name);
 
+/// Record the data source of each run of an MD workspace in the run logs
+void MANTID_MDALGORITHMS_DLL
+recordDataSources(API::MultipleExperimentInfos &ws,
+                  const std::vector<std::string> &data_sources);
+
+/// Return the data source recorded for each run of an MD workspace
+std::vector<std::string> MANTID_MDALGORITHMS_DLL
+getRecordedDataSources(const API::MultipleExperimentInfos &ws);
+
 /** CreateMD : This workflow algorithm creates MDWorkspaces in the Q3D, HKL
   frame using ConvertToMD
 */
@@ -58,6 +58,16 @@ private:
   template <typename MDE, size_t nd>
   void doLoad(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// Copy the events of the file to a mapped scratch file
+  boost::shared_ptr<API::IBoxControllerIO>
+  createMappedFileBackEnd(API::BoxController *bc,
+                          const std::string &eventType);
+
+  /// Copy the events of the file to a quantized store in memory
+  boost::shared_ptr<API::IBoxControllerIO>
+  createQuantizedBackEnd(API::BoxController *bc, const std::string &eventType,
+                         const std::vector<uint64_t> &eventIndex);
+
   void loadExperimentInfos(
       boost::shared_ptr<Mantid::API::MultipleExperimentInfos> ws);
 
@@ -43,16 +43,18 @@ private:
   getValuesFromOtherDimensions(bool &skipNormalization,
                                uint16_t expInfoIndex = 0) const;
   void cacheDimensionXValues();
-  void calculateNormalization(const std::vector<coord_t> &otherValues,
-                              Geometry::SymmetryOperation so,
-                              uint16_t expInfoIndex, size_t soIndex);
+  void calculateNormalization(
+      const std::vector<uint16_t> &expInfoIndices,
+      const std::vector<std::vector<coord_t>> &otherValues,
+      const std::vector<Geometry::SymmetryOperation> &symmetryOps);
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
                               const double theta, const double phi,
-                              Kernel::DblMatrix transform, double lowvalue,
-                              double highvalue);
+                              const Kernel::DblMatrix &transform,
+                              double lowvalue, double highvalue) const;
   void calcIntegralsForIntersections(const std::vector<double> &xValues,
                                      const API::MatrixWorkspace &integrFlux,
-                                     size_t sp, std::vector<double> &yValues);
+                                     size_t sp,
+                                     std::vector<double> &yValues) const;
 
   /// Normalization workspace
   DataObjects::MDHistoWorkspace_sptr m_normWS;
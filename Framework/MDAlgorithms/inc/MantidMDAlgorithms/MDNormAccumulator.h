@@ -0,0 +1,85 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_MDALGORITHMS_MDNORMACCUMULATOR_H_
+#define MANTID_MDALGORITHMS_MDNORMACCUMULATOR_H_
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/System.h"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** MDNormAccumulator : Accumulates the signal of a normalization
+  MDHistoWorkspace from a parallel loop.
+
+  Each thread adds its contributions to its own buffer without synchronisation
+  and the buffers are summed once at the end. Each buffer costs as much memory
+  as the signal of the workspace, 8 bytes per bin. If the buffers of all
+  threads do not fit into 1 GiB (by default) or a quarter of the free memory,
+  whichever is less, all threads add to a single shared array with atomic
+  operations instead. The loop always runs on all threads.
+
+  @code
+  MDNormAccumulator accumulator(normWS->getNPoints());
+  PRAGMA_OMP(parallel for num_threads(accumulator.numberOfThreads()))
+  for (int64_t i = 0; i < n; ++i) {
+    ...
+    accumulator.add(PARALLEL_THREAD_NUMBER, linIndex, signal);
+  }
+  accumulator.addTo(normWS->getSignalArray(), accumulate);
+  @endcode
+*/
+class DLLExport MDNormAccumulator {
+public:
+  explicit MDNormAccumulator(const size_t nPoints,
+                             const size_t maxBufferMemory = 1024 * 1024);
+
+  /// @return the number of threads that may add to the accumulator
+  int numberOfThreads() const { return m_nThreads; }
+  /// @return true if the threads add to a shared array with atomic operations
+  bool isShared() const { return !m_shared.empty(); }
+  void add(const int thread, const size_t index, const signal_t value);
+  void addTo(signal_t *signal, const bool accumulate) const;
+
+private:
+  /// The number of bins of the workspace
+  size_t m_nPoints;
+  /// The number of threads that may add to the accumulator
+  int m_nThreads;
+  /// One buffer per thread, allocated when the thread first adds to it
+  std::vector<std::vector<signal_t>> m_buffers;
+  /// The array shared by all threads if the buffers do not fit in memory
+  std::vector<std::atomic<signal_t>> m_shared;
+};
+
+/**
+ * Add a contribution to a bin
+ * @param thread :: The thread number, less than numberOfThreads()
+ * @param index :: The linear index of the bin
+ * @param value :: The contribution to add
+ */
+inline void MDNormAccumulator::add(const int thread, const size_t index,
+                                   const signal_t value) {
+  if (!m_shared.empty()) {
+    Kernel::AtomicOp(m_shared[index], value, std::plus<signal_t>());
+    return;
+  }
+  auto &buffer = m_buffers[thread];
+  if (buffer.empty())
+    buffer.resize(m_nPoints, 0.);
+  buffer[index] += value;
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_MDNORMACCUMULATOR_H_ */
@@ -0,0 +1,108 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_MDALGORITHMS_MDNORMDETECTORTABLE_H_
+#define MANTID_MDALGORITHMS_MDNORMDETECTORTABLE_H_
+
+#include "MantidAPI/ExperimentInfo.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidKernel/System.h"
+#include "MantidKernel/V3D.h"
+#include "MantidKernel/cow_ptr.h"
+#include "MantidTypes/SpectrumDefinition.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class DetectorInfo;
+}
+namespace MDAlgorithms {
+
+/** MDNormDetectorTable : The per-spectrum quantities used by the MD
+  normalization algorithms (MDNorm, MDNormSCD and MDNormDirectSC) that do not
+  depend on the goniometer: the direction of each detector, its spectrum in
+  the flux workspace and its solid angle.
+
+  The table is built once from one experiment info and reused for every other
+  experiment info with an equivalent instrument, i.e. the same detector
+  positions, masking and spectrum to detector mapping, so that the detector
+  geometry and the detector ID look-ups are not repeated for every run.
+
+  With reuse requested, create() also keeps the entries of the latest table
+  for later executions with the same instrument, detectors, spectra, flux and
+  solid angle workspaces. Only one table is kept.
+*/
+class DLLExport MDNormDetectorTable {
+public:
+  /// The cached quantities for one spectrum
+  struct Entry {
+    /// False for monitors, masked spectra, spectra without detectors and
+    /// detectors missing from the flux or solid angle workspaces
+    bool use;
+    /// Polar angle of the detector
+    double theta;
+    /// Azimuthal angle of the detector
+    double phi;
+    /// Workspace index of the detector in the flux workspace
+    size_t fluxIndex;
+    /// Solid angle of the detector, or 1 without a solid angle workspace
+    double solidAngle;
+  };
+
+  MDNormDetectorTable(const API::ExperimentInfo &exptInfo,
+                      const Kernel::V3D &samplePos, const Kernel::V3D &beamDir,
+                      const API::MatrixWorkspace *fluxWS,
+                      const API::MatrixWorkspace *solidAngleWS);
+
+  static boost::shared_ptr<const MDNormDetectorTable>
+  create(const API::ExperimentInfo &exptInfo, const Kernel::V3D &samplePos,
+         const Kernel::V3D &beamDir, const API::MatrixWorkspace *fluxWS,
+         const API::MatrixWorkspace *solidAngleWS, const bool reuse);
+
+  bool isValidFor(const API::ExperimentInfo &exptInfo) const;
+
+  /// @return the number of spectra in the table
+  size_t size() const { return m_entries.size(); }
+  /// @return the cached quantities of the spectrum at index
+  const Entry &operator[](const size_t index) const { return m_entries[index]; }
+
+private:
+  /// The entries of a table kept for later executions
+  struct CachedEntries {
+    /// The name of the instrument the entries are for
+    std::string instrument;
+    /// The detectors, spectra and workspaces the entries are for, see
+    /// cacheGeometry()
+    std::vector<double> geometry;
+    /// The entries of the table
+    std::vector<Entry> entries;
+  };
+
+  MDNormDetectorTable(const API::ExperimentInfo &exptInfo,
+                      std::vector<Entry> entries);
+  static std::vector<double>
+  cacheGeometry(const API::ExperimentInfo &exptInfo,
+                const Kernel::V3D &samplePos, const Kernel::V3D &beamDir,
+                const API::MatrixWorkspace *fluxWS,
+                const API::MatrixWorkspace *solidAngleWS);
+  static boost::shared_ptr<const CachedEntries> &tableCache();
+
+  /// The detectors the table was built from
+  const Geometry::DetectorInfo &m_detectorInfo;
+  /// The spectrum to detector mapping the table was built from
+  Kernel::cow_ptr<std::vector<SpectrumDefinition>> m_spectrumDefinitions;
+  /// One entry per spectrum
+  std::vector<Entry> m_entries;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_MDNORMDETECTORTABLE_H_ */
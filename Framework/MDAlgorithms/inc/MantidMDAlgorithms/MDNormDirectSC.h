@@ -46,12 +46,14 @@ private:
   findIntergratedDimensions(const std::vector<coord_t> &otherDimValues,
                             bool &skipNormalization);
   void cacheDimensionXValues();
-  void calculateNormalization(const std::vector<coord_t> &otherValues,
-                              const Kernel::Matrix<coord_t> &affineTrans,
-                              uint16_t expInfoIndex);
+  void calculateNormalization(
+      const std::vector<uint16_t> &expInfoIndices,
+      const std::vector<std::vector<coord_t>> &otherValues,
+      const Kernel::Matrix<coord_t> &affineTrans);
 
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
-                              const double theta, const double phi);
+                              const double theta, const double phi,
+                              const Kernel::DblMatrix &rubw) const;
 
   /// Normalization workspace
   DataObjects::MDHistoWorkspace_sptr m_normWS;
@@ -63,8 +65,6 @@ private:
   double m_Ei, m_ki, m_kfmin, m_kfmax;
   /// flag for integrated h,k,l, dE dimensions
   bool m_hIntegrated, m_kIntegrated, m_lIntegrated, m_dEIntegrated;
-  /// (2*PiRUBW)^-1
-  Mantid::Kernel::DblMatrix m_rubw;
   /// index of h,k,l, dE dimensions in the output workspaces
   size_t m_hIdx, m_kIdx, m_lIdx, m_eIdx;
   /// cached X values along dimensions h,k,l. dE
@@ -46,15 +46,17 @@ private:
   findIntergratedDimensions(const std::vector<coord_t> &otherDimValues,
                             bool &skipNormalization);
   void cacheDimensionXValues();
-  void calculateNormalization(const std::vector<coord_t> &otherValues,
-                              const Kernel::Matrix<coord_t> &affineTrans,
-                              uint16_t expInfoIndex);
+  void calculateNormalization(
+      const std::vector<uint16_t> &expInfoIndices,
+      const std::vector<std::vector<coord_t>> &otherValues,
+      const Kernel::Matrix<coord_t> &affineTrans);
   void calcIntegralsForIntersections(const std::vector<double> &xValues,
                                      const API::MatrixWorkspace &integrFlux,
                                      size_t sp,
                                      std::vector<double> &yValues) const;
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
-                              const double theta, const double phi);
+                              const double theta, const double phi,
+                              const Kernel::DblMatrix &rubw) const;
 
   /// Normalization workspace
   DataObjects::MDHistoWorkspace_sptr m_normWS;
@@ -64,8 +66,6 @@ private:
   coord_t m_hmin, m_hmax, m_kmin, m_kmax, m_lmin, m_lmax;
   /// flag for integrated h,k,l dimensions
   bool m_hIntegrated, m_kIntegrated, m_lIntegrated;
-  /// (2*PiRUBW)^-1
-  Mantid::Kernel::DblMatrix m_rubw;
   /// limits for momentum
   double m_kiMin, m_kiMax;
   /// index of h,k,l dimensions in the output workspaces
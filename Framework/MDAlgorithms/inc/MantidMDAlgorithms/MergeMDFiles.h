@@ -9,6 +9,7 @@
 
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/IMDEventWorkspace_fwd.h"
+#include "MantidDataObjects/MDBoxEventStream.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidKernel/System.h"
@@ -64,8 +65,10 @@ private:
 
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
-  // the vector of box structures for contributing files components
-  std::vector<DataObjects::MDBoxFlatTree> m_fileComponentsStructure;
+  /// the events of the boxes of each of the contributing files
+  std::vector<std::unique_ptr<DataObjects::MDBoxEventStream>> m_eventStreams;
+  /// the events of the box being merged, reused between boxes
+  std::vector<coord_t> m_boxEventTable;
 
 protected:
   /// Set to true if the output is cloned of the first one
@@ -82,9 +85,6 @@ protected:
   /// Files to load
   std::vector<std::string> m_Filenames;
 
-  /// Vector of file handles to each input file //TODO unique?
-  std::vector<API::IBoxControllerIO *> m_EventLoader;
-
   /// Output IMDEventWorkspace
   Mantid::API::IMDEventWorkspace_sptr m_OutIWS;
 
@@ -23,6 +23,10 @@ DLLExport std::vector<double> normaliseKernel(std::vector<double> kernel);
 DLLExport std::vector<double>
 renormaliseKernel(std::vector<double> kernel,
                   const std::vector<bool> &validity);
+DLLExport void convolveDimension(std::vector<double> &data,
+                                const std::vector<size_t> &shape,
+                                const size_t dimension,
+                                const std::vector<double> &kernel);
 
 /** SmoothMD : Algorithm for smoothing MDHistoWorkspaces
  */
@@ -6,10 +6,12 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/AccumulateMD.h"
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/ExperimentInfo.h"
 #include "MantidAPI/FileFinder.h"
 #include "MantidAPI/FileProperty.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/HistoryView.h"
+#include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDHistoWorkspaceIterator.h"
 #include "MantidKernel/ArrayBoundedValidator.h"
 #include "MantidKernel/ArrayProperty.h"
@@ -17,13 +19,19 @@
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidMDAlgorithms/CreateMD.h"
 
 #include <Poco/File.h>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
+#include <limits>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -31,6 +39,43 @@ using namespace Mantid::DataObjects;
 namespace Mantid {
 namespace MDAlgorithms {
 
+namespace {
+/// Add an offset to the run index of an event; MDLeanEvents have none
+template <size_t nd>
+inline void offsetRunIndex(MDLeanEvent<nd> &event,
+                           const uint16_t runIndexOffset) {
+  UNUSED_ARG(event);
+  UNUSED_ARG(runIndexOffset);
+}
+
+template <size_t nd>
+inline void offsetRunIndex(MDEvent<nd> &event, const uint16_t runIndexOffset) {
+  event.setRunIndex(
+      static_cast<uint16_t>(event.getRunIndex() + runIndexOffset));
+}
+
+/// Give an event the new index of its run; returns false if the run is removed
+template <size_t nd>
+inline bool remapRunIndex(MDLeanEvent<nd> &event,
+                          const std::vector<int> &newRunIndex) {
+  UNUSED_ARG(event);
+  UNUSED_ARG(newRunIndex);
+  return true;
+}
+
+template <size_t nd>
+inline bool remapRunIndex(MDEvent<nd> &event,
+                          const std::vector<int> &newRunIndex) {
+  const uint16_t runIndex = event.getRunIndex();
+  if (runIndex >= newRunIndex.size())
+    return true;
+  if (newRunIndex[runIndex] < 0)
+    return false;
+  event.setRunIndex(static_cast<uint16_t>(newRunIndex[runIndex]));
+  return true;
+}
+} // namespace
+
 /*
  * Reduce the vector of input data to only data files and workspaces which can
  * be found
@@ -166,13 +211,26 @@ getHistoricalDataSources(const WorkspaceHistory &ws_history,
     auto alg_history = history_item.getAlgorithmHistory();
     if (alg_history->name() == create_alg_name ||
         alg_history->name() == accumulate_alg_name) {
+      std::string added_sources;
+      std::string removed_sources;
       auto props = alg_history->getProperties();
       for (auto &prop : props) {
         PropertyHistory_const_sptr prop_history = prop;
         if (prop_history->name() == "DataSources") {
-          insertDataSources(prop_history->value(), historical_data_sources);
+          added_sources = prop_history->value();
+        } else if (prop_history->name() == "RemoveDataSources") {
+          removed_sources = prop_history->value();
         }
       }
+      // AccumulateMD removes data sources before it adds the new ones
+      if (!removed_sources.empty()) {
+        std::unordered_set<std::string> removed;
+        insertDataSources(removed_sources, removed);
+        for (const auto &data_source : removed)
+          historical_data_sources.erase(data_source);
+      }
+      if (!added_sources.empty())
+        insertDataSources(added_sources, historical_data_sources);
     }
   }
 
@@ -233,12 +291,16 @@ void AccumulateMD::init() {
                       "OutputWorkspace", "", Direction::Output),
                   "MDEventWorkspace with new data appended.");
 
+  declareProperty(make_unique<ArrayProperty<std::string>>("DataSources",
+                                                          Direction::Input),
+                  "Input workspaces to process, or filenames to load and "
+                  "process");
+
   declareProperty(
-      Kernel::make_unique<ArrayProperty<std::string>>(
-          "DataSources",
-          boost::make_shared<MandatoryValidator<std::vector<std::string>>>(),
-          Direction::Input),
-      "Input workspaces to process, or filenames to load and process");
+      make_unique<ArrayProperty<std::string>>("RemoveDataSources",
+                                              Direction::Input),
+      "Data sources whose runs and events are removed from the workspace "
+      "before the new data are added.");
 
   declareProperty(make_unique<ArrayProperty<double>>("EFix", Direction::Input),
                   "datasource energy values in meV");
@@ -314,8 +376,11 @@ void AccumulateMD::init() {
  */
 void AccumulateMD::exec() {
 
-  IMDEventWorkspace_sptr input_ws = this->getProperty("InputWorkspace");
+  m_inputWS = this->getProperty("InputWorkspace");
+  m_outputWS = m_inputWS;
   std::vector<std::string> input_data = this->getProperty("DataSources");
+  const std::vector<std::string> remove_data =
+      this->getProperty("RemoveDataSources");
 
   const std::string out_filename = this->getProperty("Filename");
   const bool filebackend = this->getProperty("FileBackEnd");
@@ -339,17 +404,17 @@ void AccumulateMD::exec() {
                  << '\n';
 
   // If we can't find any data, we can't do anything
-  if (input_data.empty()) {
+  bool do_clean = this->getProperty("Clean");
+  if (input_data.empty() && remove_data.empty()) {
     g_log.warning() << "No data found matching input in " << this->name()
                     << '\n';
-    this->setProperty("OutputWorkspace", input_ws);
+    this->setProperty("OutputWorkspace", m_inputWS);
     return; // POSSIBLE EXIT POINT
   }
   this->interruption_point();
 
   // If Clean=True then just call CreateMD to create a fresh workspace and
   // delete the old one, note this means we don't retain workspace history...
-  bool do_clean = this->getProperty("Clean");
   if (do_clean) {
     this->progress(0.5);
     IMDEventWorkspace_sptr out_ws = createMDWorkspace(
@@ -362,13 +427,24 @@ void AccumulateMD::exec() {
   }
   this->interruption_point();
 
+  // Remove data before adding any, so that a data source can be replaced
+  if (!remove_data.empty()) {
+    removeDataSources(remove_data);
+    this->interruption_point();
+  }
+
   // Find what files and workspaces have already been included in the workspace.
-  const WorkspaceHistory ws_history = input_ws->getHistory();
+  const WorkspaceHistory ws_history = m_inputWS->getHistory();
   // Get name from algorithm like this so that an error is thrown if the
   // name of the algorithm is changed
   Algorithm_sptr create_alg = createChildAlgorithm("CreateMD");
   std::vector<std::string> current_data =
       getHistoricalDataSources(ws_history, create_alg->name(), this->name());
+  for (const auto &data_source : remove_data) {
+    current_data.erase(
+        std::remove(current_data.begin(), current_data.end(), data_source),
+        current_data.end());
+  }
 
   // If there's no new data, we don't have anything to do
   const std::string old_sources =
@@ -379,24 +455,42 @@ void AccumulateMD::exec() {
   if (input_data.empty()) {
     g_log.notice() << "No new data to append to workspace in " << this->name()
                    << '\n';
-    this->setProperty("OutputWorkspace", input_ws);
+    this->setProperty("OutputWorkspace", m_outputWS);
     return; // POSSIBLE EXIT POINT
   }
   this->interruption_point();
 
   // If we reach here then new data exists to append to the input workspace
   // Use CreateMD with the new data to make a temp workspace
-  // Merge the temp workspace with the input workspace using MergeMD
   IMDEventWorkspace_sptr tmp_ws =
       createMDWorkspace(input_data, psi, gl, gs, efix, "", false);
   this->interruption_point();
   this->progress(0.5); // Report as CreateMD is complete
 
+  if (canAppendInPlace(*tmp_ws)) {
+    // Add the new events to the boxes they fall in, splitting only those
+    prepareOutputWorkspace();
+    CALL_MDEVENT_FUNCTION(appendEvents, tmp_ws);
+    this->setProperty("OutputWorkspace", m_outputWS);
+    g_log.notice() << this->name() << " successfully appended data\n";
+    this->progress(1.0);
+    return; // POSSIBLE EXIT POINT
+  }
+
+  // Otherwise merge the temp workspace with the input workspace using MergeMD
+  g_log.information() << "The new data do not fit in the existing workspace, "
+                         "merging the workspaces with MergeMD\n";
   const std::string temp_ws_name = "TEMP_WORKSPACE_ACCUMULATEMD";
+  const std::string temp_out_ws_name = "TEMP_OUTPUT_WORKSPACE_ACCUMULATEMD";
   // Currently have to use ADS here as list of workspaces can only be passed as
   // a list of workspace names as a string
   AnalysisDataService::Instance().add(temp_ws_name, tmp_ws);
-  std::string ws_names_to_merge = input_ws->getName();
+  std::string ws_names_to_merge = m_inputWS->getName();
+  if (m_outputWS != m_inputWS) {
+    // Data sources were removed from a copy of the input workspace
+    AnalysisDataService::Instance().add(temp_out_ws_name, m_outputWS);
+    ws_names_to_merge = temp_out_ws_name;
+  }
   ws_names_to_merge.append(",");
   ws_names_to_merge.append(temp_ws_name);
 
@@ -412,8 +506,179 @@ void AccumulateMD::exec() {
 
   this->progress(1.0); // Report as MergeMD is complete
 
-  // Clean up temporary workspace
+  // Clean up temporary workspaces
   AnalysisDataService::Instance().remove(temp_ws_name);
+  if (m_outputWS != m_inputWS)
+    AnalysisDataService::Instance().remove(temp_out_ws_name);
+}
+
+/*
+ * Remove the runs created from the named data sources, and their events, from
+ * the output workspace. The runs are identified by the data source recorded in
+ * their logs by CreateMD.
+ * @param data_sources :: names of the data sources to remove
+ */
+void AccumulateMD::removeDataSources(
+    const std::vector<std::string> &data_sources) {
+  const std::vector<std::string> recorded =
+      getRecordedDataSources(*m_outputWS);
+  m_newRunIndex.assign(recorded.size(), -1);
+  int numKept = 0;
+  for (size_t i = 0; i < recorded.size(); ++i) {
+    if (recorded[i].empty() ||
+        std::find(data_sources.cbegin(), data_sources.cend(), recorded[i]) ==
+            data_sources.cend())
+      m_newRunIndex[i] = numKept++;
+  }
+  if (static_cast<size_t>(numKept) == recorded.size()) {
+    g_log.warning() << "None of the data sources to remove were found in the "
+                       "runs of the workspace\n";
+    return;
+  }
+  if (m_outputWS->getEventTypeName() != MDEvent<1>::getTypeName())
+    throw std::invalid_argument(
+        "Data sources can only be removed from a workspace of MDEvents, which "
+        "record the run of each event.");
+
+  prepareOutputWorkspace();
+  CALL_MDEVENT_FUNCTION(removeRuns, m_outputWS);
+  g_log.notice() << "Removed the data of "
+                 << recorded.size() - static_cast<size_t>(numKept)
+                 << " run(s) from the workspace\n";
+}
+
+/*
+ * Check whether the events of a workspace can be added to the boxes of the
+ * output workspace, rather than merging both into a new workspace
+ * @param ws :: the workspace with the new events
+ * @returns true if the events are of the same type and fit in the output
+ * workspace, and the output workspace may be modified
+ */
+bool AccumulateMD::canAppendInPlace(const IMDEventWorkspace &ws) const {
+  if (ws.getEventTypeName() != m_outputWS->getEventTypeName() ||
+      ws.getNumDims() != m_outputWS->getNumDims())
+    return false;
+  // A file backed input workspace is modified, but not copied
+  if (m_outputWS == m_inputWS && m_inputWS->isFileBacked() &&
+      this->getPropertyValue("OutputWorkspace") !=
+          this->getPropertyValue("InputWorkspace"))
+    return false;
+  for (size_t d = 0; d < ws.getNumDims(); ++d) {
+    const auto dim = ws.getDimension(d);
+    const auto existing = m_outputWS->getDimension(d);
+    if (dim->getName() != existing->getName() ||
+        dim->getMinimum() < existing->getMinimum() ||
+        dim->getMaximum() > existing->getMaximum())
+      return false;
+  }
+  return true;
+}
+
+/*
+ * Copy the input workspace before it is modified, unless it is also the output
+ * workspace
+ */
+void AccumulateMD::prepareOutputWorkspace() {
+  if (m_outputWS != m_inputWS)
+    return;
+  const std::string out_name = this->getPropertyValue("OutputWorkspace");
+  if (!out_name.empty() && out_name == this->getPropertyValue("InputWorkspace"))
+    return;
+  if (m_inputWS->isFileBacked())
+    throw std::invalid_argument("A file backed InputWorkspace can only be "
+                                "modified in place, set OutputWorkspace to "
+                                "the InputWorkspace.");
+  m_outputWS = m_inputWS->clone();
+}
+
+/*
+ * Add the events and the runs of a workspace to the output workspace. Only the
+ * boxes receiving events are touched, and split if they get too many.
+ * @param ws :: the workspace with the new events
+ */
+template <typename MDE, size_t nd>
+void AccumulateMD::appendEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  auto out = boost::dynamic_pointer_cast<MDEventWorkspace<MDE, nd>>(m_outputWS);
+  if (!out)
+    throw std::runtime_error(
+        "Incompatible workspace types passed to AccumulateMD.");
+  if (size_t(out->getNumExperimentInfo()) + ws->getNumExperimentInfo() >
+      std::numeric_limits<uint16_t>::max())
+    throw std::invalid_argument(
+        "currently we can not combine more then 65535 experiments");
+
+  const uint16_t runIndexOffset = out->getNumExperimentInfo();
+  for (uint16_t i = 0; i < ws->getNumExperimentInfo(); ++i) {
+    out->addExperimentInfo(
+        ExperimentInfo_sptr(ws->getExperimentInfo(i)->cloneExperimentInfo()));
+  }
+
+  std::vector<MDE> events;
+  events.reserve(ws->getNPoints());
+  std::vector<API::IMDNode *> boxes;
+  ws->getBox()->getBoxes(boxes, 1000, true);
+  for (auto node : boxes) {
+    auto *box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (!box || box->getIsMasked())
+      continue;
+    for (const auto &event : box->getConstEvents()) {
+      events.push_back(event);
+      offsetRunIndex(events.back(), runIndexOffset);
+    }
+    box->releaseEvents();
+  }
+  if (events.empty())
+    return;
+
+  if (out->isFileBacked()) {
+    out->addEventsAndSplit(events, nullptr);
+  } else {
+    // The pool deletes the scheduler
+    auto ts = new ThreadSchedulerWorkStealing(0);
+    ThreadPool tp(ts, 0);
+    out->addEventsAndSplit(events, ts);
+    tp.joinAll();
+  }
+  out->refreshCache();
+  out->setFileNeedsUpdating(true);
+}
+
+/*
+ * Remove the events and the runs marked by m_newRunIndex from a workspace, and
+ * renumber the remaining runs
+ * @param ws :: the output workspace
+ */
+template <typename MDE, size_t nd>
+void AccumulateMD::removeRuns(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  std::vector<API::IMDNode *> boxes;
+  ws->getBox()->getBoxes(boxes, 1000, true);
+  const int numBoxes = static_cast<int>(boxes.size());
+  PARALLEL_FOR_IF(Kernel::threadSafe(*ws))
+  for (int i = 0; i < numBoxes; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    if (box) {
+      std::vector<MDE> &events = box->getEvents();
+      auto kept = events.begin();
+      for (auto &event : events) {
+        if (remapRunIndex(event, m_newRunIndex))
+          *kept++ = event;
+      }
+      events.erase(kept, events.end());
+      box->releaseEvents();
+    }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  MultipleExperimentInfos kept;
+  for (uint16_t i = 0; i < ws->getNumExperimentInfo(); ++i) {
+    if (m_newRunIndex[i] >= 0)
+      kept.addExperimentInfo(ws->getExperimentInfo(i));
+  }
+  ws->copyExperimentInfos(kept);
+  ws->refreshCache();
+  ws->setFileNeedsUpdating(true);
 }
 
 /*
@@ -478,6 +743,19 @@ std::map<std::string, std::string> AccumulateMD::validateInputs() {
   const std::string filename = this->getProperty("Filename");
   const bool fileBackEnd = this->getProperty("FileBackEnd");
 
+  const std::vector<std::string> remove_sources =
+      this->getProperty("RemoveDataSources");
+  if (data_sources.empty() && remove_sources.empty()) {
+    validation_output["DataSources"] =
+        "DataSources or RemoveDataSources must be given.";
+  }
+  const bool do_clean = this->getProperty("Clean");
+  if (do_clean && !remove_sources.empty()) {
+    validation_output["RemoveDataSources"] =
+        "RemoveDataSources cannot be used with Clean, which only keeps the "
+        "data in DataSources.";
+  }
+
   if (fileBackEnd && filename.empty()) {
     validation_output["Filename"] =
         "Filename must be given if FileBackEnd is required.";
@@ -23,6 +23,8 @@
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -34,6 +36,11 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// Number of events transformed together when binning a box
+constexpr size_t EVENTS_PER_BATCH = 1024;
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -101,9 +108,6 @@ void BinMD::init() {
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
                             const size_t *const chunkMax) {
-  // An array to hold the rotated/transformed coordinates
-  auto outCenter = new coord_t[m_outD];
-
   // Evaluate whether the entire box is in the same bin
   if (box->getNPoints() > (1 << nd) * 2) {
     // There is a check that the number of events is enough for it to make sense
@@ -111,18 +115,17 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
     size_t numVertexes = 0;
     auto vertexes = box->getVertexesArray(numVertexes);
 
+    // Now transform all the vertexes to the output dimensions
+    std::vector<coord_t> outVertexes(numVertexes * m_outD);
+    m_transform->applyBatch(vertexes.get(), nd, outVertexes.data(),
+                            numVertexes);
+
     // All vertexes have to be within THE SAME BIN = have the same linear index.
     size_t lastLinearIndex = 0;
     bool badOne = false;
 
     for (size_t i = 0; i < numVertexes; i++) {
-      // Cache the center of the event (again for speed)
-      const coord_t *inCenter = vertexes.get() + i * nd;
-
-      // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
-      // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
-      // <<  VMD(nd,outCenter) << '\n';
+      const coord_t *outCenter = outVertexes.data() + i * m_outD;
 
       // To build up the linear index
       size_t linearIndex = 0;
@@ -162,8 +165,6 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
     if (!badOne) {
       // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
       // Add the CACHED signal from the entire box
       signals[lastLinearIndex] += box->getSignal();
       errors[lastLinearIndex] += box->getErrorSquared();
@@ -173,7 +174,6 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
-      delete[] outCenter;
       return;
     }
   }
@@ -182,47 +182,52 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
   // same bin.
   // So you need to iterate through events.
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
+  // The transformed centers of a batch of events
+  std::vector<coord_t> outCenters(
+      m_outD * std::min(events.size(), EVENTS_PER_BATCH));
+  for (size_t first = 0; first < events.size(); first += EVENTS_PER_BATCH) {
+    const size_t batchSize = std::min(EVENTS_PER_BATCH, events.size() - first);
+    // Transform the centers of the whole batch to the output dimensions
+    m_transform->applyBatch(events[first].getCenter(), MDE::getCenterStride(),
+                            outCenters.data(), batchSize);
+
+    for (size_t i = 0; i < batchSize; ++i) {
+      const coord_t *outCenter = outCenters.data() + i * m_outD;
 
-    // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
+      // To build up the linear index
+      size_t linearIndex = 0;
+      // To mark events outside range
+      bool badOne = false;
 
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
+      /// Loop through the dimensions on which we bin
+      for (size_t bd = 0; bd < m_outD; bd++) {
+        // What is the bin index in that dimension
+        coord_t x = outCenter[bd];
+        size_t ix = size_t(x);
+        // Within range (for this chunk)?
+        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+          // Build up the linear index
+          linearIndex += indexMultiplier[bd] * ix;
+        } else {
+          // Outside the range
+          badOne = true;
+          break;
+        }
+      } // (for each dim in MDHisto)
 
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      size_t ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
+      if (!badOne) {
+        const MDE &event = events[first + i];
+        // Sum the signals as doubles to preserve precision
+        signals[linearIndex] += static_cast<signal_t>(event.getSignal());
+        errors[linearIndex] += static_cast<signal_t>(event.getErrorSquared());
+        // TODO: If DataObjects get a weight, this would need to get the summed
+        // weight.
+        numEvents[linearIndex] += 1.0;
       }
-    } // (for each dim in MDHisto)
-
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
     }
   }
   // Done with the events list
   box->releaseEvents();
-
-  delete[] outCenter;
 }
 
 //----------------------------------------------------------------------------------------------
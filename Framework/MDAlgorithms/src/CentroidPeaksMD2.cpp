@@ -6,8 +6,8 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/CentroidPeaksMD2.h"
 #include "MantidAPI/IMDEventWorkspace.h"
-#include "MantidDataObjects/CoordTransformDistance.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDIntegrationRegion.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/System.h"
@@ -79,47 +79,45 @@ void CentroidPeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   /// Radius to use around peaks
   double PeakRadius = getProperty("PeakRadius");
 
+  const int nPeaks = peakWS->getNumberPeaks();
+
+  // Get the peak centers as positions in the dimensions of the workspace
+  std::vector<V3D> positions(nPeaks);
+  std::vector<MDIntegrationRegion> spheres;
+  spheres.reserve(nPeaks);
+  for (int i = 0; i < nPeaks; ++i) {
+    const IPeak &p = peakWS->getPeak(i);
+    V3D &pos = positions[i];
+    if (CoordinatesToUse == 1) //"Q (lab frame)"
+      pos = p.getQLabFrame();
+    else if (CoordinatesToUse == 2) //"Q (sample frame)"
+      pos = p.getQSampleFrame();
+    else if (CoordinatesToUse == 3) //"HKL"
+      pos = p.getHKL();
+
+    std::vector<coord_t> center(nd);
+    for (size_t d = 0; d < nd; ++d)
+      center[d] = static_cast<coord_t>(pos[d]);
+    spheres.push_back(
+        MDIntegrationRegion::sphere(center, std::fabs(PeakRadius)));
+  }
+
+  // Perform the centroids of all the peaks in one pass over the boxes
+  std::vector<coord_t> centroids;
+  std::vector<signal_t> signals;
+  ws->centroidRegions(spheres, centroids, signals);
+
   // cppcheck-suppress syntaxError
     PRAGMA_OMP(parallel for schedule(dynamic, 10) )
-    for (int i = 0; i < int(peakWS->getNumberPeaks()); ++i) {
+    for (int i = 0; i < nPeaks; ++i) {
       // Get a direct ref to that peak.
       IPeak &p = peakWS->getPeak(i);
       double detectorDistance = p.getL2();
+      const V3D &pos = positions[i];
+      const signal_t signal = signals[i];
 
-      // Get the peak center as a position in the dimensions of the workspace
-      V3D pos;
-      if (CoordinatesToUse == 1) //"Q (lab frame)"
-        pos = p.getQLabFrame();
-      else if (CoordinatesToUse == 2) //"Q (sample frame)"
-        pos = p.getQSampleFrame();
-      else if (CoordinatesToUse == 3) //"HKL"
-        pos = p.getHKL();
-
-      // Build the sphere transformation
-      bool dimensionsUsed[nd];
-      coord_t center[nd];
-      for (size_t d = 0; d < nd; ++d) {
-        dimensionsUsed[d] = true; // Use all dimensions
-        center[d] = static_cast<coord_t>(pos[d]);
-      }
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
-
-      // Initialize the centroid to 0.0
-      signal_t signal = 0;
-      coord_t centroid[nd];
-      for (size_t d = 0; d < nd; d++)
-        centroid[d] = 0.0;
-
-      // Perform centroid
-      ws->getBox()->centroidSphere(
-          sphere, static_cast<coord_t>(PeakRadius * PeakRadius), centroid,
-          signal);
-
-      // Normalize by signal
       if (signal != 0.0) {
-        for (size_t d = 0; d < nd; d++)
-          centroid[d] /= static_cast<coord_t>(signal);
-
+        const coord_t *centroid = centroids.data() + i * nd;
         V3D vecCentroid(centroid[0], centroid[1], centroid[2]);
         p.setBinCount(static_cast<double>(signal));
 
@@ -6,14 +6,26 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
+#include <exception>
+#include <memory>
+
 namespace Mantid {
 namespace MDAlgorithms {
-/**function converts particular list of events of type T into MD workspace and
- * adds these events to the workspace itself  */
+/**function converts particular list of events of type T into MD space and
+ * appends them to the buffer
+ *@param workspaceIndex -- the spectrum to convert
+ *@param qConverter     -- the MD transformation; it is not thread-safe, so
+ *each thread needs its own copy
+ *@param buffer         -- the buffer receiving the MD events
+ *@return the number of MD events appended */
 template <class T>
-size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
+size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                          MDTransfInterface &qConverter,
+                                          EventBuffer &buffer) const {
 
   const Mantid::DataObjects::EventList &el =
       m_EventWS->getSpectrum(workspaceIndex);
@@ -30,21 +42,9 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   std::vector<coord_t> locCoord(m_Coord);
   // set up unit conversion and calculate up all coordinates, which depend on
   // spectra index only
-  if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
+  if (!qConverter.calcYDepCoordinates(locCoord, workspaceIndex))
     return 0; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
-  //
-  // allocate temporary buffers for MD Events data
-  // MD events coordinates buffer
-  std::vector<coord_t> allCoord;
-  std::vector<float> sig_err;      // array for signal and error.
-  std::vector<uint16_t> run_index; // Buffer for run index for each event
-  std::vector<uint32_t> det_ids;   // Buffer of det Id-s for each event
-
-  allCoord.reserve(this->m_NDims * numEvents);
-  sig_err.reserve(2 * numEvents);
-  run_index.reserve(numEvents);
-  det_ids.reserve(numEvents);
 
   // This little dance makes the getting vector of events more general (since
   // you can't overload by return type).
@@ -52,47 +52,65 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   getEventsFrom(el, events_ptr);
   const typename std::vector<T> &events = *events_ptr;
 
+  const size_t nEventsBefore = buffer.runIndex.size();
   // Iterators to start/end
   for (auto it = events.cbegin(); it != events.cend(); it++) {
     double val = localUnitConv.convertUnits(it->tof());
     double signal = it->weight();
     double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+    if (!qConverter.calcMatrixCoord(val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
-    sig_err.push_back(static_cast<float>(signal));
-    sig_err.push_back(static_cast<float>(errorSq));
-    run_index.push_back(runIndexLoc);
-    det_ids.push_back(detID);
-    allCoord.insert(allCoord.end(), locCoord.begin(), locCoord.end());
+    buffer.sigErr.push_back(static_cast<float>(signal));
+    buffer.sigErr.push_back(static_cast<float>(errorSq));
+    buffer.runIndex.push_back(runIndexLoc);
+    buffer.detIDs.push_back(detID);
+    buffer.coord.insert(buffer.coord.end(), locCoord.begin(), locCoord.end());
   }
-
-  // Add them to the MDEW
-  size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
-  return n_added_events;
+  return buffer.runIndex.size() - nEventsBefore;
 }
 
-/** The method runs conversion for a single event list, corresponding to a
- * particular workspace index */
-size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+/** The method converts the events of a single event list, corresponding to a
+ * particular workspace index, and appends them to the buffer */
+size_t ConvToMDEventsWS::convertSpectrum(size_t workspaceIndex,
+                                         MDTransfInterface &qConverter,
+                                         EventBuffer &buffer) const {
 
   switch (m_EventWS->getSpectrum(workspaceIndex).getEventType()) {
   case Mantid::API::TOF:
     return this->convertEventList<Mantid::Types::Event::TofEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, buffer);
   case Mantid::API::WEIGHTED:
     return this->convertEventList<Mantid::DataObjects::WeightedEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, buffer);
   case Mantid::API::WEIGHTED_NOTIME:
     return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
-        workspaceIndex);
+        workspaceIndex, qConverter, buffer);
   default:
     throw std::runtime_error("EventList had an unexpected data type!");
   }
 }
 
+/** The method runs conversion for a single event list, corresponding to a
+ * particular workspace index, and adds the events to the workspace */
+size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+  // allocate temporary buffers for MD Events data
+  const size_t numEvents =
+      m_EventWS->getSpectrum(workspaceIndex).getNumberEvents();
+  EventBuffer buffer;
+  buffer.coord.reserve(this->m_NDims * numEvents);
+  buffer.sigErr.reserve(2 * numEvents);
+  buffer.runIndex.reserve(numEvents);
+  buffer.detIDs.reserve(numEvents);
+
+  size_t n_added_events =
+      this->convertSpectrum(workspaceIndex, *m_QConverter, buffer);
+  // Add them to the MDEW
+  m_OutWSWrapper->addMDData(buffer.sigErr, buffer.runIndex, buffer.detIDs,
+                            buffer.coord, n_added_events);
+  return n_added_events;
+}
+
 /** method sets up all internal variables necessary to convert from Event
 Workspace to MDEvent workspace
 @param WSD         -- the class describing the target MD workspace, sorurce
@@ -120,6 +138,34 @@ ConvToMDEventsWS::initialize(const MDWSDescription &WSD,
 
 void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
 
+  // if any property dimension is outside of the data range requested, the job
+  // is done;
+  if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
+    return;
+
+  // Boxes in memory are built as the events are added, which needs all the
+  // events of a box at hand. File backed boxes are split as they go, so that
+  // the events can be written out.
+  if (m_OutWSWrapper->pWorkspace()->getBoxController()->isFileBacked())
+    this->addEventsAndSplit(pProgress);
+  else
+    this->addEventsInBatches(pProgress);
+
+  // Recount totals at the end.
+  m_OutWSWrapper->pWorkspace()->refreshCache();
+  // m_OutWSWrapper->refreshCentroid();
+  pProgress->report();
+
+  /// Set the special coordinate system flag on the output workspace.
+  m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
+}
+
+/** Add the events spectrum by spectrum, splitting the boxes every time enough
+ * events have been added since the last split.
+ * @param pProgress :: progress reporter
+ */
+void ConvToMDEventsWS::addEventsAndSplit(API::Progress *pProgress) {
+
   // Get the box controller
   Mantid::API::BoxController_sptr bc =
       m_OutWSWrapper->pWorkspace()->getBoxController();
@@ -131,7 +177,7 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   size_t nValidSpectra = m_NSpectra;
 
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadScheduler *ts(nullptr);
 
   int nThreads(m_NumThreads);
   if (nThreads < 0)
@@ -142,7 +188,9 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
     runMultithreaded = true;
     // Create the thread pool that will run all of these. It will be deleted by
     // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
+    // Splitting a box creates tasks for its children, of very uneven cost, so
+    // let idle threads steal them.
+    ts = new Kernel::ThreadSchedulerWorkStealing(nThreads);
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
     pProgress->resetNumSteps(nValidSpectra, 0, 1);
@@ -150,11 +198,6 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   Kernel::ThreadPool tp(ts, nThreads, new API::Progress(*pProgress));
   //<<<--  Thread control stuff
 
-  // if any property dimension is outside of the data range requested, the job
-  // is done;
-  if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
-    return;
-
   size_t eventsAdded = 0;
   for (size_t wi = 0; wi < nValidSpectra; wi++) {
 
@@ -189,14 +232,84 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   } else {
     m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(nullptr);
   }
+}
 
-  // Recount totals at the end.
-  m_OutWSWrapper->pWorkspace()->refreshCache();
-  // m_OutWSWrapper->refreshCentroid();
-  pProgress->report();
+/** Convert the events in batches of spectra holding at least the "significant"
+ * number of events of the box controller, and add each batch in one pass
+ * which also splits the boxes (MDGridBox::addAndSplitEvents). Unlike
+ * splitting the boxes at intervals, no event is moved more than once per
+ * level of the box tree.
+ *
+ * The spectra of a batch are converted in parallel, each thread with its own
+ * copy of the MD transformation. The events are added in the order of the
+ * spectra, as in the serial conversion.
+ * @param pProgress :: progress reporter
+ */
+void ConvToMDEventsWS::addEventsInBatches(API::Progress *pProgress) {
+  const size_t batchSize = m_OutWSWrapper->pWorkspace()
+                               ->getBoxController()
+                               ->getSignificantEventsNumber();
+  const size_t nValidSpectra = m_NSpectra;
+  pProgress->resetNumSteps(nValidSpectra, 0, 1);
 
-  /// Set the special coordinate system flag on the output workspace.
-  m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
+  // The transformations hold the state of the spectrum they work on
+  const bool runMultithreaded = m_NumThreads != 0;
+  std::vector<std::unique_ptr<MDTransfInterface>> qConverters;
+  const int numConverters = runMultithreaded ? PARALLEL_GET_MAX_THREADS : 1;
+  for (int i = 0; i < numConverters; ++i)
+    qConverters.emplace_back(m_QConverter->clone());
+
+  size_t batchStart = 0;
+  while (batchStart < nValidSpectra) {
+    size_t batchEnd = batchStart;
+    size_t numEvents = 0;
+    while (batchEnd < nValidSpectra && numEvents < batchSize)
+      numEvents += m_EventWS->getSpectrum(batchEnd++).getNumberEvents();
+
+    std::vector<EventBuffer> buffers(batchEnd - batchStart);
+    std::exception_ptr error;
+    PARALLEL_FOR_IF(runMultithreaded)
+    for (int64_t i = 0; i < static_cast<int64_t>(buffers.size()); ++i) {
+      try {
+        const size_t wi = batchStart + static_cast<size_t>(i);
+        this->convertSpectrum(wi, *qConverters[PARALLEL_THREAD_NUMBER],
+                              buffers[i]);
+      } catch (...) {
+        PARALLEL_CRITICAL(ConvToMDEventsWS_addEventsInBatches) {
+          if (!error)
+            error = std::current_exception();
+        }
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+
+    EventBuffer batch;
+    size_t nConverted = 0;
+    for (const auto &buffer : buffers)
+      nConverted += buffer.runIndex.size();
+    batch.coord.reserve(this->m_NDims * nConverted);
+    batch.sigErr.reserve(2 * nConverted);
+    batch.runIndex.reserve(nConverted);
+    batch.detIDs.reserve(nConverted);
+    for (auto &buffer : buffers) {
+      batch.coord.insert(batch.coord.end(), buffer.coord.cbegin(),
+                         buffer.coord.cend());
+      batch.sigErr.insert(batch.sigErr.end(), buffer.sigErr.cbegin(),
+                          buffer.sigErr.cend());
+      batch.runIndex.insert(batch.runIndex.end(), buffer.runIndex.cbegin(),
+                            buffer.runIndex.cend());
+      batch.detIDs.insert(batch.detIDs.end(), buffer.detIDs.cbegin(),
+                          buffer.detIDs.cend());
+      buffer = EventBuffer();
+    }
+
+    m_OutWSWrapper->addAndSplitMDData(batch.sigErr, batch.runIndex,
+                                      batch.detIDs, batch.coord, nConverted,
+                                      m_NumThreads);
+    batchStart = batchEnd;
+    pProgress->report(batchEnd);
+  }
 }
 
 } // namespace MDAlgorithms
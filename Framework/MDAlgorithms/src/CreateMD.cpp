@@ -29,6 +29,8 @@ using Mantid::Kernel::Direction;
 static const std::string SPLITINTO("2");
 static const std::string SPLITTHRESHOLD("500");
 static const std::string MAXRECURSIONDEPTH("20");
+// Name of the run log holding the data source of the run
+static const std::string DATA_SOURCE_LOG("data_source");
 
 /*
  * Pad the vector of parameter values to the same size as data sources
@@ -82,6 +84,42 @@ bool all_given(const std::vector<std::vector<double>> &params) {
   return true;
 }
 
+/*
+ * Record the data source of each run of an MD workspace in a log of the run,
+ * so that the events of a data source can be found again from their run index.
+ * Nothing is recorded unless there is exactly one run per data source.
+ *
+ * @param ws :: the experiment infos of the workspace
+ * @param data_sources :: the data source of each run, in order
+ */
+void recordDataSources(MultipleExperimentInfos &ws,
+                       const std::vector<std::string> &data_sources) {
+  if (ws.getNumExperimentInfo() != data_sources.size())
+    return;
+  for (uint16_t i = 0; i < ws.getNumExperimentInfo(); ++i) {
+    ws.getExperimentInfo(i)->mutableRun().addProperty(DATA_SOURCE_LOG,
+                                                      data_sources[i], true);
+  }
+}
+
+/*
+ * Return the data source of each run of an MD workspace
+ *
+ * @param ws :: the experiment infos of the workspace
+ * @returns the data source recorded by recordDataSources for each run, or an
+ * empty string for a run without one
+ */
+std::vector<std::string>
+getRecordedDataSources(const MultipleExperimentInfos &ws) {
+  std::vector<std::string> data_sources(ws.getNumExperimentInfo());
+  for (uint16_t i = 0; i < ws.getNumExperimentInfo(); ++i) {
+    const Run &run = ws.getExperimentInfo(i)->run();
+    if (run.hasProperty(DATA_SOURCE_LOG))
+      data_sources[i] = run.getProperty(DATA_SOURCE_LOG)->value();
+  }
+  return data_sources;
+}
+
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(CreateMD)
 
@@ -269,6 +307,12 @@ void CreateMD::exec() {
         AnalysisDataService::Instance().retrieve(to_merge_names[0]);
   }
 
+  // Remember where each run came from so that AccumulateMD can remove it
+  auto md_workspace =
+      boost::dynamic_pointer_cast<IMDEventWorkspace>(output_workspace);
+  if (md_workspace)
+    recordDataSources(*md_workspace, data_sources);
+
   progress.report();
 
   // Clean up temporary workspaces
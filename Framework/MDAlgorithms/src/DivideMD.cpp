@@ -9,6 +9,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -119,7 +120,7 @@ void DivideMD::execEvent() {
 void DivideMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->divide(*operand);
+  MDHistoExpression(out).divide(operand).evaluateInPlace(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -127,7 +128,9 @@ void DivideMD::execHistoHisto(
 void DivideMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->divide(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression(out)
+      .divide(scalar->y(0)[0], scalar->e(0)[0])
+      .evaluateInPlace(*out);
 }
 
 } // namespace MDAlgorithms
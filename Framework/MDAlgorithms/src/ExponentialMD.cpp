@@ -5,6 +5,7 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/ExponentialMD.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -43,7 +44,7 @@ void ExponentialMD::execEvent(Mantid::API::IMDEventWorkspace_sptr /*out*/) {
 //----------------------------------------------------------------------------------------------
 /// ExponentialMD::Run the algorithm with a MDHistoWorkspace
 void ExponentialMD::execHisto(Mantid::DataObjects::MDHistoWorkspace_sptr out) {
-  out->exp();
+  Mantid::DataObjects::MDHistoExpression(out).exp().evaluateInPlace(*out);
 }
 
 } // namespace MDAlgorithms
@@ -20,6 +20,7 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/CoordTransformDistance.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDIntegrationRegion.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
@@ -295,6 +296,56 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // PRAGMA_OMP(parallel for schedule(dynamic, 10) )
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
+
+  // Get the peak centers as positions in the dimensions of the workspace
+  std::vector<V3D> positions(nPeaks);
+  std::vector<coord_t> lenQpeaks(nPeaks, 0.0);
+  for (int i = 0; i < nPeaks; ++i) {
+    const IPeak &p = peakWS->getPeak(i);
+    V3D &pos = positions[i];
+    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
+      pos = p.getQLabFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
+      pos = p.getQSampleFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
+      pos = p.getHKL();
+    // modulus of Q
+    if (adaptiveQMultiplier != 0.0) {
+      for (size_t d = 0; d < nd; d++) {
+        const auto coord = static_cast<coord_t>(pos[d]);
+        lenQpeaks[i] += coord * coord;
+      }
+      lenQpeaks[i] = std::sqrt(lenQpeaks[i]);
+    }
+  }
+
+  // Integrate the spheres and the background shells of all the peaks in one
+  // pass over the boxes: the sphere of peak i is region i and its shell is
+  // region nPeaks + i. Peaks off the edge of the detector are skipped below.
+  std::vector<signal_t> regionSignals, regionErrorsSquared;
+  if (!cylinderBool) {
+    std::vector<MDIntegrationRegion> spheres, shells;
+    spheres.reserve(2 * nPeaks);
+    for (int i = 0; i < nPeaks; ++i) {
+      std::vector<coord_t> center(nd);
+      for (size_t d = 0; d < nd; ++d)
+        center[d] = static_cast<coord_t>(positions[i][d]);
+      const coord_t lenQpeak = lenQpeaks[i];
+      const double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
+      spheres.push_back(MDIntegrationRegion::sphere(
+          center, std::max(adaptiveRadius, 0.0)));
+      if (BackgroundOuterRadius > PeakRadius)
+        shells.push_back(MDIntegrationRegion::sphere(
+            center, std::fabs(adaptiveQBackgroundMultiplier * lenQpeak +
+                              BackgroundOuterRadius),
+            std::fabs(adaptiveQBackgroundMultiplier * lenQpeak +
+                      BackgroundInnerRadius)));
+    }
+    spheres.insert(spheres.end(), shells.begin(), shells.end());
+    ws->integrateRegions(spheres, regionSignals, regionErrorsSquared,
+                         useOnePercentBackgroundCorrection);
+  }
+
   Progress progress(this, 0., 1., nPeaks);
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
@@ -303,15 +354,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
 
     // Get a direct ref to that peak.
     IPeak &p = peakWS->getPeak(i);
-
-    // Get the peak center as a position in the dimensions of the workspace
-    V3D pos;
-    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
-      pos = p.getQLabFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
-      pos = p.getQSampleFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
-      pos = p.getHKL();
+    const V3D &pos = positions[i];
 
     // Do not integrate if sphere is off edge of detector
 
@@ -344,14 +387,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     double background_total = 0.0;
     if (!cylinderBool) {
       // modulus of Q
-      coord_t lenQpeak = 0.0;
-      if (adaptiveQMultiplier != 0.0) {
-        lenQpeak = 0.0;
-        for (size_t d = 0; d < nd; d++) {
-          lenQpeak += center[d] * center[d];
-        }
-        lenQpeak = std::sqrt(lenQpeak);
-      }
+      const coord_t lenQpeak = lenQpeaks[i];
       double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
       if (adaptiveRadius <= 0.0) {
         g_log.error() << "Error: Radius for integration sphere of peak " << i
@@ -369,7 +405,6 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
       BackgroundOuterRadiusVector[i] =
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
 
       if (Peak *shapeablePeak = dynamic_cast<Peak *>(&p)) {
 
@@ -380,28 +415,16 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         shapeablePeak->setPeakShape(sphere);
       }
 
-      // Perform the integration into whatever box is contained within.
-      ws->getBox()->integrateSphere(
-          sphere, static_cast<coord_t>(adaptiveRadius * adaptiveRadius), signal,
-          errorSquared, 0.0 /* innerRadiusSquared */,
-          useOnePercentBackgroundCorrection);
+      // The integrated signal inside the peak radius
+      signal = regionSignals[i];
+      errorSquared = regionErrorsSquared[i];
 
       // Integrate around the background radius
 
       if (BackgroundOuterRadius > PeakRadius) {
-        // Get the total signal inside "BackgroundOuterRadius"
-        ws->getBox()->integrateSphere(
-            sphere,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius)),
-            bgSignal, bgErrorSquared,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius)),
-            useOnePercentBackgroundCorrection);
+        // The signal in the background shell
+        bgSignal = regionSignals[nPeaks + i];
+        bgErrorSquared = regionErrorsSquared[nPeaks + i];
 
         // Relative volume of peak vs the BackgroundOuterRadius sphere
         double ratio = (PeakRadius / BackgroundOuterRadius);
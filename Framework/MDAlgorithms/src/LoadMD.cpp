@@ -11,7 +11,9 @@
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/RegisterFileLoader.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/BoxControllerMappedIO.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
+#include "MantidDataObjects/BoxControllerQuantizedIO.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidDataObjects/MDEventFactory.h"
@@ -25,12 +27,17 @@
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MDUnit.h"
 #include "MantidKernel/MDUnitFactory.h"
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/System.h"
 #include "MantidMDAlgorithms/SetMDFrame.h"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/TemporaryFile.h>
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
 #include <iostream>
@@ -110,6 +117,21 @@ void LoadMD::init() {
   setPropertySettings("Memory", make_unique<EnabledWhenProperty>(
                                     "FileBackEnd", IS_EQUAL_TO, "1"));
 
+  declareProperty(
+      "FileBackEndFormat", "NeXus",
+      boost::make_shared<StringListValidator>(
+          std::vector<std::string>{"NeXus", "Mapped", "Quantized"}),
+      "For FileBackEnd only: NeXus reads the events from the loaded file on "
+      "demand. Mapped copies them to a scratch file in the default save "
+      "directory which is mapped into memory, giving faster random access to "
+      "the boxes. The scratch file is removed with the workspace. Quantized "
+      "keeps the events of the boxes out of the cache in memory, with their "
+      "coordinates rounded to 16 bits within each box, which takes a third "
+      "of the memory for unweighted 4D events.");
+  setPropertySettings(
+      "FileBackEndFormat",
+      make_unique<EnabledWhenProperty>("FileBackEnd", IS_EQUAL_TO, "1"));
+
   declareProperty("LoadHistory", true,
                   "If true, the workspace history will be loaded");
 
@@ -549,10 +571,23 @@ void LoadMD::doLoad(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // ---------------------------------------- DEAL WITH BOXES
   // ------------------------------------
   if (fileBackEnd) { // TODO:: call to the file format factory
-    auto loader = boost::shared_ptr<API::IBoxControllerIO>(
-        new DataObjects::BoxControllerNeXusIO(bc.get()));
-    loader->setDataType(sizeof(coord_t), MDE::getTypeName());
-    bc->setFileBacked(loader, m_filename);
+    boost::shared_ptr<API::IBoxControllerIO> loader;
+    const std::string format = getPropertyValue("FileBackEndFormat");
+    if (format == "Mapped") {
+      prog->report("Copying the events to a mapped file");
+      loader = createMappedFileBackEnd(bc.get(), MDE::getTypeName());
+      bc->setFileBacked(loader, loader->getFileName());
+    } else if (format == "Quantized") {
+      prog->report("Quantizing the events");
+      loader = createQuantizedBackEnd(bc.get(), MDE::getTypeName(),
+                                      FlatBoxTree.getEventIndex());
+      bc->setFileBacked(loader, loader->getFileName());
+    } else {
+      loader = boost::shared_ptr<API::IBoxControllerIO>(
+          new DataObjects::BoxControllerNeXusIO(bc.get()));
+      loader->setDataType(sizeof(coord_t), MDE::getTypeName());
+      bc->setFileBacked(loader, m_filename);
+    }
     // boxes have been already made file-backed when restoring the boxTree;
     // How much memory for the cache?
     {
@@ -626,6 +661,101 @@ void LoadMD::doLoad(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   g_log.debug() << tim << " to finish up.\n";
 }
 
+/**
+ * Copy the events of the loaded file to a new, uniquely named scratch file in
+ * the default save directory and map it into memory. The events keep their
+ * positions, so the file locations of the restored boxes stay valid.
+ * @param bc : the box controller of the loaded workspace
+ * @param eventType : the type name of the events in the file
+ * @return the opened IO of the scratch file, removing it when closed
+ */
+boost::shared_ptr<API::IBoxControllerIO>
+LoadMD::createMappedFileBackEnd(API::BoxController *bc,
+                                const std::string &eventType) {
+  DataObjects::BoxControllerNeXusIO nexusIO(bc);
+  nexusIO.setDataType(sizeof(coord_t), eventType);
+  nexusIO.openFile(m_filename, "r");
+
+  std::string scratchDir =
+      ConfigService::Instance().getString("defaultsave.directory");
+  if (scratchDir.empty())
+    scratchDir = Poco::Path::temp();
+  Poco::Path scratchPath(scratchDir);
+  scratchPath.makeDirectory();
+  // createFile() only succeeds for a file that did not exist, so every load
+  // owns its scratch file and never removes one another load is using
+  const std::string baseName = Poco::Path(m_filename).getBaseName();
+  do {
+    const Poco::Path uniqueName(Poco::TemporaryFile::tempName());
+    scratchPath.setFileName(baseName + "_" + uniqueName.getFileName() +
+                            ".mdevents");
+  } while (!Poco::File(scratchPath).createFile());
+
+  auto mappedIO = boost::make_shared<DataObjects::BoxControllerMappedIO>(bc);
+  mappedIO->setDataType(sizeof(coord_t), eventType);
+  mappedIO->setDeleteOnClose(true);
+  mappedIO->openFile(scratchPath.toString(), "w");
+
+  const uint64_t nEvents = nexusIO.getFileLength();
+  const uint64_t chunk = nexusIO.getDataChunk() * 100;
+  std::vector<coord_t> block;
+  for (uint64_t position = 0; position < nEvents; position += chunk) {
+    const auto nPoints =
+        static_cast<size_t>(std::min(chunk, nEvents - position));
+    block.clear();
+    nexusIO.loadBlock(block, position, nPoints);
+    mappedIO->saveBlock(block, position);
+  }
+  std::vector<uint64_t> freeSpace;
+  nexusIO.getFreeSpaceVector(freeSpace);
+  mappedIO->setFreeSpaceVector(freeSpace);
+  nexusIO.closeFile();
+  return mappedIO;
+}
+
+/**
+ * Copy the events of the loaded file, box by box, to a quantized store in
+ * memory. The events keep their positions, so the file locations of the
+ * restored boxes stay valid.
+ * @param bc : the box controller of the loaded workspace
+ * @param eventType : the type name of the events in the file
+ * @param eventIndex : the position and number of events of each box
+ * @return the opened quantized store
+ */
+boost::shared_ptr<API::IBoxControllerIO>
+LoadMD::createQuantizedBackEnd(API::BoxController *bc,
+                               const std::string &eventType,
+                               const std::vector<uint64_t> &eventIndex) {
+  DataObjects::BoxControllerNeXusIO nexusIO(bc);
+  nexusIO.setDataType(sizeof(coord_t), eventType);
+  nexusIO.openFile(m_filename, "r");
+
+  auto quantizedIO =
+      boost::make_shared<DataObjects::BoxControllerQuantizedIO>(bc);
+  quantizedIO->setDataType(sizeof(coord_t), eventType);
+  quantizedIO->openFile(m_filename, "w");
+
+  // Each box is quantized within its own extents
+  std::vector<coord_t> block;
+  for (size_t i = 0; i + 1 < eventIndex.size(); i += 2) {
+    if (eventIndex[i + 1] == 0)
+      continue;
+    block.clear();
+    nexusIO.loadBlock(block, eventIndex[i],
+                      static_cast<size_t>(eventIndex[i + 1]));
+    quantizedIO->saveBlock(block, eventIndex[i]);
+  }
+  quantizedIO->setFileLength(nexusIO.getFileLength());
+  std::vector<uint64_t> freeSpace;
+  nexusIO.getFreeSpaceVector(freeSpace);
+  quantizedIO->setFreeSpaceVector(freeSpace);
+  nexusIO.closeFile();
+  g_log.information() << "The quantized events take "
+                      << quantizedIO->getStoredBytes() / (1024 * 1024)
+                      << " MB of memory\n";
+  return quantizedIO;
+}
+
 /**
  * Load all of the affine matrices from the file, create the
  * appropriate coordinate transform and set those on the workspace.
@@ -5,6 +5,7 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/LogarithmMD.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -61,10 +62,12 @@ void LogarithmMD::execEvent(Mantid::API::IMDEventWorkspace_sptr /*out*/) {
 void LogarithmMD::execHisto(Mantid::DataObjects::MDHistoWorkspace_sptr out) {
   bool natural = getProperty("Natural");
   double filler = getProperty("Filler");
+  Mantid::DataObjects::MDHistoExpression expression(out);
   if (natural)
-    out->log(filler);
+    expression.log(filler);
   else
-    out->log10(filler);
+    expression.log10(filler);
+  expression.evaluateInPlace(*out);
 }
 
 } // namespace MDAlgorithms
@@ -6,9 +6,35 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/MDEventWSWrapper.h"
 #include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
+namespace {
+/** add the events to the workspace and split its boxes, filling the boxes
+ * with a thread pool unless nThreads is 0
+ *@param ws       -- the target workspace
+ *@param events   -- the events to add; they are reordered
+ *@param nThreads -- number of threads; negative for all cores, 0 for none
+ */
+template <typename MDE, size_t nd>
+void addEventsAndSplit(DataObjects::MDEventWorkspace<MDE, nd> &ws,
+                       std::vector<MDE> &events, int nThreads) {
+  if (nThreads == 0) {
+    ws.addEventsAndSplit(events, nullptr);
+    return;
+  }
+  const size_t numThreads = nThreads < 0 ? 0 : static_cast<size_t>(nThreads);
+  // Children of a box get very different numbers of events, so let idle
+  // threads steal the tasks. The pool deletes the scheduler.
+  auto ts = new Kernel::ThreadSchedulerWorkStealing(numThreads);
+  Kernel::ThreadPool tp(ts, numThreads);
+  ws.addEventsAndSplit(events, ts);
+  // The tasks refer to the events, so wait for them here
+  tp.joinAll();
+}
+} // namespace
 
 /** internal helper function to create empty MDEventWorkspace with nd dimensions
  and set up internal pointer to this workspace
@@ -126,6 +152,73 @@ void MDEventWSWrapper::addMDDataND<0>(float *, uint16_t *, uint32_t *,
                               "to 0-dimensional workspace"));
 }
 
+/** templated by number of dimensions function to add multidimensional data to
+the workspace, splitting the boxes which get too many events in the same pass
+* it is  expected that all MD coordinates are within the ranges of MD defined
+workspace, so no checks are performed
+
+   tempate parameter:
+     * nd -- number of dimensions
+
+*@param sigErr   -- pointer to the beginning of 2*data_size array containing
+signal and squared error
+*@param runIndex -- pointer to the beginning of data_size  containing run index
+*@param detId    -- pointer to the beginning of dataSize array containing
+detector id-s
+*@param Coord    -- pointer to the beginning of dataSize*nd array containing the
+coordinates of nd-dimensional events
+*@param dataSize -- the length of the vector of MD events
+*@param nThreads -- number of threads filling the boxes; negative for all
+cores, 0 to fill them serially
+*/
+template <size_t nd>
+void MDEventWSWrapper::addAndSplitMDDataND(float *sigErr, uint16_t *runIndex,
+                                           uint32_t *detId, coord_t *Coord,
+                                           size_t dataSize,
+                                           int nThreads) const {
+
+  DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
+      dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get());
+  if (pWs) {
+    std::vector<DataObjects::MDEvent<nd>> events;
+    events.reserve(dataSize);
+    for (size_t i = 0; i < dataSize; i++) {
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          *(runIndex + i), *(detId + i), (Coord + i * nd));
+    }
+    addEventsAndSplit(*pWs, events, nThreads);
+  } else {
+    DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd>
+        *const pLWs = dynamic_cast<
+            DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *>(
+            m_Workspace.get());
+
+    if (!pLWs)
+      throw std::runtime_error("Bad Cast: Target MD workspace to add events "
+                               "does not correspond to type of events you try "
+                               "to add to it");
+
+    std::vector<DataObjects::MDLeanEvent<nd>> events;
+    events.reserve(dataSize);
+    for (size_t i = 0; i < dataSize; i++) {
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          (Coord + i * nd));
+    }
+    addEventsAndSplit(*pLWs, events, nThreads);
+  }
+}
+
+/// the function used in template metaloop termination on 0 dimensions and to
+/// throw the error in attempt to add data to 0-dimension workspace
+template <>
+void MDEventWSWrapper::addAndSplitMDDataND<0>(float *, uint16_t *, uint32_t *,
+                                              coord_t *, size_t, int) const {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
 /***/
 template <size_t nd> void MDEventWSWrapper::splitBoxList() {
   DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
@@ -232,6 +325,36 @@ void MDEventWSWrapper::addMDData(std::vector<float> &sigErr,
                                              &detId[0], &Coord[0], dataSize);
 }
 
+/** method adds the data to the workspace which was initiated before and
+ * splits the boxes which get too many events, without a separate splitting
+ * pass. nPoints, signal and errors of the boxes have to be refreshed after
+ * all the data are added.
+ *@param sigErr   -- pointer to the beginning of 2*data_size array containing
+ *signal and squared error
+ *@param runIndex -- pointer to the beginnign of data_size  containing run index
+ *@param detId    -- pointer to the beginning of dataSize array containing
+ *detector id-s
+ *@param Coord    -- pointer to the beginning of dataSize*nd array containig the
+ *coordinates od nd-dimensional events
+ *@param dataSize -- the length of the vector of MD events
+ *@param nThreads -- number of threads filling the boxes; negative for all
+ *cores, 0 to fill them serially
+ */
+void MDEventWSWrapper::addAndSplitMDData(std::vector<float> &sigErr,
+                                         std::vector<uint16_t> &runIndex,
+                                         std::vector<uint32_t> &detId,
+                                         std::vector<coord_t> &Coord,
+                                         size_t dataSize,
+                                         int nThreads) const {
+
+  if (dataSize == 0)
+    return;
+  // perform the actual dimension-dependent addition
+  (this->*(mdEvAddAndSplit[m_NDimensions]))(&sigErr[0], &runIndex[0],
+                                            &detId[0], &Coord[0], dataSize,
+                                            nThreads);
+}
+
 /** method should be called at the end of the algorithm, to let the workspace
 manager know that it has whole responsibility for the workspace
 (As the algorithm is static, it will hold the pointer to the workspace
@@ -253,6 +376,7 @@ public:
     LOOP<i - 1>::EXEC(pH);
     pH->wsCreator[i] = &MDEventWSWrapper::createEmptyEventWS<i>;
     pH->mdEvAddAndForget[i] = &MDEventWSWrapper::addMDDataND<i>;
+    pH->mdEvAddAndSplit[i] = &MDEventWSWrapper::addAndSplitMDDataND<i>;
     pH->mdCalCentroid[i] = &MDEventWSWrapper::calcCentroidND<i>;
     pH->mdBoxListSplitter[i] = &MDEventWSWrapper::splitBoxList<i>;
   }
@@ -264,6 +388,7 @@ public:
   static inline void EXEC(MDEventWSWrapper *pH) {
     pH->wsCreator[0] = &MDEventWSWrapper::createEmptyEventWS<0>;
     pH->mdEvAddAndForget[0] = &MDEventWSWrapper::addMDDataND<0>;
+    pH->mdEvAddAndSplit[0] = &MDEventWSWrapper::addAndSplitMDDataND<0>;
     pH->mdCalCentroid[0] = &MDEventWSWrapper::calcCentroidND<0>;
     pH->mdBoxListSplitter[0] = &MDEventWSWrapper::splitBoxList<0>;
   }
@@ -274,6 +399,7 @@ MDEventWSWrapper::MDEventWSWrapper()
     : m_NDimensions(0), m_needSplitting(false) {
   wsCreator.resize(MAX_N_DIM + 1);
   mdEvAddAndForget.resize(MAX_N_DIM + 1);
+  mdEvAddAndSplit.resize(MAX_N_DIM + 1);
   mdCalCentroid.resize(MAX_N_DIM + 1);
   mdBoxListSplitter.resize(MAX_N_DIM + 1);
   LOOP<MAX_N_DIM>::EXEC(this);
@@ -28,6 +28,8 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
+#include "MantidMDAlgorithms/MDNormDetectorTable.h"
 #include <boost/lexical_cast.hpp>
 
 namespace Mantid {
@@ -205,6 +207,12 @@ void MDNorm::init() {
   declareProperty(make_unique<WorkspaceProperty<Workspace>>(
                       "OutputNormalizationWorkspace", "", Direction::Output),
                   "A name for the output normalization MDHistoWorkspace.");
+  declareProperty(
+      "ReuseDetectorTable", false,
+      "If true, keep the scattering angles, flux indices and solid angles of "
+      "the detectors in memory and reuse them in later runs with the same "
+      "instrument, detectors, masking, flux and solid angle workspaces. Only "
+      "the values of the latest setup are kept.");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -431,30 +439,29 @@ void MDNorm::exec() {
   this->setProperty("OutputDataWorkspace", outputDataWS);
 
   m_numExptInfos = outputDataWS->getNumExperimentInfo();
-  // loop over all experiment infos
+  // Find the experiment infos that contribute to the normalization. They are
+  // then processed together, for all the symmetry operations.
+  std::vector<uint16_t> expInfoIndices;
+  std::vector<std::vector<coord_t>> otherValues;
   for (uint16_t expInfoIndex = 0; expInfoIndex < m_numExptInfos;
        expInfoIndex++) {
     // Check for other dimensions if we could measure anything in the original
     // data
     bool skipNormalization = false;
-    const std::vector<coord_t> otherValues =
+    std::vector<coord_t> values =
         getValuesFromOtherDimensions(skipNormalization, expInfoIndex);
 
-    cacheDimensionXValues();
-
     if (!skipNormalization) {
-      size_t symmOpsIndex = 0;
-      for (const auto &so : symmetryOps) {
-        calculateNormalization(otherValues, so, expInfoIndex, symmOpsIndex);
-        symmOpsIndex++;
-      }
-
+      expInfoIndices.push_back(expInfoIndex);
+      otherValues.push_back(std::move(values));
     } else {
       g_log.warning("Binning limits are outside the limits of the MDWorkspace. "
                     "Not applying normalization.");
     }
-    // if more than one experiment info, keep accumulating
-    m_accumulate = true;
+  }
+  cacheDimensionXValues();
+  if (!expInfoIndices.empty()) {
+    calculateNormalization(expInfoIndices, otherValues, symmetryOps);
   }
   IAlgorithm_sptr divideMD = createChildAlgorithm("DivideMD", 0.99, 1.);
   divideMD->setProperty("LHSWorkspace", outputDataWS);
@@ -889,97 +896,120 @@ void MDNorm::cacheDimensionXValues() {
 
 /**
  * Computed the normalization for the input workspace. Results are stored in
- * m_normWS
- * @param otherValues - values for dimensions other than Q or DeltaE
- * @param so - symmetry operation
- * @param expInfoIndex - current experiment info index
- * @param soIndex - the index of symmetry operation (for progress purposes)
+ * m_normWS. The detectors of all the experiment infos and symmetry operations
+ * are processed in a single parallel loop, each thread accumulating into its
+ * own buffer.
+ * @param expInfoIndices - indices of the experiment infos to include
+ * @param otherValues - values for dimensions other than Q or DeltaE, for each
+ * of the experiment infos
+ * @param symmetryOps - symmetry operations
  */
-void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
-                                    Geometry::SymmetryOperation so,
-                                    uint16_t expInfoIndex, size_t soIndex) {
-  const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
-  std::vector<double> lowValues, highValues;
-  auto *lowValuesLog = dynamic_cast<VectorDoubleProperty *>(
-      currentExptInfo.getLog("MDNorm_low"));
-  lowValues = (*lowValuesLog)();
-  auto *highValuesLog = dynamic_cast<VectorDoubleProperty *>(
-      currentExptInfo.getLog("MDNorm_high"));
-  highValues = (*highValuesLog)();
-
-  DblMatrix R = currentExptInfo.run().getGoniometerMatrix();
-  DblMatrix soMatrix(3, 3);
-  auto v = so.transformHKL(V3D(1, 0, 0));
-  soMatrix.setColumn(0, v);
-  v = so.transformHKL(V3D(0, 1, 0));
-  soMatrix.setColumn(1, v);
-  v = so.transformHKL(V3D(0, 0, 1));
-  soMatrix.setColumn(2, v);
-  soMatrix.Invert();
-  DblMatrix Qtransform = R * m_UB * soMatrix * m_W;
-  Qtransform.Invert();
-  const double protonCharge = currentExptInfo.run().getProtonCharge();
-  const auto &spectrumInfo = currentExptInfo.spectrumInfo();
-
-  // Mappings
-  const int64_t ndets = static_cast<int64_t>(spectrumInfo.size());
-  detid2index_map fluxDetToIdx;
-  detid2index_map solidAngDetToIdx;
-  bool haveSA = false;
+void MDNorm::calculateNormalization(
+    const std::vector<uint16_t> &expInfoIndices,
+    const std::vector<std::vector<coord_t>> &otherValues,
+    const std::vector<Geometry::SymmetryOperation> &symmetryOps) {
   API::MatrixWorkspace_const_sptr solidAngleWS =
       getProperty("SolidAngleWorkspace");
   API::MatrixWorkspace_const_sptr integrFlux = getProperty("FluxWorkspace");
-  if (solidAngleWS != nullptr) {
-    haveSA = true;
-    solidAngDetToIdx = solidAngleWS->getDetectorIDToWorkspaceIndexMap();
+
+  // The inverse of the symmetry operations
+  std::vector<DblMatrix> soMatrices;
+  soMatrices.reserve(symmetryOps.size());
+  for (const auto &so : symmetryOps) {
+    DblMatrix soMatrix(3, 3);
+    auto v = so.transformHKL(V3D(1, 0, 0));
+    soMatrix.setColumn(0, v);
+    v = so.transformHKL(V3D(0, 1, 0));
+    soMatrix.setColumn(1, v);
+    v = so.transformHKL(V3D(0, 0, 1));
+    soMatrix.setColumn(2, v);
+    soMatrix.Invert();
+    soMatrices.push_back(soMatrix);
   }
-  if (m_diffraction) {
-    fluxDetToIdx = integrFlux->getDetectorIDToWorkspaceIndexMap();
+
+  // The goniometer dependent quantities of each experiment info. The detector
+  // table is shared by consecutive experiment infos with the same instrument.
+  const size_t nRuns = expInfoIndices.size();
+  std::vector<const std::vector<double> *> lowValues(nRuns), highValues(nRuns);
+  std::vector<DblMatrix> Qtransforms;
+  Qtransforms.reserve(nRuns * m_numSymmOps);
+  std::vector<double> protonCharges(nRuns);
+  std::vector<boost::shared_ptr<const MDNormDetectorTable>> detectorTables(
+      nRuns);
+  const bool reuse = getProperty("ReuseDetectorTable");
+  size_t nSpectra = 0;
+  for (size_t run = 0; run < nRuns; ++run) {
+    const auto &currentExptInfo =
+        *(m_inputWS->getExperimentInfo(expInfoIndices[run]));
+    auto *lowValuesLog = dynamic_cast<VectorDoubleProperty *>(
+        currentExptInfo.getLog("MDNorm_low"));
+    auto *highValuesLog = dynamic_cast<VectorDoubleProperty *>(
+        currentExptInfo.getLog("MDNorm_high"));
+    if (!lowValuesLog || !highValuesLog) {
+      throw std::runtime_error("Workspace does not contain the MDNorm_low and "
+                               "MDNorm_high logs. Cannot continue.");
+    }
+    lowValues[run] = &(*lowValuesLog)();
+    highValues[run] = &(*highValuesLog)();
+
+    const DblMatrix R = currentExptInfo.run().getGoniometerMatrix();
+    for (const auto &soMatrix : soMatrices) {
+      DblMatrix Qtransform = R * m_UB * soMatrix * m_W;
+      Qtransform.Invert();
+      Qtransforms.push_back(Qtransform);
+    }
+    protonCharges[run] = currentExptInfo.run().getProtonCharge();
+
+    if (run > 0 && detectorTables[run - 1]->isValidFor(currentExptInfo)) {
+      detectorTables[run] = detectorTables[run - 1];
+    } else {
+      detectorTables[run] = MDNormDetectorTable::create(
+          currentExptInfo, m_samplePos, m_beamDir,
+          m_diffraction ? integrFlux.get() : nullptr, solidAngleWS.get(),
+          reuse);
+    }
+    nSpectra = std::max(nSpectra, detectorTables[run]->size());
   }
 
   const size_t vmdDims = (m_diffraction) ? 3 : 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  MDNormAccumulator accumulator(m_normWS->getNPoints());
   std::vector<std::array<double, 4>> intersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
 
-  double progStep = 0.7 / static_cast<double>(m_numExptInfos * m_numSymmOps);
-  double progIndex = static_cast<double>(soIndex + expInfoIndex * m_numSymmOps);
-  auto prog =
-      make_unique<API::Progress>(this, 0.3 + progStep * progIndex,
-                                 0.3 + progStep * (1. + progIndex), ndets);
+  // one iteration per spectrum of each experiment info and symmetry operation
+  const int64_t nSpectraPerTransform = static_cast<int64_t>(nSpectra);
+  const int64_t nIterations =
+      static_cast<int64_t>(Qtransforms.size()) * nSpectraPerTransform;
+  auto prog = make_unique<API::Progress>(this, 0.3, 1.0, nIterations);
 
   bool safe = true;
   if (m_diffraction) {
     safe = Kernel::threadSafe(*integrFlux);
   }
   // cppcheck-suppress syntaxError
-PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (safe))
-for (int64_t i = 0; i < ndets; i++) {
+PRAGMA_OMP(parallel for num_threads(accumulator.numberOfThreads()) private(intersections, xValues, yValues, pos, posNew) if (safe))
+for (int64_t i = 0; i < nIterations; i++) {
   PARALLEL_START_INTERUPT_REGION
 
-  if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) ||
-      spectrumInfo.isMasked(i)) {
+  const size_t transform = static_cast<size_t>(i / nSpectraPerTransform);
+  const size_t run = transform / m_numSymmOps;
+  const size_t spectrum = static_cast<size_t>(i % nSpectraPerTransform);
+  const auto &detectorTable = *detectorTables[run];
+  if (spectrum >= detectorTable.size() || !detectorTable[spectrum].use) {
     continue;
   }
-
-  const auto &detector = spectrumInfo.detector(i);
-  double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
-  double phi = detector.getPhi();
-  // If the dtefctor is a group, this should be the ID of the first detector
-  const auto detID = detector.getID();
+  const auto &detector = detectorTable[spectrum];
 
   // Intersections
-  this->calculateIntersections(intersections, theta, phi, Qtransform,
-                               lowValues[i], highValues[i]);
+  this->calculateIntersections(intersections, detector.theta, detector.phi,
+                               Qtransforms[transform],
+                               (*lowValues[run])[spectrum],
+                               (*highValues[run])[spectrum]);
   if (intersections.empty())
     continue;
   // Get solid angle for this contribution
-  double solid = protonCharge;
-  if (haveSA) {
-    solid =
-        solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0] * protonCharge;
-  }
+  double solid = detector.solidAngle * protonCharges[run];
 
   if (m_diffraction) {
     // -- calculate integrals for the intersection --
@@ -992,19 +1022,21 @@ for (int64_t i = 0; i < ndets; i++) {
     for (auto it = intersectionsBegin; it != intersections.end(); ++it, ++x) {
       *x = (*it)[3];
     }
-    // get the flux spetrum number
-    size_t wsIdx = fluxDetToIdx.find(detID)->second;
     // calculate integrals at momenta from xValues by interpolating between
-    // points in spectrum sp
+    // points in the flux spectrum of the detector
     // of workspace integrFlux. The result is stored in yValues
-    calcIntegralsForIntersections(xValues, *integrFlux, wsIdx, yValues);
+    calcIntegralsForIntersections(xValues, *integrFlux, detector.fluxIndex,
+                                  yValues);
   }
 
   // Compute final position in HKL
   // pre-allocate for efficiency and copy non-hkl dim values into place
-  pos.resize(vmdDims + otherValues.size());
-  std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims);
+  const auto &runOtherValues = otherValues[run];
+  pos.resize(vmdDims + runOtherValues.size());
+  std::copy(runOtherValues.begin(), runOtherValues.end(),
+            pos.begin() + vmdDims);
 
+  const int thread = PARALLEL_THREAD_NUMBER;
   auto intersectionsBegin = intersections.begin();
   for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
     const auto &curIntSec = *it;
@@ -1044,8 +1076,7 @@ for (int64_t i = 0; i < ndets; i++) {
     size_t linIndex = m_normWS->getLinearIndexAtCoord(posNew.data());
     if (linIndex == size_t(-1))
       continue;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    accumulator.add(thread, linIndex, signal);
   }
 
   prog->report();
@@ -1053,15 +1084,7 @@ for (int64_t i = 0; i < ndets; i++) {
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->getSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-} else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->getSignalArray());
-}
+accumulator.addTo(m_normWS->getSignalArray(), m_accumulate);
 m_accumulate = true;
 }
 
@@ -1077,8 +1100,8 @@ m_accumulate = true;
  */
 void MDNorm::calculateIntersections(
     std::vector<std::array<double, 4>> &intersections, const double theta,
-    const double phi, Kernel::DblMatrix transform, double lowvalue,
-    double highvalue) {
+    const double phi, const Kernel::DblMatrix &transform, double lowvalue,
+    double highvalue) const {
   V3D qout(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta)),
       qin(0., 0., 1);
 
@@ -1221,7 +1244,7 @@ void MDNorm::calculateIntersections(
  */
 void MDNorm::calcIntegralsForIntersections(
     const std::vector<double> &xValues, const API::MatrixWorkspace &integrFlux,
-    size_t sp, std::vector<double> &yValues) {
+    size_t sp, std::vector<double> &yValues) const {
   assert(xValues.size() == yValues.size());
 
   // the x-data from the workspace
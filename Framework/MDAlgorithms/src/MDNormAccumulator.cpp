@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
+#include "MantidKernel/Memory.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/**
+ * Choose between per-thread buffers and a shared array for a workspace of the
+ * given size. The buffers of all threads together may use at most
+ * maxBufferMemory or a quarter of the free memory, whichever is less.
+ * @param nPoints :: The number of bins of the normalization workspace
+ * @param maxBufferMemory :: The most memory, in kB, that the buffers of all
+ * threads may use together
+ */
+MDNormAccumulator::MDNormAccumulator(const size_t nPoints,
+                                     const size_t maxBufferMemory)
+    : m_nPoints(nPoints), m_nThreads(PARALLEL_GET_MAX_THREADS) {
+  const Kernel::MemoryStats memoryStats;
+  const size_t freeMemory = memoryStats.availMem(); // in kB
+  const size_t bufferCost = nPoints * sizeof(signal_t) / 1024 + 1;
+  const size_t budget = std::min(maxBufferMemory, freeMemory / 4);
+  const auto nThreads = static_cast<size_t>(m_nThreads);
+  if (nThreads == 1 || nThreads <= budget / bufferCost)
+    m_buffers.resize(nThreads);
+  else
+    m_shared = std::vector<std::atomic<signal_t>>(nPoints);
+}
+
+/**
+ * Sum the contributions of all threads into a signal array
+ * @param signal :: The signal array, with as many bins as the workspace
+ * @param accumulate :: If true the sum is added to the signal, otherwise it
+ * replaces it
+ */
+void MDNormAccumulator::addTo(signal_t *signal, const bool accumulate) const {
+  const int64_t nPoints = static_cast<int64_t>(m_nPoints);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < nPoints; ++i) {
+    signal_t sum = accumulate ? signal[i] : 0.;
+    if (!m_shared.empty())
+      sum += m_shared[i];
+    for (const auto &buffer : m_buffers) {
+      if (!buffer.empty())
+        sum += buffer[i];
+    }
+    signal[i] = sum;
+  }
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -0,0 +1,232 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidMDAlgorithms/MDNormDetectorTable.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <boost/make_shared.hpp>
+
+#include <mutex>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+namespace {
+/// Guards the table kept for later executions
+std::mutex g_tableCacheMutex;
+
+/// Append the number of detector IDs and the IDs of each spectrum
+void appendDetectorIDs(const API::MatrixWorkspace &ws,
+                       std::vector<double> &geometry) {
+  for (size_t i = 0; i < ws.getNumberHistograms(); ++i) {
+    const auto &detIDs = ws.getSpectrum(i).getDetectorIDs();
+    geometry.push_back(static_cast<double>(detIDs.size()));
+    geometry.insert(geometry.end(), detIDs.begin(), detIDs.end());
+  }
+}
+} // namespace
+
+/**
+ * Build the table for all spectra of an experiment info
+ * @param exptInfo :: The experiment info with the detectors
+ * @param samplePos :: The position of the sample
+ * @param beamDir :: The unit vector along the beam
+ * @param fluxWS :: The workspace with the integrated flux, or nullptr if the
+ * flux is not needed
+ * @param solidAngleWS :: The workspace with the solid angles, or nullptr for a
+ * solid angle of 1 for every detector
+ */
+MDNormDetectorTable::MDNormDetectorTable(
+    const API::ExperimentInfo &exptInfo, const Kernel::V3D &samplePos,
+    const Kernel::V3D &beamDir, const API::MatrixWorkspace *fluxWS,
+    const API::MatrixWorkspace *solidAngleWS)
+    : m_detectorInfo(exptInfo.detectorInfo()),
+      m_spectrumDefinitions(
+          exptInfo.spectrumInfo().sharedSpectrumDefinitions()),
+      m_entries(exptInfo.spectrumInfo().size()) {
+  const auto &spectrumInfo = exptInfo.spectrumInfo();
+  detid2index_map fluxDetToIdx, solidAngDetToIdx;
+  if (fluxWS)
+    fluxDetToIdx = fluxWS->getDetectorIDToWorkspaceIndexMap();
+  if (solidAngleWS)
+    solidAngDetToIdx = solidAngleWS->getDetectorIDToWorkspaceIndexMap();
+
+  const int64_t nSpectra = static_cast<int64_t>(m_entries.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < nSpectra; ++i) {
+    auto &entry = m_entries[i];
+    entry.use = false;
+    entry.theta = 0.;
+    entry.phi = 0.;
+    entry.fluxIndex = 0;
+    entry.solidAngle = 1.;
+    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) ||
+        spectrumInfo.isMasked(i)) {
+      continue;
+    }
+    const auto &detector = spectrumInfo.detector(i);
+    // If the detector is a group, this is the ID of the first detector
+    const auto detID = detector.getID();
+    if (fluxWS) {
+      const auto fluxIt = fluxDetToIdx.find(detID);
+      if (fluxIt == fluxDetToIdx.end())
+        continue;
+      entry.fluxIndex = fluxIt->second;
+    }
+    if (solidAngleWS) {
+      const auto solidAngIt = solidAngDetToIdx.find(detID);
+      if (solidAngIt == solidAngDetToIdx.end())
+        continue;
+      entry.solidAngle = solidAngleWS->y(solidAngIt->second)[0];
+    }
+    entry.theta = detector.getTwoTheta(samplePos, beamDir);
+    entry.phi = detector.getPhi();
+    entry.use = true;
+  }
+}
+
+/**
+ * Make a table of known entries for an experiment info
+ * @param exptInfo :: The experiment info the entries are valid for
+ * @param entries :: One entry per spectrum
+ */
+MDNormDetectorTable::MDNormDetectorTable(const API::ExperimentInfo &exptInfo,
+                                         std::vector<Entry> entries)
+    : m_detectorInfo(exptInfo.detectorInfo()),
+      m_spectrumDefinitions(
+          exptInfo.spectrumInfo().sharedSpectrumDefinitions()),
+      m_entries(std::move(entries)) {}
+
+/**
+ * Build the table for all spectra of an experiment info, or take the entries
+ * from the table of an earlier execution with the same setup
+ * @param exptInfo :: The experiment info with the detectors
+ * @param samplePos :: The position of the sample
+ * @param beamDir :: The unit vector along the beam
+ * @param fluxWS :: The workspace with the integrated flux, or nullptr if the
+ * flux is not needed
+ * @param solidAngleWS :: The workspace with the solid angles, or nullptr for a
+ * solid angle of 1 for every detector
+ * @param reuse :: If true, reuse the entries of the table kept by an earlier
+ * execution if they match and keep the new table otherwise
+ * @return The table
+ */
+boost::shared_ptr<const MDNormDetectorTable> MDNormDetectorTable::create(
+    const API::ExperimentInfo &exptInfo, const Kernel::V3D &samplePos,
+    const Kernel::V3D &beamDir, const API::MatrixWorkspace *fluxWS,
+    const API::MatrixWorkspace *solidAngleWS, const bool reuse) {
+  // The position of a scanning detector depends on the time index
+  if (!reuse || exptInfo.detectorInfo().isScanning())
+    return boost::make_shared<const MDNormDetectorTable>(
+        exptInfo, samplePos, beamDir, fluxWS, solidAngleWS);
+
+  const std::string instrument = exptInfo.getInstrument()->getName();
+  auto geometry =
+      cacheGeometry(exptInfo, samplePos, beamDir, fluxWS, solidAngleWS);
+  {
+    std::lock_guard<std::mutex> lock(g_tableCacheMutex);
+    const auto &cache = tableCache();
+    if (cache && cache->instrument == instrument &&
+        cache->geometry == geometry)
+      return boost::shared_ptr<const MDNormDetectorTable>(
+          new MDNormDetectorTable(exptInfo, cache->entries));
+  }
+
+  auto table = boost::make_shared<const MDNormDetectorTable>(
+      exptInfo, samplePos, beamDir, fluxWS, solidAngleWS);
+  auto cached = boost::make_shared<CachedEntries>();
+  cached->instrument = instrument;
+  cached->geometry = std::move(geometry);
+  cached->entries = table->m_entries;
+  std::lock_guard<std::mutex> lock(g_tableCacheMutex);
+  tableCache() = cached;
+  return table;
+}
+
+/**
+ * Get everything the entries of a table depend on, apart from the name of the
+ * instrument: the sample position and beam direction, the masking and position
+ * of every detector, the detectors of every spectrum and the detector IDs of
+ * the flux and solid angle workspaces with the solid angles.
+ * @param exptInfo :: The experiment info with the detectors
+ * @param samplePos :: The position of the sample
+ * @param beamDir :: The unit vector along the beam
+ * @param fluxWS :: The workspace with the integrated flux, or nullptr
+ * @param solidAngleWS :: The workspace with the solid angles, or nullptr
+ * @return The values, in a flat vector
+ */
+std::vector<double> MDNormDetectorTable::cacheGeometry(
+    const API::ExperimentInfo &exptInfo, const Kernel::V3D &samplePos,
+    const Kernel::V3D &beamDir, const API::MatrixWorkspace *fluxWS,
+    const API::MatrixWorkspace *solidAngleWS) {
+  const auto &detectorInfo = exptInfo.detectorInfo();
+  const auto &spectrumInfo = exptInfo.spectrumInfo();
+  std::vector<double> geometry{samplePos.X(), samplePos.Y(), samplePos.Z(),
+                               beamDir.X(),   beamDir.Y(),   beamDir.Z()};
+  geometry.reserve(5 * detectorInfo.size() + 4 * spectrumInfo.size());
+  for (size_t i = 0; i < detectorInfo.size(); ++i) {
+    const auto position = detectorInfo.position(i);
+    geometry.push_back(detectorInfo.isMonitor(i) ? 1.0 : 0.0);
+    geometry.push_back(detectorInfo.isMasked(i) ? 1.0 : 0.0);
+    geometry.push_back(position.X());
+    geometry.push_back(position.Y());
+    geometry.push_back(position.Z());
+  }
+  for (size_t i = 0; i < spectrumInfo.size(); ++i) {
+    const auto &definition = spectrumInfo.spectrumDefinition(i);
+    geometry.push_back(static_cast<double>(definition.size()));
+    for (const auto &index : definition)
+      geometry.push_back(static_cast<double>(index.first));
+  }
+  // The number of spectra, or -1 without a workspace
+  geometry.push_back(
+      fluxWS ? static_cast<double>(fluxWS->getNumberHistograms()) : -1.);
+  if (fluxWS)
+    appendDetectorIDs(*fluxWS, geometry);
+  geometry.push_back(solidAngleWS ? static_cast<double>(
+                                        solidAngleWS->getNumberHistograms())
+                                  : -1.);
+  if (solidAngleWS) {
+    appendDetectorIDs(*solidAngleWS, geometry);
+    for (size_t i = 0; i < solidAngleWS->getNumberHistograms(); ++i)
+      geometry.push_back(solidAngleWS->y(i)[0]);
+  }
+  return geometry;
+}
+
+/**
+ * The entries kept for later executions, guarded by g_tableCacheMutex
+ * @return A reference to the kept entries, which may be null
+ */
+boost::shared_ptr<const MDNormDetectorTable::CachedEntries> &
+MDNormDetectorTable::tableCache() {
+  static boost::shared_ptr<const CachedEntries> cache;
+  return cache;
+}
+
+/**
+ * Check whether the table can be used for another experiment info.
+ * @param exptInfo :: An experiment info
+ * @return True if the experiment info has the same detector positions, masking
+ * and spectrum to detector mapping as the one the table was built from
+ */
+bool MDNormDetectorTable::isValidFor(
+    const API::ExperimentInfo &exptInfo) const {
+  const auto &definitions =
+      exptInfo.spectrumInfo().sharedSpectrumDefinitions();
+  if (definitions != m_spectrumDefinitions &&
+      !(*definitions == *m_spectrumDefinitions))
+    return false;
+  return m_detectorInfo.isEquivalent(exptInfo.detectorInfo());
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
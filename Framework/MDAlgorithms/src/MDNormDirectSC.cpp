@@ -21,6 +21,8 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
+#include "MantidMDAlgorithms/MDNormDetectorTable.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -50,8 +52,8 @@ MDNormDirectSC::MDNormDirectSC()
       m_kmax(0.0f), m_lmin(0.0f), m_lmax(0.0f), m_dEmin(0.f), m_dEmax(0.f),
       m_Ei(0.), m_ki(0.), m_kfmin(0.), m_kfmax(0.), m_hIntegrated(true),
       m_kIntegrated(true), m_lIntegrated(true), m_dEIntegrated(true),
-      m_rubw(3, 3), m_hIdx(-1), m_kIdx(-1), m_lIdx(-1), m_eIdx(-1), m_hX(),
-      m_kX(), m_lX(), m_eX(), m_samplePos(), m_beamDir() {}
+      m_hIdx(-1), m_kIdx(-1), m_lIdx(-1), m_eIdx(-1), m_hX(), m_kX(), m_lX(),
+      m_eX(), m_samplePos(), m_beamDir() {}
 
 /// Algorithm's version for identification. @see Algorithm::version
 int MDNormDirectSC::version() const { return 1; }
@@ -132,6 +134,12 @@ void MDNormDirectSC::init() {
   declareProperty(make_unique<WorkspaceProperty<Workspace>>(
                       "OutputNormalizationWorkspace", "", Direction::Output),
                   "A name for the output normalization MDHistoWorkspace.");
+  declareProperty(
+      "ReuseDetectorTable", false,
+      "If true, keep the scattering angles and solid angles of the detectors "
+      "in memory and reuse them in later runs with the same instrument, "
+      "detectors, masking and solid angle workspace. Only the values of the "
+      "latest setup are kept.");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -149,26 +157,31 @@ void MDNormDirectSC::exec() {
   setProperty("OutputNormalizationWorkspace", m_normWS);
 
   m_numExptInfos = outputWS->getNumExperimentInfo();
-  // loop over all experiment infos
+  // Find the experiment infos that contribute to the normalization. They are
+  // then processed together.
+  std::vector<uint16_t> expInfoIndices;
+  std::vector<std::vector<coord_t>> otherValues;
+  Kernel::Matrix<coord_t> affineTrans;
   for (uint16_t expInfoIndex = 0; expInfoIndex < m_numExptInfos;
        expInfoIndex++) {
     // Check for other dimensions if we could measure anything in the original
     // data
     bool skipNormalization = false;
-    const std::vector<coord_t> otherValues =
+    std::vector<coord_t> values =
         getValuesFromOtherDimensions(skipNormalization, expInfoIndex);
-    const auto affineTrans =
-        findIntergratedDimensions(otherValues, skipNormalization);
-    cacheDimensionXValues();
+    affineTrans = findIntergratedDimensions(values, skipNormalization);
 
     if (!skipNormalization) {
-      calculateNormalization(otherValues, affineTrans, expInfoIndex);
+      expInfoIndices.push_back(expInfoIndex);
+      otherValues.push_back(std::move(values));
     } else {
       g_log.warning("Binning limits are outside the limits of the MDWorkspace. "
                     "Not applying normalization.");
     }
-    // if more than one experiment info, keep accumulating
-    m_accumulate = true;
+  }
+  cacheDimensionXValues();
+  if (!expInfoIndices.empty()) {
+    calculateNormalization(expInfoIndices, otherValues, affineTrans);
   }
 
   // Set the display normalization based on the input workspace
@@ -278,7 +291,8 @@ MDHistoWorkspace_sptr MDNormDirectSC::binInputWS() {
     if (propName != "SolidAngleWorkspace" &&
         propName != "TemporaryNormalizationWorkspace" &&
         propName != "OutputNormalizationWorkspace" &&
-        propName != "SkipSafetyCheck") {
+        propName != "SkipSafetyCheck" &&
+        propName != "ReuseDetectorTable") {
       binMD->setPropertyValue(propName, prop->value());
     }
   }
@@ -454,86 +468,97 @@ void MDNormDirectSC::cacheDimensionXValues() {
 
 /**
  * Computed the normalization for the input workspace. Results are stored in
- * m_normWS
- * @param otherValues non HKLE dimensions
+ * m_normWS. The detectors of all the experiment infos are processed in a
+ * single parallel loop, each thread accumulating into its own buffer.
+ * @param expInfoIndices indices of the experiment infos to include
+ * @param otherValues non HKLE dimensions for each of them
  * @param affineTrans affine matrix
- * @param expInfoIndex current experiment info index
  */
 void MDNormDirectSC::calculateNormalization(
-    const std::vector<coord_t> &otherValues,
-    const Kernel::Matrix<coord_t> &affineTrans, uint16_t expInfoIndex) {
+    const std::vector<uint16_t> &expInfoIndices,
+    const std::vector<std::vector<coord_t>> &otherValues,
+    const Kernel::Matrix<coord_t> &affineTrans) {
   constexpr double energyToK = 8.0 * M_PI * M_PI *
                                PhysicalConstants::NeutronMass *
                                PhysicalConstants::meV * 1e-20 /
                                (PhysicalConstants::h * PhysicalConstants::h);
-  const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
-  using VectorDoubleProperty = Kernel::PropertyWithValue<std::vector<double>>;
-  auto *rubwLog = dynamic_cast<VectorDoubleProperty *>(
-      currentExptInfo.getLog("RUBW_MATRIX"));
-  if (!rubwLog) {
-    throw std::runtime_error(
-        "Wokspace does not contain a log entry for the RUBW matrix."
-        "Cannot continue.");
-  } else {
-    Kernel::DblMatrix rubwValue(
-        (*rubwLog)()); // includes the 2*pi factor but not goniometer for now :)
-    m_rubw = currentExptInfo.run().getGoniometerMatrix() * rubwValue;
-    m_rubw.Invert();
-  }
-  const double protonCharge = currentExptInfo.run().getProtonCharge();
-
-  const auto &spectrumInfo = currentExptInfo.spectrumInfo();
-
-  // Mapping
-  const int64_t ndets = static_cast<int64_t>(spectrumInfo.size());
-  bool haveSA = false;
   API::MatrixWorkspace_const_sptr solidAngleWS =
       getProperty("SolidAngleWorkspace");
-  detid2index_map solidAngDetToIdx;
-  if (solidAngleWS != nullptr) {
-    haveSA = true;
-    solidAngDetToIdx = solidAngleWS->getDetectorIDToWorkspaceIndexMap();
+
+  // The goniometer dependent quantities of each experiment info. The detector
+  // table is shared by consecutive experiment infos with the same instrument.
+  const size_t nRuns = expInfoIndices.size();
+  std::vector<Kernel::DblMatrix> rubw(nRuns);
+  std::vector<double> protonCharges(nRuns);
+  std::vector<boost::shared_ptr<const MDNormDetectorTable>> detectorTables(
+      nRuns);
+  const bool reuse = getProperty("ReuseDetectorTable");
+  size_t nSpectra = 0;
+  for (size_t run = 0; run < nRuns; ++run) {
+    const auto &currentExptInfo =
+        *(m_inputWS->getExperimentInfo(expInfoIndices[run]));
+    using VectorDoubleProperty = Kernel::PropertyWithValue<std::vector<double>>;
+    auto *rubwLog = dynamic_cast<VectorDoubleProperty *>(
+        currentExptInfo.getLog("RUBW_MATRIX"));
+    if (!rubwLog) {
+      throw std::runtime_error(
+          "Wokspace does not contain a log entry for the RUBW matrix."
+          "Cannot continue.");
+    } else {
+      Kernel::DblMatrix rubwValue(
+          (*rubwLog)()); // includes the 2*pi factor but not goniometer for now
+      rubw[run] = currentExptInfo.run().getGoniometerMatrix() * rubwValue;
+      rubw[run].Invert();
+    }
+    protonCharges[run] = currentExptInfo.run().getProtonCharge();
+
+    if (run > 0 && detectorTables[run - 1]->isValidFor(currentExptInfo)) {
+      detectorTables[run] = detectorTables[run - 1];
+    } else {
+      detectorTables[run] = MDNormDetectorTable::create(
+          currentExptInfo, m_samplePos, m_beamDir, nullptr,
+          solidAngleWS.get(), reuse);
+    }
+    nSpectra = std::max(nSpectra, detectorTables[run]->size());
   }
 
   const size_t vmdDims = 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  MDNormAccumulator accumulator(m_normWS->getNPoints());
   std::vector<std::array<double, 4>> intersections;
   std::vector<coord_t> pos, posNew;
-  double progStep = 0.7 / m_numExptInfos;
-  auto prog =
-      make_unique<API::Progress>(this, 0.3 + progStep * expInfoIndex,
-                                 0.3 + progStep * (expInfoIndex + 1.), ndets);
+  // one iteration per spectrum of each experiment info
+  const int64_t nSpectraPerRun = static_cast<int64_t>(nSpectra);
+  const int64_t nIterations = static_cast<int64_t>(nRuns) * nSpectraPerRun;
+  auto prog = make_unique<API::Progress>(this, 0.3, 1.0, nIterations);
   // cppcheck-suppress syntaxError
-PRAGMA_OMP(parallel for private(intersections, pos, posNew))
-for (int64_t i = 0; i < ndets; i++) {
+PRAGMA_OMP(parallel for num_threads(accumulator.numberOfThreads()) private(intersections, pos, posNew))
+for (int64_t i = 0; i < nIterations; i++) {
   PARALLEL_START_INTERUPT_REGION
 
-  if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) ||
-      spectrumInfo.isMasked(i)) {
+  const size_t run = static_cast<size_t>(i / nSpectraPerRun);
+  const size_t spectrum = static_cast<size_t>(i % nSpectraPerRun);
+  const auto &detectorTable = *detectorTables[run];
+  if (spectrum >= detectorTable.size() || !detectorTable[spectrum].use) {
     continue;
   }
-  const auto &detector = spectrumInfo.detector(i);
-  double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
-  double phi = detector.getPhi();
-  // If the detector is a group, this should be the ID of the first detector
-  const auto detID = detector.getID();
+  const auto &detector = detectorTable[spectrum];
 
   // Intersections
-  this->calculateIntersections(intersections, theta, phi);
+  this->calculateIntersections(intersections, detector.theta, detector.phi,
+                               rubw[run]);
   if (intersections.empty())
     continue;
 
   // Get solid angle for this contribution
-  double solid = protonCharge;
-  if (haveSA) {
-    solid =
-        solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0] * protonCharge;
-  }
+  double solid = detector.solidAngle * protonCharges[run];
   // Compute final position in HKL
   // pre-allocate for efficiency and copy non-hkl dim values into place
-  pos.resize(vmdDims + otherValues.size() + 1);
-  std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims);
+  const auto &runOtherValues = otherValues[run];
+  pos.resize(vmdDims + runOtherValues.size() + 1);
+  std::copy(runOtherValues.begin(), runOtherValues.end(),
+            pos.begin() + vmdDims);
   pos.push_back(1.);
+  const int thread = PARALLEL_THREAD_NUMBER;
   auto intersectionsBegin = intersections.begin();
   for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
     const auto &curIntSec = *it;
@@ -561,24 +586,15 @@ for (int64_t i = 0; i < ndets; i++) {
 
     // signal = integral between two consecutive intersections *solid angle
     // *PC
-    double signal = solid * delta;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    accumulator.add(thread, linIndex, solid * delta);
   }
   prog->report();
 
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->getSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-} else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->getSignalArray());
-}
+accumulator.addTo(m_normWS->getSignalArray(), m_accumulate);
+m_accumulate = true;
 }
 
 /**
@@ -588,15 +604,16 @@ if (m_accumulate) {
  * @param intersections A list of intersections in HKL space
  * @param theta Polar angle with detector
  * @param phi Azimuthal angle with detector
+ * @param rubw The inverse of (2*Pi*R*UBW) for the experiment info
  */
 void MDNormDirectSC::calculateIntersections(
     std::vector<std::array<double, 4>> &intersections, const double theta,
-    const double phi) {
+    const double phi, const Kernel::DblMatrix &rubw) const {
   V3D qout(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta)),
       qin(0., 0., m_ki);
 
-  qout = m_rubw * qout;
-  qin = m_rubw * qin;
+  qout = rubw * qout;
+  qin = rubw * qin;
   if (convention == "Crystallography") {
     qout *= -1;
     qin *= -1;
@@ -21,6 +21,8 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
+#include "MantidMDAlgorithms/MDNormDetectorTable.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -48,7 +50,7 @@ DECLARE_ALGORITHM(MDNormSCD)
 MDNormSCD::MDNormSCD()
     : m_normWS(), m_inputWS(), m_hmin(0.0f), m_hmax(0.0f), m_kmin(0.0f),
       m_kmax(0.0f), m_lmin(0.0f), m_lmax(0.0f), m_hIntegrated(true),
-      m_kIntegrated(true), m_lIntegrated(true), m_rubw(3, 3), m_kiMin(0.0),
+      m_kIntegrated(true), m_lIntegrated(true), m_kiMin(0.0),
       m_kiMax(EMPTY_DBL()), m_hIdx(-1), m_kIdx(-1), m_lIdx(-1), m_hX(), m_kX(),
       m_lX(), m_samplePos(), m_beamDir() {}
 
@@ -135,6 +137,12 @@ void MDNormSCD::init() {
   declareProperty(make_unique<WorkspaceProperty<Workspace>>(
                       "OutputNormalizationWorkspace", "", Direction::Output),
                   "A name for the output normalization MDHistoWorkspace.");
+  declareProperty(
+      "ReuseDetectorTable", false,
+      "If true, keep the scattering angles, flux indices and solid angles of "
+      "the detectors in memory and reuse them in later runs with the same "
+      "instrument, detectors, masking, flux and solid angle workspaces. Only "
+      "the values of the latest setup are kept.");
 }
 
 /**
@@ -151,25 +159,31 @@ void MDNormSCD::exec() {
   setProperty("OutputNormalizationWorkspace", m_normWS);
 
   m_numExptInfos = outputWS->getNumExperimentInfo();
-  // loop over all experiment infos
+  // Find the experiment infos that contribute to the normalization. They are
+  // then processed together.
+  std::vector<uint16_t> expInfoIndices;
+  std::vector<std::vector<coord_t>> otherValues;
+  Kernel::Matrix<coord_t> affineTrans;
   for (uint16_t expInfoIndex = 0; expInfoIndex < m_numExptInfos;
        expInfoIndex++) {
     // Check for other dimensions if we could measure anything in the original
     // data
     bool skipNormalization = false;
-    const std::vector<coord_t> otherValues =
+    std::vector<coord_t> values =
         getValuesFromOtherDimensions(skipNormalization, expInfoIndex);
-    const auto affineTrans =
-        findIntergratedDimensions(otherValues, skipNormalization);
-    cacheDimensionXValues();
+    affineTrans = findIntergratedDimensions(values, skipNormalization);
 
     if (!skipNormalization) {
-      calculateNormalization(otherValues, affineTrans, expInfoIndex);
+      expInfoIndices.push_back(expInfoIndex);
+      otherValues.push_back(std::move(values));
     } else {
       g_log.warning("Binning limits are outside the limits of the MDWorkspace. "
                     "Not applying normalization.");
     }
-    m_accumulate = true;
+  }
+  cacheDimensionXValues();
+  if (!expInfoIndices.empty()) {
+    calculateNormalization(expInfoIndices, otherValues, affineTrans);
   }
 }
 
@@ -251,7 +265,8 @@ MDHistoWorkspace_sptr MDNormSCD::binInputWS() {
     if (propName != "FluxWorkspace" && propName != "SolidAngleWorkspace" &&
         propName != "TemporaryNormalizationWorkspace" &&
         propName != "OutputNormalizationWorkspace" &&
-        propName != "SkipSafetyCheck") {
+        propName != "SkipSafetyCheck" &&
+        propName != "ReuseDetectorTable") {
       binMD->setPropertyValue(propName, prop->value());
     }
   }
@@ -404,78 +419,88 @@ void MDNormSCD::cacheDimensionXValues() {
 
 /**
  * Computed the normalization for the input workspace. Results are stored in
- * m_normWS
- * @param otherValues
- * @param affineTrans
- * @param expInfoIndex current experiment info index
+ * m_normWS. The detectors of all the experiment infos are processed in a
+ * single parallel loop, each thread accumulating into its own buffer.
+ * @param expInfoIndices The indices of the experiment infos to include
+ * @param otherValues The values of the non-HKL dimensions for each of them
+ * @param affineTrans The transformation to the normalization workspace
  */
 void MDNormSCD::calculateNormalization(
-    const std::vector<coord_t> &otherValues,
-    const Kernel::Matrix<coord_t> &affineTrans, uint16_t expInfoIndex) {
+    const std::vector<uint16_t> &expInfoIndices,
+    const std::vector<std::vector<coord_t>> &otherValues,
+    const Kernel::Matrix<coord_t> &affineTrans) {
   API::MatrixWorkspace_const_sptr integrFlux = getProperty("FluxWorkspace");
   integrFlux->getXMinMax(m_kiMin, m_kiMax);
   API::MatrixWorkspace_const_sptr solidAngleWS =
       getProperty("SolidAngleWorkspace");
 
-  const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
-  using VectorDoubleProperty = Kernel::PropertyWithValue<std::vector<double>>;
-  auto *rubwLog = dynamic_cast<VectorDoubleProperty *>(
-      currentExptInfo.getLog("RUBW_MATRIX"));
-  if (!rubwLog) {
-    throw std::runtime_error(
-        "Wokspace does not contain a log entry for the RUBW matrix."
-        "Cannot continue.");
-  } else {
-    Kernel::DblMatrix rubwValue(
-        (*rubwLog)()); // includes the 2*pi factor but not goniometer for now :)
-    m_rubw = currentExptInfo.run().getGoniometerMatrix() * rubwValue;
-    m_rubw.Invert();
-  }
-  const double protonCharge = currentExptInfo.run().getProtonCharge();
-
-  const auto &spectrumInfo = currentExptInfo.spectrumInfo();
+  // The goniometer dependent quantities of each experiment info. The detector
+  // table is shared by consecutive experiment infos with the same instrument.
+  const size_t nRuns = expInfoIndices.size();
+  std::vector<Kernel::DblMatrix> rubw(nRuns);
+  std::vector<double> protonCharges(nRuns);
+  std::vector<boost::shared_ptr<const MDNormDetectorTable>> detectorTables(
+      nRuns);
+  const bool reuse = getProperty("ReuseDetectorTable");
+  size_t nSpectra = 0;
+  for (size_t run = 0; run < nRuns; ++run) {
+    const auto &currentExptInfo =
+        *(m_inputWS->getExperimentInfo(expInfoIndices[run]));
+    using VectorDoubleProperty = Kernel::PropertyWithValue<std::vector<double>>;
+    auto *rubwLog = dynamic_cast<VectorDoubleProperty *>(
+        currentExptInfo.getLog("RUBW_MATRIX"));
+    if (!rubwLog) {
+      throw std::runtime_error(
+          "Wokspace does not contain a log entry for the RUBW matrix."
+          "Cannot continue.");
+    } else {
+      Kernel::DblMatrix rubwValue(
+          (*rubwLog)()); // includes the 2*pi factor but not goniometer for now
+      rubw[run] = currentExptInfo.run().getGoniometerMatrix() * rubwValue;
+      rubw[run].Invert();
+    }
+    protonCharges[run] = currentExptInfo.run().getProtonCharge();
 
-  // Mappings
-  const int64_t ndets = static_cast<int64_t>(spectrumInfo.size());
-  const detid2index_map fluxDetToIdx =
-      integrFlux->getDetectorIDToWorkspaceIndexMap();
-  const detid2index_map solidAngDetToIdx =
-      solidAngleWS->getDetectorIDToWorkspaceIndexMap();
+    if (run > 0 && detectorTables[run - 1]->isValidFor(currentExptInfo)) {
+      detectorTables[run] = detectorTables[run - 1];
+    } else {
+      detectorTables[run] = MDNormDetectorTable::create(
+          currentExptInfo, m_samplePos, m_beamDir, integrFlux.get(),
+          solidAngleWS.get(), reuse);
+    }
+    nSpectra = std::max(nSpectra, detectorTables[run]->size());
+  }
 
   const size_t vmdDims = 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  MDNormAccumulator accumulator(m_normWS->getNPoints());
   std::vector<std::array<double, 4>> intersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
-  double progStep = 0.7 / m_numExptInfos;
-  auto prog =
-      make_unique<API::Progress>(this, 0.3 + progStep * expInfoIndex,
-                                 0.3 + progStep * (expInfoIndex + 1.), ndets);
+  // one iteration per spectrum of each experiment info
+  const int64_t nSpectraPerRun = static_cast<int64_t>(nSpectra);
+  const int64_t nIterations = static_cast<int64_t>(nRuns) * nSpectraPerRun;
+  auto prog = make_unique<API::Progress>(this, 0.3, 1.0, nIterations);
   // cppcheck-suppress syntaxError
-PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (Kernel::threadSafe(*integrFlux)))
-for (int64_t i = 0; i < ndets; i++) {
+PRAGMA_OMP(parallel for num_threads(accumulator.numberOfThreads()) private(intersections, xValues, yValues, pos, posNew) if (Kernel::threadSafe(*integrFlux)))
+for (int64_t i = 0; i < nIterations; i++) {
   PARALLEL_START_INTERUPT_REGION
 
-  if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) ||
-      spectrumInfo.isMasked(i)) {
+  const size_t run = static_cast<size_t>(i / nSpectraPerRun);
+  const size_t spectrum = static_cast<size_t>(i % nSpectraPerRun);
+  const auto &detectorTable = *detectorTables[run];
+  if (spectrum >= detectorTable.size() || !detectorTable[spectrum].use) {
     continue;
   }
-  const auto &detector = spectrumInfo.detector(i);
-  double theta = detector.getTwoTheta(m_samplePos, m_beamDir);
-  double phi = detector.getPhi();
-  // If the dtefctor is a group, this should be the ID of the first detector
-  const auto detID = detector.getID();
+  const auto &detector = detectorTable[spectrum];
 
   // Intersections
-  this->calculateIntersections(intersections, theta, phi);
+  this->calculateIntersections(intersections, detector.theta, detector.phi,
+                               rubw[run]);
   if (intersections.empty())
     continue;
 
-  // get the flux spetrum number
-  size_t wsIdx = fluxDetToIdx.find(detID)->second;
   // Get solid angle for this contribution
-  double solid =
-      solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0] * protonCharge;
+  double solid = detector.solidAngle * protonCharges[run];
 
   // -- calculate integrals for the intersection --
   // momentum values at intersections
@@ -488,16 +513,20 @@ for (int64_t i = 0; i < ndets; i++) {
     *x = (*it)[3];
   }
   // calculate integrals at momenta from xValues by interpolating between
-  // points in spectrum sp
+  // points in the flux spectrum of the detector
   // of workspace integrFlux. The result is stored in yValues
-  calcIntegralsForIntersections(xValues, *integrFlux, wsIdx, yValues);
+  calcIntegralsForIntersections(xValues, *integrFlux, detector.fluxIndex,
+                                yValues);
 
   // Compute final position in HKL
   // pre-allocate for efficiency and copy non-hkl dim values into place
-  pos.resize(vmdDims + otherValues.size());
-  std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims - 1);
+  const auto &runOtherValues = otherValues[run];
+  pos.resize(vmdDims + runOtherValues.size());
+  std::copy(runOtherValues.begin(), runOtherValues.end(),
+            pos.begin() + vmdDims - 1);
   pos.push_back(1.);
 
+  const int thread = PARALLEL_THREAD_NUMBER;
   for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
     const auto &curIntSec = *it;
     const auto &prevIntSec = *(it - 1);
@@ -520,24 +549,15 @@ for (int64_t i = 0; i < ndets; i++) {
     // index of the current intersection
     size_t k = static_cast<size_t>(std::distance(intersectionsBegin, it));
     // signal = integral between two consecutive intersections
-    signal_t signal = (yValues[k] - yValues[k - 1]) * solid;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    accumulator.add(thread, linIndex, (yValues[k] - yValues[k - 1]) * solid);
   }
   prog->report();
 
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->getSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-} else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->getSignalArray());
-}
+accumulator.addTo(m_normWS->getSignalArray(), m_accumulate);
+m_accumulate = true;
 }
 
 /**
@@ -623,12 +643,13 @@ void MDNormSCD::calcIntegralsForIntersections(
  * @param intersections A list of intersections in HKL space
  * @param theta Polar angle withd detector
  * @param phi Azimuthal angle with detector
+ * @param rubw The inverse of (2*Pi*R*UBW) for the experiment info
  */
 void MDNormSCD::calculateIntersections(
     std::vector<std::array<double, 4>> &intersections, const double theta,
-    const double phi) {
+    const double phi, const Kernel::DblMatrix &rubw) const {
   V3D q(-sin(theta) * cos(phi), -sin(theta) * sin(phi), 1. - cos(theta));
-  q = m_rubw * q;
+  q = rubw * q;
   if (convention == "Crystallography") {
     q *= -1;
   }
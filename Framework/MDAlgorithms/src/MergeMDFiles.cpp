@@ -9,6 +9,8 @@
 #include "MantidAPI/MultipleFileProperty.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBoxBase.h"
+#include "MantidDataObjects/MDBoxEventIndexNeXusReader.h"
+#include "MantidDataObjects/MDBoxEventStream.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/Strings.h"
@@ -25,6 +27,15 @@ using namespace Mantid::DataObjects;
 namespace Mantid {
 namespace MDAlgorithms {
 
+namespace {
+/// The memory shared by the read-ahead buffers of all input files
+constexpr size_t READ_AHEAD_BYTES = 400000000;
+/// The memory shared by the windows of the event indexes of all input files
+constexpr size_t INDEX_READ_AHEAD_BYTES = 40000000;
+/// The smallest number of boxes read from an event index at a time
+constexpr size_t MIN_INDEX_WINDOW = 1024;
+} // namespace
+
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(MergeMDFiles)
 
@@ -33,7 +44,7 @@ DECLARE_ALGORITHM(MergeMDFiles)
  */
 MergeMDFiles::MergeMDFiles()
     : m_nDims(0), m_MDEventType(), m_fileBasedTargetWS(false), m_Filenames(),
-      m_EventLoader(), m_OutIWS(), m_totalEvents(0), m_totalLoaded(0),
+      m_eventStreams(), m_OutIWS(), m_totalEvents(0), m_totalLoaded(0),
       m_fileMutex(), m_statsMutex() {}
 
 //----------------------------------------------------------------------------------------------
@@ -71,7 +82,9 @@ void MergeMDFiles::init() {
 //----------------------------------------------------------------------------------------------
 /** Loads all of the box data required (no events) for later use.
  * Calculates total number events in each box
- * Also opens the files and leaves them open */
+ * Also opens the files and leaves them open. The box structure of each file is
+ * discarded once it has been read; the location of the events of its boxes is
+ * read again from the file, a window of boxes at a time, while merging. */
 void MergeMDFiles::loadBoxData() {
   this->progress(0.05, "Loading File Info");
   // Get plain box structure and box tree
@@ -83,46 +96,58 @@ void MergeMDFiles::loadBoxData() {
   // Total number of events in ALL files.
   m_totalEvents = 0;
 
-  m_fileComponentsStructure.resize(m_Filenames.size());
-  m_EventLoader.assign(m_Filenames.size(), nullptr);
+  m_eventStreams.clear();
+  m_eventStreams.reserve(m_Filenames.size());
 
   try {
     for (size_t i = 0; i < m_Filenames.size(); i++) {
       // load box structure and the experimental info from each target
       // workspace.
-      m_fileComponentsStructure[i].loadBoxStructure(m_Filenames[i], m_nDims,
-                                                    m_MDEventType, true, true);
+      MDBoxFlatTree fileStructure;
+      fileStructure.loadBoxStructure(m_Filenames[i], m_nDims, m_MDEventType,
+                                     true, true);
       // export just loaded experiment info to the target workspace
-      m_fileComponentsStructure[i].exportExperiment(m_OutIWS);
+      fileStructure.exportExperiment(m_OutIWS);
+      const std::vector<uint64_t> &fileEventIndex =
+          fileStructure.getEventIndex();
 
       // Check for consistency
-      if (i > 0) {
-        if (m_fileComponentsStructure[i].getEventIndex().size() !=
-            targetEventIndexes.size())
-          throw std::runtime_error(
-              "Inconsistent number of boxes found in file " + m_Filenames[i] +
-              ". Cannot merge these files. Did you generate them all with "
-              "exactly the same box structure?");
-      }
+      if (fileEventIndex.size() != targetEventIndexes.size())
+        throw std::runtime_error(
+            "Inconsistent number of boxes found in file " + m_Filenames[i] +
+            ". Cannot merge these files. Did you generate them all with "
+            "exactly the same box structure?");
 
       // calculate total number of events per target cell, which will be
       size_t nBoxes = Boxes.size();
       for (size_t j = 0; j < nBoxes; j++) {
         size_t ID = Boxes[j]->getID();
-        targetEventIndexes[2 * ID + 1] +=
-            m_fileComponentsStructure[i].getEventIndex()[2 * ID + 1];
-        m_totalEvents +=
-            m_fileComponentsStructure[i].getEventIndex()[2 * ID + 1];
+        targetEventIndexes[2 * ID + 1] += fileEventIndex[2 * ID + 1];
+        m_totalEvents += fileEventIndex[2 * ID + 1];
       }
 
-      // Open the event data, track the total number of events
+      // Open the event data
       auto bc = boost::shared_ptr<API::BoxController>(
           new API::BoxController(static_cast<size_t>(m_nDims)));
-      bc->fromXMLString(m_fileComponentsStructure[i].getBCXMLdescr());
-
-      m_EventLoader[i] = new BoxControllerNeXusIO(bc.get());
-      m_EventLoader[i]->setDataType(sizeof(coord_t), m_MDEventType);
-      m_EventLoader[i]->openFile(m_Filenames[i], "r");
+      bc->fromXMLString(fileStructure.getBCXMLdescr());
+
+      auto loader = Kernel::make_unique<BoxControllerNeXusIO>(bc.get());
+      loader->setDataType(sizeof(coord_t), m_MDEventType);
+      loader->openFile(m_Filenames[i], "r");
+      const size_t nColumns = static_cast<size_t>(loader->getNDataColums());
+      // Share the read-ahead memory between all the files
+      const size_t bufferSize =
+          std::max(loader->getDataChunk(),
+                   READ_AHEAD_BYTES /
+                       (m_Filenames.size() * nColumns * sizeof(coord_t)));
+      const size_t indexWindowSize =
+          std::max(MIN_INDEX_WINDOW,
+                   INDEX_READ_AHEAD_BYTES /
+                       (m_Filenames.size() * 2 * sizeof(uint64_t)));
+      m_eventStreams.emplace_back(Kernel::make_unique<MDBoxEventStream>(
+          std::move(loader),
+          Kernel::make_unique<MDBoxEventIndexNeXusReader>(m_Filenames[i]),
+          nColumns, bufferSize, indexWindowSize));
     }
   } catch (...) {
     // Close all open files in case of error
@@ -153,8 +178,11 @@ void MergeMDFiles::loadBoxData() {
                  << " files.\n";
 }
 
-/** Task that loads all of the events from corresponded boxes of all files
+/** Loads all of the events from corresponded boxes of all files
  * that is being merged into a particular box in the output workspace.
+ * The boxes are visited in the order of their IDs, which is the order in
+ * which their events are stored in the input files, so that every file is
+ * read forwards.
  */
 
 uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
@@ -162,28 +190,14 @@ uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
   /// (from cloning)
   TargetBox->clear();
 
+  const size_t ID = TargetBox->getID();
+  m_boxEventTable.clear();
   uint64_t nBoxEvents(0);
-  std::vector<size_t> numFileEvents(m_EventLoader.size());
-
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    numFileEvents[iw] = static_cast<size_t>(
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
-    nBoxEvents += numFileEvents[iw];
-  }
-
-  // At this point memory required is known, so it is reserved all in one go
-  TargetBox->reserveMemoryForLoad(nBoxEvents);
-
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    uint64_t fileLocation =
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 0];
-    if (numFileEvents[iw] == 0)
-      continue;
-    TargetBox->loadAndAddFrom(m_EventLoader[iw], fileLocation,
-                              numFileEvents[iw]);
+  for (auto &stream : m_eventStreams) {
+    nBoxEvents += stream->appendEvents(ID, m_boxEventTable);
   }
+  if (nBoxEvents > 0)
+    TargetBox->setEventsData(m_boxEventTable);
 
   return nBoxEvents;
 }
@@ -240,15 +254,8 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_progress = Kernel::make_unique<Progress>(this, 0.1, 0.9, size_t(numBoxes));
   m_progress->setNotifyStep(0.1);
 
-  // For tracking progress
-  // uint64_t m_totalEventsInTasks = 0;
-
-  // Prepare thread pool
   CPUTimer overallTime;
 
-  auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
   Kernel::DiskBuffer *DiskBuf(nullptr);
   if (m_fileBasedTargetWS) {
     DiskBuf = bc->getFileIO();
@@ -273,32 +280,12 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
         // DiskBuf->toWrite(Saver);
       }
     }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
     m_progress->reportIncrement(ib, "Loading and merging box data");
   }
   if (DiskBuf) {
     DiskBuf->flushCache();
     bc->getFileIO()->flushData();
   }
-  //// Run any final tasks
-  // tp.joinAll();
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
@@ -402,13 +389,8 @@ void MergeMDFiles::exec() {
 
   setProperty("OutputWorkspace", m_OutIWS);
 }
-/**Delete all event loaders */
-void MergeMDFiles::clearEventLoaders() {
-  for (auto &loader : m_EventLoader) {
-    delete loader;
-    loader = nullptr;
-  }
-}
+/**Close all the input files */
+void MergeMDFiles::clearEventLoaders() { m_eventStreams.clear(); }
 
 } // namespace MDAlgorithms
 } // namespace Mantid
@@ -9,6 +9,7 @@
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -133,7 +134,7 @@ void MinusMD::execEvent() {
 void MinusMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->subtract(*operand);
+  MDHistoExpression(out).minus(operand).evaluateInPlace(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -141,7 +142,9 @@ void MinusMD::execHistoHisto(
 void MinusMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->subtract(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression(out)
+      .minus(scalar->y(0)[0], scalar->e(0)[0])
+      .evaluateInPlace(*out);
 }
 
 } // namespace MDAlgorithms
@@ -9,6 +9,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -117,7 +118,7 @@ void MultiplyMD::execEvent() {
 void MultiplyMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->multiply(*operand);
+  MDHistoExpression(out).multiply(operand).evaluateInPlace(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -125,7 +126,9 @@ void MultiplyMD::execHistoHisto(
 void MultiplyMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->multiply(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression(out)
+      .multiply(scalar->y(0)[0], scalar->e(0)[0])
+      .evaluateInPlace(*out);
 }
 
 } // namespace MDAlgorithms
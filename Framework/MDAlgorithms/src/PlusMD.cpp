@@ -9,6 +9,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -147,7 +148,7 @@ void PlusMD::checkInputs() {
 void PlusMD::execHistoHisto(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::MDHistoWorkspace_const_sptr operand) {
-  out->add(*operand);
+  MDHistoExpression(out).plus(operand).evaluateInPlace(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -155,7 +156,9 @@ void PlusMD::execHistoHisto(
 void PlusMD::execHistoScalar(
     Mantid::DataObjects::MDHistoWorkspace_sptr out,
     Mantid::DataObjects::WorkspaceSingleValue_const_sptr scalar) {
-  out->add(scalar->y(0)[0], scalar->e(0)[0]);
+  MDHistoExpression(out)
+      .plus(scalar->y(0)[0], scalar->e(0)[0])
+      .evaluateInPlace(*out);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/PowerMD.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidKernel/System.h"
 
 using namespace Mantid::Kernel;
@@ -51,7 +52,8 @@ void PowerMD::execEvent(Mantid::API::IMDEventWorkspace_sptr /*out*/) {
 /// PowerMD::Run the algorithm with a MDHistoWorkspace
 void PowerMD::execHisto(Mantid::DataObjects::MDHistoWorkspace_sptr out) {
   double exponent = getProperty("Exponent");
-  out->power(exponent);
+  Mantid::DataObjects::MDHistoExpression(out).power(exponent).evaluateInPlace(
+      *out);
 }
 
 } // namespace MDAlgorithms
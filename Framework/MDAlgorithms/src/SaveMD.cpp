@@ -10,6 +10,8 @@
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/Progress.h"
 #include "MantidAPI/WorkspaceHistory.h"
+#include "MantidDataObjects/BoxControllerMappedIO.h"
+#include "MantidDataObjects/BoxControllerQuantizedIO.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
@@ -22,6 +24,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include <Poco/File.h>
+#include <algorithm>
 
 using file_holder_type = std::unique_ptr<::NeXus::File>;
 
@@ -41,6 +44,33 @@ void prepareUpdate(MDBoxFlatTree &BoxFlatStruct, BoxController *bc,
   // box structure
   BoxFlatStruct.initFlatStructure(ws, filename);
 }
+
+/** Copy all the events of a scratch back end into a new NeXus file.
+ * @param scratchIO :: the mapped or quantized back end, with its cache flushed
+ * @param bc :: the box controller of the saved workspace
+ * @param eventType :: the type name of the events
+ * @param filename :: the file to save the events to
+ */
+void copyScratchEvents(const IBoxControllerIO &scratchIO, BoxController *bc,
+                       const std::string &eventType,
+                       const std::string &filename) {
+  BoxControllerNeXusIO saver(bc);
+  saver.setDataType(sizeof(Mantid::coord_t), eventType);
+  saver.openFile(filename, "w");
+  const uint64_t nEvents = scratchIO.getFileLength();
+  const uint64_t chunk = scratchIO.getDataChunk() * 100;
+  std::vector<Mantid::coord_t> block;
+  for (uint64_t position = 0; position < nEvents; position += chunk) {
+    const auto nPoints =
+        static_cast<size_t>(std::min(chunk, nEvents - position));
+    scratchIO.loadBlock(block, position, nPoints);
+    saver.saveBlock(block, position);
+  }
+  std::vector<uint64_t> freeSpace;
+  scratchIO.getFreeSpaceVector(freeSpace);
+  saver.setFreeSpaceVector(freeSpace);
+  saver.closeFile();
+}
 } // namespace
 
 namespace Mantid {
@@ -102,13 +132,32 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   bool wsIsFileBacked = ws->isFileBacked();
   std::string filename = getPropertyValue("Filename");
   BoxController_sptr bc = ws->getBoxController();
-  auto copyFile =
-      wsIsFileBacked && !filename.empty() && filename != bc->getFilename();
+  // A mapped or quantized back end is a scratch copy of the events, which are
+  // written out to the NeXus file as if the workspace was in memory
+  const IBoxControllerIO *scratchIO = nullptr;
+  const bool isQuantized =
+      wsIsFileBacked &&
+      dynamic_cast<DataObjects::BoxControllerQuantizedIO *>(bc->getFileIO());
+  if (isQuantized ||
+      (wsIsFileBacked &&
+       dynamic_cast<DataObjects::BoxControllerMappedIO *>(bc->getFileIO())))
+    scratchIO = bc->getFileIO();
+  if (isQuantized)
+    g_log.warning() << "The events of " << ws->getName()
+                    << " are quantized in memory. The file will hold their "
+                       "coordinates rounded to 1/131070 of the size of their "
+                       "box, not the coordinates originally loaded.\n";
+  auto copyFile = wsIsFileBacked && !scratchIO && !filename.empty() &&
+                  filename != bc->getFilename();
   if (wsIsFileBacked) {
     if (makeFileBackend) {
       throw std::runtime_error(
           "MakeFileBacked selected but workspace is already file backed.");
     }
+    if (updateFileBackend && scratchIO) {
+      throw std::runtime_error("UpdateFileBackEnd selected but workspace is "
+                               "backed by a scratch copy of its events.");
+    }
   } else {
     if (updateFileBackend) {
       throw std::runtime_error(
@@ -116,7 +165,7 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     }
   }
 
-  if (!wsIsFileBacked) {
+  if (!wsIsFileBacked || scratchIO) {
     Poco::File oldFile(filename);
     if (oldFile.exists())
       oldFile.remove();
@@ -160,6 +209,11 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       BoxFlatStruct.saveBoxStructure(filename);
     }
     Poco::File(bc->getFilename()).copyTo(filename);
+  } else if (scratchIO) {
+    prepareUpdate<MDE, nd>(BoxFlatStruct, bc.get(), ws, filename);
+    prog->resetNumSteps(1, 0.06, 0.90);
+    copyScratchEvents(*scratchIO, bc.get(), MDE::getTypeName(), filename);
+    prog->report("Saving Events");
   } else // not file backed;
   {
     // the boxes file positions are unknown and we need to calculate it.
@@ -200,29 +200,32 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   uint64_t totalAdded = outWS->getNEvents();
   uint64_t numSinceSplit = 0;
 
+  // The rotated/transformed coordinates of the events in a box
+  std::vector<coord_t> outCenters;
+
   // Go through every box for this chunk.
   // PARALLEL_FOR_IF( !bc->isFileBacked() )
   for (int i = 0; i < int(boxes.size()); i++) {
     MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
     // Perform the binning in this separate method.
     if (box && !box->getIsMasked()) {
-      // An array to hold the rotated/transformed coordinates
-      coord_t outCenter[ond];
-
       const std::vector<MDE> &events = box->getConstEvents();
 
-      for (auto it = events.cbegin(); it != events.cend(); ++it) {
-        // Cache the center of the event (again for speed)
-        const coord_t *inCenter = it->getCenter();
-
-        if (function->isPointContained(inCenter)) {
-          // Now transform to the output dimensions
-          m_transformFromOriginal->apply(inCenter, outCenter);
+      // Transform the centers of all the events to the output dimensions
+      outCenters.resize(events.size() * ond);
+      if (!events.empty())
+        m_transformFromOriginal->applyBatch(events.front().getCenter(),
+                                            MDE::getCenterStride(),
+                                            outCenters.data(), events.size());
 
+      for (size_t j = 0; j < events.size(); ++j) {
+        const MDE &event = events[j];
+        if (function->isPointContained(event.getCenter())) {
           // Create the event
-          OMDE newEvent(it->getSignal(), it->getErrorSquared(), outCenter);
+          OMDE newEvent(event.getSignal(), event.getErrorSquared(),
+                        outCenters.data() + j * ond);
           // Copy extra data, if any
-          copyEvent(*it, newEvent);
+          copyEvent(event, newEvent);
           // Add it to the workspace
           if (outRootBox->addEvent(newEvent))
             numSinceSplit++;
@@ -5,11 +5,8 @@
 //     & Institut Laue - Langevin
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/SmoothMD.h"
-#include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
-#include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/Progress.h"
-#include "MantidDataObjects/MDHistoWorkspaceIterator.h"
 #include "MantidKernel/ArrayBoundedValidator.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/CompositeValidator.h"
@@ -17,12 +14,18 @@
 #include "MantidKernel/MandatoryValidator.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
+#include "MantidKernel/make_unique.h"
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_real.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <sstream>
 #include <stack>
@@ -32,7 +35,6 @@
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
-using namespace Mantid::DataObjects;
 
 // Typedef for width vector
 using WidthVector = std::vector<double>;
@@ -54,6 +56,164 @@ using SmoothFunctionMap = std::map<std::string, SmoothFunction>;
 
 namespace {
 
+/// Kernels with at least this many elements are applied by FFT
+const size_t MIN_FFT_KERNEL_SIZE = 32;
+
+/**
+ * Convolve a line directly with a kernel centred on each bin
+ * @param line : The values to convolve
+ * @param kernel : The kernel, of odd size
+ * @param result : The convolved values, sized as the line
+ */
+void convolveLine(const std::vector<double> &line, const KernelVector &kernel,
+                  std::vector<double> &result) {
+  const auto length = static_cast<int>(line.size());
+  const auto half = static_cast<int>(kernel.size() / 2);
+  for (int i = 0; i < length; ++i) {
+    const int first = std::max(0, i - half);
+    const int last = std::min(length - 1, i + half);
+    double sum = 0.0;
+    for (int j = first; j <= last; ++j) {
+      sum += kernel[j - i + half] * line[j];
+    }
+    result[i] = sum;
+  }
+}
+
+/**
+ * Convolution of lines of one length with a kernel through their Fourier
+ * transforms. The lines are padded with zeros to a power of two long enough
+ * for the kernel not to wrap around onto them.
+ */
+class LineFFTConvolution {
+public:
+  LineFFTConvolution(const KernelVector &kernel, const size_t length) {
+    const size_t half = kernel.size() / 2;
+    m_size = 2;
+    while (m_size < length + half) {
+      m_size *= 2;
+    }
+    // Arranged so that bin i of the convolution is sum_j kernel[j - i + half]
+    // * line[j], as for convolveLine
+    m_kernelTransform.assign(m_size, 0.0);
+    for (size_t i = 0; i < kernel.size(); ++i) {
+      m_kernelTransform[(m_size + half - i) % m_size] = kernel[i];
+    }
+    gsl_fft_real_radix2_transform(m_kernelTransform.data(), 1, m_size);
+  }
+
+  /**
+   * @param line : The values to convolve
+   * @param work : Work space, resized as needed
+   * @param result : The convolved values, sized as the line
+   */
+  void convolve(const std::vector<double> &line, std::vector<double> &work,
+                std::vector<double> &result) const {
+    work.assign(m_size, 0.0);
+    std::copy(line.cbegin(), line.cend(), work.begin());
+    gsl_fft_real_radix2_transform(work.data(), 1, m_size);
+    // Multiply the half-complex transforms
+    const auto &kernel = m_kernelTransform;
+    const size_t half = m_size / 2;
+    work[0] *= kernel[0];
+    work[half] *= kernel[half];
+    for (size_t i = 1; i < half; ++i) {
+      const double re =
+          work[i] * kernel[i] - work[m_size - i] * kernel[m_size - i];
+      const double im =
+          work[i] * kernel[m_size - i] + work[m_size - i] * kernel[i];
+      work[i] = re;
+      work[m_size - i] = im;
+    }
+    gsl_fft_halfcomplex_radix2_inverse(work.data(), 1, m_size);
+    std::copy(work.cbegin(), work.cbegin() + line.size(), result.begin());
+  }
+
+private:
+  /// The padded length of the lines
+  size_t m_size;
+  /// The half-complex transform of the kernel
+  std::vector<double> m_kernelTransform;
+};
+
+/**
+ * Smooth a workspace by a normalised convolution with a kernel which is the
+ * product of a 1D kernel for each dimension, applied as a pass along each
+ * dimension in turn. The bins beyond the edges and the masked bins, where the
+ * weighting workspace is 0, do not contribute, and the kernel is normalised
+ * over the remaining bins. Masked bins are set to NaN.
+ * @param toSmooth : Workspace to smooth
+ * @param kernels : The 1D kernel for each dimension
+ * @param weightingWS : Weighting workspace (optional)
+ * @param propagateErrors : If true, the errors are those of the weighted
+ * mean; otherwise each bin gets the weighted mean of the errors squared
+ * @param progress : Reports a step for each dimension, and one at the end
+ * @return Smoothed MDHistoWorkspace
+ */
+IMDHistoWorkspace_sptr
+separableSmooth(const IMDHistoWorkspace &toSmooth,
+                const std::vector<KernelVector> &kernels,
+                const OptionalIMDHistoWorkspace_const_sptr &weightingWS,
+                const bool propagateErrors, Progress &progress) {
+  const auto nPoints = static_cast<size_t>(toSmooth.getNPoints());
+  const size_t nDims = kernels.size();
+  std::vector<size_t> shape(nDims);
+  for (size_t d = 0; d < nDims; ++d) {
+    shape[d] = toSmooth.getDimension(d)->getNBins();
+  }
+
+  const Mantid::signal_t *signal = toSmooth.getSignalArray();
+  const Mantid::signal_t *errorSquared = toSmooth.getErrorSquaredArray();
+  const Mantid::signal_t *weights =
+      weightingWS ? (*weightingWS)->getSignalArray() : nullptr;
+  std::vector<bool> measured(nPoints, true);
+  std::vector<double> sumSignal(signal, signal + nPoints);
+  std::vector<double> sumErrorSquared(errorSquared, errorSquared + nPoints);
+  std::vector<double> sumKernel(nPoints, 1.0);
+  if (weights) {
+    for (size_t i = 0; i < nPoints; ++i) {
+      if (weights[i] == 0) {
+        // Nothing measured here. We cannot use that point.
+        measured[i] = false;
+        sumSignal[i] = 0.0;
+        sumErrorSquared[i] = 0.0;
+        sumKernel[i] = 0.0;
+      }
+    }
+  }
+
+  for (size_t d = 0; d < nDims; ++d) {
+    KernelVector errorKernel(kernels[d]);
+    if (propagateErrors) {
+      for (auto &value : errorKernel) {
+        value *= value;
+      }
+    }
+    Mantid::MDAlgorithms::convolveDimension(sumSignal, shape, d, kernels[d]);
+    Mantid::MDAlgorithms::convolveDimension(sumKernel, shape, d, kernels[d]);
+    Mantid::MDAlgorithms::convolveDimension(sumErrorSquared, shape, d,
+                                            errorKernel);
+    progress.report();
+  }
+
+  IMDHistoWorkspace_sptr outWS(toSmooth.clone());
+  Mantid::signal_t *outSignal = outWS->getSignalArray();
+  Mantid::signal_t *outErrorSquared = outWS->getErrorSquaredArray();
+  for (size_t i = 0; i < nPoints; ++i) {
+    if (!measured[i]) {
+      outSignal[i] = std::numeric_limits<double>::quiet_NaN();
+      outErrorSquared[i] = std::numeric_limits<double>::quiet_NaN();
+      continue;
+    }
+    outSignal[i] = sumSignal[i] / sumKernel[i];
+    outErrorSquared[i] = propagateErrors
+                             ? sumErrorSquared[i] / (sumKernel[i] * sumKernel[i])
+                             : sumErrorSquared[i] / sumKernel[i];
+  }
+  progress.report();
+  return outWS;
+}
+
 /**
  * Maps a function name to a smoothing function
  * @return function map
@@ -146,6 +306,63 @@ KernelVector normaliseKernel(KernelVector kernel) {
   return kernel;
 }
 
+/*
+ * Convolve an array along one of its dimensions with a kernel centred on each
+ * bin. Bins beyond the edges of the array count as zero. Kernels of at least
+ * MIN_FFT_KERNEL_SIZE elements are applied through Fourier transforms of the
+ * lines, except to lines holding non-finite values, which would spread over
+ * the whole line.
+ * @param data : The array, with the first dimension varying fastest
+ * @param shape : The number of bins in each dimension of the array
+ * @param dimension : The dimension to convolve along
+ * @param kernel : The kernel, of odd size
+ */
+void convolveDimension(std::vector<double> &data,
+                       const std::vector<size_t> &shape, const size_t dimension,
+                       const KernelVector &kernel) {
+  size_t stride = 1;
+  for (size_t d = 0; d < dimension; ++d) {
+    stride *= shape[d];
+  }
+  const size_t length = shape[dimension];
+  const size_t nLines = data.size() / length;
+
+  std::unique_ptr<LineFFTConvolution> fftConvolution;
+  if (kernel.size() >= MIN_FFT_KERNEL_SIZE && length > 1) {
+    fftConvolution =
+        Mantid::Kernel::make_unique<LineFFTConvolution>(kernel, length);
+  }
+
+  // The lines are shared out in chunks, which reuse their buffers
+  const size_t linesPerChunk = 256;
+  const auto nChunks =
+      static_cast<int64_t>((nLines + linesPerChunk - 1) / linesPerChunk);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t chunk = 0; chunk < nChunks; ++chunk) {
+    std::vector<double> line(length);
+    std::vector<double> result(length);
+    std::vector<double> work;
+    const size_t firstLine = static_cast<size_t>(chunk) * linesPerChunk;
+    const size_t endLine = std::min(nLines, firstLine + linesPerChunk);
+    for (size_t lineIndex = firstLine; lineIndex < endLine; ++lineIndex) {
+      const size_t first =
+          lineIndex % stride + (lineIndex / stride) * stride * length;
+      for (size_t i = 0; i < length; ++i) {
+        line[i] = data[first + i * stride];
+      }
+      if (fftConvolution &&
+          std::all_of(line.cbegin(), line.cend(),
+                      [](const double value) { return std::isfinite(value); }))
+        fftConvolution->convolve(line, work, result);
+      else
+        convolveLine(line, kernel, result);
+      for (size_t i = 0; i < length; ++i) {
+        data[first + i * stride] = result[i];
+      }
+    }
+  }
+}
+
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(SmoothMD)
 
@@ -169,7 +386,8 @@ const std::string SmoothMD::summary() const {
 
 /**
  * Hat function smoothing. All weights even. Hat function boundaries beyond
- * width.
+ * width. Each bin gets the mean signal and the mean error squared of the bins
+ * within the width around it.
  * @param toSmooth : Workspace to smooth
  * @param widthVector : Width vector
  * @param weightingWS : Weighting workspace (optional)
@@ -179,92 +397,19 @@ IMDHistoWorkspace_sptr
 SmoothMD::hatSmooth(IMDHistoWorkspace_const_sptr toSmooth,
                     const WidthVector &widthVector,
                     OptionalIMDHistoWorkspace_const_sptr weightingWS) {
-
-  const bool useWeights = weightingWS.is_initialized();
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
-  // Create the output workspace.
-  IMDHistoWorkspace_sptr outWS(toSmooth->clone());
-  progress.reportIncrement(
-      size_t(double(nPoints) * 0.1)); // Report ~10% progress
-
-  const int nThreads = Mantid::API::FrameworkManager::Instance()
-                           .getNumOMPThreads(); // NThreads to Request
-
-  auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
-
-    PARALLEL_START_INTERUPT_REGION
-    auto iterator =
-        dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
-
-    if (!iterator) {
-      throw std::logic_error(
-          "Failed to cast IMDIterator to MDHistoWorkspaceIterator");
-    }
-
-    do {
-      // Gets all vertex-touching neighbours
-      size_t iteratorIndex = iterator->getLinearIndex();
-
-      if (useWeights) {
-
-        // Check that we could measure here.
-        if ((*weightingWS)->getSignalAt(iteratorIndex) == 0) {
-
-          outWS->setSignalAt(iteratorIndex,
-                             std::numeric_limits<double>::quiet_NaN());
-          outWS->setErrorSquaredAt(iteratorIndex,
-                                   std::numeric_limits<double>::quiet_NaN());
-
-          continue; // Skip we couldn't measure here.
-        }
-      }
-
-      // Explicitly cast the doubles to int
-      // We've already checked in the validator that the doubles we have are odd
-      // integer values and well below max int
-      std::vector<int> widthVectorInt;
-      widthVectorInt.reserve(widthVector.size());
-      for (auto const widthEntry : widthVector) {
-        widthVectorInt.push_back(static_cast<int>(widthEntry));
-      }
-
-      std::vector<size_t> neighbourIndexes =
-          iterator->findNeighbourIndexesByWidth(widthVectorInt);
-
-      size_t nNeighbours = neighbourIndexes.size();
-      double sumSignal = iterator->getSignal();
-      double sumSqError = iterator->getError();
-      for (auto neighbourIndex : neighbourIndexes) {
-        if (useWeights) {
-          if ((*weightingWS)->getSignalAt(neighbourIndex) == 0) {
-            // Nothing measured here. We cannot use that neighbouring point.
-            nNeighbours -= 1;
-            continue;
-          }
-        }
-        sumSignal += toSmooth->getSignalAt(neighbourIndex);
-        double error = toSmooth->getErrorAt(neighbourIndex);
-        sumSqError += (error * error);
-      }
-
-      // Calculate the mean
-      outWS->setSignalAt(iteratorIndex, sumSignal / double(nNeighbours + 1));
-      // Calculate the sample variance
-      outWS->setErrorSquaredAt(iteratorIndex,
-                               sumSqError / double(nNeighbours + 1));
-
-      progress.report();
-
-    } while (iterator->next());
-    PARALLEL_END_INTERUPT_REGION
+  // The hat is the product of a 1D hat in each dimension
+  std::vector<KernelVector> hat_kernels;
+  hat_kernels.reserve(widthVector.size());
+  for (const auto width : widthVector) {
+    // We've already checked in the validator that the widths are integer
+    // values and well below max int
+    const auto halfWidth = static_cast<size_t>(width) / 2;
+    hat_kernels.emplace_back(2 * halfWidth + 1, 1.0);
   }
-  PARALLEL_CHECK_INTERUPT_REGION
 
-  return outWS;
+  Progress progress(this, 0.0, 1.0, widthVector.size() + 1);
+  return separableSmooth(*toSmooth, hat_kernels, weightingWS, false,
+                         progress);
 }
 
 /**
@@ -282,107 +427,16 @@ IMDHistoWorkspace_sptr
 SmoothMD::gaussianSmooth(IMDHistoWorkspace_const_sptr toSmooth,
                          const WidthVector &widthVector,
                          OptionalIMDHistoWorkspace_const_sptr weightingWS) {
-
-  const bool useWeights = weightingWS.is_initialized();
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
-  // Create the output workspace
-  IMDHistoWorkspace_sptr outWS(toSmooth->clone().release());
-  // Create a temporary workspace
-  IMDHistoWorkspace_sptr tempWS(toSmooth->clone().release());
-  progress.reportIncrement(
-      size_t(double(nPoints) * 0.1)); // Report ~10% progress
-
-  // Create a kernel for each dimension and
+  // Create a kernel for each dimension
   std::vector<KernelVector> gaussian_kernels;
   gaussian_kernels.reserve(widthVector.size());
   for (const auto width : widthVector) {
     gaussian_kernels.push_back(gaussianKernel(width));
   }
 
-  const int nThreads = Mantid::API::FrameworkManager::Instance()
-                           .getNumOMPThreads(); // NThreads to Request
-
-  auto read_ws = outWS;
-  auto write_ws = tempWS;
-  for (size_t dimension_number = 0; dimension_number < widthVector.size();
-       ++dimension_number) {
-
-    auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-    // Alternately write to each workspace
-    if (dimension_number % 2 == 0) {
-      read_ws = outWS;
-      write_ws = tempWS;
-    } else {
-      read_ws = tempWS;
-      write_ws = outWS;
-    }
-
-    PARALLEL_FOR_NO_WSP_CHECK()
-    for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
-
-      PARALLEL_START_INTERUPT_REGION
-      auto iterator =
-          dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
-      if (!iterator) {
-        throw std::logic_error(
-            "Failed to cast IMDIterator to MDHistoWorkspaceIterator");
-      }
-
-      do {
-
-        // Gets linear index at current position
-        size_t iteratorIndex = iterator->getLinearIndex();
-
-        if (useWeights) {
-
-          // Check that we could measure here.
-          if ((*weightingWS)->getSignalAt(iteratorIndex) == 0) {
-
-            write_ws->setSignalAt(iteratorIndex,
-                                  std::numeric_limits<double>::quiet_NaN());
-            write_ws->setErrorSquaredAt(
-                iteratorIndex, std::numeric_limits<double>::quiet_NaN());
-
-            continue; // Skip we couldn't measure here.
-          }
-        }
-
-        std::pair<std::vector<size_t>, std::vector<bool>> indexesAndValidity =
-            iterator->findNeighbourIndexesByWidth1D(
-                static_cast<int>(gaussian_kernels[dimension_number].size()),
-                static_cast<int>(dimension_number));
-        std::vector<size_t> neighbourIndexes = std::get<0>(indexesAndValidity);
-        std::vector<bool> indexValidity = std::get<1>(indexesAndValidity);
-        auto normalised_kernel = renormaliseKernel(
-            gaussian_kernels[dimension_number], indexValidity);
-
-        // Convolve signal with kernel
-        double sumSignal = 0;
-        double sumSquareError = 0;
-        double error = 0;
-        for (size_t i = 0; i < neighbourIndexes.size(); ++i) {
-          if (indexValidity[i]) {
-            sumSignal += read_ws->getSignalAt(neighbourIndexes[i]) *
-                         normalised_kernel[i];
-            error =
-                read_ws->getErrorAt(neighbourIndexes[i]) * normalised_kernel[i];
-            sumSquareError += error * error;
-          }
-
-          write_ws->setSignalAt(iteratorIndex, sumSignal);
-          write_ws->setErrorSquaredAt(iteratorIndex, sumSquareError);
-        }
-        progress.report();
-
-      } while (iterator->next());
-      PARALLEL_END_INTERUPT_REGION
-    }
-    PARALLEL_CHECK_INTERUPT_REGION
-  }
-
-  return write_ws;
+  Progress progress(this, 0.0, 1.0, widthVector.size() + 1);
+  return separableSmooth(*toSmooth, gaussian_kernels, weightingWS, true,
+                         progress);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -8,9 +8,11 @@
 #define MANTID_MDALGORITHMS_ACCUMULATEMDTEST_H_
 
 #include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/ExperimentInfo.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidMDAlgorithms/AccumulateMD.h"
+#include "MantidMDAlgorithms/CreateMD.h"
 #include "MantidTestHelpers/MDEventsTestHelper.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include <Poco/File.h>
@@ -351,6 +353,102 @@ public:
     // as create from clean so lost data in data_source_1
     TS_ASSERT_EQUALS(in_ws->getNEvents(), out_ws->getNEvents());
   }
+
+  void test_clean_does_not_accept_data_sources_to_remove() {
+    AccumulateMD acc_alg;
+    acc_alg.initialize();
+    acc_alg.setPropertyValue("DataSources", "data_source_2");
+    acc_alg.setPropertyValue("RemoveDataSources", "data_source_1");
+    acc_alg.setProperty("Clean", true);
+    // validateInputs is only public through the IAlgorithm interface
+    const auto errors =
+        static_cast<Mantid::API::IAlgorithm &>(acc_alg).validateInputs();
+    TS_ASSERT_EQUALS(errors.count("RemoveDataSources"), 1);
+  }
+
+  void test_record_data_sources() {
+    auto ws = makeAnyMDEW<MDEvent<3>, 3>(2, 0.0, 10.0, 1);
+    ws->addExperimentInfo(boost::make_shared<ExperimentInfo>());
+    ws->addExperimentInfo(boost::make_shared<ExperimentInfo>());
+    const uint16_t numRuns = ws->getNumExperimentInfo();
+
+    // Nothing is recorded unless there is one data source per run
+    Mantid::MDAlgorithms::recordDataSources(*ws, {"too_few"});
+    auto recorded = Mantid::MDAlgorithms::getRecordedDataSources(*ws);
+    TS_ASSERT_EQUALS(recorded, std::vector<std::string>(numRuns, ""));
+
+    std::vector<std::string> data_sources(numRuns, "data_source_a");
+    data_sources.back() = "data_source_b";
+    Mantid::MDAlgorithms::recordDataSources(*ws, data_sources);
+    recorded = Mantid::MDAlgorithms::getRecordedDataSources(*ws);
+    TS_ASSERT_EQUALS(recorded, data_sources);
+  }
+
+  void test_algorithm_success_remove_data() {
+    auto sim_alg = Mantid::API::AlgorithmManager::Instance().create(
+        "CreateSimulationWorkspace");
+    sim_alg->initialize();
+    sim_alg->setPropertyValue("Instrument", "MAR");
+    sim_alg->setPropertyValue("BinParams", "-3,1,3");
+    sim_alg->setPropertyValue("UnitX", "DeltaE");
+    sim_alg->setPropertyValue("OutputWorkspace", "data_source_1");
+    sim_alg->execute();
+
+    sim_alg->setPropertyValue("OutputWorkspace", "data_source_2");
+    sim_alg->execute();
+
+    auto log_alg =
+        Mantid::API::AlgorithmManager::Instance().create("AddSampleLog");
+    log_alg->initialize();
+    log_alg->setProperty("Workspace", "data_source_1");
+    log_alg->setPropertyValue("LogName", "Ei");
+    log_alg->setPropertyValue("LogText", "3.0");
+    log_alg->setPropertyValue("LogType", "Number");
+    log_alg->execute();
+
+    log_alg->setProperty("Workspace", "data_source_2");
+    log_alg->execute();
+
+    auto create_alg =
+        Mantid::API::AlgorithmManager::Instance().create("CreateMD");
+    create_alg->setRethrows(true);
+    create_alg->initialize();
+    create_alg->setPropertyValue("OutputWorkspace", "md_sample_workspace");
+    create_alg->setPropertyValue("DataSources", "data_source_1,data_source_2");
+    create_alg->setPropertyValue("Alatt", "1,1,1");
+    create_alg->setPropertyValue("Angdeg", "90,90,90");
+    create_alg->setPropertyValue("Efix", "12.0");
+    create_alg->setPropertyValue("u", "1,0,0");
+    create_alg->setPropertyValue("v", "0,1,0");
+    create_alg->execute();
+    IMDEventWorkspace_sptr in_ws =
+        boost::dynamic_pointer_cast<IMDEventWorkspace>(
+            AnalysisDataService::Instance().retrieve("md_sample_workspace"));
+    TS_ASSERT_EQUALS(in_ws->getNumExperimentInfo(), 2);
+    const uint64_t in_events = in_ws->getNEvents();
+
+    AccumulateMD acc_alg;
+    acc_alg.initialize();
+    acc_alg.setPropertyValue("InputWorkspace", "md_sample_workspace");
+    acc_alg.setPropertyValue("OutputWorkspace", "accumulated_workspace");
+    acc_alg.setPropertyValue("RemoveDataSources", "data_source_1");
+    acc_alg.setPropertyValue("Alatt", "1,1,1");
+    acc_alg.setPropertyValue("Angdeg", "90,90,90");
+    acc_alg.setPropertyValue("u", "1,0,0");
+    acc_alg.setPropertyValue("v", "0,1,0");
+    TS_ASSERT_THROWS_NOTHING(acc_alg.execute());
+    IMDEventWorkspace_sptr out_ws =
+        boost::dynamic_pointer_cast<IMDEventWorkspace>(
+            AnalysisDataService::Instance().retrieve("accumulated_workspace"));
+
+    // Only the run of data_source_2 is left, and the input is unchanged
+    TS_ASSERT_EQUALS(out_ws->getNumExperimentInfo(), 1);
+    TS_ASSERT_EQUALS(Mantid::MDAlgorithms::getRecordedDataSources(*out_ws),
+                     std::vector<std::string>(1, "data_source_2"));
+    TS_ASSERT_EQUALS(2 * out_ws->getNEvents(), in_events);
+    TS_ASSERT_EQUALS(in_ws->getNEvents(), in_events);
+    TS_ASSERT_EQUALS(in_ws->getNumExperimentInfo(), 2);
+  }
 };
 
 #endif /* MANTID_MDALGORITHMS_ACCUMULATEMDTEST_H_ */
@@ -176,7 +176,8 @@ public:
   //=================================================================================================================
   template <size_t nd>
   void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true,
-                    double memory = 0, bool BoxStructureOnly = false) {
+                    double memory = 0, bool BoxStructureOnly = false,
+                    const std::string &fileBackEndFormat = "NeXus") {
     using MDE = MDLeanEvent<nd>;
 
     //------ Start by creating the file
@@ -228,6 +229,8 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filename", filename));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("FileBackEnd", FileBackEnd));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Memory", memory));
+    TS_ASSERT_THROWS_NOTHING(
+        alg.setPropertyValue("FileBackEndFormat", fileBackEndFormat));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("MetadataOnly", false));
@@ -412,6 +415,27 @@ public:
     do_test_exec<3>(true, true, 1.0);
   }
 
+  /// Keep the events in a mapped scratch copy of the file
+  void test_exec_3D_with_mapped_FileBackEnd() {
+    do_test_exec<3>(true, true, 0.0, false, "Mapped");
+  }
+
+  /// Run the loading into a small cache of a mapped scratch file
+  void test_exec_3D_with_mapped_FileBackEnd_andSmallBuffer() {
+    do_test_exec<3>(true, true, 1.0, false, "Mapped");
+  }
+
+  /// Keep the events quantized in memory; they stay within the tolerance of
+  /// the comparison
+  void test_exec_3D_with_quantized_FileBackEnd() {
+    do_test_exec<3>(true, true, 0.0, false, "Quantized");
+  }
+
+  /// Run the loading into a small cache of quantized events
+  void test_exec_3D_with_quantized_FileBackEnd_andSmallBuffer() {
+    do_test_exec<3>(true, true, 1.0, false, "Quantized");
+  }
+
   /** Use the file back end,
    * then change it and save to update the file at the back end.
    */
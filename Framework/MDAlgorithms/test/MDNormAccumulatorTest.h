@@ -0,0 +1,74 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_MDALGORITHMS_MDNORMACCUMULATORTEST_H_
+#define MANTID_MDALGORITHMS_MDNORMACCUMULATORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
+
+#include <vector>
+
+using Mantid::MDAlgorithms::MDNormAccumulator;
+using Mantid::signal_t;
+
+class MDNormAccumulatorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDNormAccumulatorTest *createSuite() {
+    return new MDNormAccumulatorTest();
+  }
+  static void destroySuite(MDNormAccumulatorTest *suite) { delete suite; }
+
+  void test_numberOfThreads() {
+    MDNormAccumulator accumulator(100);
+    TS_ASSERT_EQUALS(accumulator.numberOfThreads(), PARALLEL_GET_MAX_THREADS);
+    TS_ASSERT(!accumulator.isShared());
+  }
+
+  void test_large_workspace_keeps_all_threads() {
+    // 1000 bins need 8 kB per thread, more than the 1 kB allowed
+    MDNormAccumulator accumulator(1000, 1);
+    TS_ASSERT_EQUALS(accumulator.numberOfThreads(), PARALLEL_GET_MAX_THREADS);
+    TS_ASSERT_EQUALS(accumulator.isShared(), PARALLEL_GET_MAX_THREADS > 1);
+  }
+
+  void test_parallel_sum() { do_test_parallel_sum(MDNormAccumulator(10)); }
+
+  void test_parallel_sum_shared() {
+    do_test_parallel_sum(MDNormAccumulator(10, 0));
+  }
+
+  void test_unused_accumulator_gives_zero() {
+    MDNormAccumulator accumulator(3);
+    std::vector<signal_t> signal(3, 5.);
+    accumulator.addTo(signal.data(), true);
+    TS_ASSERT_EQUALS(signal, std::vector<signal_t>(3, 5.));
+    accumulator.addTo(signal.data(), false);
+    TS_ASSERT_EQUALS(signal, std::vector<signal_t>(3, 0.));
+  }
+
+private:
+  void do_test_parallel_sum(MDNormAccumulator &&accumulator) {
+    const size_t nPoints = 10;
+    const int64_t nContributions = 10000;
+    PRAGMA_OMP(parallel for num_threads(accumulator.numberOfThreads()))
+    for (int64_t i = 0; i < nContributions; ++i) {
+      accumulator.add(PARALLEL_THREAD_NUMBER, i % nPoints, 1.);
+    }
+
+    std::vector<signal_t> signal(nPoints, 5.);
+    accumulator.addTo(signal.data(), false);
+    TS_ASSERT_EQUALS(signal, std::vector<signal_t>(nPoints, 1000.));
+    accumulator.addTo(signal.data(), true);
+    TS_ASSERT_EQUALS(signal, std::vector<signal_t>(nPoints, 2000.));
+  }
+};
+
+#endif /* MANTID_MDALGORITHMS_MDNORMACCUMULATORTEST_H_ */
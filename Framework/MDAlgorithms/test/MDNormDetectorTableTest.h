@@ -0,0 +1,123 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_MDALGORITHMS_MDNORMDETECTORTABLETEST_H_
+#define MANTID_MDALGORITHMS_MDNORMDETECTORTABLETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidMDAlgorithms/MDNormDetectorTable.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cmath>
+
+using Mantid::MDAlgorithms::MDNormDetectorTable;
+using Mantid::Kernel::V3D;
+
+class MDNormDetectorTableTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDNormDetectorTableTest *createSuite() {
+    return new MDNormDetectorTableTest();
+  }
+  static void destroySuite(MDNormDetectorTableTest *suite) { delete suite; }
+
+  void test_detector_directions() {
+    auto ws =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(4, 3);
+    const auto &spectrumInfo = ws->spectrumInfo();
+    MDNormDetectorTable table(*ws, spectrumInfo.samplePosition(), beamDir(*ws),
+                              nullptr, nullptr);
+    TS_ASSERT_EQUALS(table.size(), 4);
+    for (size_t i = 0; i < table.size(); ++i) {
+      TS_ASSERT(table[i].use);
+      TS_ASSERT_DELTA(table[i].theta, spectrumInfo.twoTheta(i), 1e-10);
+      const V3D position = spectrumInfo.position(i);
+      TS_ASSERT_DELTA(table[i].phi, std::atan2(position.Y(), position.X()),
+                      1e-10);
+      TS_ASSERT_EQUALS(table[i].solidAngle, 1.);
+    }
+  }
+
+  void test_flux_and_solid_angle_lookup() {
+    auto ws =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(4, 3);
+    // Only has the first two detectors
+    auto solidAngleWS =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(2, 1);
+    solidAngleWS->mutableY(0)[0] = 0.25;
+    solidAngleWS->mutableY(1)[0] = 0.5;
+    ws->mutableSpectrumInfo().setMasked(0, true);
+
+    MDNormDetectorTable table(*ws, ws->spectrumInfo().samplePosition(),
+                              beamDir(*ws), ws.get(), solidAngleWS.get());
+    TS_ASSERT_EQUALS(table.size(), 4);
+    TS_ASSERT(!table[0].use);
+    TS_ASSERT(table[1].use);
+    TS_ASSERT_EQUALS(table[1].fluxIndex, 1);
+    TS_ASSERT_EQUALS(table[1].solidAngle, 0.5);
+    TS_ASSERT(!table[2].use);
+    TS_ASSERT(!table[3].use);
+  }
+
+  void test_isValidFor() {
+    auto ws =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(4, 3);
+    MDNormDetectorTable table(*ws, ws->spectrumInfo().samplePosition(),
+                              beamDir(*ws), nullptr, nullptr);
+    TS_ASSERT(table.isValidFor(*ws));
+
+    auto sameInstrument = ws->clone();
+    TS_ASSERT(table.isValidFor(*sameInstrument));
+
+    auto masked = ws->clone();
+    masked->mutableSpectrumInfo().setMasked(2, true);
+    TS_ASSERT(!table.isValidFor(*masked));
+
+    auto smaller =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(3, 3);
+    TS_ASSERT(!table.isValidFor(*smaller));
+  }
+
+  void test_create_reuses_entries_of_an_earlier_table() {
+    auto ws =
+        WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(4, 3);
+    const V3D samplePos = ws->spectrumInfo().samplePosition();
+    auto first = MDNormDetectorTable::create(*ws, samplePos, beamDir(*ws),
+                                             nullptr, nullptr, true);
+    auto again = ws->clone();
+    auto second = MDNormDetectorTable::create(*again, samplePos, beamDir(*ws),
+                                              nullptr, nullptr, true);
+    TS_ASSERT_DIFFERS(first, second);
+    TS_ASSERT(second->isValidFor(*again));
+    TS_ASSERT_EQUALS(second->size(), first->size());
+    for (size_t i = 0; i < first->size(); ++i) {
+      TS_ASSERT_EQUALS((*second)[i].use, (*first)[i].use);
+      TS_ASSERT_EQUALS((*second)[i].theta, (*first)[i].theta);
+      TS_ASSERT_EQUALS((*second)[i].phi, (*first)[i].phi);
+    }
+
+    // A masked detector must not pick up the kept entries
+    auto masked = ws->clone();
+    masked->mutableSpectrumInfo().setMasked(2, true);
+    auto third = MDNormDetectorTable::create(*masked, samplePos, beamDir(*ws),
+                                             nullptr, nullptr, true);
+    TS_ASSERT(!(*third)[2].use);
+    TS_ASSERT((*third)[1].use);
+  }
+
+private:
+  V3D beamDir(const Mantid::API::MatrixWorkspace &ws) {
+    const auto &spectrumInfo = ws.spectrumInfo();
+    V3D dir = spectrumInfo.samplePosition() - spectrumInfo.sourcePosition();
+    dir.normalize();
+    return dir;
+  }
+};
+
+#endif /* MANTID_MDALGORITHMS_MDNORMDETECTORTABLETEST_H_ */
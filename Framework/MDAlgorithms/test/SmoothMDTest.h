@@ -408,6 +408,36 @@ public:
     }
   }
 
+  void test_convolve_dimension_with_short_and_long_kernels() {
+    // A 3 x 40 array, convolved along its second dimension
+    const std::vector<size_t> shape{3, 40};
+    std::vector<double> data(3 * 40);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<double>((i * 37) % 11);
+    }
+    // The long kernel is applied by FFT
+    for (const size_t kernelSize : {5, 33, 79}) {
+      std::vector<double> kernel(kernelSize);
+      for (size_t i = 0; i < kernelSize; ++i) {
+        kernel[i] = 1.0 + static_cast<double>(i % 3);
+      }
+      auto convolved = data;
+      Mantid::MDAlgorithms::convolveDimension(convolved, shape, 1, kernel);
+
+      const auto half = static_cast<int>(kernelSize / 2);
+      for (int x = 0; x < 3; ++x) {
+        for (int y = 0; y < 40; ++y) {
+          double expected = 0.0;
+          for (int offset = -half; offset <= half; ++offset) {
+            if (y + offset >= 0 && y + offset < 40)
+              expected += kernel[offset + half] * data[x + 3 * (y + offset)];
+          }
+          TS_ASSERT_DELTA(convolved[x + 3 * y], expected, 1e-9);
+        }
+      }
+    }
+  }
+
   void test_simple_smooth_gaussian_function() {
     auto toSmooth = MDEventsTestHelper::makeFakeMDHistoWorkspace(
         1 /*signal*/, 2 /*numDims*/, 3 /*numBins in each dimension*/);
@@ -486,11 +516,43 @@ public:
       TS_ASSERT_DELTA(expected_error[i], out->getErrorAt(i), 0.001);
     }
   }
+
+  void test_smooth_gaussian_with_normalization_guidance() {
+    const size_t nd = 1;
+    MDHistoWorkspace_sptr toSmooth =
+        MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0 /*signal value*/, nd,
+                                                     10);
+    toSmooth->setSignalAt(9, 100);
+
+    MDHistoWorkspace_sptr normWs = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        1.0 /*signal value*/, nd, 10);
+    normWs->setSignalAt(9, 0);
+
+    SmoothMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    WidthVector widthVector(1, 3);
+    alg.setProperty("WidthVector", widthVector);
+    alg.setProperty("InputWorkspace", toSmooth);
+    alg.setProperty("InputNormalizationWorkspace", normWs);
+    alg.setProperty("Function", "Gaussian");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.execute();
+    IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+
+    // The masked bin is ignored by its neighbours
+    for (size_t i = 0; i < 9; ++i) {
+      TS_ASSERT_DELTA(2.0, out->getSignalAt(i), 1e-9);
+    }
+    TS_ASSERT(std::isnan(out->getSignalAt(9)));
+    TS_ASSERT(std::isnan(out->getErrorAt(9)));
+  }
 };
 
 class SmoothMDTestPerformance : public CxxTest::TestSuite {
 private:
   IMDHistoWorkspace_sptr m_toSmooth;
+  IMDHistoWorkspace_sptr m_toSmooth4D;
 
 public:
   // This pair of boilerplate methods prevent the suite being created statically
@@ -503,6 +565,8 @@ public:
   SmoothMDTestPerformance() {
     m_toSmooth = MDEventsTestHelper::makeFakeMDHistoWorkspace(
         1 /*signal*/, 2 /*numDims*/, 500 /*numBins in each dimension*/);
+    m_toSmooth4D = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        1 /*signal*/, 4 /*numDims*/, 40 /*numBins in each dimension*/);
   }
 
   void test_execute_hat_function() {
@@ -545,6 +609,32 @@ public:
     IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
     TS_ASSERT(out);
   }
+  void test_execute_hat_function_4D() {
+    SmoothMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    WidthVector widthVector(1, 7); // Smooth with width == 7
+    alg.setProperty("WidthVector", widthVector);
+    alg.setProperty("InputWorkspace", m_toSmooth4D);
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.execute();
+    IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+    TS_ASSERT(out);
+  }
+
+  void test_execute_wide_gaussian_function_4D() {
+    SmoothMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    WidthVector widthVector(1, 20); // Kernels long enough for FFT
+    alg.setProperty("WidthVector", widthVector);
+    alg.setProperty("InputWorkspace", m_toSmooth4D);
+    alg.setProperty("Function", "Gaussian");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.execute();
+    IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+    TS_ASSERT(out);
+  }
 };
 
 #endif /* MANTID_MDALGORITHMS_SMOOTHMDTEST_H_ */
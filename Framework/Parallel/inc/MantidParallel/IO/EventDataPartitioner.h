@@ -19,15 +19,27 @@ namespace IO {
 /** Partition the event_time_offset and event_id entries and combine them with
   pulse time information obtained from PulseTimeGenerator. Partitioning is to
   obtain a separate vector of events for each rank in an MPI run of Mantid,
-  i.e., each event_id is assigned to a specific MPI rank. Currently a
-  round-robin partitioning scheme is hard-coded.
+  i.e., each event_id is assigned to a specific MPI rank, or to a specific
+  thread when running in a single process. Currently a round-robin
+  partitioning scheme is hard-coded. Events with a negative spectrum index
+  have no event list. They are kept in the first partition with an index of
+  -1, so the parser can count those passing its filter as discarded. Weights
+  of the events are optional, events without a weight get a weight of 1.
 
   @author Simon Heybrock
   @date 2017
 */
 namespace detail {
 template <class TimeOffsetType> struct Event {
+  Event() = default;
+  Event(const int32_t index, const TimeOffsetType tof,
+        const Types::Core::DateAndTime pulseTime, const float weight = 1.0f)
+      : index(index), weight(weight), tof(tof), pulseTime(pulseTime) {}
+
   int32_t index; // local spectrum index
+  // Placed next to the index, where it fits into the padding before a 64 bit
+  // time-of-flight.
+  float weight;
   TimeOffsetType tof;
   Types::Core::DateAndTime pulseTime;
 };
@@ -45,13 +57,25 @@ public:
    * @param partitioned output vector of data for each partition
    * @param globalSpectrumIndex list of spectrum indices
    * @param eventTimeOffset list TOF values, same length as globalSpectrumIndex
+   * @param eventWeight list of weights, same length as globalSpectrumIndex, or
+   * nullptr if the events are not weighted
    * @param range defines start and end of data for lookup in PulseTimeGenerator
    */
   virtual void partition(std::vector<std::vector<Event>> &partitioned,
                          const int32_t *globalSpectrumIndex,
                          const TimeOffsetType *eventTimeOffset,
+                         const float *eventWeight,
                          const Chunker::LoadRange &range) = 0;
 
+  /// Partition given data of events without weights.
+  void partition(std::vector<std::vector<Event>> &partitioned,
+                 const int32_t *globalSpectrumIndex,
+                 const TimeOffsetType *eventTimeOffset,
+                 const Chunker::LoadRange &range) {
+    partition(partitioned, globalSpectrumIndex, eventTimeOffset, nullptr,
+              range);
+  }
+
 protected:
   const int m_numWorkers;
 };
@@ -66,9 +90,11 @@ public:
       : AbstractEventDataPartitioner<TimeOffsetType>(numWorkers),
         m_pulseTimes(std::move(gen)) {}
 
+  using AbstractEventDataPartitioner<TimeOffsetType>::partition;
   void partition(std::vector<std::vector<Event>> &partitioned,
                  const int32_t *globalSpectrumIndex,
                  const TimeOffsetType *eventTimeOffset,
+                 const float *eventWeight,
                  const Chunker::LoadRange &range) override;
 
 private:
@@ -79,7 +105,7 @@ template <class IndexType, class TimeZeroType, class TimeOffsetType>
 void EventDataPartitioner<IndexType, TimeZeroType, TimeOffsetType>::partition(
     std::vector<std::vector<Event>> &partitioned,
     const int32_t *globalSpectrumIndex, const TimeOffsetType *eventTimeOffset,
-    const Chunker::LoadRange &range) {
+    const float *eventWeight, const Chunker::LoadRange &range) {
   for (auto &item : partitioned)
     item.clear();
   const auto workers =
@@ -88,11 +114,19 @@ void EventDataPartitioner<IndexType, TimeZeroType, TimeOffsetType>::partition(
 
   m_pulseTimes.seek(range.eventOffset);
   for (size_t event = 0; event < range.eventCount; ++event) {
+    const auto pulseTime = m_pulseTimes.next();
+    const float weight = eventWeight ? eventWeight[event] : 1.0f;
+    // A negative index marks an event without a matching spectrum.
+    if (globalSpectrumIndex[event] < 0) {
+      partitioned[0].emplace_back(-1, eventTimeOffset[event], pulseTime,
+                                  weight);
+      continue;
+    }
     // Currently this supports only a hard-coded round-robin partitioning.
     int partition = globalSpectrumIndex[event] % workers;
     auto index = globalSpectrumIndex[event] / workers;
-    partitioned[partition].emplace_back(detail::Event<TimeOffsetType>{
-        index, eventTimeOffset[event], m_pulseTimes.next()});
+    partitioned[partition].emplace_back(index, eventTimeOffset[event],
+                                        pulseTime, weight);
   }
 }
 
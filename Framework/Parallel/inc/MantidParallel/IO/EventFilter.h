@@ -0,0 +1,81 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#ifndef MANTID_PARALLEL_IO_EVENTFILTER_H_
+#define MANTID_PARALLEL_IO_EVENTFILTER_H_
+
+#include "MantidTypes/Core/DateAndTime.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace Mantid {
+namespace Parallel {
+namespace IO {
+
+/** Selection of the events to keep when parsing event data. The default
+  keeps all events. Both ranges are inclusive, as in LoadEventNexus.
+*/
+struct EventFilter {
+  /// Smallest time-of-flight to keep, in microseconds
+  double tofMin{std::numeric_limits<double>::lowest()};
+  /// Largest time-of-flight to keep, in microseconds
+  double tofMax{std::numeric_limits<double>::max()};
+  /// Earliest pulse time to keep
+  Types::Core::DateAndTime pulseTimeStart{
+      Types::Core::DateAndTime::minimum()};
+  /// Latest pulse time to keep
+  Types::Core::DateAndTime pulseTimeStop{
+      Types::Core::DateAndTime::maximum()};
+
+  /// True if the event passes the filter
+  bool accept(const double tof,
+              const Types::Core::DateAndTime &pulseTime) const {
+    return tof >= tofMin && tof <= tofMax && pulseTime >= pulseTimeStart &&
+           pulseTime <= pulseTimeStop;
+  }
+};
+
+/** Summary of the events added to the event lists while parsing.
+ */
+struct EventStatistics {
+  /// Times-of-flight at or above this are counted as bad and ignored for
+  /// longestTof. They usually stem from errors in the raw DAS data.
+  static constexpr double BAD_TOF = 2e8;
+
+  /// Shortest time-of-flight of the events kept, in microseconds
+  double shortestTof{std::numeric_limits<double>::max()};
+  /// Longest time-of-flight below BAD_TOF of the events kept, in microseconds
+  double longestTof{0.0};
+  /// Number of events kept with a time-of-flight of BAD_TOF or more
+  size_t badTofs{0};
+  /// Number of events dropped since there is no event list for their ID
+  size_t discardedEvents{0};
+
+  /// Account for an event that was added to an event list
+  void add(const double tof) {
+    shortestTof = std::min(shortestTof, tof);
+    if (tof < BAD_TOF)
+      longestTof = std::max(longestTof, tof);
+    else
+      ++badTofs;
+  }
+
+  /// Combine with the statistics of other events
+  void merge(const EventStatistics &other) {
+    shortestTof = std::min(shortestTof, other.shortestTof);
+    longestTof = std::max(longestTof, other.longestTof);
+    badTofs += other.badTofs;
+    discardedEvents += other.discardedEvents;
+  }
+};
+
+} // namespace IO
+} // namespace Parallel
+} // namespace Mantid
+
+#endif /* MANTID_PARALLEL_IO_EVENTFILTER_H_ */
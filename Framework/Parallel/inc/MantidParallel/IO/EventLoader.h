@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "MantidParallel/DllConfig.h"
+#include "MantidParallel/IO/EventFilter.h"
 
 namespace Mantid {
 namespace Types {
@@ -24,7 +25,11 @@ class Communicator;
 namespace IO {
 
 /** Loader for event data from Nexus files with parallelism based on multiple
-  processes (MPI) for performance.
+  processes (MPI) for performance. Within a single process the parsing of the
+  events is spread across threads instead.
+
+  The weights of weighted (simulated) events are loaded into separate lists
+  next to the event lists, since the loader knows TofEvent only.
 
   @author Simon Heybrock
   @date 2017
@@ -34,11 +39,18 @@ MANTID_PARALLEL_DLL std::unordered_map<int32_t, size_t>
 makeAnyEventIdToBankMap(const std::string &filename,
                         const std::string &groupName,
                         const std::vector<std::string> &bankNames);
-MANTID_PARALLEL_DLL void
+MANTID_PARALLEL_DLL EventStatistics
 load(const Communicator &communicator, const std::string &filename,
      const std::string &groupName, const std::vector<std::string> &bankNames,
      const std::vector<int32_t> &bankOffsets,
-     std::vector<std::vector<Types::Event::TofEvent> *> eventLists);
+     std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+     std::vector<std::vector<float> *> weightLists = {},
+     const EventFilter &filter = EventFilter{}, const int numThreads = 1);
+MANTID_PARALLEL_DLL EventStatistics loadSingleSpectrumBanks(
+    const std::string &filename, const std::string &groupName,
+    const std::vector<std::string> &bankNames,
+    std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+    const EventFilter &filter = EventFilter{}, const int numThreads = 1);
 } // namespace EventLoader
 
 } // namespace IO
@@ -30,7 +30,9 @@ std::vector<size_t> readBankSizes(const H5::Group &group,
                                   const std::vector<std::string> &bankNames) {
   std::vector<size_t> bankSizes;
   for (const auto &bankName : bankNames) {
-    const H5::DataSet dataset = group.openDataSet(bankName + "/event_id");
+    // Not event_id, which event monitors may not have
+    const H5::DataSet dataset =
+        group.openDataSet(bankName + "/event_time_offset");
     const H5::DataSpace dataSpace = dataset.getSpace();
     bankSizes.push_back(dataSpace.getSelectNpoints());
   }
@@ -59,6 +61,8 @@ void load(const Chunker &chunker, NXEventDataSource<TimeOffsetType> &dataSource,
   const auto &ranges = chunker.makeLoadRanges();
   std::vector<int32_t> event_id(2 * chunkSize);
   std::vector<TimeOffsetType> event_time_offset(2 * chunkSize);
+  const bool weighted = dataSink.isWeighted();
+  std::vector<float> event_weight(weighted ? 2 * chunkSize : 0);
   // Wait for thread completion before exit. Wrapped in struct in case of
   // exceptions.
   ThreadWaiter<EventParser<TimeOffsetType>> threadCleanup(dataSink);
@@ -74,6 +78,9 @@ void load(const Chunker &chunker, NXEventDataSource<TimeOffsetType> &dataSource,
                            range.eventCount);
     dataSource.readEventTimeOffset(event_time_offset.data() + bufferOffset,
                                    range.eventOffset, range.eventCount);
+    if (weighted)
+      dataSource.readEventWeight(event_weight.data() + bufferOffset,
+                                 range.eventOffset, range.eventCount);
     if (previousBank != -1)
       dataSink.wait();
     if (static_cast<int64_t>(range.bankIndex) != previousBank) {
@@ -82,16 +89,21 @@ void load(const Chunker &chunker, NXEventDataSource<TimeOffsetType> &dataSource,
       previousBank = range.bankIndex;
     }
     dataSink.startAsync(event_id.data() + bufferOffset,
-                        event_time_offset.data() + bufferOffset, range);
+                        event_time_offset.data() + bufferOffset,
+                        weighted ? event_weight.data() + bufferOffset : nullptr,
+                        range);
     bufferOffset = (bufferOffset + chunkSize) % (2 * chunkSize);
   }
 }
 
 template <class TimeOffsetType>
-void load(const Communicator &comm, const H5::Group &group,
-          const std::vector<std::string> &bankNames,
-          const std::vector<int32_t> &bankOffsets,
-          std::vector<std::vector<Types::Event::TofEvent> *> eventLists) {
+EventStatistics
+load(const Communicator &comm, const H5::Group &group,
+     const std::vector<std::string> &bankNames,
+     const std::vector<int32_t> &bankOffsets,
+     std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+     std::vector<std::vector<float> *> weightLists, const EventFilter &filter,
+     const int numThreads, const bool singleSpectrumBanks) {
   // In tests loading from a single SSD this chunk size seems close to the
   // optimum. May need to be adjusted in the future (potentially dynamically)
   // when loading from parallel file systems and running on a cluster.
@@ -102,14 +114,21 @@ void load(const Communicator &comm, const H5::Group &group,
   // required when accessing the parallel file system.
   const Chunker chunker(comm.size(), comm.rank(),
                         readBankSizes(group, bankNames), chunkSize);
-  NXEventDataLoader<TimeOffsetType> loader(comm.size(), group, bankNames);
+  // Within a single process the events are partitioned across threads
+  // instead, see EventParser.
+  const int numPartitions = comm.size() == 1 ? numThreads : comm.size();
+  NXEventDataLoader<TimeOffsetType> loader(numPartitions, group, bankNames,
+                                           singleSpectrumBanks);
   EventParser<TimeOffsetType> consumer(comm, chunker.makeWorkerGroups(),
-                                       bankOffsets, eventLists);
+                                       bankOffsets, std::move(eventLists),
+                                       std::move(weightLists));
+  consumer.setEventFilter(filter);
   load<TimeOffsetType>(chunker, loader, consumer);
+  return consumer.statistics();
 }
 
 /// Translate from H5::DataType to actual type, forward to load implementation.
-template <class... T> void load(const H5::DataType &type, T &&... args) {
+template <class... T> auto load(const H5::DataType &type, T &&... args) {
   if (type == H5::PredType::NATIVE_INT32)
     return load<int32_t>(args...);
   if (type == H5::PredType::NATIVE_INT64)
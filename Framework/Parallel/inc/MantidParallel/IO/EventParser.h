@@ -7,11 +7,13 @@
 #ifndef MANTID_PARALLEL_IO_EVENT_PARSER_H
 #define MANTID_PARALLEL_IO_EVENT_PARSER_H
 
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidParallel/Collectives.h"
 #include "MantidParallel/Communicator.h"
 #include "MantidParallel/DllConfig.h"
 #include "MantidParallel/IO/Chunker.h"
 #include "MantidParallel/IO/EventDataPartitioner.h"
+#include "MantidParallel/IO/EventFilter.h"
 #include "MantidParallel/Nonblocking.h"
 #include "MantidTypes/Event/TofEvent.h"
 
@@ -30,7 +32,10 @@ namespace IO {
 
 /** Distributed (MPI) parsing of Nexus events from a data stream. Data is
 distributed accross MPI ranks for writing to event lists on the correct target
-rank.
+rank. In a single process the data is instead partitioned across threads,
+which then append to disjoint sets of event lists concurrently. For weighted
+events the weight of each event is appended to a list of weights next to its
+event list.
 
 @author Lamar Moore
 @date 2017
@@ -39,7 +44,10 @@ namespace detail {
 void MANTID_PARALLEL_DLL eventIdToGlobalSpectrumIndex(int32_t *event_id_start,
                                                       size_t count,
                                                       const int32_t bankOffset);
-}
+void MANTID_PARALLEL_DLL markInvalidSpectrumIndices(int32_t *index,
+                                                    size_t count,
+                                                    const size_t numSpectra);
+} // namespace detail
 
 template <class TimeOffsetType> class EventParser {
 public:
@@ -47,26 +55,39 @@ public:
   EventParser(const Communicator &comm,
               std::vector<std::vector<int>> rankGroups,
               std::vector<int32_t> bankOffsets,
-              std::vector<std::vector<Types::Event::TofEvent> *> eventLists);
+              std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+              std::vector<std::vector<float> *> weightLists = {});
 
   void setEventDataPartitioner(
       std::unique_ptr<AbstractEventDataPartitioner<TimeOffsetType>>
           partitioner);
   void setEventTimeOffsetUnit(const std::string &unit);
+  void setEventFilter(const EventFilter &filter);
+  const EventStatistics &statistics() const;
+  /// True if the parser appends the weights of the events
+  bool isWeighted() const { return !m_weightLists.empty(); }
 
   void startAsync(int32_t *event_id_start,
                   const TimeOffsetType *event_time_offset_start,
                   const Chunker::LoadRange &range);
+  void startAsync(int32_t *event_id_start,
+                  const TimeOffsetType *event_time_offset_start,
+                  const float *event_weight_start,
+                  const Chunker::LoadRange &range);
 
   void wait();
 
 private:
   void doParsing(int32_t *event_id_start,
                  const TimeOffsetType *event_time_offset_start,
+                 const float *event_weight_start,
                  const Chunker::LoadRange &range);
 
   void redistributeDataMPI();
-  void populateEventLists();
+  void populateEventListsThreaded();
+  void populateEventLists(const std::vector<Event> &events,
+                          const int32_t stride, const int32_t offset,
+                          EventStatistics &statistics) const;
 
   // Default to 0 such that failure to set unit is easily detected.
   double m_timeOffsetScale{0.0};
@@ -74,9 +95,12 @@ private:
   std::vector<std::vector<int>> m_rankGroups;
   std::vector<int32_t> m_bankOffsets;
   std::vector<std::vector<Types::Event::TofEvent> *> m_eventLists;
+  std::vector<std::vector<float> *> m_weightLists;
   std::unique_ptr<AbstractEventDataPartitioner<TimeOffsetType>> m_partitioner;
   std::vector<std::vector<Event>> m_allRankData;
   std::vector<Event> m_thisRankData;
+  EventFilter m_filter;
+  EventStatistics m_statistics;
   std::thread m_thread;
 };
 
@@ -90,6 +114,8 @@ private:
  * @param eventLists workspace event lists which will be populated by the
  * parser. The parser assumes that there always is a matching event list for any
  * event ID that will be passed in via `startAsync`.
+ * @param weightLists lists receiving the weights of the events appended to the
+ * event list of the same index, or empty if the weights are not needed.
  * @param globalToLocalSpectrumIndex lookup table which converts a global
  * spectrum index to a spectrum index local to a given mpi rank
  */
@@ -97,10 +123,12 @@ template <class TimeOffsetType>
 EventParser<TimeOffsetType>::EventParser(
     const Communicator &comm, std::vector<std::vector<int>> rankGroups,
     std::vector<int32_t> bankOffsets,
-    std::vector<std::vector<TofEvent> *> eventLists)
+    std::vector<std::vector<TofEvent> *> eventLists,
+    std::vector<std::vector<float> *> weightLists)
     : m_comm(comm), m_rankGroups(std::move(rankGroups)),
       m_bankOffsets(std::move(bankOffsets)),
-      m_eventLists(std::move(eventLists)) {}
+      m_eventLists(std::move(eventLists)),
+      m_weightLists(std::move(weightLists)) {}
 
 /// Set the EventDataPartitioner to use for parsing subsequent events.
 template <class TimeOffsetType>
@@ -139,15 +167,22 @@ void EventParser<TimeOffsetType>::setEventTimeOffsetUnit(
                            "` for event_time_offset");
 }
 
+/// Set the filter applied to subsequent events. Defaults to keeping all.
+template <class TimeOffsetType>
+void EventParser<TimeOffsetType>::setEventFilter(const EventFilter &filter) {
+  m_filter = filter;
+}
+
+/// Return the statistics of all events parsed so far. Call wait() first.
+template <class TimeOffsetType>
+const EventStatistics &EventParser<TimeOffsetType>::statistics() const {
+  return m_statistics;
+}
+
 /// Convert m_allRankData into m_thisRankData by means of redistribution via
 /// MPI.
 template <class TimeOffsetType>
 void EventParser<TimeOffsetType>::redistributeDataMPI() {
-  if (m_comm.size() == 1) {
-    m_thisRankData = m_allRankData.front();
-    return;
-  }
-
   std::vector<int> sizes(m_allRankData.size());
   std::transform(m_allRankData.cbegin(), m_allRankData.cend(), sizes.begin(),
                  [](const std::vector<Event> &vec) {
@@ -185,19 +220,61 @@ void EventParser<TimeOffsetType>::redistributeDataMPI() {
   Parallel::wait_all(recv_requests.begin(), recv_requests.end());
 }
 
-/// Append events in m_thisRankData to m_eventLists.
+/** Append the events of each partition in m_allRankData to m_eventLists,
+ * with the partitions shared between the OpenMP threads. Used when running in
+ * a single process, where the partitions are by spectrum index modulo the
+ * number of partitions so each thread writes to its own event lists.
+ */
 template <class TimeOffsetType>
-void EventParser<TimeOffsetType>::populateEventLists() {
-  for (const auto &event : m_thisRankData) {
-    m_eventLists[event.index]->emplace_back(
-        m_timeOffsetScale * static_cast<double>(event.tof), event.pulseTime);
+void EventParser<TimeOffsetType>::populateEventListsThreaded() {
+  // Below this running in parallel costs more than it saves.
+  constexpr size_t minEventsForThreads = 64 * 1024;
+  const auto numPartitions = static_cast<int32_t>(m_allRankData.size());
+  size_t numEvents{0};
+  for (const auto &partition : m_allRankData)
+    numEvents += partition.size();
+
+  std::vector<EventStatistics> statistics(numPartitions);
+  PARALLEL_FOR_IF(numEvents >= minEventsForThreads)
+  for (int32_t i = 0; i < numPartitions; ++i)
+    populateEventLists(m_allRankData[i], numPartitions, i, statistics[i]);
+  for (const auto &item : statistics)
+    m_statistics.merge(item);
+}
+
+/** Append events to m_eventLists.
+ *
+ * @param events Events to append, passing the filter.
+ * @param stride Number of partitions the spectrum indices were divided by.
+ * @param offset Partition of the events, the event list of an event is
+ * `index * stride + offset`.
+ * @param statistics Updated with the events that were appended.
+ */
+template <class TimeOffsetType>
+void EventParser<TimeOffsetType>::populateEventLists(
+    const std::vector<Event> &events, const int32_t stride,
+    const int32_t offset, EventStatistics &statistics) const {
+  for (const auto &event : events) {
+    const double tof = m_timeOffsetScale * static_cast<double>(event.tof);
+    if (!m_filter.accept(tof, event.pulseTime))
+      continue;
+    // Events without an event list only count once they pass the filter, as
+    // in the default loader.
+    if (event.index < 0) {
+      ++statistics.discardedEvents;
+      continue;
+    }
+    const auto listIndex = event.index * stride + offset;
+    auto &eventList = *m_eventLists[listIndex];
+    eventList.emplace_back(tof, event.pulseTime);
+    if (!m_weightLists.empty())
+      m_weightLists[listIndex]->push_back(event.weight);
+    statistics.add(tof);
     // In general `index` is random so this loop suffers from frequent cache
     // misses (probably because the hardware prefetchers cannot keep up with the
     // number of different memory locations that are getting accessed). We
     // manually prefetch into L2 cache to reduce the amount of misses.
-    _mm_prefetch(
-        reinterpret_cast<char *>(&m_eventLists[event.index]->back() + 1),
-        _MM_HINT_T1);
+    _mm_prefetch(reinterpret_cast<char *>(&eventList.back() + 1), _MM_HINT_T1);
   }
 }
 
@@ -216,28 +293,53 @@ template <class TimeOffsetType>
 void EventParser<TimeOffsetType>::startAsync(
     int32_t *event_id_start, const TimeOffsetType *event_time_offset_start,
     const Chunker::LoadRange &range) {
+  startAsync(event_id_start, event_time_offset_start, nullptr, range);
+}
+
+/** Asynchronously starts parsing weighted events, see above.
+ * @param event_id_start Buffer containing event IDs.
+ * @param event_time_offset_start Buffer containing TOD.
+ * @param event_weight_start Buffer containing the weights of the events, or
+ * nullptr for a weight of 1.
+ * @param range Bank, file index offset and number of the events.
+ */
+template <class TimeOffsetType>
+void EventParser<TimeOffsetType>::startAsync(
+    int32_t *event_id_start, const TimeOffsetType *event_time_offset_start,
+    const float *event_weight_start, const Chunker::LoadRange &range) {
   // Wrapped in lambda because std::thread is unable to specialize doParsing on
   // its own
-  m_thread =
-      std::thread([this, event_id_start, event_time_offset_start, &range] {
-        doParsing(event_id_start, event_time_offset_start, range);
-      });
+  m_thread = std::thread([this, event_id_start, event_time_offset_start,
+                          event_weight_start, &range] {
+    doParsing(event_id_start, event_time_offset_start, event_weight_start,
+              range);
+  });
 }
 
 template <class TimeOffsetType>
 void EventParser<TimeOffsetType>::doParsing(
     int32_t *event_id_start, const TimeOffsetType *event_time_offset_start,
-    const Chunker::LoadRange &range) {
+    const float *event_weight_start, const Chunker::LoadRange &range) {
   // change event_id_start in place
   detail::eventIdToGlobalSpectrumIndex(event_id_start, range.eventCount,
                                        m_bankOffsets[range.bankIndex]);
 
+  // In a single process there is an event list for every spectrum, so IDs
+  // without a spectrum can be recognized and dropped.
+  if (m_comm.size() == 1)
+    detail::markInvalidSpectrumIndices(event_id_start, range.eventCount,
+                                       m_eventLists.size());
+
   // event_id_start now contains globalSpectrumIndex
   m_partitioner->partition(m_allRankData, event_id_start,
-                           event_time_offset_start, range);
+                           event_time_offset_start, event_weight_start, range);
 
-  redistributeDataMPI();
-  populateEventLists();
+  if (m_comm.size() == 1) {
+    populateEventListsThreaded();
+  } else {
+    redistributeDataMPI();
+    populateEventLists(m_thisRankData, 1, 0, m_statistics);
+  }
 }
 
 template <class TimeOffsetType> void EventParser<TimeOffsetType>::wait() {
@@ -8,6 +8,7 @@
 #define MANTID_PARALLEL_IO_NXEVENTDATALOADER_H_
 
 #include <H5Cpp.h>
+#include <algorithm>
 #include <vector>
 
 #include "MantidKernel/make_unique.h"
@@ -25,6 +26,11 @@ namespace IO {
   event_time_offset. The class is templated such that the types of
   event_index, event_time_zero, and event_time_offset can be set as required.
 
+  The optional event_weight of simulated files is read as well, events of
+  banks without it get a weight of 1. Groups holding the events of a single
+  spectrum, such as event monitors, can be read with all event IDs set to 0,
+  ignoring any event_id.
+
   @author Simon Heybrock
   @date 2017
 */
@@ -32,7 +38,8 @@ template <class TimeOffsetType>
 class NXEventDataLoader : public NXEventDataSource<TimeOffsetType> {
 public:
   NXEventDataLoader(const int numWorkers, const H5::Group &group,
-                    std::vector<std::string> bankNames);
+                    std::vector<std::string> bankNames,
+                    const bool singleSpectrumBanks = false);
 
   std::unique_ptr<AbstractEventDataPartitioner<TimeOffsetType>>
   setBankIndex(const size_t bank) override;
@@ -42,14 +49,19 @@ public:
   void readEventTimeOffset(TimeOffsetType *event_time_offset, size_t start,
                            size_t count) const override;
   std::string readEventTimeOffsetUnit() const override;
+  void readEventWeight(float *event_weight, size_t start,
+                       size_t count) const override;
 
 private:
   const int m_numWorkers;
   const H5::Group m_root;
   H5::Group m_group;
   const std::vector<std::string> m_bankNames;
+  const bool m_singleSpectrumBanks;
   H5::DataSet m_id;
   H5::DataSet m_time_offset;
+  H5::DataSet m_weight;
+  bool m_hasWeight{false};
 };
 
 namespace detail {
@@ -65,14 +77,15 @@ std::vector<T> read(const H5::Group &group, const std::string &dataSetName) {
   return result;
 }
 
-/** Read subset of data set and write the result into buffer.
+/** Read subset of data set and write the result into buffer, converting the
+ * values to the given type.
  *
  * The subset is given by a start index and a count. */
 template <class T>
-void read(T *buffer, const H5::DataSet &dataSet, size_t start, size_t count) {
+void read(T *buffer, const H5::DataSet &dataSet, size_t start, size_t count,
+          const H5::DataType &dataType) {
   auto hstart = static_cast<hsize_t>(start);
   auto hcount = static_cast<hsize_t>(count);
-  H5::DataType dataType = dataSet.getDataType();
   H5::DataSpace dataSpace = dataSet.getSpace();
   if ((static_cast<int64_t>(dataSpace.getSelectNpoints()) -
        static_cast<int64_t>(hstart)) <= 0)
@@ -84,6 +97,20 @@ void read(T *buffer, const H5::DataSet &dataSet, size_t start, size_t count) {
   dataSet.read(buffer, dataType, memSpace, dataSpace);
 }
 
+/** Read subset of data set and write the result into buffer.
+ *
+ * The subset is given by a start index and a count. */
+template <class T>
+void read(T *buffer, const H5::DataSet &dataSet, size_t start, size_t count) {
+  read(buffer, dataSet, start, count, dataSet.getDataType());
+}
+
+/// Return true if the group has a link of the given name.
+inline bool exists(const H5::Group &group, const std::string &name) {
+  // libhdf5 on Ubuntu 14.04 does not have Group::exists, use the C API.
+  return H5Lexists(group.getId(), name.c_str(), H5P_DEFAULT) > 0;
+}
+
 /** Read subset of data set from group and write the result into buffer.
  *
  * The subset is given by a start index and a count. */
@@ -178,21 +205,31 @@ makeEventDataPartitioner(const H5::DataType &type, T2 &&... args) {
 
 /** Constructor from group and bank names in group to load from.
  *
- * Template TimeOffsetType -> type used for reading event_time_offset */
+ * Template TimeOffsetType -> type used for reading event_time_offset
+ * @param numWorkers Number of partitions of the events.
+ * @param group Group holding the banks.
+ * @param bankNames Names of the NXevent_data or NXmonitor groups to load.
+ * @param singleSpectrumBanks If true each bank holds the events of a single
+ * spectrum, and the event IDs are all read as 0. */
 template <class TimeOffsetType>
 NXEventDataLoader<TimeOffsetType>::NXEventDataLoader(
     const int numWorkers, const H5::Group &group,
-    std::vector<std::string> bankNames)
+    std::vector<std::string> bankNames, const bool singleSpectrumBanks)
     : m_numWorkers(numWorkers), m_root(group),
-      m_bankNames(std::move(bankNames)) {}
+      m_bankNames(std::move(bankNames)),
+      m_singleSpectrumBanks(singleSpectrumBanks) {}
 
 /// Set the bank index and return a EventDataPartitioner for that bank.
 template <class TimeOffsetType>
 std::unique_ptr<AbstractEventDataPartitioner<TimeOffsetType>>
 NXEventDataLoader<TimeOffsetType>::setBankIndex(const size_t bank) {
   m_group = m_root.openGroup(m_bankNames[bank]);
-  m_id = m_group.openDataSet("event_id");
+  if (!m_singleSpectrumBanks)
+    m_id = m_group.openDataSet("event_id");
   m_time_offset = m_group.openDataSet("event_time_offset");
+  m_hasWeight = detail::exists(m_group, "event_weight");
+  if (m_hasWeight)
+    m_weight = m_group.openDataSet("event_weight");
   return detail::makeEventDataPartitioner<TimeOffsetType>(
       m_group.openDataSet("event_index").getDataType(),
       m_group.openDataSet("event_time_zero").getDataType(), m_group,
@@ -204,7 +241,10 @@ template <class TimeOffsetType>
 void NXEventDataLoader<TimeOffsetType>::readEventID(int32_t *buffer,
                                                     size_t start,
                                                     size_t count) const {
-  detail::read(buffer, m_id, start, count);
+  if (m_singleSpectrumBanks)
+    std::fill_n(buffer, count, 0);
+  else
+    detail::read(buffer, m_id, start, count);
 }
 
 /// Read subset given by start and count from event_time_offset and write it
@@ -221,6 +261,17 @@ std::string NXEventDataLoader<TimeOffsetType>::readEventTimeOffsetUnit() const {
   return detail::readAttribute(m_time_offset, "units");
 }
 
+/// Read the weights of events, or set them to 1 if the bank has no weights.
+template <class TimeOffsetType>
+void NXEventDataLoader<TimeOffsetType>::readEventWeight(float *buffer,
+                                                        size_t start,
+                                                        size_t count) const {
+  if (m_hasWeight)
+    detail::read(buffer, m_weight, start, count, H5::PredType::NATIVE_FLOAT);
+  else
+    std::fill_n(buffer, count, 1.0f);
+}
+
 } // namespace IO
 } // namespace Parallel
 } // namespace Mantid
@@ -35,6 +35,8 @@ public:
   virtual void readEventTimeOffset(TimeOffsetType *event_time_offset,
                                    size_t start, size_t count) const = 0;
   virtual std::string readEventTimeOffsetUnit() const = 0;
+  virtual void readEventWeight(float *event_weight, size_t start,
+                               size_t count) const = 0;
 };
 
 } // namespace IO
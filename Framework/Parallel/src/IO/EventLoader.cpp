@@ -9,6 +9,7 @@
 #include "MantidParallel/IO/NXEventDataLoader.h"
 
 #include <H5Cpp.h>
+#include <algorithm>
 
 namespace Mantid {
 namespace Parallel {
@@ -39,16 +40,64 @@ makeAnyEventIdToBankMap(const std::string &filename,
   return idToBank;
 }
 
-/// Load events from given banks into event lists.
-void load(const Communicator &comm, const std::string &filename,
-          const std::string &groupName,
-          const std::vector<std::string> &bankNames,
-          const std::vector<int32_t> &bankOffsets,
-          std::vector<std::vector<Types::Event::TofEvent> *> eventLists) {
+/** Load events from given banks into event lists.
+ *
+ * @param comm Communicator of the processes taking part in the load.
+ * @param filename Path of the Nexus file.
+ * @param groupName Name of the NXentry holding the banks.
+ * @param bankNames Names of the NXevent_data groups to load.
+ * @param bankOffsets Offset between event ID and spectrum index of each bank.
+ * @param eventLists Event lists of the spectra of this process.
+ * @param weightLists Lists receiving the weights of the events added to the
+ * event list of the same index. Empty if the weights are not loaded.
+ * @param filter Events outside the filter are not added to the event lists.
+ * @param numThreads Number of threads parsing events. Only used if there is a
+ * single process.
+ * @return Statistics of the events that were added to the event lists.
+ */
+EventStatistics load(const Communicator &comm, const std::string &filename,
+                     const std::string &groupName,
+                     const std::vector<std::string> &bankNames,
+                     const std::vector<int32_t> &bankOffsets,
+                     std::vector<std::vector<Types::Event::TofEvent> *>
+                         eventLists,
+                     std::vector<std::vector<float> *> weightLists,
+                     const EventFilter &filter, const int numThreads) {
+  H5::H5File file(filename, H5F_ACC_RDONLY);
+  H5::Group group = file.openGroup(groupName);
+  return load(readDataType(group, bankNames, "event_time_offset"), comm, group,
+              bankNames, bankOffsets, std::move(eventLists),
+              std::move(weightLists), filter, std::max(1, numThreads), false);
+}
+
+/** Load events from banks holding the events of a single spectrum each, such
+ * as event monitors, in a single process. Any event IDs in the banks are
+ * ignored.
+ *
+ * @param filename Path of the Nexus file.
+ * @param groupName Name of the NXentry holding the banks.
+ * @param bankNames Names of the groups to load.
+ * @param eventLists Event list of each bank.
+ * @param filter Events outside the filter are not added to the event lists.
+ * @param numThreads Number of threads parsing events.
+ * @return Statistics of the events that were added to the event lists.
+ */
+EventStatistics loadSingleSpectrumBanks(
+    const std::string &filename, const std::string &groupName,
+    const std::vector<std::string> &bankNames,
+    std::vector<std::vector<Types::Event::TofEvent> *> eventLists,
+    const EventFilter &filter, const int numThreads) {
   H5::H5File file(filename, H5F_ACC_RDONLY);
   H5::Group group = file.openGroup(groupName);
-  load(readDataType(group, bankNames, "event_time_offset"), comm, group,
-       bankNames, bankOffsets, std::move(eventLists));
+  // All event IDs are read as 0, so the offset of a bank maps them to the
+  // index of its event list.
+  std::vector<int32_t> bankOffsets(bankNames.size());
+  for (size_t i = 0; i < bankNames.size(); ++i)
+    bankOffsets[i] = -static_cast<int32_t>(i);
+  return load(readDataType(group, bankNames, "event_time_offset"),
+              Communicator{}, group, bankNames, bankOffsets,
+              std::move(eventLists), std::vector<std::vector<float> *>{},
+              filter, std::max(1, numThreads), true);
 }
 } // namespace EventLoader
 
@@ -27,6 +27,21 @@ void eventIdToGlobalSpectrumIndex(int32_t *event_id_start, size_t count,
     event_id_start[i] -= bankOffset;
 }
 
+/** Replace spectrum indices that have no spectrum by -1, which makes
+ * EventDataPartitioner mark the corresponding events as having no event list.
+ *
+ * @param index Starting position of chunk of data containing spectrum indices.
+ * @param count Number of items in data chunk
+ * @param numSpectra Number of spectra, valid indices are below this.
+ */
+void markInvalidSpectrumIndices(int32_t *index, size_t count,
+                                const size_t numSpectra) {
+  for (size_t i = 0; i < count; ++i) {
+    if (index[i] < 0 || static_cast<size_t>(index[i]) >= numSpectra)
+      index[i] = -1;
+  }
+}
+
 } // namespace detail
 } // namespace IO
 } // namespace Parallel
@@ -18,7 +18,8 @@ namespace Parallel {
 namespace IO {
 namespace detail {
 bool operator==(const Event<double> &a, const Event<double> &b) {
-  return a.index == b.index && a.tof == b.tof && a.pulseTime == b.pulseTime;
+  return a.index == b.index && a.tof == b.tof && a.pulseTime == b.pulseTime &&
+         a.weight == b.weight;
 }
 } // namespace detail
 } // namespace IO
@@ -135,6 +136,47 @@ public:
     TS_ASSERT_EQUALS(data[1][1], (Event{1, 3.3, DateAndTime(8)}));
     TS_ASSERT_EQUALS(data[1][2], (Event{0, 4.4, DateAndTime(8)}));
   }
+
+  void test_partition_weights() {
+    EventDataPartitioner<int32_t, int64_t, double> partitioner(
+        2, PulseTimeGenerator<int32_t, int64_t>({0, 2, 2, 3}, {2, 4, 6, 8},
+                                                "nanosecond", 0));
+    std::vector<std::vector<Event>> data;
+    std::vector<int32_t> index{5, 1, 4, 1};
+    std::vector<double> tof{1.1, 2.2, 3.3, 4.4};
+    std::vector<float> weight{0.5f, 1.5f, 2.5f, 3.5f};
+    partitioner.partition(data, index.data(), tof.data(), weight.data(),
+                          {0, 0, 4});
+    TS_ASSERT_EQUALS(data.size(), 2);
+    TS_ASSERT_EQUALS(data[0].size(), 1);
+    TS_ASSERT_EQUALS(data[1].size(), 3);
+    // Each weight follows its event into the partition
+    TS_ASSERT_EQUALS(data[1][0], (Event{2, 1.1, DateAndTime(2), 0.5f}));
+    TS_ASSERT_EQUALS(data[1][1], (Event{0, 2.2, DateAndTime(2), 1.5f}));
+    TS_ASSERT_EQUALS(data[0][0], (Event{2, 3.3, DateAndTime(6), 2.5f}));
+    TS_ASSERT_EQUALS(data[1][2], (Event{0, 4.4, DateAndTime(8), 3.5f}));
+    // Without weights every event has unit weight
+    partitioner.partition(data, index.data(), tof.data(), {0, 0, 4});
+    TS_ASSERT_EQUALS(data[0][0], (Event{2, 3.3, DateAndTime(6), 1.0f}));
+  }
+
+  void test_negative_index_is_kept_in_first_partition() {
+    EventDataPartitioner<int32_t, int64_t, double> partitioner(
+        2, PulseTimeGenerator<int32_t, int64_t>({0, 2, 2, 3}, {2, 4, 6, 8},
+                                                "nanosecond", 0));
+    std::vector<std::vector<Event>> data;
+    std::vector<int32_t> index{5, -1, 4, -1};
+    std::vector<double> tof{1.1, 2.2, 3.3, 4.4};
+    partitioner.partition(data, index.data(), tof.data(), {0, 0, 4});
+    TS_ASSERT_EQUALS(data.size(), 2);
+    TS_ASSERT_EQUALS(data[0].size(), 3);
+    TS_ASSERT_EQUALS(data[1].size(), 1);
+    // Pulse times of the events after an invalid one are unaffected
+    TS_ASSERT_EQUALS(data[1][0], (Event{2, 1.1, DateAndTime(2)}));
+    TS_ASSERT_EQUALS(data[0][0], (Event{-1, 2.2, DateAndTime(2)}));
+    TS_ASSERT_EQUALS(data[0][1], (Event{2, 3.3, DateAndTime(6)}));
+    TS_ASSERT_EQUALS(data[0][2], (Event{-1, 4.4, DateAndTime(8)}));
+  }
 };
 
 #endif /* MANTID_PARALLEL_EVENTDATAPARTITIONERTEST_H_ */
@@ -17,6 +17,7 @@
 #include "MantidTypes/Event/TofEvent.h"
 
 #include <H5Cpp.h>
+#include <algorithm>
 
 namespace Mantid {
 namespace Parallel {
@@ -80,6 +81,12 @@ public:
       event_time_offset[i] = static_cast<int32_t>(17 * m_bank + start + i);
   }
 
+  void readEventWeight(float *event_weight, size_t start,
+                       size_t count) const override {
+    for (size_t i = 0; i < count; ++i)
+      event_weight[i] = static_cast<float>(m_bank + 1);
+  }
+
   std::string readEventTimeOffsetUnit() const override {
     // Using nanosecond implies that EventLoader must convert to microsecond,
     // allowing us to see and test the conversion in action.
@@ -92,7 +99,8 @@ private:
   size_t m_bank{0};
 };
 
-void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize) {
+void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize,
+                  const bool weighted) {
   const std::vector<size_t> bankSizes{111, 1111, 11111};
   Chunker chunker(comm.size(), comm.rank(), bankSizes, chunkSize);
   // FakeDataSource encodes information on bank and position in file into TOF
@@ -104,9 +112,14 @@ void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize) {
   std::vector<std::vector<Types::Event::TofEvent> *> eventListPtrs;
   for (auto &eventList : eventLists)
     eventListPtrs.emplace_back(&eventList);
+  std::vector<std::vector<float>> weightLists(weighted ? eventLists.size()
+                                                       : 0);
+  std::vector<std::vector<float> *> weightListPtrs;
+  for (auto &weightList : weightLists)
+    weightListPtrs.emplace_back(&weightList);
 
   EventParser<int32_t> dataSink(comm, chunker.makeWorkerGroups(), bankOffsets,
-                                eventListPtrs);
+                                eventListPtrs, weightListPtrs);
   TS_ASSERT_THROWS_NOTHING(
       (EventLoader::load<int32_t>(chunker, dataSource, dataSink)));
 
@@ -117,6 +130,15 @@ void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize) {
     size_t pixelInBank = globalSpectrumIndex % 77;
     TS_ASSERT_EQUALS(eventLists[localSpectrumIndex].size(),
                      (bankSizes[bank] + 77 - 1 - pixelInBank) / 77);
+    if (weighted) {
+      // FakeDataSource gives all events of a bank the weight `bank + 1`.
+      const auto &weights = weightLists[localSpectrumIndex];
+      TS_ASSERT_EQUALS(weights.size(), eventLists[localSpectrumIndex].size());
+      TS_ASSERT(std::all_of(weights.cbegin(), weights.cend(),
+                            [bank](const float weight) {
+                              return weight == static_cast<float>(bank + 1);
+                            }));
+    }
     int64_t previousPulseTime{0};
     for (size_t event = 0; event < eventLists[localSpectrumIndex].size();
          ++event) {
@@ -197,7 +219,16 @@ public:
     for (const size_t chunkSize : {37, 123, 1111}) {
       for (const auto threads : {1, 2, 3, 5, 7, 13}) {
         ParallelTestHelpers::ParallelRunner runner(threads);
-        runner.run(do_test_load, chunkSize);
+        runner.run(do_test_load, chunkSize, false);
+      }
+    }
+  }
+
+  void test_load_weights() {
+    for (const size_t chunkSize : {37, 1111}) {
+      for (const auto threads : {1, 3}) {
+        ParallelTestHelpers::ParallelRunner runner(threads);
+        runner.run(do_test_load, chunkSize, true);
       }
     }
   }
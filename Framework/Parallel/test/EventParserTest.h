@@ -335,6 +335,115 @@ public:
     gen.checkEventLists();
   }
 
+  void testParsingFull_InParts_4Threads_2Banks() {
+    // Enough events that the parser uses threads
+    size_t numBanks = 2;
+    anonymous::FakeParserDataGenerator<int32_t, int64_t, double> gen(
+        numBanks, 1000, 2, 400);
+    auto parser = gen.generateTestParser();
+
+    for (size_t bank = 0; bank < numBanks; bank++) {
+      parser->setEventDataPartitioner(
+          Kernel::make_unique<EventDataPartitioner<int32_t, int64_t, double>>(
+              4, PulseTimeGenerator<int32_t, int64_t>{gen.eventIndex(bank),
+                                                      gen.eventTimeZero(),
+                                                      "nanosecond", 0}));
+      parser->setEventTimeOffsetUnit("microsecond");
+      auto event_id = gen.eventId(bank);
+      auto event_time_offset = gen.eventTimeOffset(bank);
+
+      auto parts = 2;
+      auto portion = event_id.size() / parts;
+      for (int i = 0; i < parts; ++i) {
+        auto offset = portion * i;
+        if (i == (parts - 1))
+          portion = event_id.size() - offset;
+        Chunker::LoadRange range{bank, offset, portion};
+        parser->startAsync(event_id.data() + offset,
+                           event_time_offset.data() + offset, range);
+        parser->wait();
+      }
+    }
+    gen.checkEventLists();
+    TS_ASSERT_EQUALS(parser->statistics().discardedEvents, 0);
+  }
+
+  void test_filter_and_statistics() {
+    std::vector<std::vector<int>> rankGroups;
+    std::vector<int32_t> bankOffsets{10};
+    std::vector<TofEvent> eventList0;
+    std::vector<TofEvent> eventList1;
+    std::vector<std::vector<TofEvent> *> eventLists{&eventList0, &eventList1};
+    Parallel::Communicator comm;
+    EventParser<double> parser(comm, rankGroups, bankOffsets, eventLists);
+    parser.setEventDataPartitioner(
+        Kernel::make_unique<EventDataPartitioner<int32_t, int32_t, double>>(
+            2, PulseTimeGenerator<int32_t, int32_t>({0, 3}, {100, 200},
+                                                    "nanosecond", 0)));
+    parser.setEventTimeOffsetUnit("microsecond");
+    EventFilter filter;
+    filter.tofMin = 2.0;
+    filter.tofMax = 3e8;
+    filter.pulseTimeStart = DateAndTime(150);
+    parser.setEventFilter(filter);
+
+    // IDs 9 and 12 have no event list, but only ID 9 passes the filter
+    std::vector<int32_t> event_id{10, 11, 10, 11, 9, 10, 10, 12};
+    const std::vector<double> event_time_offset{5.0, 6.0, 7.0, 8.0,
+                                                9.0, 1.0, 2.5e8, 1.5};
+    const Chunker::LoadRange range{0, 0, event_id.size()};
+    parser.startAsync(event_id.data(), event_time_offset.data(), range);
+    parser.wait();
+
+    // The first pulse and the event below tofMin are filtered out
+    TS_ASSERT_EQUALS(eventList0,
+                     std::vector<TofEvent>{TofEvent(2.5e8, DateAndTime(200))});
+    TS_ASSERT_EQUALS(eventList1,
+                     std::vector<TofEvent>{TofEvent(8.0, DateAndTime(200))});
+    const auto &statistics = parser.statistics();
+    TS_ASSERT_EQUALS(statistics.discardedEvents, 1);
+    TS_ASSERT_EQUALS(statistics.shortestTof, 8.0);
+    TS_ASSERT_EQUALS(statistics.longestTof, 8.0);
+    TS_ASSERT_EQUALS(statistics.badTofs, 1);
+  }
+
+  void test_weights() {
+    std::vector<std::vector<int>> rankGroups;
+    std::vector<int32_t> bankOffsets{10};
+    std::vector<TofEvent> eventList0;
+    std::vector<TofEvent> eventList1;
+    std::vector<std::vector<TofEvent> *> eventLists{&eventList0, &eventList1};
+    std::vector<float> weightList0;
+    std::vector<float> weightList1;
+    std::vector<std::vector<float> *> weightLists{&weightList0, &weightList1};
+    Parallel::Communicator comm;
+    EventParser<double> parser(comm, rankGroups, bankOffsets, eventLists,
+                               weightLists);
+    TS_ASSERT(parser.isWeighted());
+    parser.setEventDataPartitioner(
+        Kernel::make_unique<EventDataPartitioner<int32_t, int32_t, double>>(
+            2, PulseTimeGenerator<int32_t, int32_t>({0}, {100}, "nanosecond",
+                                                    0)));
+    parser.setEventTimeOffsetUnit("microsecond");
+    EventFilter filter;
+    filter.tofMin = 2.0;
+    parser.setEventFilter(filter);
+
+    std::vector<int32_t> event_id{10, 11, 10, 11};
+    const std::vector<double> event_time_offset{5.0, 6.0, 1.0, 8.0};
+    const std::vector<float> event_weight{0.5f, 1.5f, 2.5f, 3.5f};
+    const Chunker::LoadRange range{0, 0, event_id.size()};
+    parser.startAsync(event_id.data(), event_time_offset.data(),
+                      event_weight.data(), range);
+    parser.wait();
+
+    // Weights of filtered events are dropped along with the events
+    TS_ASSERT_EQUALS(eventList0.size(), 1);
+    TS_ASSERT_EQUALS(weightList0, std::vector<float>{0.5f});
+    TS_ASSERT_EQUALS(eventList1.size(), 2);
+    TS_ASSERT_EQUALS(weightList1, (std::vector<float>{1.5f, 3.5f}));
+  }
+
   void test_setEventTimeOffsetUnit() {
     std::vector<std::vector<int>> rankGroups;
     std::vector<int32_t> bankOffsets{0};
@@ -0,0 +1,112 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+//     NScD Oak Ridge National Laboratory, European Spallation Source
+//     & Institut Laue - Langevin
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidAPI/IMDHistoWorkspace.h"
+
+#include <boost/python/class.hpp>
+#include <boost/python/make_constructor.hpp>
+#include <boost/python/return_arg.hpp>
+
+#include <stdexcept>
+
+using Mantid::API::IMDHistoWorkspace_sptr;
+using Mantid::DataObjects::MDHistoExpression;
+using Mantid::DataObjects::MDHistoWorkspace;
+using Mantid::DataObjects::MDHistoWorkspace_sptr;
+using Mantid::signal_t;
+using namespace boost::python;
+
+namespace {
+/// Cast a workspace passed from Python to an MDHistoWorkspace
+MDHistoWorkspace_sptr toHisto(const IMDHistoWorkspace_sptr &workspace) {
+  auto histo = boost::dynamic_pointer_cast<MDHistoWorkspace>(workspace);
+  if (!histo)
+    throw std::invalid_argument(
+        "MDHistoExpression: expected an MDHistoWorkspace");
+  return histo;
+}
+
+MDHistoExpression *createExpression(const IMDHistoWorkspace_sptr &input) {
+  return new MDHistoExpression(toHisto(input));
+}
+
+MDHistoExpression &plusWorkspace(MDHistoExpression &self,
+                                 const IMDHistoWorkspace_sptr &operand) {
+  return self.plus(toHisto(operand));
+}
+
+MDHistoExpression &minusWorkspace(MDHistoExpression &self,
+                                  const IMDHistoWorkspace_sptr &operand) {
+  return self.minus(toHisto(operand));
+}
+
+MDHistoExpression &multiplyWorkspace(MDHistoExpression &self,
+                                     const IMDHistoWorkspace_sptr &operand) {
+  return self.multiply(toHisto(operand));
+}
+
+MDHistoExpression &divideWorkspace(MDHistoExpression &self,
+                                   const IMDHistoWorkspace_sptr &operand) {
+  return self.divide(toHisto(operand));
+}
+
+void evaluateInPlace(const MDHistoExpression &self,
+                     const IMDHistoWorkspace_sptr &output) {
+  self.evaluateInPlace(*toHisto(output));
+}
+
+/// Pointer to one of the overloads taking a scalar
+using ScalarOperation = MDHistoExpression &(MDHistoExpression::*)(
+    const signal_t, const signal_t);
+} // namespace
+
+void export_MDHistoExpression() {
+  class_<MDHistoExpression, boost::noncopyable>("MDHistoExpression", no_init)
+      .def("__init__",
+           make_constructor(&createExpression, default_call_policies(),
+                            (arg("input"))),
+           "Start a chain of operations on the given MDHistoWorkspace")
+      .def("plus", &plusWorkspace, return_self<>(),
+           (arg("self"), arg("operand")), "Add a workspace")
+      .def("plus", static_cast<ScalarOperation>(&MDHistoExpression::plus),
+           return_self<>(), (arg("self"), arg("signal"), arg("error") = 0.0),
+           "Add a scalar")
+      .def("minus", &minusWorkspace, return_self<>(),
+           (arg("self"), arg("operand")), "Subtract a workspace")
+      .def("minus", static_cast<ScalarOperation>(&MDHistoExpression::minus),
+           return_self<>(), (arg("self"), arg("signal"), arg("error") = 0.0),
+           "Subtract a scalar")
+      .def("multiply", &multiplyWorkspace, return_self<>(),
+           (arg("self"), arg("operand")), "Multiply by a workspace")
+      .def("multiply",
+           static_cast<ScalarOperation>(&MDHistoExpression::multiply),
+           return_self<>(), (arg("self"), arg("signal"), arg("error") = 0.0),
+           "Multiply by a scalar")
+      .def("divide", &divideWorkspace, return_self<>(),
+           (arg("self"), arg("operand")), "Divide by a workspace")
+      .def("divide", static_cast<ScalarOperation>(&MDHistoExpression::divide),
+           return_self<>(), (arg("self"), arg("signal"), arg("error") = 0.0),
+           "Divide by a scalar")
+      .def("log", &MDHistoExpression::log, return_self<>(),
+           (arg("self"), arg("filler") = 0.0),
+           "Take the natural logarithm of the signal")
+      .def("log10", &MDHistoExpression::log10, return_self<>(),
+           (arg("self"), arg("filler") = 0.0),
+           "Take the base-10 logarithm of the signal")
+      .def("exp", &MDHistoExpression::exp, return_self<>(), arg("self"),
+           "Take the exponential of the signal")
+      .def("power", &MDHistoExpression::power, return_self<>(),
+           (arg("self"), arg("exponent")), "Raise the signal to a power")
+      .def("size", &MDHistoExpression::size, arg("self"),
+           "Return the number of recorded operations")
+      .def("evaluate", &MDHistoExpression::evaluate, arg("self"),
+           "Evaluate the expression in a single pass into a new workspace")
+      .def("evaluateInPlace", &evaluateInPlace,
+           (arg("self"), arg("output")),
+           "Evaluate the expression in a single pass into an existing "
+           "workspace, which may be the input");
+}
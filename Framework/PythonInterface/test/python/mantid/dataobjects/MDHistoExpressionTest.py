@@ -0,0 +1,50 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory UKRI,
+#     NScD Oak Ridge National Laboratory, European Spallation Source
+#     & Institut Laue - Langevin
+# SPDX - License - Identifier: GPL - 3.0 +
+from __future__ import (absolute_import, division, print_function)
+
+import unittest
+
+import numpy
+from mantid import mtd
+from mantid.dataobjects import MDHistoExpression
+from testhelpers import run_algorithm
+
+
+class MDHistoExpressionTest(unittest.TestCase):
+
+    def setUp(self):
+        for name, signal in (('A', '1,2,3,4'), ('B', '4,3,2,1'), ('C', '2,2,2,2')):
+            run_algorithm('CreateMDHistoWorkspace', SignalInput=signal, ErrorInput='1,1,1,1',
+                          Dimensionality='2', Extents='-1,1,-1,1', NumberOfBins='2,2',
+                          Names='x,y', Units='U,U', OutputWorkspace=name)
+
+    def tearDown(self):
+        mtd.clear()
+
+    def test_evaluate(self):
+        result = MDHistoExpression(mtd['A']).minus(mtd['B']).divide(mtd['C']).multiply(2.0).evaluate()
+        numpy.testing.assert_allclose(result.getSignalArray().flatten(order='F'), [-3., -1., 1., 3.])
+        # The inputs are unchanged
+        numpy.testing.assert_allclose(mtd['A'].getSignalArray().flatten(order='F'), [1., 2., 3., 4.])
+
+    def test_chained_expression_creates_no_temporaries(self):
+        names = sorted(mtd.getObjectNames())
+        A = mtd['A']
+        expression = MDHistoExpression(A).plus(mtd['B']).multiply(mtd['C']).plus(1.0, 0.0).log()
+        self.assertEqual(expression.size(), 4)
+        expression.evaluateInPlace(A)
+        # The result is written into A, no workspace is added to the ADS
+        self.assertEqual(sorted(mtd.getObjectNames()), names)
+        numpy.testing.assert_allclose(A.getSignalArray().flatten(order='F'), [numpy.log(11.)] * 4)
+
+    def test_output_cannot_be_a_later_operand(self):
+        expression = MDHistoExpression(mtd['A']).exp().plus(mtd['B'])
+        self.assertRaises(ValueError, expression.evaluateInPlace, mtd['B'])
+
+
+if __name__ == '__main__':
+    unittest.main()